@@ -104,7 +104,8 @@ DtlsTransport::DtlsTransport(
     std::string password,
     bool isServer, 
     wa::Worker* worker, 
-    wa::IOWorker* io_worker)
+    wa::IOWorker* io_worker,
+    std::unique_ptr<PrewarmedTransport> prewarmed)
       : Transport(med, 
                   transport_name, 
                   connection_id, 
@@ -114,9 +115,29 @@ DtlsTransport::DtlsTransport(
                   iceConfig, 
                   worker),
         isServer_(isServer) {
-  ELOG_DEBUG("%s message: constructor, transportName: %s, isBundle: %d", 
-    toLog(), transport_name.c_str(), bundle);
-    
+  if (prewarmed && !(isServer_ && rtcp_mux)) {
+    // The pool only makes rtcp-muxed server transports
+    ELOG_WARN("%s message: prewarmed transport not usable, isServer: %d, rtcpMux: %d",
+              toLog(), isServer_, rtcp_mux);
+    TransportPool::dispose(std::move(prewarmed), io_worker);
+  }
+  prewarmed_ = prewarmed != nullptr;
+  ELOG_DEBUG("%s message: constructor, transportName: %s, isBundle: %d, prewarmed: %d", 
+    toLog(), transport_name.c_str(), bundle, prewarmed_);
+
+  if (prewarmed_) {
+    // Server context and started ICE, both made by the TransportPool
+    dtlsRtp = std::move(prewarmed->dtls);
+    dtlsRtp->setDtlsReceiver(this);
+    iceConfig_.connection_id = connection_id_;
+    iceConfig_.username = username;
+    iceConfig_.password = password;
+    ice_ = std::move(prewarmed->ice);
+    rtp_timeout_checker_ = std::move(std::make_unique<TimeoutChecker>(this, dtlsRtp.get()));
+    ELOG_DEBUG("%s message: created", toLog());
+    return;
+  }
+
   dtlsRtp.reset(new DtlsSocketContext());
   dtlsRtp->setDtlsReceiver(this);
 
@@ -166,8 +187,15 @@ DtlsTransport::~DtlsTransport() {
 }
 
 void DtlsTransport::start() {
-  ice_->setIceListener(weak_from_this());
   ice_->copyLogContextFrom(*this);
+  if (prewarmed_) {
+    // Gathering is under way or done, the listener gets what it missed
+    ELOG_DEBUG("%s message: claiming started ice", toLog());
+    ice_->setRemoteCredentials(iceConfig_.username, iceConfig_.password);
+    ice_->setIceListener(weak_from_this());
+    return;
+  }
+  ice_->setIceListener(weak_from_this());
   ELOG_DEBUG("%s message: starting ice", toLog());
   ice_->start();
 }
@@ -197,12 +225,63 @@ void DtlsTransport::onIceData(packetPtr packet) {
     return;
   }
 
-  int len = packet->length;
-  char *data = packet->data;
-  unsigned int component_id = packet->comp;
+  if (!acceptSrtp(packet->data, packet->length, packet->comp)) {
+    return;
+  }
 
-  int length = len;
-  SrtpChannel *srtp = srtp_.get();
+  auto unprotect_packet = std::make_shared<DataPacket>(
+      packet->comp, packet->data, packet->length, VIDEO_PACKET, 
+      packet->received_time_ms);
+  if (!unprotect(unprotect_packet->data, &unprotect_packet->length, 
+                 unprotect_packet->comp, unprotect_packet->received_time_ms)) {
+    return;
+  }
+
+  wa::LatencyTrace trace = packet->latencyTrace();
+  if (trace.active()) {
+    wa::LatencyTracer::stage(wa::LatencyStage::kSrtp, trace);
+    unprotect_packet->metadata().trace = trace;
+  }
+
+  if (auto listener = getTransportListener().lock()) {
+    listener->onTransportData(std::move(unprotect_packet), this);
+  }
+}
+
+void DtlsTransport::onIceDataBatch(DescriptorSpan packets) {
+  if (!running_) {
+    return;
+  }
+
+  // SRTP is undone in place, and the packets for the listener are moved
+  // up to the front of |packets|.
+  size_t count = 0;
+  for (size_t i = 0; i < packets.size(); ++i) {
+    PacketDescriptor& packet = packets[i];
+    if (packet.length <= 0 || 
+        !acceptSrtp(packet.data(), packet.length, packet.comp) ||
+        !unprotect(packet.data(), &packet.length, packet.comp, 
+                   packet.received_time_ms)) {
+      continue;
+    }
+    packet.type = VIDEO_PACKET;
+    wa::LatencyTracer::stage(wa::LatencyStage::kSrtp, packet.meta.trace);
+    if (count != i) {
+      packets[count] = std::move(packet);
+    }
+    ++count;
+  }
+
+  if (count == 0) {
+    return;
+  }
+
+  if (auto listener = getTransportListener().lock()) {
+    listener->onTransportDataBatch(DescriptorSpan(packets.data(), count), this);
+  }
+}
+
+bool DtlsTransport::acceptSrtp(char* data, int len, unsigned int component_id) {
   if (DtlsTransport::isDtlsPacket(data, len)) {
     ELOG_DEBUG("%s message: Received DTLS message, transportName: %s, componentId: %u",
                toLog(), transport_name.c_str(), component_id);
@@ -212,42 +291,44 @@ void DtlsTransport::onIceData(packetPtr packet) {
     } else {
       dtlsRtcp->read(reinterpret_cast<unsigned char*>(data), len);
     }
-    return;
+    return false;
   }
   
-  if (this->getTransportState() != TRANSPORT_READY) {
-    return;
-  }
-  
-  auto unprotect_packet = std::make_shared<DataPacket>(
-      component_id, data, len, VIDEO_PACKET, packet->received_time_ms);
+  return this->getTransportState() == TRANSPORT_READY;
+}
 
+bool DtlsTransport::unprotect(char* data, 
+                              int* length, 
+                              unsigned int component_id, 
+                              uint64_t received_time_ms) {
+  SrtpChannel *srtp = srtp_.get();
   if (dtlsRtcp != NULL && component_id == 2) {
     srtp = srtcp_.get();
   }
   
   if (srtp == NULL) {
-    return;
+    return false;
   }
   
-  RtcpHeader *chead = reinterpret_cast<RtcpHeader*>(unprotect_packet->data);
+  RtcpHeader *chead = reinterpret_cast<RtcpHeader*>(data);
   if (chead->isRtcp()) {
-    if (srtp->unprotectRtcp(unprotect_packet->data, &unprotect_packet->length) < 0) {
-      return;
+    if (srtp->unprotectRtcp(data, length) < 0) {
+      return false;
     }
   } else {
-    if (srtp->unprotectRtp(unprotect_packet->data, &unprotect_packet->length) < 0) {
-      return;
+    if (srtp->unprotectRtp(data, length) < 0) {
+      return false;
     }
   }
   
-  if (length <= 0) {
-    return;
+  if (*length <= 0) {
+    return false;
   }
-  
-  if (auto listener = getTransportListener().lock()) {
-    listener->onTransportData(unprotect_packet, this);
+
+  if (capture_in_) {
+    capture_in_->write(data, *length, chead->isRtcp(), received_time_ms);
   }
+  return true;
 }
 
 void DtlsTransport::updateIceState(IceState state, IceConnection *conn) {
@@ -270,7 +351,7 @@ void DtlsTransport::onCandidate(const CandidateInfo &candidate, IceConnection *c
   });
 }
 
-void DtlsTransport::write(char* data, int len) {
+void DtlsTransport::write(char* data, int len, wa::LatencyTrace& trace) {
   if (ice_ == nullptr || !running_) {
     return;
   }
@@ -281,6 +362,10 @@ void DtlsTransport::write(char* data, int len) {
     memcpy(protectBuf_, data, len);
     int comp = 1;
     RtcpHeader *chead = reinterpret_cast<RtcpHeader*>(protectBuf_);
+    if (capture_out_) {
+      capture_out_->write(protectBuf_, len, chead->isRtcp(), 
+                          wa::ClockUtils::timePointToMs(wa::clock::now()));
+    }
     if (chead->isRtcp()) {
       if (!rtcp_mux_) {
         comp = 2;
@@ -305,8 +390,10 @@ void DtlsTransport::write(char* data, int len) {
     if (length <= 10) {
       return;
     }
+    wa::LatencyTracer::stage(wa::LatencyStage::kProtect, trace);
     if (ice_->checkIceState() == IceState::READY) {
       writeOnIce(comp, protectBuf_, length);
+      wa::LatencyTracer::stage(wa::LatencyStage::kSend, trace);
     }
   }
 }
@@ -422,6 +509,9 @@ void DtlsTransport::updateIceStateSync(IceState state, IceConnection *conn) {
   }
   
   if (state == IceState::READY) {
+    if (ice_ready_time_ == wa::time_point()) {
+      ice_ready_time_ = wa::clock::now();
+    }
     if (!isServer_ && dtlsRtp && !dtlsRtp->started) {
       ELOG_DEBUG("%s message: DTLSRTP Start, transportName: %s", toLog(), transport_name.c_str());
       dtlsRtp->start();
@@ -12,6 +12,7 @@
 #include "erizo/dtls/DtlsSocket.h"
 #include "erizo/IceConnection.h"
 #include "erizo/Transport.h"
+#include "erizo/TransportPool.h"
 #include "erizo/logger.h"
 
 namespace erizo {
@@ -33,7 +34,8 @@ class DtlsTransport : dtls::DtlsReceiver, public Transport {
                 std::string password, 
                 bool isServer, 
                 wa::Worker* worker,
-                wa::IOWorker* io_worker);
+                wa::IOWorker* io_worker,
+                std::unique_ptr<PrewarmedTransport> prewarmed = nullptr);
   virtual ~DtlsTransport();
   void connectionStateChanged(IceState newState);
   std::string getMyFingerprint() const;
@@ -43,12 +45,13 @@ class DtlsTransport : dtls::DtlsReceiver, public Transport {
 
   //woker thread
   void onIceData(packetPtr packet) override;
+  void onIceDataBatch(DescriptorSpan packets) override;
 
   //IceConnectionListener implement
   void onCandidate(const CandidateInfo &candidate, IceConnection *conn) override;
   void updateIceState(IceState state, IceConnection *conn) override;
   
-  void write(char* data, int len) override;
+  void write(char* data, int len, wa::LatencyTrace& trace) override;
 
   //DtlsReceiver implement
   void onDtlsPacket(dtls::DtlsSocketContext *ctx, 
@@ -68,11 +71,21 @@ class DtlsTransport : dtls::DtlsReceiver, public Transport {
   
   static bool isDtlsPacket(const char* buf, int len);
  private:
+  // Hands DTLS to the handshake, true if |data| is SRTP or SRTCP the
+  // transport is ready to unprotect.
+  bool acceptSrtp(char* data, int len, unsigned int component_id);
+  // Decrypts |data| in place, false if there is nothing to hand to the
+  // listener.
+  bool unprotect(char* data, 
+                 int* length, 
+                 unsigned int component_id, 
+                 uint64_t received_time_ms);
   char protectBuf_[5000];
   std::unique_ptr<dtls::DtlsSocketContext> dtlsRtp, dtlsRtcp;
   std::unique_ptr<SrtpChannel> srtp_, srtcp_;
   bool readyRtp{false}, readyRtcp{false};
   bool isServer_;
+  bool prewarmed_{false};
   std::unique_ptr<TimeoutChecker> rtcp_timeout_checker_, rtp_timeout_checker_;
   packetPtr p_;
 };
@@ -60,6 +60,10 @@ struct IceConfig {
     uint16_t max_port{0};
     bool should_trickle{false};
     bool use_nicer{false};
+    // A full agent that nominates, for the client side of a connection to a
+    // lite one. wa never sets it, its connections are the lite, controlled
+    // side; the client peers of bench_loopback_load do.
+    bool ice_controlling{false};
 };
 
 /**
@@ -75,7 +79,7 @@ enum IceState {
 
 class IceConnectionListener {
  public:
-    virtual void onPacketReceived(packetPtr packet) = 0;
+    virtual void onPacketReceived(PacketDescriptor packet) = 0;
     virtual void onCandidate(const CandidateInfo &candidate, IceConnection *conn) = 0;
     virtual void updateIceState(IceState state, IceConnection *conn) = 0;
 };
@@ -133,13 +133,14 @@ void LibNiceConnection::onData(unsigned int component_id, char* buf, int len) {
   }
 
   if (state == IceState::READY) {
-    packetPtr packet (new DataPacket());
-    std::memcpy(packet->data, buf, len);
-    packet->comp = component_id;
-    packet->length = len;
-    packet->received_time_ms = ClockUtils::timePointToMs(clock::now());
+    PacketDescriptor packet(std::make_shared<PacketBuffer>(),
+                            DataPacket::usedLength(len), component_id,
+                            OTHER_PACKET,
+                            ClockUtils::timePointToMs(clock::now()));
+    std::memcpy(packet.data(), buf, packet.length);
+    packet.meta.trace = LatencyTracer::sample();
     if (auto listener = getIceListener().lock()) {
-      listener->onPacketReceived(packet);
+      listener->onPacketReceived(std::move(packet));
     }
   }
 }
@@ -163,7 +164,8 @@ void LibNiceConnection::start() {
     ELOG_TRACE("%s message: creating Nice Agent", toLog());
 
     // Create a nice agent
-    agent_ = lib_nice_->NiceAgentNewFull(context_, 
+    agent_ = lib_nice_->NiceAgentNewFull(context_, ice_config_.ice_controlling ?
+        NICE_AGENT_OPTION_REGULAR_NOMINATION :
         NICE_AGENT_OPTION_LITE_MODE|NICE_AGENT_OPTION_SUPPORT_RENOMINATION);
 
     if (ice_config_.stun_server.compare("") != 0 && ice_config_.stun_port != 0) {
@@ -174,7 +176,7 @@ void LibNiceConnection::start() {
                  toLog(), ice_config_.stun_server.c_str(), ice_config_.stun_port);
     }
     
-    gboolean controllingMode = {FALSE};
+    gboolean controllingMode = ice_config_.ice_controlling ? TRUE : FALSE;
     g_object_set(agent_, "controlling-mode", controllingMode, nullptr);
     
     g_object_set(agent_, "max-connectivity-checks", 100, nullptr);
@@ -352,7 +354,48 @@ bool LibNiceConnection::setRemoteCandidates(const std::vector<CandidateInfo> &ca
 
 void LibNiceConnection::gatheringDone(uint stream_id) {
   ELOG_DEBUG("%s message: gathering done, stream_id: %u", toLog(), stream_id);
-  updateIceState(IceState::CANDIDATES_RECEIVED);
+  {
+    std::lock_guard<std::mutex> guard(gathered_mutex_);
+    gathering_done_ = true;
+  }
+  deliverGathered();
+}
+
+void LibNiceConnection::setIceListener(std::weak_ptr<IceConnectionListener> listener) {
+  {
+    std::lock_guard<std::mutex> guard(gathered_mutex_);
+    IceConnection::setIceListener(listener);
+  }
+  deliverGathered();
+}
+
+void LibNiceConnection::deliverGathered() {
+  std::unique_lock<std::mutex> guard(gathered_mutex_);
+  if (delivering_) {
+    // The thread delivering picks up what was just queued
+    return;
+  }
+  delivering_ = true;
+  while (true) {
+    auto listener = this->getIceListener().lock();
+    if (!listener || (gathered_.empty() && !gathering_done_)) {
+      break;
+    }
+    std::vector<CandidateInfo> candidates;
+    candidates.swap(gathered_);
+    bool done = gathering_done_;
+    gathering_done_ = false;
+    guard.unlock();
+
+    for (const auto& cand_info : candidates) {
+      listener->onCandidate(cand_info, this);
+    }
+    if (done) {
+      updateIceState(IceState::CANDIDATES_RECEIVED);
+    }
+    guard.lock();
+  }
+  delivering_ = false;
 }
 
 CandidateInfo LibNiceConnection::transformCandidate(NiceCandidate* cand, bool bLocal) {
@@ -421,9 +464,11 @@ void LibNiceConnection::gotCandidate(NiceCandidate* cand) {
   cand_info.username = ufrag_;
   cand_info.password = upass_;
 
-  if (auto listener = this->getIceListener().lock()) {
-    listener->onCandidate(cand_info, this);
+  {
+    std::lock_guard<std::mutex> guard(gathered_mutex_);
+    gathered_.push_back(std::move(cand_info));
   }
+  deliverGathered();
 }
 
 void LibNiceConnection::setRemoteCredentials(const std::string& username, const std::string& password) {
@@ -81,11 +81,19 @@ class LibNiceConnection : public IceConnection {
 
   void gotCandidate(NiceCandidate*);
 
+  /**
+   * Attaches the listener and hands it the candidates and the gathering state
+   * reached before, as happens for a connection started ahead of time.
+   */
+  void setIceListener(std::weak_ptr<IceConnectionListener> listener) override;
+
   void onRemoteNewCandidate(NiceCandidate*);
 
  private:
   void mainLoop();
   CandidateInfo transformCandidate(NiceCandidate* cand, bool local);
+  // Hands what gathered_ holds to the listener, outside gathered_mutex_.
+  void deliverGathered();
   
  private:
   std::unique_ptr<LibNiceInterface> lib_nice_;
@@ -97,6 +105,13 @@ class LibNiceConnection : public IceConnection {
   std::mutex close_mutex_;
   bool receivedLastCandidate_;
 
+  // Local candidates and the end of gathering not yet handed to a listener,
+  // kept in order while none is attached or another thread delivers.
+  std::mutex gathered_mutex_;
+  std::vector<CandidateInfo> gathered_;
+  bool gathering_done_{false};
+  bool delivering_{false};
+
   guint stream_id_{0};
 };
 
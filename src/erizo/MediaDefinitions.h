@@ -11,8 +11,12 @@
 #include <algorithm>
 #include <memory>
 #include <cstring>
+#include <string>
 
+#include "myrtc/rtc_base/array_view.h"
+#include "myrtc/rtp_rtcp/rtp_header_view.h"
 #include "utils/Clock.h"
+#include "utils/LatencyTracer.h"
 
 namespace erizo {
 
@@ -22,7 +26,98 @@ enum packetType {
   OTHER_PACKET
 };
 
+// Per layer metadata, only present on packets a layer aware handler looked at.
+struct PacketLayerInfo {
+  bool belongsToSpatialLayer(int spatial_layer_) const {
+    return std::find(compatible_spatial_layers.begin(),
+                     compatible_spatial_layers.end(),
+                     spatial_layer_) != compatible_spatial_layers.end();
+  }
+
+  bool belongsToTemporalLayer(int temporal_layer_) const {
+    return std::find(compatible_temporal_layers.begin(),
+                     compatible_temporal_layers.end(),
+                     temporal_layer_) != compatible_temporal_layers.end();
+  }
+
+  std::vector<int> compatible_spatial_layers;
+  std::vector<int> compatible_temporal_layers;
+  bool is_keyframe{false};  // Note: It can be just a keyframe first packet in VP8
+  bool ending_of_layer_frame{false};
+  int picture_id{-1};
+  int tl0_pic_idx{-1};
+  std::string codec;
+  unsigned int clock_rate{0};
+};
+
+// What a packet picks up on its way through: the layout of its RTP header,
+// parsed once on arrival, and its stage timestamps when it is sampled for
+// latency tracing.
+struct PacketMetadata {
+  bool empty() const {
+    return header.size() == 0 && !trace.active();
+  }
+
+  wa::LatencyTrace trace;
+  // Stale once the header bytes are rewritten, see
+  // webrtc::RtpHeaderView::Matches().
+  webrtc::RtpHeaderView header;
+};
+
+// MTU sized payload storage behind a shared handle. Left uninitialized, the
+// bytes are always written before they are read.
+struct PacketBuffer {
+  static constexpr int kCapacity = 1500;
+
+  PacketBuffer() {}
+
+  char data[kCapacity];
+};
+
+using PacketBufferPtr = std::shared_ptr<PacketBuffer>;
+
+// A packet as the receive path queues and batches it: a handle on the buffer
+// holding its bytes and its metadata inline, a couple of hundred bytes to copy
+// where DataPacket drags 1.5 KB along. From the ICE read to
+// MediaStream::onTransportDataBatch packets travel as descriptors, SRTP is
+// undone in place in the buffer.
+struct PacketDescriptor {
+  PacketDescriptor() = default;
+
+  PacketDescriptor(PacketBufferPtr buffer_, 
+                   int length_, 
+                   int comp_, 
+                   packetType type_, 
+                   uint64_t received_time_ms_)
+    : buffer{std::move(buffer_)}, 
+      length{length_}, 
+      comp{comp_}, 
+      type{type_}, 
+      received_time_ms{received_time_ms_} {
+  }
+
+  char* data() const {
+    return buffer->data;
+  }
+
+  PacketBufferPtr buffer;
+  int length{0};
+  int comp{0};         //component_id
+  packetType type{OTHER_PACKET};
+  uint64_t received_time_ms{0};
+  PacketMetadata meta;
+  std::shared_ptr<const PacketLayerInfo> layers;
+};
+
+// A run of descriptors handed over in one call, see PacketSpan.
+using DescriptorSpan = rtc::ArrayView<PacketDescriptor>;
+
+// Compatibility shim for the code passing payload and metadata around in one
+// object, the pipeline and the sinks. Layer info and metadata live in optional
+// side structs, and copies only touch the used part of data[].
 struct DataPacket {
+  static constexpr int kMaxLength = PacketBuffer::kCapacity;
+
   DataPacket() = default;
 
   DataPacket(int comp_, 
@@ -31,71 +126,141 @@ struct DataPacket {
              packetType type_, 
              uint64_t received_time_ms_) 
              : comp{comp_}, 
-               length{length_}, 
+               length{usedLength(length_)}, 
                type{type_}, 
-               received_time_ms{received_time_ms_}, 
-               is_keyframe{false},
-               ending_of_layer_frame{false}, 
-               picture_id{-1}, 
-               tl0_pic_idx{-1} {
-    std::memcpy(data, data_, length_);
+               received_time_ms{received_time_ms_} {
+    std::memcpy(data, data_, length);
   }
 
   DataPacket(int comp_, const char *data_, int length_, packetType type_)
     : comp{comp_}, 
-      length{length_}, 
+      length{usedLength(length_)}, 
       type{type_}, 
-      received_time_ms{wa::ClockUtils::timePointToMs(wa::clock::now())},
-      is_keyframe{false}, 
-      ending_of_layer_frame{false},
-      picture_id{-1}, 
-      tl0_pic_idx{-1} {
-    std::memcpy(data, data_, length_);
+      received_time_ms{wa::ClockUtils::timePointToMs(wa::clock::now())} {
+    std::memcpy(data, data_, length);
   }
 
   DataPacket(int comp_, const unsigned char *data_, int length_)
     : comp{comp_}, 
-      length{length_}, 
+      length{usedLength(length_)}, 
       type{VIDEO_PACKET}, 
-      received_time_ms{wa::ClockUtils::timePointToMs(wa::clock::now())},
-      is_keyframe{false}, 
-      ending_of_layer_frame{false}, 
-      picture_id{-1}, 
-      tl0_pic_idx{-1} {
-    std::memcpy(data, data_, length_);
+      received_time_ms{wa::ClockUtils::timePointToMs(wa::clock::now())} {
+    std::memcpy(data, data_, length);
+  }
+
+  explicit DataPacket(const PacketDescriptor& desc)
+    : comp{desc.comp}, 
+      length{usedLength(desc.length)}, 
+      type{desc.type}, 
+      received_time_ms{desc.received_time_ms} {
+    std::memcpy(data, desc.data(), length);
+    if (desc.layers) {
+      layers = std::make_unique<PacketLayerInfo>(*desc.layers);
+    }
+    if (!desc.meta.empty()) {
+      meta = std::make_unique<PacketMetadata>(desc.meta);
+    }
   }
 
-  bool belongsToSpatialLayer(int spatial_layer_) {
-    std::vector<int>::iterator item = std::find(compatible_spatial_layers.begin(),
-                                              compatible_spatial_layers.end(),
-                                              spatial_layer_);
+  DataPacket(const DataPacket& other)
+    : comp{other.comp}, 
+      length{usedLength(other.length)}, 
+      type{other.type}, 
+      received_time_ms{other.received_time_ms} {
+    std::memcpy(data, other.data, length);
+    if (other.layers) {
+      layers = std::make_unique<PacketLayerInfo>(*other.layers);
+    }
+    if (other.meta) {
+      meta = std::make_unique<PacketMetadata>(*other.meta);
+    }
+  }
+
+  DataPacket& operator=(const DataPacket& other) {
+    if (this != &other) {
+      comp = other.comp;
+      length = usedLength(other.length);
+      type = other.type;
+      received_time_ms = other.received_time_ms;
+      std::memcpy(data, other.data, length);
+      layers.reset(other.layers ? new PacketLayerInfo(*other.layers) : nullptr);
+      meta.reset(other.meta ? new PacketMetadata(*other.meta) : nullptr);
+    }
+    return *this;
+  }
+
+  PacketLayerInfo& layerInfo() {
+    if (!layers) {
+      layers = std::make_unique<PacketLayerInfo>();
+    }
+    return *layers;
+  }
+
+  PacketMetadata& metadata() {
+    if (!meta) {
+      meta = std::make_unique<PacketMetadata>();
+    }
+    return *meta;
+  }
 
-    return item != compatible_spatial_layers.end();
+  // The header parsed on arrival, nullptr if it was not.
+  const webrtc::RtpHeaderView* parsedHeader() const {
+    return meta && meta->header.size() != 0 ? &meta->header : nullptr;
+  }
+
+  // Inactive unless the packet was sampled for tracing.
+  wa::LatencyTrace latencyTrace() const {
+    return meta ? meta->trace : wa::LatencyTrace{};
+  }
+
+  bool belongsToSpatialLayer(int spatial_layer_) {
+    return layers && layers->belongsToSpatialLayer(spatial_layer_);
   }
 
   bool belongsToTemporalLayer(int temporal_layer_) {
-    std::vector<int>::iterator item = std::find(compatible_temporal_layers.begin(),
-                                              compatible_temporal_layers.end(),
-                                              temporal_layer_);
+    return layers && layers->belongsToTemporalLayer(temporal_layer_);
+  }
+
+  // The part of data[] a copy takes, never past its end.
+  static int usedLength(int length) {
+    return std::min(std::max(length, 0), kMaxLength);
+  }
+
+  int comp{0};         //component_id
+  char data[kMaxLength];
+  int length{0};
+  packetType type{OTHER_PACKET};
+  uint64_t received_time_ms{0};
+  std::unique_ptr<PacketLayerInfo> layers;
+  std::unique_ptr<PacketMetadata> meta;
+};
 
-    return item != compatible_temporal_layers.end();
+// A [offset, offset + length) window into a packet owned by the caller, used to
+// hand out the blocks of a compound RTCP packet without copying them. Only
+// valid for the duration of the call it is passed to, keep a copy() instead.
+struct DataPacketView {
+  DataPacketView(DataPacket* packet_, int offset_, int length_)
+    : packet{packet_}, offset{offset_}, length{length_} {
   }
 
-  int comp;         //component_id
-  char data[1500];
+  char* data() const {
+    return packet->data + offset;
+  }
+
+  std::shared_ptr<DataPacket> copy() const {
+    return std::make_shared<DataPacket>(packet->comp, data(), length,
+                                        packet->type, packet->received_time_ms);
+  }
+
+  DataPacket* packet;
+  int offset;
   int length;
-  packetType type;
-  uint64_t received_time_ms;
-  std::vector<int> compatible_spatial_layers;
-  std::vector<int> compatible_temporal_layers;
-  bool is_keyframe;  // Note: It can be just a keyframe first packet in VP8
-  bool ending_of_layer_frame;
-  int picture_id;
-  int tl0_pic_idx;
-  std::string codec;
-  unsigned int clock_rate = 0;
 };
 
+// A run of packets handed over in one call, so that a worker wakeup can push
+// everything received since the last one through each layer in one pass.
+using PacketSpan = rtc::ArrayView<const std::shared_ptr<DataPacket>>;
+
 class MediaEvent {
 public:
   MediaEvent() = default;
@@ -113,8 +278,15 @@ public:
   inline int deliverFeedback(std::shared_ptr<DataPacket> data_packet) {
     return this->deliverFeedback_(data_packet);
   }
+  inline int deliverFeedback(const DataPacketView& block) {
+    return this->deliverFeedbackBlock_(block);
+  }
 private:
   virtual int deliverFeedback_(std::shared_ptr<DataPacket> data_packet) = 0;
+  // Sinks consuming feedback synchronously override this to skip the copy.
+  virtual int deliverFeedbackBlock_(const DataPacketView& block) {
+    return this->deliverFeedback_(block.copy());
+  }
 };
 
 class FeedbackSource {
@@ -147,6 +319,23 @@ class MediaSink {
   inline int deliverVideoData(std::shared_ptr<DataPacket> data_packet) {
     return this->deliverVideoData_(std::move(data_packet));
   }
+
+  inline int deliverAudioDataBatch(PacketSpan packets) {
+    return this->deliverAudioDataBatch_(packets);
+  }
+
+  inline int deliverVideoDataBatch(PacketSpan packets) {
+    return this->deliverVideoDataBatch_(packets);
+  }
+
+  // RTCP blocks split out of a compound packet, see DataPacketView.
+  inline int deliverAudioRtcp(const DataPacketView& block) {
+    return this->deliverAudioRtcp_(block);
+  }
+
+  inline int deliverVideoRtcp(const DataPacketView& block) {
+    return this->deliverVideoRtcp_(block);
+  }
   
   inline uint32_t getVideoSinkSSRC() {
     return video_sink_ssrc_;
@@ -185,6 +374,28 @@ class MediaSink {
   virtual int deliverAudioData_(std::shared_ptr<DataPacket> data_packet) = 0;
   virtual int deliverVideoData_(std::shared_ptr<DataPacket> data_packet) = 0;
   virtual int deliverEvent_(MediaEventPtr event) = 0;
+  // Sinks able to take a whole batch at once override these.
+  virtual int deliverAudioDataBatch_(PacketSpan packets) {
+    int total = 0;
+    for (const auto& packet : packets) {
+      total += this->deliverAudioData_(packet);
+    }
+    return total;
+  }
+  virtual int deliverVideoDataBatch_(PacketSpan packets) {
+    int total = 0;
+    for (const auto& packet : packets) {
+      total += this->deliverVideoData_(packet);
+    }
+    return total;
+  }
+  // Sinks consuming RTCP synchronously override these to skip the copy.
+  virtual int deliverAudioRtcp_(const DataPacketView& block) {
+    return this->deliverAudioData_(block.copy());
+  }
+  virtual int deliverVideoRtcp_(const DataPacketView& block) {
+    return this->deliverVideoData_(block.copy());
+  }
 
  protected:
   // SSRCs received by the SINK
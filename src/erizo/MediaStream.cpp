@@ -352,35 +352,12 @@ int MediaStream::deliverVideoData_(std::shared_ptr<DataPacket> video_packet) {
 }
 
 int MediaStream::deliverFeedback_(std::shared_ptr<DataPacket> fb_packet) {
-/*
-  RtcpHeader *chead = reinterpret_cast<RtcpHeader*>(fb_packet->data);
-  uint32_t recvSSRC = chead->getSourceSSRC();
-  if (chead->isREMB()) {
-    for (uint8_t index = 0; index < chead->getREMBNumSSRC(); index++) {
-      uint32_t ssrc = chead->getREMBFeedSSRC(index);
-      if (isVideoSourceSSRC(ssrc)) {
-        recvSSRC = ssrc;
-        break;
-      }
-    }
-  }
-  
-  if (isVideoSourceSSRC(recvSSRC)) {
-    fb_packet->type = VIDEO_PACKET;
-    sendPacket(std::make_shared<DataPacket>(*fb_packet));
-  } else if (isAudioSourceSSRC(recvSSRC)) {
-    fb_packet->type = AUDIO_PACKET;
-    sendPacket(std::make_shared<DataPacket>(*fb_packet));
-  } else {
-    ELOG_DEBUG("%s deliverFeedback unknownSSRC: %u," 
-               "localVideoSSRC: %u, localAudioSSRC: %u",
-               toLog(), recvSSRC, 
-               this->getVideoSourceSSRC(), this->getAudioSourceSSRC());
-  }
-*/
-  sendPacket(std::make_shared<DataPacket>(*fb_packet));
-  
-  return fb_packet->length;
+  // Feedback only comes from the constructors bound to this stream, which
+  // terminate the subscribers' RTCP and generate their own, so the packet is
+  // ours to send as is.
+  int length = fb_packet->length;
+  sendPacket(std::move(fb_packet));
+  return length;
 }
 
 int MediaStream::deliverEvent_(MediaEventPtr event) {
@@ -394,41 +371,51 @@ int MediaStream::deliverEvent_(MediaEventPtr event) {
   return 1;
 }
 
+void MediaStream::onTransportRtcp(const DataPacketView& block, Transport*) {
+  if (!pipeline_initialized_) {
+    ELOG_ERROR("%s message: Pipeline not initialized yet.", toLog());
+    return;
+  }
+
+  // RTCP is consumed synchronously by the sinks, so |block| is handed over
+  // as is, sinks deferring it make their own copy.
+  if (is_publisher_) {
+    assert(fb_sink_ == nullptr);
+    RtcpHeader *chead = reinterpret_cast<RtcpHeader*>(block.data());
+    if (audio_sink_ && (!video_sink_ || isAudioSourceSSRC(chead->getSSRC()))) {
+      audio_sink_->deliverAudioRtcp(block);
+    } else if (video_sink_) {
+      video_sink_->deliverVideoRtcp(block);
+    }
+  } else if (fb_sink_ != nullptr && should_send_feedback_) {
+    fb_sink_->deliverFeedback(block);
+  }
+}
+
 void MediaStream::onTransportData(std::shared_ptr<DataPacket> incoming_packet, 
-                                  Transport*) {
+                                  Transport* transport) {
   if (audio_sink_ == nullptr && video_sink_ == nullptr && fb_sink_ == nullptr) {
     return;
   }
 
-  auto packet = std::make_shared<DataPacket>(*incoming_packet);
+  RtcpHeader *chead = reinterpret_cast<RtcpHeader*> (incoming_packet->data);
+  if (chead->isRtcp()) {
+    onTransportRtcp(DataPacketView(incoming_packet.get(), 0, 
+                                   incoming_packet->length), transport);
+    return;
+  }
+
+  readFromTransport(std::make_shared<DataPacket>(*incoming_packet));
+}
 
+void MediaStream::readFromTransport(std::shared_ptr<DataPacket> packet) {
   if (!pipeline_initialized_) {
     ELOG_ERROR("%s message: Pipeline not initialized yet.", toLog());
     return;
   }
 
-  char* buf = packet->data;
-  RtpHeader *head = reinterpret_cast<RtpHeader*> (buf);
-  RtcpHeader *chead = reinterpret_cast<RtcpHeader*> (buf);
+  RtpHeader *head = reinterpret_cast<RtpHeader*> (packet->data);
 
-  // PROCESS RTCP
-  if (chead->isRtcp()) {
-    if (is_publisher_) {
-      assert(fb_sink_ == nullptr);
-      if (video_sink_) {
-        video_sink_->deliverVideoData(std::move(packet));
-      }
-
-      if (audio_sink_) {
-        audio_sink_->deliverAudioData(std::move(packet));
-      }
-      
-    } else if (fb_sink_ != nullptr && should_send_feedback_) {
-       fb_sink_->deliverFeedback(std::move(packet));
-    }
-    return;
-  }
-  
   uint32_t recvSSRC = head->getSSRC();
   if (isVideoSourceSSRC(recvSSRC)) {
     packet->type = VIDEO_PACKET;
@@ -441,6 +428,39 @@ void MediaStream::onTransportData(std::shared_ptr<DataPacket> incoming_packet,
   }
 }
 
+void MediaStream::onTransportDataBatch(DescriptorSpan packets, Transport* transport) {
+  if (audio_sink_ == nullptr && video_sink_ == nullptr && fb_sink_ == nullptr) {
+    return;
+  }
+
+  // The stream's copies are made straight from the descriptors, the only
+  // copies of the payload on the way from the socket to the pipeline.
+  batching_ = true;
+  for (const auto& packet : packets) {
+    auto copy = std::make_shared<DataPacket>(packet);
+    RtcpHeader *chead = reinterpret_cast<RtcpHeader*> (copy->data);
+    if (chead->isRtcp()) {
+      onTransportRtcp(DataPacketView(copy.get(), 0, copy->length), transport);
+      continue;
+    }
+    readFromTransport(std::move(copy));
+  }
+  batching_ = false;
+
+  if (!video_batch_.empty()) {
+    if (video_sink_) {
+      video_sink_->deliverVideoDataBatch(video_batch_);
+    }
+    video_batch_.clear();
+  }
+  if (!audio_batch_.empty()) {
+    if (audio_sink_) {
+      audio_sink_->deliverAudioDataBatch(audio_batch_);
+    }
+    audio_batch_.clear();
+  }
+}
+
 void MediaStream::read(std::shared_ptr<DataPacket> packet) {
   char* buf = packet->data;
  
@@ -455,10 +475,18 @@ void MediaStream::read(std::shared_ptr<DataPacket> packet) {
     int len = packet->length;
     if (isVideoSourceSSRC(recvSSRC) && video_sink_) {
       parseIncomingPayloadType(buf, len, VIDEO_PACKET);
-      video_sink_->deliverVideoData(std::move(packet));
+      if (batching_) {
+        video_batch_.push_back(std::move(packet));
+      } else {
+        video_sink_->deliverVideoData(std::move(packet));
+      }
     } else if (isAudioSourceSSRC(recvSSRC) && audio_sink_) {
       parseIncomingPayloadType(buf, len, AUDIO_PACKET);
-      audio_sink_->deliverAudioData(std::move(packet));
+      if (batching_) {
+        audio_batch_.push_back(std::move(packet));
+      } else {
+        audio_sink_->deliverAudioData(std::move(packet));
+      }
     } else {
       ELOG_WARN("%s read video unknownSSRC: %u, "
                 "localVideoSSRC: %u, localAudioSSRC: %u",
@@ -105,6 +105,9 @@ class MediaStream final : public MediaSink,
   void getJSONStats(std::function<void(std::string)> callback);
 
   void onTransportData(std::shared_ptr<DataPacket> packet, Transport *transport);
+  void onTransportDataBatch(DescriptorSpan packets, Transport *transport);
+  // One block of a compound RTCP packet, see WebRtcConnection::onRtcpFromTransport.
+  void onTransportRtcp(const DataPacketView& block, Transport *transport);
 
   void setTransportInfo(std::string audio_info, std::string video_info);
 
@@ -160,6 +163,8 @@ class MediaStream final : public MediaSink,
   int deliverFeedback_(std::shared_ptr<DataPacket> fb_packet) override;
   int deliverEvent_(MediaEventPtr event) override;
   void initializePipeline();
+  // Pushes the stream's own copy of an RTP packet into the pipeline
+  void readFromTransport(std::shared_ptr<DataPacket> packet);
   void transferLayerStats(std::string spatial, std::string temporal);
   void transferMediaStats(std::string target_node, std::string source_parent, std::string source_node);
 
@@ -193,6 +198,12 @@ class MediaStream final : public MediaSink,
   bool pipeline_initialized_{false};
   bool is_publisher_;
 
+  // While a batch runs through the pipeline, read() collects its output here
+  // and the sinks get it in one call at the end.
+  bool batching_{false};
+  std::vector<std::shared_ptr<DataPacket>> video_batch_;
+  std::vector<std::shared_ptr<DataPacket>> audio_batch_;
+
  protected:
   std::shared_ptr<SdpInfo> remote_sdp_;
 };
@@ -69,6 +69,14 @@ namespace erizo {
     rids_.clear();
     return processSdp(sdp, media);
   }
+
+  bool SdpInfo::initWithParsedSdp(const std::function<void(SdpInfo&)>& fill) {
+    rids_.clear();
+    parsed_order_map.clear();
+    fill(*this);
+    return postProcessInfo();
+  }
+
   std::string SdpInfo::addCandidate(const CandidateInfo& info) {
     candidateVector_.push_back(info);
     return stringifyCandidate(info);
@@ -9,6 +9,7 @@
 
 #include <stdint.h>
 
+#include <functional>
 #include <string>
 #include <vector>
 #include <map>
@@ -163,6 +164,12 @@ class SdpInfo {
    * @return true if success
    */
   bool initWithSdp(const std::string& sdp, const std::string& media);
+  /**
+   * Inits the object with an SDP the caller has already parsed.
+   * @param fill Sets the members initWithSdp would have read from the SDP text.
+   * @return true if success
+   */
+  bool initWithParsedSdp(const std::function<void(SdpInfo&)>& fill);
   /**
    * Adds a new candidate.
    * @param info The CandidateInfo containing the new candidate
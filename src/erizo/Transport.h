@@ -11,9 +11,12 @@
 #include <string>
 #include <vector>
 #include <cstdio>
+#include <mutex>
 #include "erizo/IceConnection.h"
+#include "erizo/rtp/RtpCapture.h"
 #include "utils/Worker.h"
 #include "utils/IOWorker.h"
+#include "utils/Clock.h"
 #include "erizo/logger.h"
 
 /**
@@ -35,6 +38,12 @@ class TransportListener {
  public:
   virtual ~TransportListener() = default;
   virtual void onTransportData(std::shared_ptr<DataPacket> packet, Transport *transport) = 0;
+  // Listeners may parse into the descriptors, which are theirs for the call.
+  virtual void onTransportDataBatch(DescriptorSpan packets, Transport *transport) {
+    for (const auto& packet : packets) {
+      onTransportData(std::make_shared<DataPacket>(packet), transport);
+    }
+  }
   virtual void updateState(TransportState state, Transport *transport) = 0;
   virtual void onCandidate(const CandidateInfo& cand, Transport *transport) = 0;
 };
@@ -64,7 +73,16 @@ class Transport : public std::enable_shared_from_this<Transport>,
   virtual ~Transport() {}
   virtual void updateIceState(IceState state, IceConnection *conn) = 0;
   virtual void onIceData(packetPtr packet) = 0;
-  virtual void write(char* data, int len) = 0;
+  // Everything received since the last worker wakeup, in arrival order.
+  virtual void onIceDataBatch(DescriptorSpan packets) {
+    for (const auto& packet : packets) {
+      if (packet.length > 0) {
+        onIceData(std::make_shared<DataPacket>(packet));
+      }
+    }
+  }
+  // |trace| is advanced past protect and send when the packet is traced.
+  virtual void write(char* data, int len, wa::LatencyTrace& trace) = 0;
   virtual void processLocalSdp(SdpInfo *localSdp_) = 0;
   virtual void start() = 0;
   virtual void close() = 0;
@@ -103,16 +121,19 @@ class Transport : public std::enable_shared_from_this<Transport>,
   }
 
   //IceConnectionListener implement
-  void onPacketReceived(packetPtr packet) {
-    worker_->task([weak_transport = weak_from_this(), packet]() {
+  // Packets are queued and only the first one into an empty queue wakes the
+  // worker up, which then drains the whole queue in one go.
+  void onPacketReceived(PacketDescriptor packet) {
+    {
+      std::lock_guard<std::mutex> guard(pending_lock_);
+      pending_packets_.push_back(std::move(packet));
+      if (pending_packets_.size() > 1) {
+        return;
+      }
+    }
+    worker_->task([weak_transport = weak_from_this()]() {
       if (auto this_ptr = weak_transport.lock()) {
-        if (packet->length > 0) {
-          this_ptr->onIceData(packet);
-        }
-        if (packet->length == -1) {
-          this_ptr->running_ = false;
-          return;
-        }
+        this_ptr->drainPendingPackets();
       }
     });
   }
@@ -125,6 +146,18 @@ class Transport : public std::enable_shared_from_this<Transport>,
     return worker_;
   }
 
+  // Worker thread. Taps the clear packets after SRTP unprotect and before
+  // protect, a nullptr capture stops that direction.
+  void setCapture(std::unique_ptr<RtpCapture> in, std::unique_ptr<RtpCapture> out) {
+    capture_in_ = std::move(in);
+    capture_out_ = std::move(out);
+  }
+
+  // When ICE got connected, a default time_point until then
+  wa::time_point getIceReadyTime() {
+    return ice_ready_time_;
+  }
+
 public:
   std::unique_ptr<IceConnection> ice_;
   MediaType mediaType;
@@ -133,6 +166,37 @@ public:
 private:
   std::weak_ptr<TransportListener> transport_listener_;
 
+private:
+  void drainPendingPackets() {
+    {
+      std::lock_guard<std::mutex> guard(pending_lock_);
+      draining_packets_.swap(pending_packets_);
+    }
+    // A -1 length packet marks the end of the ice connection
+    size_t count = 0;
+    bool closed = false;
+    for (; count < draining_packets_.size(); ++count) {
+      if (draining_packets_[count].length == -1) {
+        closed = true;
+        break;
+      }
+      wa::LatencyTracer::stage(wa::LatencyStage::kDequeue,
+                               draining_packets_[count].meta.trace);
+    }
+    if (count) {
+      onIceDataBatch(DescriptorSpan(draining_packets_.data(), count));
+    }
+    if (closed) {
+      running_ = false;
+    }
+    // Both vectors keep their capacity, so steady state costs no allocation.
+    draining_packets_.clear();
+  }
+
+  std::mutex pending_lock_;
+  std::vector<PacketDescriptor> pending_packets_;
+  std::vector<PacketDescriptor> draining_packets_;
+
 protected:
   std::string connection_id_;
   TransportState state_;
@@ -140,6 +204,9 @@ protected:
   bool bundle_;
   bool running_;
   wa::Worker* worker_;
+  wa::time_point ice_ready_time_;
+  std::unique_ptr<RtpCapture> capture_in_;
+  std::unique_ptr<RtpCapture> capture_out_;
 };
 
 }  // namespace erizo
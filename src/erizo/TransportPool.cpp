@@ -0,0 +1,100 @@
+//
+// Copyright (c) 2021- anjisuan783
+//
+// SPDX-License-Identifier: MIT
+//
+
+#include "erizo/TransportPool.h"
+
+#include "erizo/LibNiceConnection.h"
+
+namespace erizo {
+
+DEFINE_LOGGER(TransportPool, "TransportPool");
+
+namespace {
+
+// Whether agents gathered with |a| fit a connection configured with |b|.
+bool sameNetwork(const IceConfig& a, const IceConfig& b) {
+  return a.ip_addresses == b.ip_addresses &&
+         a.network_interface == b.network_interface &&
+         a.stun_server == b.stun_server && a.stun_port == b.stun_port &&
+         a.turn_server == b.turn_server && a.turn_port == b.turn_port &&
+         a.turn_username == b.turn_username && a.turn_pass == b.turn_pass &&
+         a.min_port == b.min_port && a.max_port == b.max_port;
+}
+
+}  // namespace
+
+TransportPool::TransportPool(const IceConfig& ice_config,
+                             wa::IOWorker* io_worker,
+                             size_t size)
+    : ice_config_{ice_config}, io_worker_{io_worker}, size_{size} {
+  // Pooled agents serve bundled transports, see WebRtcConnection::processRemoteSdp
+  ice_config_.media_type = VIDEO_TYPE;
+  ice_config_.transport_name = "video";
+  ice_config_.ice_components = 1;
+  ice_config_.username.clear();
+  ice_config_.password.clear();
+}
+
+TransportPool::~TransportPool() {
+  std::lock_guard<std::mutex> guard(mutex_);
+  for (auto& transport : ready_) {
+    dispose(std::move(transport), io_worker_);
+  }
+  ready_.clear();
+}
+
+void TransportPool::dispose(std::unique_ptr<PrewarmedTransport> transport,
+                            wa::IOWorker* io_worker) {
+  // Held by a shared_ptr, a task has to be copyable
+  std::shared_ptr<PrewarmedTransport> doomed = std::move(transport);
+  io_worker->task([doomed]() mutable {
+    doomed.reset();
+  });
+}
+
+std::unique_ptr<PrewarmedTransport> TransportPool::claim(const IceConfig& ice_config) {
+  if (!sameNetwork(ice_config_, ice_config)) {
+    return nullptr;
+  }
+  std::lock_guard<std::mutex> guard(mutex_);
+  if (ready_.empty()) {
+    ELOG_DEBUG("message: pool empty, size: %lu", size_);
+    return nullptr;
+  }
+  std::unique_ptr<PrewarmedTransport> transport = std::move(ready_.back());
+  ready_.pop_back();
+  return transport;
+}
+
+void TransportPool::refill() {
+  size_t missing;
+  {
+    std::lock_guard<std::mutex> guard(mutex_);
+    missing = size_ > ready_.size() ? size_ - ready_.size() : 0;
+  }
+  // Built unlocked, claims go on meanwhile
+  for (size_t i = 0; i < missing; ++i) {
+    std::unique_ptr<PrewarmedTransport> transport = create();
+    std::lock_guard<std::mutex> guard(mutex_);
+    if (ready_.size() >= size_) {
+      break;
+    }
+    ready_.push_back(std::move(transport));
+  }
+}
+
+std::unique_ptr<PrewarmedTransport> TransportPool::create() {
+  auto transport = std::make_unique<PrewarmedTransport>();
+  transport->dtls.reset(new dtls::DtlsSocketContext());
+  transport->dtls->createServer();
+  // Binds the sockets and starts gathering, candidates are kept until a
+  // listener is set, see LibNiceConnection::setIceListener
+  transport->ice.reset(LibNiceConnection::create(ice_config_, io_worker_));
+  transport->ice->start();
+  return transport;
+}
+
+}  // namespace erizo
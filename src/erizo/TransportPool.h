@@ -0,0 +1,73 @@
+//
+// Copyright (c) 2021- anjisuan783
+//
+// SPDX-License-Identifier: MIT
+//
+
+#ifndef ERIZO_SRC_ERIZO_TRANSPORTPOOL_H_
+#define ERIZO_SRC_ERIZO_TRANSPORTPOOL_H_
+
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "erizo/IceConnection.h"
+#include "erizo/dtls/DtlsSocket.h"
+#include "erizo/logger.h"
+#include "utils/IOWorker.h"
+
+namespace erizo {
+
+/**
+ * ICE and DTLS state of a bundled, rtcp-muxed server transport, made before
+ * the offer it will answer is known.
+ */
+struct PrewarmedTransport {
+  std::unique_ptr<IceConnection> ice;
+  std::unique_ptr<dtls::DtlsSocketContext> dtls;
+};
+
+/**
+ * Keeps a few ICE-lite agents of one IOWorker started ahead of time, with
+ * their sockets bound, candidates gathering and local credentials known, each
+ * next to a DTLS server context. A connection claims one when its remote SDP
+ * arrives instead of building the transport from scratch.
+ */
+class TransportPool {
+  DECLARE_LOGGER();
+
+ public:
+  TransportPool(const IceConfig& ice_config, wa::IOWorker* io_worker, size_t size);
+  ~TransportPool();
+
+  /**
+   * Takes a ready transport.
+   * @return nullptr if the pool is empty or |ice_config| is not the network
+   * setup the pool was made for.
+   */
+  std::unique_ptr<PrewarmedTransport> claim(const IceConfig& ice_config);
+
+  /**
+   * Tops the pool up to its size.
+   */
+  void refill();
+
+  /**
+   * Destroys |transport| on |io_worker|, the thread its agent runs on.
+   */
+  static void dispose(std::unique_ptr<PrewarmedTransport> transport,
+                      wa::IOWorker* io_worker);
+
+ private:
+  std::unique_ptr<PrewarmedTransport> create();
+
+  IceConfig ice_config_;
+  wa::IOWorker* io_worker_;
+  const size_t size_;
+
+  std::mutex mutex_;
+  std::vector<std::unique_ptr<PrewarmedTransport>> ready_;
+};
+
+}  // namespace erizo
+#endif  // ERIZO_SRC_ERIZO_TRANSPORTPOOL_H_
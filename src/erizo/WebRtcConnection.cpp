@@ -9,6 +9,7 @@
 #include "utils/IOWorker.h"
 #include "erizo/MediaStream.h"
 #include "erizo/DtlsTransport.h"
+#include "erizo/TransportPool.h"
 #include "erizo/SdpInfo.h"
 #include "erizo/rtp/RtpHeaders.h"
 #include "erizo/rtp/RtcpForwarder.h"
@@ -20,6 +21,18 @@
 namespace erizo {
 DEFINE_LOGGER(WebRtcConnection, "WebRtcConnection");
 
+namespace {
+
+// Milliseconds from |from| to |to|, -1 if |to| was not reached
+int64_t phaseMs(wa::time_point from, wa::time_point to) {
+  if (to == wa::time_point()) {
+    return -1;
+  }
+  return wa::ClockUtils::durationToMs(to - from);
+}
+
+}  // namespace
+
 WebRtcConnection::WebRtcConnection(wa::Worker* worker, 
     wa::IOWorker* io_worker,
     const std::string& connection_id, 
@@ -160,6 +173,10 @@ bool WebRtcConnection::createOffer(bool video_enabled, bool audioEnabled, bool b
   return true;
 }
 
+void WebRtcConnection::setTransportPool(std::shared_ptr<TransportPool> pool) {
+  transport_pool_ = std::move(pool);
+}
+
 void WebRtcConnection::addMediaStream(std::shared_ptr<MediaStream> media_stream) {
   ELOG_DEBUG("%s message: Adding mediaStream, id: %s", 
              toLog(), media_stream->getId().c_str());
@@ -262,6 +279,18 @@ bool WebRtcConnection::setRemoteSdp(const std::string &sdp, const std::string& s
   return true;
 }
 
+bool WebRtcConnection::setRemoteSdp(const std::function<void(SdpInfo&)>& fill,
+                                    const std::string& stream_id) {
+  ELOG_DEBUG("%s message: setting parsed remote SDP", toLog());
+  if (!sending_) {
+    return false;
+  }
+
+  remote_sdp_->initWithParsedSdp(fill);
+  processRemoteSdp(stream_id);
+  return true;
+}
+
 void WebRtcConnection::setRemoteSdpsToMediaStreams(const std::string& stream_id) {
   ELOG_DEBUG("%s message: setting remote SDP, stream: %s", toLog(), stream_id);
 
@@ -301,6 +330,7 @@ bool WebRtcConnection::processRemoteSdp(const std::string& stream_id) {
     return true;
   }
 
+  setup_times_.remote_sdp = wa::clock::now();
   bundle_ = remote_sdp_->isBundle;
 
   if (remote_sdp_->dtlsRole == ACTPASS) {
@@ -319,6 +349,11 @@ bool WebRtcConnection::processRemoteSdp(const std::string& stream_id) {
         if (video_transport_.get() == nullptr) {
           ELOG_DEBUG("%s message: Creating videoTransport, ufrag: %s, pass: %s",
                       toLog(), username.c_str(), password.c_str());
+          std::unique_ptr<PrewarmedTransport> prewarmed;
+          if (transport_pool_ && bundle_ && remote_sdp_->isRtcpMux) {
+            prewarmed = transport_pool_->claim(ice_config_);
+          }
+          setup_times_.prewarmed = prewarmed != nullptr;
           video_transport_ = 
               std::make_shared<DtlsTransport>(VIDEO_TYPE, 
                                               "video", 
@@ -331,9 +366,20 @@ bool WebRtcConnection::processRemoteSdp(const std::string& stream_id) {
                                               password, 
                                               true,
                                               worker_, 
-                                              io_worker_);
+                                              io_worker_,
+                                              std::move(prewarmed));
           video_transport_->copyLogContextFrom(*this);
           video_transport_->start();
+          if (setup_times_.prewarmed) {
+            // Queued behind the tasks replaying the claimed agent's
+            // candidates, so the answer does not wait for it
+            std::weak_ptr<TransportPool> weak_pool = transport_pool_;
+            worker_->task([weak_pool]() {
+              if (auto pool = weak_pool.lock()) {
+                pool->refill();
+              }
+            });
+          }
         } else {
           ELOG_DEBUG("%s message: Updating videoTransport, ufrag: %s, pass: %s",
                       toLog(), username.c_str(), password.c_str());
@@ -545,20 +591,22 @@ void WebRtcConnection::onREMBFromTransport(RtcpHeader *, Transport *) {
 
 void WebRtcConnection::onRtcpFromTransport(
     std::shared_ptr<DataPacket> packet, Transport *transport) {
-  RtpUtils::forEachRtcpBlock(packet, [this, packet, transport](RtcpHeader *chead) {
-    uint32_t ssrc = chead->isFeedback() ? chead->getSourceSSRC() : chead->getSSRC();
+  // Blocks are routed as views into |packet|, which stays alive and untouched
+  // until every stream has consumed them.
+  DataPacket* compound = packet.get();
+  RtpUtils::forEachRtcpBlock(packet->data, packet->length,
+      [this, compound, transport](RtcpHeader *chead, int offset, int length) {
     if (chead->isREMB()) {
       onREMBFromTransport(chead, transport);
       return;
     }
-    std::shared_ptr<DataPacket> rtcp = std::make_shared<DataPacket>(*packet);
-    rtcp->length = (ntohs(chead->length) + 1) * 4;
-    std::memcpy(rtcp->data, chead, rtcp->length);
-    forEachMediaStream([this, rtcp, transport, ssrc] (const std::shared_ptr<MediaStream> &media_stream) {
+    uint32_t ssrc = chead->isFeedback() ? chead->getSourceSSRC() : chead->getSSRC();
+    DataPacketView block(compound, offset, length);
+    for (auto& media_stream : media_streams_) {
       if (media_stream->isSourceSSRC(ssrc) || media_stream->isSinkSSRC(ssrc)) {
-        media_stream->onTransportData(rtcp, transport);
+        media_stream->onTransportRtcp(block, transport);
       }
-    });
+    }
   });
 }
 
@@ -575,9 +623,77 @@ void WebRtcConnection::onTransportData(
     return;
   }
   
-  RtpHeader *head = reinterpret_cast<RtpHeader*> (buf);
-  uint32_t ssrc = head->getSSRC();
+  uint32_t ssrc = prepareRtpFromTransport(packet);
+  forEachMediaStream([packet, transport, ssrc] (const std::shared_ptr<MediaStream> &media_stream) {
+    if (media_stream->isSourceSSRC(ssrc) || media_stream->isSinkSSRC(ssrc)) {
+      media_stream->onTransportData(packet, transport);
+    }
+  });
+}
+
+void WebRtcConnection::onTransportDataBatch(
+    DescriptorSpan packets, Transport *transport) {
+  if (getCurrentState() != CONN_READY) {
+    return;
+  }
+
+  // Packets keep their arrival order: each run of consecutive RTP is
+  // regrouped per stream so that each stream gets its share of the run in one
+  // call, and is handed over before the RTCP that follows it.
+  batch_rtp_.clear();
+  batch_ssrcs_.clear();
+  for (auto& packet : packets) {
+    RtcpHeader *chead = reinterpret_cast<RtcpHeader*> (packet.data());
+    if (chead->isRtcp()) {
+      flushRtpBatch(transport);
+      onRtcpFromTransport(std::make_shared<DataPacket>(packet), transport);
+      continue;
+    }
+    batch_ssrcs_.push_back(prepareRtpFromTransport(packet));
+    batch_rtp_.push_back(&packet);
+  }
+  flushRtpBatch(transport);
+}
+
+void WebRtcConnection::flushRtpBatch(Transport *transport) {
+  if (batch_rtp_.empty()) {
+    return;
+  }
+
+  for (auto& media_stream : media_streams_) {
+    batch_stream_.clear();
+    for (size_t i = 0; i < batch_rtp_.size(); ++i) {
+      uint32_t ssrc = batch_ssrcs_[i];
+      if (media_stream->isSourceSSRC(ssrc) || media_stream->isSinkSSRC(ssrc)) {
+        batch_stream_.push_back(*batch_rtp_[i]);
+      }
+    }
+    if (!batch_stream_.empty()) {
+      media_stream->onTransportDataBatch(batch_stream_, transport);
+    }
+  }
+  batch_stream_.clear();
+  batch_rtp_.clear();
+  batch_ssrcs_.clear();
+}
+
+uint32_t WebRtcConnection::prepareRtpFromTransport(
+    const std::shared_ptr<DataPacket>& packet) {
   extension_processor_->processRtpExtensions(packet);
+  return mapRtpFromTransport(packet->data);
+}
+
+uint32_t WebRtcConnection::prepareRtpFromTransport(PacketDescriptor& packet) {
+  extension_processor_->processRtpExtensions(packet);
+  return mapRtpFromTransport(packet.data());
+}
+
+uint32_t WebRtcConnection::mapRtpFromTransport(const char* data) {
+  const RtpHeader *head = reinterpret_cast<const RtpHeader*> (data);
+  uint32_t ssrc = head->getSSRC();
+  if (setup_times_.first_media == wa::time_point()) {
+    onFirstMedia();
+  }
   const std::string& mid = this->extension_processor_->lastMid();
   const std::string& rid = this->extension_processor_->lastRid();
   
@@ -598,12 +714,7 @@ void WebRtcConnection::onTransportData(
       });
     }
   }
-  
-  forEachMediaStream([packet, transport, ssrc] (const std::shared_ptr<MediaStream> &media_stream) {
-    if (media_stream->isSourceSSRC(ssrc) || media_stream->isSinkSSRC(ssrc)) {
-      media_stream->onTransportData(packet, transport);
-    }
-  });
+  return ssrc;
 }
 
 void WebRtcConnection::maybeNotifyWebRtcConnectionEvent(
@@ -720,6 +831,12 @@ void WebRtcConnection::updateState(TransportState state, Transport * transport)
   }
 
   global_state_ = temp;
+  if (global_state_ == CONN_GATHERED) {
+    setup_times_.gathered = wa::clock::now();
+  } else if (global_state_ == CONN_READY) {
+    setup_times_.dtls_ready = wa::clock::now();
+    setup_times_.ice_ready = transport->getIceReadyTime();
+  }
 
   ELOG_INFO("%s newGlobalState: %d", toLog(), global_state_);
   maybeNotifyWebRtcConnectionEvent(global_state_, msg);
@@ -745,6 +862,18 @@ void WebRtcConnection::trackTransportInfo() {
     });
 }
 
+void WebRtcConnection::onFirstMedia() {
+  setup_times_.first_media = wa::clock::now();
+  const wa::time_point& start = setup_times_.remote_sdp;
+  ELOG_INFO("%s message: setup done, prewarmed: %d, gathered: %lld ms, "
+            "iceReady: %lld ms, dtlsReady: %lld ms, firstMedia: %lld ms",
+            toLog(), setup_times_.prewarmed,
+            static_cast<long long>(phaseMs(start, setup_times_.gathered)),
+            static_cast<long long>(phaseMs(start, setup_times_.ice_ready)),
+            static_cast<long long>(phaseMs(start, setup_times_.dtls_ready)),
+            static_cast<long long>(phaseMs(start, setup_times_.first_media)));
+}
+
 void WebRtcConnection::setMetadata(std::map<std::string, std::string> metadata)  {
   setLogContext(metadata);
 }
@@ -764,7 +893,42 @@ void WebRtcConnection::write(std::shared_ptr<DataPacket> packet) {
     return;
   }
   extension_processor_->processRtpExtensions(packet);
-  transport->write(packet->data, packet->length);
+  wa::LatencyTrace trace = packet->latencyTrace();
+  transport->write(packet->data, packet->length, trace);
+}
+
+bool WebRtcConnection::startCapture(const std::string& file_prefix) {
+  if (!video_transport_) {
+    ELOG_WARN("%s message: no transport to capture", toLog());
+    return false;
+  }
+  auto capture = [this](Transport* transport, const std::string& prefix) {
+    auto in = RtpCapture::open(prefix + "-in.rtpdump");
+    auto out = RtpCapture::open(prefix + "-out.rtpdump");
+    if (!in || !out) {
+      ELOG_WARN("%s message: can not open capture files, prefix: %s",
+                toLog(), prefix.c_str());
+      return false;
+    }
+    transport->setCapture(std::move(in), std::move(out));
+    return true;
+  };
+  bool result = capture(video_transport_.get(), file_prefix);
+  if (result && !bundle_ && audio_transport_) {
+    result = capture(audio_transport_.get(), file_prefix + "-audio");
+  }
+  ELOG_INFO("%s message: start capture, prefix: %s, result: %d", 
+            toLog(), file_prefix.c_str(), result);
+  return result;
+}
+
+void WebRtcConnection::stopCapture() {
+  for (auto& transport : {video_transport_, audio_transport_}) {
+    if (transport) {
+      transport->setCapture(nullptr, nullptr);
+    }
+  }
+  ELOG_INFO("%s message: stop capture", toLog());
 }
 
 // Only for Testing purposes
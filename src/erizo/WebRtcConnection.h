@@ -17,6 +17,7 @@
 #include "erizo/MediaDefinitions.h"
 #include "erizo/Transport.h"
 #include "erizo/Stats.h"
+#include "utils/Clock.h"
 
 namespace erizo {
 
@@ -28,6 +29,7 @@ constexpr uint32_t kDefaultAudioSinkSSRC = 44444;
 class MediaStream;
 class SdpInfo;
 class RtpExtensionProcessor;
+class TransportPool;
 
 /**
  * WebRTC Events
@@ -44,6 +46,18 @@ enum WebRTCEvent {
   CONN_FAILED = 500         // TRANSPORT_FAILED msg="remotesdp" stream_id=""
 };
 
+/**
+ * When each connection setup phase was reached, a default time_point until then.
+ */
+struct SetupTimes {
+  wa::time_point remote_sdp;    // first remote SDP set
+  wa::time_point gathered;      // CONN_GATHERED, the answer is known
+  wa::time_point ice_ready;
+  wa::time_point dtls_ready;    // CONN_READY
+  wa::time_point first_media;   // first RTP packet once ready
+  bool prewarmed{false};        // the transport came from a TransportPool
+};
+
 class WebRtcConnectionEventListener {
  public:
   virtual ~WebRtcConnectionEventListener() { }
@@ -87,6 +101,18 @@ class WebRtcConnection: public TransportListener,
    * @return true if the SDP was received correctly.
    */
   bool setRemoteSdp(const std::string &sdp, const std::string& stream_id);
+  /**
+   * Sets the SDP of the remote peer, already parsed by the caller.
+   * @param fill Writes the SDP into the remote SdpInfo, see SdpInfo::initWithParsedSdp.
+   * @return true if the SDP was received correctly.
+   */
+  bool setRemoteSdp(const std::function<void(SdpInfo&)>& fill, const std::string& stream_id);
+
+  /**
+   * Lets the bundled transport be claimed from |pool| instead of being built
+   * when the first remote SDP arrives. Set before that.
+   */
+  void setTransportPool(std::shared_ptr<TransportPool> pool);
 
   bool createOffer(bool video_enabled, bool audio_enabled, bool bundle);
   /**
@@ -120,6 +146,7 @@ class WebRtcConnection: public TransportListener,
   WebRTCEvent getCurrentState();
 
   void onTransportData(std::shared_ptr<DataPacket> packet, Transport *transport) override;
+  void onTransportDataBatch(DescriptorSpan packets, Transport *transport) override;
 
   void updateState(TransportState state, Transport * transport) override;
 
@@ -136,12 +163,23 @@ class WebRtcConnection: public TransportListener,
   void removeMediaStream(const std::string& stream_id);
   void forEachMediaStream(std::function<void(const std::shared_ptr<MediaStream>&)> func);
 
+  /**
+   * Writes the clear RTP and RTCP of the connection to
+   * <file_prefix>-in.rtpdump and <file_prefix>-out.rtpdump, see RtpCapture.
+   * An unbundled audio transport gets <file_prefix>-audio-in/out.rtpdump.
+   * @return false if there is no transport yet or the files can not be opened.
+   */
+  bool startCapture(const std::string& file_prefix);
+  void stopCapture();
+
   void setTransport(std::shared_ptr<Transport> transport);  // Only for Testing purposes
 
   std::shared_ptr<Stats> getStatsService() { return stats_; }
 
   RtpExtensionProcessor& getRtpExtensionProcessor() { return *extension_processor_; }
 
+  const SetupTimes& getSetupTimes() const { return setup_times_; }
+
   inline std::string toLog() {
     return "id: " + connection_id_ + ", " + printLogContext();
   }
@@ -153,7 +191,15 @@ class WebRtcConnection: public TransportListener,
   std::string getJSONCandidate(const std::string& mid, const std::string& sdp);
   void trackTransportInfo();
   void onRtcpFromTransport(std::shared_ptr<DataPacket> packet, Transport *transport);
+  // Runs the extension processor and the mid/rid SSRC mapping, returns the SSRC
+  uint32_t prepareRtpFromTransport(const std::shared_ptr<DataPacket>& packet);
+  uint32_t prepareRtpFromTransport(PacketDescriptor& packet);
+  // The mid/rid SSRC mapping, once the extension processor has run
+  uint32_t mapRtpFromTransport(const char* data);
+  // Hands the RTP gathered in batch_rtp_ to the media streams
+  void flushRtpBatch(Transport *transport);
   void onREMBFromTransport(RtcpHeader *chead, Transport *transport);
+  void onFirstMedia();
   void maybeNotifyWebRtcConnectionEvent(const WebRTCEvent& event, 
       const std::string& message, const std::string& stream_id = "");
  private:
@@ -181,6 +227,13 @@ class WebRtcConnection: public TransportListener,
   bool first_remote_sdp_processed_{false};
   std::map<std::string, uint32_t> mapping_ssrcs_;
   std::shared_ptr<Stats> stats_;
+  std::shared_ptr<TransportPool> transport_pool_;
+  SetupTimes setup_times_;
+
+  // Scratch space reused by onTransportDataBatch
+  std::vector<PacketDescriptor*> batch_rtp_;
+  std::vector<uint32_t> batch_ssrcs_;
+  std::vector<PacketDescriptor> batch_stream_;
 };
 
 }  // namespace erizo
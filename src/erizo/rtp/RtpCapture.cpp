@@ -0,0 +1,127 @@
+//
+// Copyright (c) 2021- anjisuan783
+//
+// SPDX-License-Identifier: MIT
+//
+
+#include "erizo/rtp/RtpCapture.h"
+
+#include <arpa/inet.h>
+#include <sys/time.h>
+
+#include <cstring>
+
+namespace erizo {
+
+namespace {
+
+const char kRtpDumpMagic[] = "#!rtpplay1.0 0.0.0.0/0\n";
+const char kRtpDumpMagicPrefix[] = "#!rtpplay1.0 ";
+
+// RD_hdr_t of rtptools, all fields in network order
+struct RtpDumpFileHeader {
+  uint32_t start_sec;
+  uint32_t start_usec;
+  uint32_t source;
+  uint16_t port;
+  uint16_t padding;
+};
+
+// RD_packet_t of rtptools, all fields in network order
+struct RtpDumpPacketHeader {
+  // Of this header and the packet
+  uint16_t length;
+  // Of the RTP packet, 0 for RTCP
+  uint16_t plen;
+  uint32_t offset_ms;
+};
+
+static_assert(sizeof(RtpDumpFileHeader) == 16, "RD_hdr_t");
+static_assert(sizeof(RtpDumpPacketHeader) == 8, "RD_packet_t");
+
+constexpr int kMaxPacketLength = 0xffff - sizeof(RtpDumpPacketHeader);
+
+}  // namespace
+
+std::unique_ptr<RtpCapture> RtpCapture::open(const std::string& path) {
+  auto writer = wa::AsyncFileWriter::open(path);
+  if (!writer) {
+    return nullptr;
+  }
+  struct timeval now;
+  gettimeofday(&now, nullptr);
+  RtpDumpFileHeader header{};
+  header.start_sec = htonl(static_cast<uint32_t>(now.tv_sec));
+  header.start_usec = htonl(static_cast<uint32_t>(now.tv_usec));
+  writer->write(kRtpDumpMagic, sizeof(kRtpDumpMagic) - 1);
+  writer->write(&header, sizeof(header));
+  return std::unique_ptr<RtpCapture>(new RtpCapture(
+      std::move(writer), wa::ClockUtils::timePointToMs(wa::clock::now())));
+}
+
+RtpCapture::RtpCapture(std::shared_ptr<wa::AsyncFileWriter> writer,
+                       uint64_t start_ms)
+    : writer_{std::move(writer)},
+      start_ms_{start_ms} {
+}
+
+RtpCapture::~RtpCapture() {
+  writer_->close();
+}
+
+void RtpCapture::write(const char* data, int len, bool rtcp, uint64_t time_ms) {
+  if (len <= 0 || len > kMaxPacketLength) {
+    return;
+  }
+  RtpDumpPacketHeader header;
+  header.length = htons(static_cast<uint16_t>(len + sizeof(header)));
+  header.plen = htons(rtcp ? 0 : static_cast<uint16_t>(len));
+  header.offset_ms = htonl(static_cast<uint32_t>(
+      time_ms > start_ms_ ? time_ms - start_ms_ : 0));
+  // Header and packet in one write, so a full buffer drops them together.
+  record_.assign(reinterpret_cast<const char*>(&header), sizeof(header));
+  record_.append(data, len);
+  if (writer_->write(record_.data(), record_.size())) {
+    ++packets_;
+  } else {
+    ++dropped_;
+  }
+}
+
+std::unique_ptr<RtpDumpReader> RtpDumpReader::open(const std::string& path) {
+  FILE* file = fopen(path.c_str(), "rb");
+  if (!file) {
+    return nullptr;
+  }
+  std::unique_ptr<RtpDumpReader> reader(new RtpDumpReader(file));
+  char line[128];
+  RtpDumpFileHeader header;
+  if (!fgets(line, sizeof(line), file) ||
+      strncmp(line, kRtpDumpMagicPrefix, sizeof(kRtpDumpMagicPrefix) - 1) ||
+      fread(&header, sizeof(header), 1, file) != 1) {
+    return nullptr;
+  }
+  return reader;
+}
+
+RtpDumpReader::~RtpDumpReader() {
+  fclose(file_);
+}
+
+bool RtpDumpReader::next(RtpDumpPacket* packet) {
+  RtpDumpPacketHeader header;
+  if (fread(&header, sizeof(header), 1, file_) != 1) {
+    return false;
+  }
+  uint16_t length = ntohs(header.length);
+  if (length < sizeof(header)) {
+    return false;
+  }
+  packet->offset_ms = ntohl(header.offset_ms);
+  packet->rtcp = header.plen == 0;
+  packet->data.resize(length - sizeof(header));
+  return packet->data.empty() ||
+         fread(packet->data.data(), packet->data.size(), 1, file_) == 1;
+}
+
+}  // namespace erizo
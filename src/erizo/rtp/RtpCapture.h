@@ -0,0 +1,79 @@
+//
+// Copyright (c) 2021- anjisuan783
+//
+// SPDX-License-Identifier: MIT
+//
+
+#ifndef ERIZO_SRC_ERIZO_RTP_RTPCAPTURE_H_
+#define ERIZO_SRC_ERIZO_RTP_RTPCAPTURE_H_
+
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "utils/AsyncFileWriter.h"
+#include "utils/Clock.h"
+
+namespace erizo {
+
+/**
+ * Writes clear RTP and RTCP packets in the rtpdump format read by rtpplay,
+ * Wireshark and RtpDumpReader. The file is written by the background
+ * AsyncFileWriter thread; packets that do not fit its buffer are dropped
+ * whole and counted.
+ */
+class RtpCapture {
+ public:
+  // nullptr if |path| can not be opened.
+  static std::unique_ptr<RtpCapture> open(const std::string& path);
+
+  ~RtpCapture();
+
+  // On one thread at a time. |time_ms| is a wa::clock time, offsets are kept
+  // from the open.
+  void write(const char* data, int len, bool rtcp, uint64_t time_ms);
+
+  const std::string& path() const { return writer_->path(); }
+  uint64_t packets() const { return packets_; }
+  uint64_t dropped() const { return dropped_; }
+
+ private:
+  RtpCapture(std::shared_ptr<wa::AsyncFileWriter> writer, uint64_t start_ms);
+
+  std::shared_ptr<wa::AsyncFileWriter> writer_;
+  const uint64_t start_ms_;
+  std::string record_;
+  uint64_t packets_{0};
+  uint64_t dropped_{0};
+};
+
+struct RtpDumpPacket {
+  // From the start of the capture
+  uint32_t offset_ms{0};
+  bool rtcp{false};
+  std::vector<char> data;
+};
+
+/**
+ * Reads back the files RtpCapture writes, or any other rtpdump file.
+ */
+class RtpDumpReader {
+ public:
+  // nullptr if |path| is not a readable rtpdump file.
+  static std::unique_ptr<RtpDumpReader> open(const std::string& path);
+
+  ~RtpDumpReader();
+
+  // False at the end of the file, or on a truncated packet.
+  bool next(RtpDumpPacket* packet);
+
+ private:
+  explicit RtpDumpReader(FILE* file) : file_{file} {}
+
+  FILE* file_;
+};
+
+}  // namespace erizo
+
+#endif  // ERIZO_SRC_ERIZO_RTP_RTPCAPTURE_H_
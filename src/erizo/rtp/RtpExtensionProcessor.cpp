@@ -69,59 +69,64 @@ bool RtpExtensionProcessor::isValidExtension(const std::string& uri)
   return value != ext_mappings_.end() && translationMap_.find(uri) != translationMap_.end();
 }
 
+const std::array<RTPExtensions, kRtpExtSize>* 
+RtpExtensionProcessor::extensionMapFor(packetType type) 
+{
+  switch (type) {
+    case VIDEO_PACKET:
+      return &ext_map_video_;
+    case AUDIO_PACKET:
+      return &ext_map_audio_;
+    default:
+      return nullptr;
+  }
+}
+
+webrtc::RtpHeaderView& RtpExtensionProcessor::headerOf(DataPacket* p) 
+{
+  return p->meta ? p->meta->header : scratch_header_;
+}
+
+const webrtc::RtpHeaderView& RtpExtensionProcessor::parseHeader(
+    const char* data, int length, webrtc::RtpHeaderView& header) 
+{
+  const uint8_t* bytes = reinterpret_cast<const uint8_t*>(data);
+  if (!header.Matches(bytes, length)) {
+    header.Parse(bytes, length);
+  }
+  return header;
+}
+
 std::pair<std::string, uint32_t> RtpExtensionProcessor::checkNewRid(std::shared_ptr<DataPacket> p) 
 {
   const RtpHeader* head = reinterpret_cast<const RtpHeader*>(p->data);
-  std::array<RTPExtensions, kRtpExtSize> extMap;
   std::pair<std::string, uint32_t> ret;
 
   if (head->getExtension()) {
-    switch (p->type) {
-      case VIDEO_PACKET:
-        extMap = ext_map_video_;
-        break;
-      case AUDIO_PACKET:
-        extMap = ext_map_audio_;
-        break;
-      default:
-        ELOG_WARN("Won't check RID for unknown type packets");
-        return ret;
-        break;
+    const std::array<RTPExtensions, kRtpExtSize>* extMap = extensionMapFor(p->type);
+    if (!extMap) {
+      ELOG_WARN("Won't check RID for unknown type packets");
+      return ret;
     }
 
-    uint16_t totalExtLength = head->getExtLength();
-    if (head->getExtId() == 0xBEDE) {
-      char* extBuffer = (char*)&head->extensions;  // NOLINT
-      uint8_t extByte = 0;
-      uint16_t currentPlace = 1;
-      uint8_t extId = 0;
-      uint8_t extLength = 0;
-      while (currentPlace < (totalExtLength*4)) {
-        extByte = (uint8_t)(*extBuffer);
-        extId = extByte >> 4;
-        extLength = extByte & 0x0F;
-        if (extId != 0 && extMap[extId] != 0) {
-          if (extMap[extId] == RTP_ID) {
-            std::string rid;
-            for (uint8_t i = 1; i <= extLength + 1; i++) {
-              rid.push_back(*(extBuffer + i));
-            }
-            auto it = rids_.find(rid);
-            if (it != rids_.end()) {
-              if (it->second != head->getSSRC()) {
-                ELOG_WARN("Conflict SSRC(%u, %u) for RID(%s)",
-                  it->second, head->getSSRC(), rid.c_str());
-              }
-            } else {
-              ELOG_INFO("New RID:%s, SSRC:%u", rid.c_str(), head->getSSRC());
-              ret.first = rid;
-              ret.second = head->getSSRC();
-              rids_.insert(ret);
-            }
-          }
+    const webrtc::RtpHeaderView& header = 
+        parseHeader(p->data, p->length, headerOf(p.get()));
+    for (const auto& extension : header.extensions()) {
+      if (extension.id >= kRtpExtSize || (*extMap)[extension.id] != RTP_ID) {
+        continue;
+      }
+      std::string rid(p->data + extension.offset, extension.length);
+      auto it = rids_.find(rid);
+      if (it != rids_.end()) {
+        if (it->second != head->getSSRC()) {
+          ELOG_WARN("Conflict SSRC(%u, %u) for RID(%s)",
+            it->second, head->getSSRC(), rid.c_str());
         }
-        extBuffer = extBuffer + extLength + 2;
-        currentPlace = currentPlace + extLength + 2;
+      } else {
+        ELOG_INFO("New RID:%s, SSRC:%u", rid.c_str(), head->getSSRC());
+        ret.first = rid;
+        ret.second = head->getSSRC();
+        rids_.insert(ret);
       }
     }
   }
@@ -130,56 +135,52 @@ std::pair<std::string, uint32_t> RtpExtensionProcessor::checkNewRid(std::shared_
 
 uint32_t RtpExtensionProcessor::processRtpExtensions(std::shared_ptr<DataPacket> p) 
 {
-  const RtpHeader* head = reinterpret_cast<const RtpHeader*>(p->data);
-  uint32_t len = p->length;
-  std::array<RTPExtensions, kRtpExtSize> extMap;
+  return processRtpExtensions(p->data, p->length, p->type, headerOf(p.get()));
+}
+
+uint32_t RtpExtensionProcessor::processRtpExtensions(PacketDescriptor& p) 
+{
+  // The header is parsed once here, on arrival, and the result travels
+  // with the packet down to webrtc::Call.
+  return processRtpExtensions(p.data(), p.length, p.type, p.meta.header);
+}
+
+uint32_t RtpExtensionProcessor::processRtpExtensions(
+    const char* data, int length, packetType type, webrtc::RtpHeaderView& view) 
+{
+  const RtpHeader* head = reinterpret_cast<const RtpHeader*>(data);
+  uint32_t len = length;
 
   last_mid_.clear();
   last_rid_.clear();
+  const webrtc::RtpHeaderView& header = parseHeader(data, length, view);
   if (head->getExtension()) {
-    switch (p->type) {
-      case VIDEO_PACKET:
-        extMap = ext_map_video_;
-        break;
-      case AUDIO_PACKET:
-        extMap = ext_map_audio_;
-        break;
-      default:
-        ELOG_WARN("Won't process RTP extensions for unknown type packets");
-        return 0;
+    const std::array<RTPExtensions, kRtpExtSize>* extMap = extensionMapFor(type);
+    if (!extMap) {
+      ELOG_WARN("Won't process RTP extensions for unknown type packets");
+      return 0;
     }
-    
-    uint16_t totalExtLength = head->getExtLength();
-    if (head->getExtId() == 0xBEDE) {
-      char* extBuffer = (char*)&head->extensions;  // NOLINT
-      uint8_t extByte = 0;
-      uint16_t currentPlace = 1;
-      uint8_t extId = 0;
-      uint8_t extLength = 0;
-      while (currentPlace < (totalExtLength*4)) {
-        extByte = (uint8_t)(*extBuffer);
-        extId = extByte >> 4;
-        extLength = extByte & 0x0F;
-        if (extId != 0 && extMap[extId] != 0) {
-          switch (extMap[extId]) {
-            case ABS_SEND_TIME:
-              // processAbsSendTime(extBuffer);
-              break;
-            case VIDEO_ORIENTATION:
-              processVideoOrientation(extBuffer);
-              break;
-            case MEDIA_ID:
-              processMid(extBuffer);
-              break;
-            case RTP_ID:
-              processRid(extBuffer);
-              break;
-            default:
-              break;
-          }
-        }
-        extBuffer = extBuffer + extLength + 2;
-        currentPlace = currentPlace + extLength + 2;
+
+    for (const auto& extension : header.extensions()) {
+      if (extension.id >= kRtpExtSize) {
+        continue;
+      }
+      const char* value = data + extension.offset;
+      switch ((*extMap)[extension.id]) {
+        case ABS_SEND_TIME:
+          // processAbsSendTime(data + extension.offset - 1);
+          break;
+        case VIDEO_ORIENTATION:
+          processVideoOrientation(value, extension.length);
+          break;
+        case MEDIA_ID:
+          processMid(value, extension.length);
+          break;
+        case RTP_ID:
+          processRid(value, extension.length);
+          break;
+        default:
+          break;
       }
     }
   }
@@ -191,10 +192,14 @@ VideoRotation RtpExtensionProcessor::getVideoRotation()
   return video_orientation_;
 }
 
-uint32_t RtpExtensionProcessor::processVideoOrientation(char* buf) 
+uint32_t RtpExtensionProcessor::processVideoOrientation(const char* value, 
+                                                        uint8_t length) 
 {
-  VideoOrientation* head = reinterpret_cast<VideoOrientation*>(buf);
-  video_orientation_ = head->getVideoOrientation();
+  if (length == 0) {
+    return 0;
+  }
+  video_orientation_ = 
+      VideoOrientation::convertCVOByteToVideoRotation(value[0]);
   return 0;
 }
 
@@ -215,25 +220,15 @@ uint32_t RtpExtensionProcessor::processAbsSendTime(char* buf)
   return 0;
 }
 
-uint32_t RtpExtensionProcessor::processMid(char* extBuffer) 
+uint32_t RtpExtensionProcessor::processMid(const char* value, uint8_t length) 
 {
-  uint8_t extByte = (uint8_t)(*extBuffer);
-  uint8_t extLength = extByte & 0x0F;
-  last_mid_.clear();
-  for (uint8_t i = 1; i <= extLength + 1; i++) {
-    last_mid_.push_back(*(extBuffer + i));
-  }
+  last_mid_.assign(value, length);
   return 0;
 }
 
-uint32_t RtpExtensionProcessor::processRid(char* extBuffer) 
+uint32_t RtpExtensionProcessor::processRid(const char* value, uint8_t length) 
 {
-  uint8_t extByte = (uint8_t)(*extBuffer);
-  uint8_t extLength = extByte & 0x0F;
-  last_rid_.clear();
-  for (uint8_t i = 1; i <= extLength + 1; i++) {
-    last_rid_.push_back(*(extBuffer + i));
-  }
+  last_rid_.assign(value, length);
   return 0;
 }
 
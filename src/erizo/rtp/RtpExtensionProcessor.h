@@ -43,7 +43,10 @@ class RtpExtensionProcessor final {
 
   void setSdpInfo(std::shared_ptr<SdpInfo> theInfo);
   
+  // Packets without metadata are parsed into scratch space: the header kept
+  // for webrtc::Call is the one of the descriptors on the receive path.
   uint32_t processRtpExtensions(std::shared_ptr<DataPacket> p);
+  uint32_t processRtpExtensions(PacketDescriptor& p);
   
   // return new RID:ssrc in extension if detected
   std::pair<std::string, uint32_t> checkNewRid(std::shared_ptr<DataPacket> p);
@@ -72,11 +75,25 @@ class RtpExtensionProcessor final {
   std::map<std::string, uint32_t> rids_;
   std::string last_mid_;
   std::string last_rid_;
+  webrtc::RtpHeaderView scratch_header_;
+
+  uint32_t processRtpExtensions(const char* data, 
+                                int length, 
+                                packetType type, 
+                                webrtc::RtpHeaderView& view);
+  const std::array<RTPExtensions, kRtpExtSize>* 
+      extensionMapFor(packetType type);
+  // Where the header of |p| is parsed to, its metadata if it has some.
+  webrtc::RtpHeaderView& headerOf(DataPacket* p);
+  // Returns |header|, parsed from |data| unless done already.
+  const webrtc::RtpHeaderView& parseHeader(const char* data, 
+                                           int length, 
+                                           webrtc::RtpHeaderView& header);
 
   uint32_t processAbsSendTime(char* buf);
-  uint32_t processVideoOrientation(char* buf);
-  uint32_t processMid(char* buf);
-  uint32_t processRid(char* buf);
+  uint32_t processVideoOrientation(const char* value, uint8_t length);
+  uint32_t processMid(const char* value, uint8_t length);
+  uint32_t processRid(const char* value, uint8_t length);
   uint32_t stripExtension(char* buf, int len);
 };
 
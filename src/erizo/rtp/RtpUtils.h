@@ -25,6 +25,12 @@ class RtpUtils {
 
   static void forEachRtcpBlock(std::shared_ptr<DataPacket> packet, std::function<void(RtcpHeader*)> f);
 
+  // Walks a compound RTCP packet in place, |f| gets every block's header
+  // together with its offset and length inside |buf|. Stops at the first
+  // block running past |len|.
+  template <typename F>
+  static void forEachRtcpBlock(char* buf, int len, F&& f);
+
   static void updateREMB(RtcpHeader *chead, uint bitrate);
 
   static bool isPLI(std::shared_ptr<DataPacket> packet);
@@ -43,6 +49,23 @@ class RtpUtils {
   static std::shared_ptr<DataPacket> makePaddingPacket(std::shared_ptr<DataPacket> packet, uint8_t padding_size);
 };
 
+template <typename F>
+void RtpUtils::forEachRtcpBlock(char* buf, int len, F&& f) {
+  int offset = 0;
+  while (offset + static_cast<int>(sizeof(uint32_t)) <= len) {
+    RtcpHeader *chead = reinterpret_cast<RtcpHeader*>(buf + offset);
+    if (!chead->isRtcp()) {
+      return;
+    }
+    int rtcp_length = (ntohs(chead->length) + 1) * 4;
+    if (offset + rtcp_length > len) {
+      return;
+    }
+    f(chead, offset, rtcp_length);
+    offset += rtcp_length;
+  }
+}
+
 }  // namespace erizo
 
 #endif  // ERIZO_SRC_ERIZO_RTP_RTPUTILS_H_
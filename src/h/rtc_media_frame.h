@@ -53,10 +53,23 @@ enum VideoCodecProfile {
   PROFILE_AVC_HIGH                    = 100,
 };
 
+// One NAL unit of an Annex-B frame, |offset| points past the start code.
+struct NaluInfo {
+  uint32_t offset;
+  uint32_t length;
+  uint8_t type;
+};
+
+const int kMaxNalusPerFrame = 32;
+
 struct VideoFrameSpecificInfo {
   uint16_t width;
   uint16_t height;
   bool isKeyFrame;
+  // NAL unit boundaries, filled in once where the frame is reassembled so
+  // packetizers need not rescan the payload. 0 means not available.
+  uint8_t naluCount;
+  NaluInfo nalus[kMaxNalusPerFrame];
 };
 
 struct AudioFrameSpecificInfo {
@@ -86,6 +99,10 @@ struct Frame {
   uint32_t        timeStamp;
   int64_t         ntpTimeMs;
   MediaSpecInfo   additionalInfo;
+  // Latency trace of the sampled packet the frame was built from, in ns of the
+  // steady clock, 0 when none was. See wa::LatencyTrace.
+  int64_t         traceStartNs{0};
+  int64_t         traceLastNs{0};
 
   Frame() = default;
   
@@ -101,6 +118,8 @@ struct Frame {
     } else {
       additionalInfo.audio = r.additionalInfo.audio;
     }
+    traceStartNs = r.traceStartNs;
+    traceLastNs = r.traceLastNs;
     need_delete = true;
   }
 
@@ -116,6 +135,8 @@ struct Frame {
     } else {
       additionalInfo.audio = r.additionalInfo.audio;
     }
+    traceStartNs = r.traceStartNs;
+    traceLastNs = r.traceLastNs;
     need_delete = true;
     r.need_delete = false;
   }
@@ -9,6 +9,8 @@
 
 #include <memory>
 #include <functional>
+#include <string>
+#include <vector>
 
 #include "rtc_media_frame.h"
 
@@ -39,6 +41,49 @@ struct TTrackInfo {
   int32_t request_keyframe_period_{-1}; //for rtmp video pull
 };
 
+// Counters of one track, rates are over the time since the previous
+// getStats of its connection.
+struct RtcTrackStats {
+  std::string mid_;
+  EMediaType type_{media_unknow};
+  bool publish_{false};           // received from the peer
+  uint32_t ssrc_{0};
+
+  uint64_t packets_{0};
+  uint64_t bytes_{0};
+  uint32_t bitrate_bps_{0};
+  uint32_t packet_rate_{0};
+
+  // For a publish track the loss and jitter seen here, for a subscribe track
+  // the ones the peer reports.
+  int32_t packets_lost_{0};
+  float fraction_lost_{0};
+  uint32_t jitter_ms_{0};
+
+  // RTCP feedback sent to the peer for a publish track, received from it
+  // for a subscribe track.
+  uint32_t nack_count_{0};
+  uint32_t pli_count_{0};
+  uint32_t fir_count_{0};
+  uint32_t key_frames_{0};
+
+  // REMB sent upstream for a publish track, received for a subscribe track.
+  uint32_t bwe_bps_{0};
+  int64_t rtt_ms_{-1};
+};
+
+struct RtcConnectionStats {
+  std::string connectId_;
+  int64_t rtt_ms_{-1};
+
+  // Load of the worker running the connection, over its last period.
+  double worker_busy_ratio_{0};
+  int64_t worker_queue_delay_p50_us_{0};
+  int64_t worker_queue_delay_p99_us_{0};
+
+  std::vector<RtcTrackStats> tracks_;
+};
+
 class WebrtcAgentSink 
     : public std::enable_shared_from_this<WebrtcAgentSink> {
  public:
@@ -50,6 +95,8 @@ class WebrtcAgentSink
   virtual void onAnswer(const std::string&) = 0;
   virtual void onFrame(const owt_base::Frame&) = 0;
   virtual void onStat() = 0;
+  // Snapshot asked for by rtc_api::getStats without a callback.
+  virtual void onStat(const RtcConnectionStats&) { }
 
   void callBack(std::function<void(std::shared_ptr<WebrtcAgentSink>)> f) {
     if (!async_callback_) {
@@ -89,6 +136,15 @@ class rtc_api {
       const std::vector<std::string>& network_addresses,
       const std::string& service_addr) = 0;
 
+  /**
+   * Keeps |size| ICE/DTLS transports per IO worker started ahead of the
+   * offers, each holding a bound socket and a gathering ICE agent. A bundled,
+   * rtcp-muxed offer claims one instead of building its own. 0, the default,
+   * turns the pool off. Takes effect for IO workers whose pool is not made
+   * yet, so call it before the first publish or subscribe.
+   */
+  virtual int setTransportPoolSize(uint32_t size) = 0;
+
   virtual int publish(TOption&, const std::string& offer) = 0;
 
   virtual int unpublish(const std::string& connectId) = 0;
@@ -102,6 +158,41 @@ class rtc_api {
   virtual int cutoff(const std::string& from, const std::string& to) = 0;
 
   virtual void mediaOnOff() = 0;
+
+  /**
+   * Takes a snapshot of the counters of |connectId| on its worker, between
+   * two of its media tasks. |callback| is called there, on the worker, or the
+   * snapshot goes to onStat() of the connection's sink when it is empty.
+   */
+  virtual int getStats(const std::string& connectId,
+      std::function<void(const RtcConnectionStats&)> callback) = 0;
+
+  /**
+   * Writes the decrypted RTP and RTCP of |connectId| to
+   * <file_prefix>-in.rtpdump and <file_prefix>-out.rtpdump, from a background
+   * thread, until stopCapture. The files replay with bench_rtp_replay.
+   * The files are opened on the connection's worker, after this returns;
+   * |callback|, when not empty, is called there with whether they were.
+   */
+  virtual int startCapture(const std::string& connectId, 
+                           const std::string& file_prefix,
+                           std::function<void(bool)> callback) = 0;
+
+  virtual int stopCapture(const std::string& connectId) = 0;
+
+  /**
+   * Writes the bandwidth estimation, probing, stream config and RTP/RTCP
+   * header events of |connectId| to rotating <file_prefix>-<n>.rtclog files,
+   * from a background thread, until stopEventLog. The format is described in
+   * owt/rtc_adapter/RtcEventLogImpl.h; with no log started the events cost
+   * next to nothing. Like startCapture, the first file is opened on the
+   * worker and |callback| tells whether it was.
+   */
+  virtual int startEventLog(const std::string& connectId,
+                            const std::string& file_prefix,
+                            std::function<void(bool)> callback) = 0;
+
+  virtual int stopEventLog(const std::string& connectId) = 0;
 };
 
 class AgentFactory {
@@ -11,6 +11,7 @@
 #ifndef API_RTC_EVENT_LOG_RTC_EVENT_LOG_H_
 #define API_RTC_EVENT_LOG_RTC_EVENT_LOG_H_
 
+#include <atomic>
 #include <cstddef>
 #include <cstdint>
 #include <functional>
@@ -53,6 +54,13 @@ class RtcEventLog {
 
   // Log an RTC event (the type of event is determined by the subclass).
   virtual void Log(std::unique_ptr<RtcEvent> event) = 0;
+
+  // False while Log() drops everything. Call sites logging per packet check
+  // it first, so a log that is off costs them no event to build.
+  bool IsLogging() const { return logging_.load(std::memory_order_relaxed); }
+
+ protected:
+  std::atomic<bool> logging_{false};
 };
 
 // No-op implementation is used if flag is not set, or in tests.
@@ -10,6 +10,9 @@
 #ifndef API_TASK_QUEUE_TASK_QUEUE_BASE_H_
 #define API_TASK_QUEUE_TASK_QUEUE_BASE_H_
 
+#include <stddef.h>
+#include <stdint.h>
+
 #include <memory>
 
 #include "queued_task.h"
@@ -17,6 +20,18 @@
 
 namespace webrtc {
 
+// Told about the tasks of a queue, to measure its load. OnTaskPosted() may be
+// called on any thread, OnTaskRun() is called on the queue.
+class TaskQueueObserver {
+ public:
+  virtual ~TaskQueueObserver() = default;
+  // |depth| counts the tasks waiting to run, the posted one included.
+  virtual void OnTaskPosted(size_t depth) = 0;
+  // |delay_ns| is the wait from the post, or from the due time of a delayed
+  // task. |depth| tasks were left waiting behind this one.
+  virtual void OnTaskRun(int64_t delay_ns, int64_t run_ns, size_t depth) = 0;
+};
+
 // Asynchronously executes tasks in a way that guarantees that they're executed
 // in FIFO order and that tasks never overlap. Tasks may always execute on the
 // same worker thread and they may not. To DCHECK that tasks are executing on a
@@ -56,6 +71,10 @@ class RTC_LOCKABLE TaskQueueBase {
   static TaskQueueBase* Current();
   
   virtual bool IsCurrent() const { return Current() == this; }
+
+  // Set before the first task is posted. Queues that do not measure their
+  // tasks ignore it.
+  virtual void SetObserver(TaskQueueObserver* observer) {}
   
  protected:
   class CurrentTaskQueueSetter {
@@ -136,6 +136,23 @@ webrtc::AudioReceiveStream::Stats AudioReceiveStream::GetStats() const {
   webrtc::AudioReceiveStream::Stats stats;
   stats.remote_ssrc = config_.rtp.remote_ssrc;
 
+  StreamStatistician* statistician =
+      rtp_receive_statistics_->GetStatistician(stats.remote_ssrc);
+  if (!statistician) {
+    return stats;
+  }
+  RtpReceiveStats rtp_stats = statistician->GetStats();
+  stats.payload_bytes_rcvd = rtp_stats.packet_counter.payload_bytes;
+  stats.header_and_padding_bytes_rcvd =
+      rtp_stats.packet_counter.header_bytes +
+      rtp_stats.packet_counter.padding_bytes;
+  stats.packets_rcvd = rtp_stats.packet_counter.packets;
+  stats.packets_lost = rtp_stats.packets_lost;
+  // Jitter is in RTP timestamp units, all decoders share the clock rate.
+  if (!payload_type_frequencies_.empty()) {
+    stats.jitter_ms =
+        rtp_stats.jitter * 1000 / payload_type_frequencies_.begin()->second;
+  }
   return stats;
 }
 
@@ -114,6 +114,12 @@ class AudioReceiveStream {
       // for details.
       bool transport_cc = false;
 
+      // Transport the stream arrives on, when one Call hosts the streams of
+      // several transports. Streams of a transport share its transport-wide
+      // sequence numbers and so get feedback from one estimator. 0 is the
+      // Call's own transport.
+      uint32_t transport_id = 0;
+
       // See NackConfig for description.
       NackConfig nack;
 
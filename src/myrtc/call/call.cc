@@ -170,6 +170,10 @@ class Call final : public webrtc::Call,
   DeliveryStatus DeliverPacket(MediaType media_type,
                                rtc::CopyOnWriteBuffer packet,
                                int64_t packet_time_us) override;
+  DeliveryStatus DeliverRtpPacket(MediaType media_type,
+                                  rtc::CopyOnWriteBuffer packet,
+                                  const RtpHeaderView& header,
+                                  int64_t packet_time_us) override;
 
   // Implements RecoveredPacketReceiver.
   //void OnRecoveredPacket(const uint8_t* packet, size_t length) override;
@@ -178,8 +182,11 @@ class Call final : public webrtc::Call,
   DeliveryStatus DeliverRtcp(MediaType media_type,
                              const uint8_t* packet,
                              size_t length);
+  // |header| may be null, or describe another packet, if the caller has
+  // not parsed this one.
   DeliveryStatus DeliverRtp(MediaType media_type,
                             rtc::CopyOnWriteBuffer packet,
+                            const RtpHeaderView* header,
                             int64_t packet_time_us);
 
   void NotifyBweOfReceivedPacket(const RtpPacketReceived& packet,
@@ -229,15 +236,25 @@ class Call final : public webrtc::Call,
   // single mapping from ssrc to a more abstract receive stream, with
   // accessor methods for all configuration we need at this level.
   struct ReceiveRtpConfig {
-    explicit ReceiveRtpConfig(const webrtc::AudioReceiveStream::Config& config)
+    ReceiveRtpConfig(const webrtc::AudioReceiveStream::Config& config,
+                     ReceiveSideCongestionController* congestion_controller,
+                     AudioReceiveStream* stream)
         : extensions(config.rtp.extensions),
-          use_send_side_bwe(UseSendSideBwe(config)) {}
-    explicit ReceiveRtpConfig(const webrtc::VideoReceiveStream::Config& config)
+          use_send_side_bwe(UseSendSideBwe(config)),
+          congestion_controller(congestion_controller),
+          audio_stream(stream) {}
+    ReceiveRtpConfig(const webrtc::VideoReceiveStream::Config& config,
+                     ReceiveSideCongestionController* congestion_controller,
+                     VideoReceiveStream* stream)
         : extensions(config.rtp.extensions),
-          use_send_side_bwe(UseSendSideBwe(config)) {}
-    explicit ReceiveRtpConfig(const FlexfecReceiveStream::Config& config)
+          use_send_side_bwe(UseSendSideBwe(config)),
+          congestion_controller(congestion_controller),
+          video_stream(stream) {}
+    ReceiveRtpConfig(const FlexfecReceiveStream::Config& config,
+                     ReceiveSideCongestionController* congestion_controller)
         : extensions(config.rtp_header_extensions),
-          use_send_side_bwe(UseSendSideBwe(config)) {}
+          use_send_side_bwe(UseSendSideBwe(config)),
+          congestion_controller(congestion_controller) {}
 
     // Registered RTP header extensions for each stream. Note that RTP header
     // extensions are negotiated per track ("m= line") in the SDP, but we have
@@ -247,9 +264,36 @@ class Call final : public webrtc::Call,
     // Set if both RTP extension the RTCP feedback message needed for
     // send side BWE are negotiated.
     const bool use_send_side_bwe;
+    // Of the transport the stream arrives on.
+    ReceiveSideCongestionController* const congestion_controller;
+    // The stream itself, to hand it the RTCP sent from its SSRC.
+    AudioReceiveStream* const audio_stream = nullptr;
+    VideoReceiveStream* const video_stream = nullptr;
   };
   std::map<uint32_t, ReceiveRtpConfig> receive_rtp_config_;
 
+  // Receive side congestion control of a transport other than the Call's
+  // own, see AudioReceiveStream::Config::Rtp::transport_id. Its feedback
+  // goes out through the RTP modules of its own streams.
+  struct ReceiveTransport {
+    explicit ReceiveTransport(Clock* clock)
+        : congestion_controller(clock, &packet_router) {}
+
+    PacketRouter packet_router;
+    ReceiveSideCongestionController congestion_controller;
+    size_t num_streams = 0;
+  };
+
+  // Counts a stream on |transport_id|, setting the transport up on its
+  // first stream and tearing it down after its last.
+  void AddReceiveTransportStream(uint32_t transport_id);
+  void RemoveReceiveTransportStream(uint32_t transport_id);
+  PacketRouter* ReceivePacketRouter(uint32_t transport_id);
+  ReceiveSideCongestionController* ReceiveCongestionController(
+      uint32_t transport_id);
+
+  std::map<uint32_t, std::unique_ptr<ReceiveTransport>> receive_transports_;
+
   // Audio and Video send streams are owned by the client that creates them.
   
   webrtc::RtcEventLog* event_log_;
@@ -354,6 +398,7 @@ Call::~Call() {
   RTC_DCHECK_RUN_ON(&configuration_sequence_checker_);
   RTC_CHECK(audio_receive_streams_.empty());
   RTC_CHECK(video_receive_streams_.empty());
+  RTC_DCHECK(receive_transports_.empty());
 
   module_process_thread_->Stop();
   module_process_thread_->DeRegisterModule(
@@ -477,10 +522,16 @@ webrtc::AudioReceiveStream* Call::CreateAudioReceiveStream(
   event_log_->Log(std::make_unique<RtcEventAudioReceiveStreamConfig>(
       CreateRtcLogStreamConfig(config)));
   
+  const uint32_t transport_id = config.rtp.transport_id;
+  AddReceiveTransportStream(transport_id);
   AudioReceiveStream* receive_stream = new AudioReceiveStream(
-      clock_, &audio_receiver_controller_, &packet_router_, module_process_thread_.get(), config, event_log_);
+      clock_, &audio_receiver_controller_, ReceivePacketRouter(transport_id), 
+      module_process_thread_.get(), config, event_log_);
 
-  receive_rtp_config_.emplace(config.rtp.remote_ssrc, ReceiveRtpConfig(config));
+  receive_rtp_config_.emplace(
+      config.rtp.remote_ssrc,
+      ReceiveRtpConfig(config, ReceiveCongestionController(transport_id),
+                       receive_stream));
   audio_receive_streams_.insert(receive_stream);
 
   UpdateAggregateNetworkState();
@@ -496,7 +547,9 @@ void Call::DestroyAudioReceiveStream(
   
   const AudioReceiveStream::Config& config = audio_receive_stream->config();
   uint32_t ssrc = config.rtp.remote_ssrc;
-  receive_side_cc_.GetRemoteBitrateEstimator(UseSendSideBwe(config))
+  const uint32_t transport_id = config.rtp.transport_id;
+  ReceiveCongestionController(transport_id)
+      ->GetRemoteBitrateEstimator(UseSendSideBwe(config))
       ->RemoveStream(ssrc);
   audio_receive_streams_.erase(audio_receive_stream);
 
@@ -504,13 +557,18 @@ void Call::DestroyAudioReceiveStream(
   
   UpdateAggregateNetworkState();
   delete audio_receive_stream;
+  RemoveReceiveTransportStream(transport_id);
 }
 
 webrtc::VideoReceiveStream* Call::CreateVideoReceiveStream(
     webrtc::VideoReceiveStream::Config configuration) {
   RTC_DCHECK_RUN_ON(&configuration_sequence_checker_);
 
-  receive_side_cc_.SetSendPeriodicFeedback(
+  const uint32_t transport_id = configuration.rtp.transport_id;
+  AddReceiveTransportStream(transport_id);
+  ReceiveSideCongestionController* congestion_controller =
+      ReceiveCongestionController(transport_id);
+  congestion_controller->SetSendPeriodicFeedback(
       SendPeriodicFeedback(configuration.rtp.extensions));
 
   RegisterRateObserver();
@@ -519,7 +577,7 @@ webrtc::VideoReceiveStream* Call::CreateVideoReceiveStream(
     new VideoReceiveStream(task_queue_factory_, 
                            &video_receiver_controller_, 
                            num_cpu_cores_,
-                           &packet_router_, 
+                           ReceivePacketRouter(transport_id), 
                            std::move(configuration),
                            module_process_thread_.get(), 
                            call_stats_.get(), 
@@ -532,11 +590,13 @@ webrtc::VideoReceiveStream* Call::CreateVideoReceiveStream(
     // stream. Since the transport_send_cc negotiation is per payload
     // type, we may get an incorrect value for the rtx stream, but
     // that is unlikely to matter in practice.
-    receive_rtp_config_.emplace(config.rtp.rtx_ssrc,
-                                ReceiveRtpConfig(config));
+    receive_rtp_config_.emplace(
+        config.rtp.rtx_ssrc,
+        ReceiveRtpConfig(config, congestion_controller, receive_stream));
   }
-  receive_rtp_config_.emplace(config.rtp.remote_ssrc,
-                              ReceiveRtpConfig(config));
+  receive_rtp_config_.emplace(
+      config.rtp.remote_ssrc,
+      ReceiveRtpConfig(config, congestion_controller, receive_stream));
   video_receive_streams_.insert(receive_stream);
   
   receive_stream->SignalNetworkState(video_network_state_);
@@ -562,11 +622,14 @@ void Call::DestroyVideoReceiveStream(
   }
   video_receive_streams_.erase(receive_stream_impl);
 
-  receive_side_cc_.GetRemoteBitrateEstimator(UseSendSideBwe(config))
+  const uint32_t transport_id = config.rtp.transport_id;
+  ReceiveCongestionController(transport_id)
+      ->GetRemoteBitrateEstimator(UseSendSideBwe(config))
       ->RemoveStream(config.rtp.remote_ssrc);
 
   UpdateAggregateNetworkState();
   delete receive_stream_impl;
+  RemoveReceiveTransportStream(transport_id);
 }
 
 FlexfecReceiveStream* Call::CreateFlexfecReceiveStream(
@@ -594,7 +657,8 @@ FlexfecReceiveStream* Call::CreateFlexfecReceiveStream(
 
     RTC_DCHECK(receive_rtp_config_.find(config.remote_ssrc) ==
                receive_rtp_config_.end());
-    receive_rtp_config_.emplace(config.remote_ssrc, ReceiveRtpConfig(config));
+    receive_rtp_config_.emplace(config.remote_ssrc,
+                                ReceiveRtpConfig(config, &receive_side_cc_));
   }
 
   // TODO(brandtr): Store config in RtcEventLog here.
@@ -676,19 +740,43 @@ PacketReceiver::DeliveryStatus Call::DeliverRtcp(MediaType media_type,
     received_rtcp_bytes_per_second_counter_.Add(static_cast<int>(length));
   }
   bool rtcp_delivered = false;
-  if (media_type == MediaType::ANY || media_type == MediaType::VIDEO) {
-    for (VideoReceiveStream* stream : video_receive_streams_) {
-      if (stream->DeliverRtcp(packet, length))
+  if (!receive_transports_.empty()) {
+    // With the streams of several transports in the Call, RTCP goes to the
+    // stream of its sender only. RTCP from an unknown sender is dropped
+    // rather than offered to all, which would hand one peer's reports, or
+    // forged ones, to the streams of the other connections.
+    if (length < 8) {
+      return DELIVERY_PACKET_ERROR;
+    }
+    auto sender = receive_rtp_config_.find(
+        ByteReader<uint32_t>::ReadBigEndian(packet + 4));
+    if (sender == receive_rtp_config_.end()) {
+      return DELIVERY_UNKNOWN_SSRC;
+    }
+    if (VideoReceiveStream* stream = sender->second.video_stream) {
+      if (media_type == MediaType::ANY || media_type == MediaType::VIDEO)
+        rtcp_delivered = stream->DeliverRtcp(packet, length);
+    } else if (AudioReceiveStream* stream = sender->second.audio_stream) {
+      if (media_type == MediaType::ANY || media_type == MediaType::AUDIO) {
+        stream->DeliverRtcp(packet, length);
         rtcp_delivered = true;
+      }
     }
-  }
-  if (media_type == MediaType::ANY || media_type == MediaType::AUDIO) {
-    for (AudioReceiveStream* stream : audio_receive_streams_) {
-      stream->DeliverRtcp(packet, length);
-      rtcp_delivered = true;
+  } else {
+    if (media_type == MediaType::ANY || media_type == MediaType::VIDEO) {
+      for (VideoReceiveStream* stream : video_receive_streams_) {
+        if (stream->DeliverRtcp(packet, length))
+          rtcp_delivered = true;
+      }
+    }
+    if (media_type == MediaType::ANY || media_type == MediaType::AUDIO) {
+      for (AudioReceiveStream* stream : audio_receive_streams_) {
+        stream->DeliverRtcp(packet, length);
+        rtcp_delivered = true;
+      }
     }
   }
-  if (rtcp_delivered) {
+  if (rtcp_delivered && event_log_->IsLogging()) {
     event_log_->Log(std::make_unique<RtcEventRtcpPacketIncoming>(
         rtc::MakeArrayView(packet, length)));
   }
@@ -698,9 +786,12 @@ PacketReceiver::DeliveryStatus Call::DeliverRtcp(MediaType media_type,
 
 PacketReceiver::DeliveryStatus Call::DeliverRtp(MediaType media_type,
                                                 rtc::CopyOnWriteBuffer packet,
+                                                const RtpHeaderView* header,
                                                 int64_t packet_time_us) {
   RtpPacketReceived parsed_packet;
-  if (!parsed_packet.Parse(std::move(packet)))
+  bool parsed = header ? parsed_packet.Parse(std::move(packet), *header)
+                       : parsed_packet.Parse(std::move(packet));
+  if (!parsed)
     return DELIVERY_PACKET_ERROR;
 
   if (packet_time_us != -1) {
@@ -755,8 +846,10 @@ PacketReceiver::DeliveryStatus Call::DeliverRtp(MediaType media_type,
     if (audio_receiver_controller_.OnRtpPacket(parsed_packet)) {
       received_bytes_per_second_counter_.Add(length);
       received_audio_bytes_per_second_counter_.Add(length);
-      event_log_->Log(
-          std::make_unique<RtcEventRtpPacketIncoming>(parsed_packet));
+      if (event_log_->IsLogging()) {
+        event_log_->Log(
+            std::make_unique<RtcEventRtpPacketIncoming>(parsed_packet));
+      }
       const int64_t arrival_time_ms = parsed_packet.arrival_time_ms();
       if (!first_received_rtp_audio_ms_) {
         first_received_rtp_audio_ms_.emplace(arrival_time_ms);
@@ -769,8 +862,10 @@ PacketReceiver::DeliveryStatus Call::DeliverRtp(MediaType media_type,
     if (video_receiver_controller_.OnRtpPacket(parsed_packet)) {
       received_bytes_per_second_counter_.Add(length);
       received_video_bytes_per_second_counter_.Add(length);
-      event_log_->Log(
-          std::make_unique<RtcEventRtpPacketIncoming>(parsed_packet));
+      if (event_log_->IsLogging()) {
+        event_log_->Log(
+            std::make_unique<RtcEventRtpPacketIncoming>(parsed_packet));
+      }
       const int64_t arrival_time_ms = parsed_packet.arrival_time_ms();
       if (!first_received_rtp_video_ms_) {
         first_received_rtp_video_ms_.emplace(arrival_time_ms);
@@ -790,7 +885,19 @@ PacketReceiver::DeliveryStatus Call::DeliverPacket(
   if (IsRtcp(packet.cdata(), packet.size()))
     return DeliverRtcp(media_type, packet.cdata(), packet.size());
 
-  return DeliverRtp(media_type, std::move(packet), packet_time_us);
+  return DeliverRtp(media_type, std::move(packet), nullptr, packet_time_us);
+}
+
+PacketReceiver::DeliveryStatus Call::DeliverRtpPacket(
+    MediaType media_type,
+    rtc::CopyOnWriteBuffer packet,
+    const RtpHeaderView& header,
+    int64_t packet_time_us) {
+  RTC_DCHECK_RUN_ON(&configuration_sequence_checker_);
+  if (IsRtcp(packet.cdata(), packet.size()))
+    return DeliverRtcp(media_type, packet.cdata(), packet.size());
+
+  return DeliverRtp(media_type, std::move(packet), &header, packet_time_us);
 }
 
 #if 0
@@ -850,12 +957,63 @@ void Call::NotifyBweOfReceivedPacket(const RtpPacketReceived& packet,
   // For audio, we only support send side BWE.
   if (media_type == MediaType::VIDEO ||
       (use_send_side_bwe && header.extension.hasTransportSequenceNumber)) {
-    receive_side_cc_.OnReceivedPacket(
+    it->second.congestion_controller->OnReceivedPacket(
         packet.arrival_time_ms(), packet.payload_size() + packet.padding_size(),
         header);
   }
 }
 
+void Call::AddReceiveTransportStream(uint32_t transport_id) {
+  if (transport_id == 0) {
+    return;
+  }
+  std::unique_ptr<ReceiveTransport>& transport =
+      receive_transports_[transport_id];
+  if (!transport) {
+    transport = std::make_unique<ReceiveTransport>(clock_);
+    call_stats_->RegisterStatsObserver(&transport->congestion_controller);
+    module_process_thread_->RegisterModule(
+        transport->congestion_controller.GetRemoteBitrateEstimator(true),
+        RTC_FROM_HERE);
+  }
+  ++transport->num_streams;
+}
+
+void Call::RemoveReceiveTransportStream(uint32_t transport_id) {
+  if (transport_id == 0) {
+    return;
+  }
+  auto found = receive_transports_.find(transport_id);
+  RTC_DCHECK(found != receive_transports_.end());
+  ReceiveTransport* transport = found->second.get();
+  if (--transport->num_streams > 0) {
+    return;
+  }
+  module_process_thread_->DeRegisterModule(
+      transport->congestion_controller.GetRemoteBitrateEstimator(true));
+  call_stats_->DeregisterStatsObserver(&transport->congestion_controller);
+  receive_transports_.erase(found);
+}
+
+PacketRouter* Call::ReceivePacketRouter(uint32_t transport_id) {
+  if (transport_id == 0) {
+    return &packet_router_;
+  }
+  auto found = receive_transports_.find(transport_id);
+  RTC_DCHECK(found != receive_transports_.end());
+  return &found->second->packet_router;
+}
+
+ReceiveSideCongestionController* Call::ReceiveCongestionController(
+    uint32_t transport_id) {
+  if (transport_id == 0) {
+    return &receive_side_cc_;
+  }
+  auto found = receive_transports_.find(transport_id);
+  RTC_DCHECK(found != receive_transports_.end());
+  return &found->second->congestion_controller;
+}
+
 }  // namespace internal
 
 }  // namespace webrtc
@@ -17,6 +17,7 @@
 
 #include "api/media_types.h"
 #include "rtc_base/copy_on_write_buffer.h"
+#include "rtp_rtcp/rtp_header_view.h"
 
 namespace webrtc {
 
@@ -32,6 +33,15 @@ class PacketReceiver {
                                        rtc::CopyOnWriteBuffer packet,
                                        int64_t packet_time_us) = 0;
 
+  // Same as DeliverPacket() for an RTP packet whose header was parsed into
+  // |header| on arrival, so it need not be parsed again.
+  virtual DeliveryStatus DeliverRtpPacket(MediaType media_type,
+                                          rtc::CopyOnWriteBuffer packet,
+                                          const RtpHeaderView& header,
+                                          int64_t packet_time_us) {
+    return DeliverPacket(media_type, std::move(packet), packet_time_us);
+  }
+
  protected:
   virtual ~PacketReceiver() {}
 };
@@ -10,6 +10,8 @@
 
 #include "call/rtp_demuxer.h"
 
+#include <string.h>
+
 #include "call/rtp_packet_sink_interface.h"
 #include "call/rtp_rtcp_demuxer_helper.h"
 #include "call/ssrc_binding_observer.h"
@@ -20,6 +22,9 @@
 #include "rtc_base/string_builder.h"
 
 namespace webrtc {
+namespace {
+constexpr size_t kInitialSsrcTableSize = 16;
+}  // namespace
 
 RtpDemuxerCriteria::RtpDemuxerCriteria() = default;
 RtpDemuxerCriteria::~RtpDemuxerCriteria() = default;
@@ -43,11 +48,11 @@ std::string RtpDemuxer::DescribePacket(const RtpPacketReceived& packet) {
   return sb.Release();
 }
 
-RtpDemuxer::RtpDemuxer() = default;
+RtpDemuxer::RtpDemuxer() : ssrc_table_(kInitialSsrcTableSize) {}
 
 RtpDemuxer::~RtpDemuxer() {
   RTC_DCHECK(sink_by_mid_.empty());
-  RTC_DCHECK(sink_by_ssrc_.empty());
+  RTC_DCHECK_EQ(ssrc_bindings_, 0u);
   RTC_DCHECK(sinks_by_pt_.empty());
   RTC_DCHECK(sink_by_mid_and_rsid_.empty());
   RTC_DCHECK(sink_by_rsid_.empty());
@@ -82,7 +87,8 @@ bool RtpDemuxer::AddSink(const RtpDemuxerCriteria& criteria, RtpPacketSinkInterf
   }
 
   for (uint32_t ssrc : criteria.ssrcs) {
-    sink_by_ssrc_.emplace(ssrc, sink);
+    FindOrAddSsrcEntry(ssrc)->sink = sink;
+    ++ssrc_bindings_;
   }
 
   for (uint8_t payload_type : criteria.payload_types) {
@@ -90,6 +96,7 @@ bool RtpDemuxer::AddSink(const RtpDemuxerCriteria& criteria, RtpPacketSinkInterf
   }
 
   RefreshKnownMids();
+  ++generation_;
 
   return true;
 }
@@ -121,7 +128,8 @@ bool RtpDemuxer::CriteriaWouldConflict(const RtpDemuxerCriteria& criteria) const
   }
 
   for (uint32_t ssrc : criteria.ssrcs) {
-    if (sink_by_ssrc_.find(ssrc) != sink_by_ssrc_.end()) {
+    const SsrcEntry* entry = FindSsrcEntry(ssrc);
+    if (entry && entry->sink) {
       return true;
     }
   }
@@ -160,11 +168,18 @@ void RtpDemuxer::AddSink(const std::string& rsid, RtpPacketSinkInterface* sink)
 bool RtpDemuxer::RemoveSink(const RtpPacketSinkInterface* sink) {
   RTC_DCHECK(sink);
   size_t num_removed = RemoveFromMapByValue(&sink_by_mid_, sink) +
-                       RemoveFromMapByValue(&sink_by_ssrc_, sink) +
                        RemoveFromMultimapByValue(&sinks_by_pt_, sink) +
                        RemoveFromMapByValue(&sink_by_mid_and_rsid_, sink) +
                        RemoveFromMapByValue(&sink_by_rsid_, sink);
+  for (SsrcEntry& entry : ssrc_table_) {
+    if (entry.used && entry.sink == sink) {
+      entry.sink = nullptr;
+      --ssrc_bindings_;
+      ++num_removed;
+    }
+  }
   RefreshKnownMids();
+  ++generation_;
   return num_removed > 0;
 }
 
@@ -178,6 +193,30 @@ bool RtpDemuxer::OnRtpPacket(const RtpPacketReceived& packet) {
 }
 
 RtpPacketSinkInterface* RtpDemuxer::ResolveSink(const RtpPacketReceived& packet) {
+  uint32_t ssrc = packet.Ssrc();
+  const SsrcEntry* entry = FindSsrcEntry(ssrc);
+  if (entry && entry->resolved_generation == generation_ &&
+      CarriesLatchedIds(packet, *entry)) {
+    return entry->resolved_sink;
+  }
+
+  bool by_payload_type = false;
+  RtpPacketSinkInterface* sink = ResolveSinkByIds(packet, &by_payload_type);
+
+  // A packet whose MID or RSID was not latched, such as one dropped for an
+  // unknown MID, says nothing about the packets that carry the latched ones.
+  // Neither does one routed by payload type, the next may carry another.
+  SsrcEntry* resolved = FindSsrcEntry(ssrc);
+  if (resolved && !by_payload_type && CarriesLatchedIds(packet, *resolved)) {
+    resolved->resolved_sink = sink;
+    resolved->resolved_generation = generation_;
+  }
+  return sink;
+}
+
+RtpPacketSinkInterface* RtpDemuxer::ResolveSinkByIds(
+    const RtpPacketReceived& packet,
+    bool* by_payload_type) {
   // See the BUNDLE spec for high level reference to this algorithm:
   // https://tools.ietf.org/html/draft-ietf-mmusic-sdp-bundle-negotiation-38#section-10.2
 
@@ -201,29 +240,23 @@ RtpPacketSinkInterface* RtpDemuxer::ResolveSink(const RtpPacketReceived& packet)
   // there isn't a rule/sink yet because we might add an MID/RSID rule after
   // learning an MID/RSID<->SSRC association.
 
-  std::string* mid = nullptr;
   if (has_mid) {
-    mid_by_ssrc_[ssrc] = packet_mid;
-    mid = &packet_mid;
-  } else {
-    // If the packet does not include a MID header extension, check if there is
-    // a latched MID for the SSRC.
-    const auto it = mid_by_ssrc_.find(ssrc);
-    if (it != mid_by_ssrc_.end()) {
-      mid = &it->second;
-    }
+    FindOrAddSsrcEntry(ssrc)->mid = packet_mid;
   }
-
-  std::string* rsid = nullptr;
   if (has_rsid) {
-    rsid_by_ssrc_[ssrc] = packet_rsid;
-    rsid = &packet_rsid;
-  } else {
-    // If the packet does not include an RRID/RSID header extension, check if
-    // there is a latched RSID for the SSRC.
-    const auto it = rsid_by_ssrc_.find(ssrc);
-    if (it != rsid_by_ssrc_.end()) {
-      rsid = &it->second;
+    FindOrAddSsrcEntry(ssrc)->rsid = packet_rsid;
+  }
+
+  // If the packet does not include a MID or RRID/RSID header extension, check
+  // if there is one latched for the SSRC.
+  const std::string* mid = nullptr;
+  const std::string* rsid = nullptr;
+  if (const SsrcEntry* entry = FindSsrcEntry(ssrc)) {
+    if (!entry->mid.empty()) {
+      mid = &entry->mid;
+    }
+    if (!entry->rsid.empty()) {
+      rsid = &entry->rsid;
     }
   }
 
@@ -266,15 +299,100 @@ RtpPacketSinkInterface* RtpDemuxer::ResolveSink(const RtpPacketReceived& packet)
 
   // We trust signaled SSRC more than payload type which is likely to conflict
   // between streams.
-  const auto ssrc_sink_it = sink_by_ssrc_.find(ssrc);
-  if (ssrc_sink_it != sink_by_ssrc_.end()) {
-    return ssrc_sink_it->second;
+  const SsrcEntry* entry = FindSsrcEntry(ssrc);
+  if (entry && entry->sink) {
+    return entry->sink;
   }
 
   // Legacy senders will only signal payload type, support that as last resort.
+  *by_payload_type = true;
   return ResolveSinkByPayloadType(packet.PayloadType(), ssrc);
 }
 
+bool RtpDemuxer::CarriesLatchedIds(const RtpPacketReceived& packet,
+                                   const SsrcEntry& entry) const {
+  // Raw values are compared, a value that only parses to the latched one
+  // takes the full path.
+  if (use_mid_) {
+    rtc::ArrayView<const uint8_t> mid = packet.GetRawExtension<RtpMid>();
+    if (!mid.empty() && !IdEquals(entry.mid, mid)) {
+      return false;
+    }
+  }
+  rtc::ArrayView<const uint8_t> rsid =
+      packet.GetRawExtension<RepairedRtpStreamId>();
+  if (rsid.empty()) {
+    rsid = packet.GetRawExtension<RtpStreamId>();
+  }
+  return rsid.empty() || IdEquals(entry.rsid, rsid);
+}
+
+bool RtpDemuxer::IdEquals(const std::string& id,
+                          rtc::ArrayView<const uint8_t> value) {
+  return !id.empty() && id.size() == value.size() &&
+         memcmp(id.data(), value.data(), value.size()) == 0;
+}
+
+const RtpDemuxer::SsrcEntry* RtpDemuxer::FindSsrcEntry(uint32_t ssrc) const {
+  if (last_entry_ && last_entry_->ssrc == ssrc) {
+    return last_entry_;
+  }
+  const size_t mask = ssrc_table_.size() - 1;
+  for (size_t i = (ssrc * 0x9E3779B1u) & mask;; i = (i + 1) & mask) {
+    const SsrcEntry& entry = ssrc_table_[i];
+    if (!entry.used) {
+      return nullptr;
+    }
+    if (entry.ssrc == ssrc) {
+      last_entry_ = &entry;
+      return &entry;
+    }
+  }
+}
+
+RtpDemuxer::SsrcEntry* RtpDemuxer::FindSsrcEntry(uint32_t ssrc) {
+  return const_cast<SsrcEntry*>(
+      static_cast<const RtpDemuxer*>(this)->FindSsrcEntry(ssrc));
+}
+
+RtpDemuxer::SsrcEntry* RtpDemuxer::FindOrAddSsrcEntry(uint32_t ssrc) {
+  if (SsrcEntry* entry = FindSsrcEntry(ssrc)) {
+    return entry;
+  }
+  // Kept at most three quarters full.
+  if ((ssrc_entries_ + 1) * 4 > ssrc_table_.size() * 3) {
+    GrowSsrcTable();
+  }
+  const size_t mask = ssrc_table_.size() - 1;
+  size_t i = (ssrc * 0x9E3779B1u) & mask;
+  while (ssrc_table_[i].used) {
+    i = (i + 1) & mask;
+  }
+  SsrcEntry& entry = ssrc_table_[i];
+  entry.used = true;
+  entry.ssrc = ssrc;
+  ++ssrc_entries_;
+  last_entry_ = &entry;
+  return &entry;
+}
+
+void RtpDemuxer::GrowSsrcTable() {
+  std::vector<SsrcEntry> table(ssrc_table_.size() * 2);
+  table.swap(ssrc_table_);
+  const size_t mask = ssrc_table_.size() - 1;
+  for (SsrcEntry& entry : table) {
+    if (!entry.used) {
+      continue;
+    }
+    size_t i = (entry.ssrc * 0x9E3779B1u) & mask;
+    while (ssrc_table_[i].used) {
+      i = (i + 1) & mask;
+    }
+    ssrc_table_[i] = std::move(entry);
+  }
+  last_entry_ = nullptr;
+}
+
 RtpPacketSinkInterface* RtpDemuxer::ResolveSinkByMid(const std::string& mid,
                                                      uint32_t ssrc) {
   const auto it = sink_by_mid_.find(mid);
@@ -354,24 +472,23 @@ RtpPacketSinkInterface* RtpDemuxer::ResolveSinkByPayloadType(
 }
 
 bool RtpDemuxer::AddSsrcSinkBinding(uint32_t ssrc, RtpPacketSinkInterface* sink) {
-  if (sink_by_ssrc_.size() >= kMaxSsrcBindings) {
+  if (ssrc_bindings_ >= kMaxSsrcBindings) {
     RTC_LOG(LS_WARNING) << "New SSRC=" << ssrc
                         << " sink binding ignored; limit of" << kMaxSsrcBindings
                         << " bindings has been reached.";
     return false;
   }
 
-  auto result = sink_by_ssrc_.emplace(ssrc, sink);
-  auto it = result.first;
-  bool inserted = result.second;
-  if (inserted) {
-    return true;
+  SsrcEntry* entry = FindOrAddSsrcEntry(ssrc);
+  if (entry->sink == sink) {
+    return false;
   }
-  if (it->second != sink) {
-    it->second = sink;
-    return true;
+  if (!entry->sink) {
+    ++ssrc_bindings_;
   }
-  return false;
+  entry->sink = sink;
+  ++generation_;
+  return true;
 }
 
 void RtpDemuxer::RegisterSsrcBindingObserver(SsrcBindingObserver* observer) {
@@ -17,6 +17,8 @@
 #include <utility>
 #include <vector>
 
+#include "rtc_base/array_view.h"
+
 namespace webrtc {
 
 class RtpPacketReceived;
@@ -143,9 +145,28 @@ class RtpDemuxer {
 
   // Configure whether to look at the MID header extension when demuxing
   // incoming RTP packets. By default this is enabled.
-  void set_use_mid(bool use_mid) { use_mid_ = use_mid; }
+  void set_use_mid(bool use_mid) {
+    use_mid_ = use_mid;
+    ++generation_;
+  }
 
  private:
+  // What is known about one SSRC. Besides the sink bound to it and the MID
+  // and RSID latched from its packets, it caches the sink its last packet
+  // resolved to. That result holds for later packets carrying the same (or
+  // no) MID and RSID until |generation_| moves on. The MID and RSID are held
+  // by the entry, empty when none was latched, so the remote peer can not
+  // grow anything beyond the SSRC entries.
+  struct SsrcEntry {
+    uint32_t ssrc = 0;
+    bool used = false;
+    RtpPacketSinkInterface* sink = nullptr;
+    std::string mid;
+    std::string rsid;
+    RtpPacketSinkInterface* resolved_sink = nullptr;
+    uint64_t resolved_generation = 0;
+  };
+
   // Returns true if adding a sink with the given criteria would cause conflicts
   // with the existing criteria and should be rejected.
   bool CriteriaWouldConflict(const RtpDemuxerCriteria& criteria) const;
@@ -154,7 +175,27 @@ class RtpDemuxer {
   // should receive the packet.
   // Will record any SSRC<->ID associations along the way.
   // If the packet should be dropped, this method returns null.
+  // Most packets are answered from the cached result of their SSRC entry,
+  // only the first packets of an SSRC, or those with a new MID or RSID, run
+  // the full algorithm in ResolveSinkByIds().
   RtpPacketSinkInterface* ResolveSink(const RtpPacketReceived& packet);
+  // Sets |by_payload_type| if the payload type was looked at.
+  RtpPacketSinkInterface* ResolveSinkByIds(const RtpPacketReceived& packet,
+                                           bool* by_payload_type);
+
+  // True if the MID and RSID carried by |packet|, if any, are the ones
+  // latched in |entry|.
+  bool CarriesLatchedIds(const RtpPacketReceived& packet,
+                         const SsrcEntry& entry) const;
+  static bool IdEquals(const std::string& id,
+                       rtc::ArrayView<const uint8_t> value);
+
+  // Open addressed SSRC table, entries are never removed. Pointers into it
+  // are invalidated by FindOrAddSsrcEntry().
+  const SsrcEntry* FindSsrcEntry(uint32_t ssrc) const;
+  SsrcEntry* FindSsrcEntry(uint32_t ssrc);
+  SsrcEntry* FindOrAddSsrcEntry(uint32_t ssrc);
+  void GrowSsrcTable();
 
   // Used by the ResolveSink algorithm.
   RtpPacketSinkInterface* ResolveSinkByMid(const std::string& mid,
@@ -179,7 +220,6 @@ class RtpDemuxer {
   // SSRC mapping which receives all MID, payload type, or RSID to SSRC bindings
   // discovered when demuxing packets).
   std::map<std::string, RtpPacketSinkInterface*> sink_by_mid_;
-  std::map<uint32_t, RtpPacketSinkInterface*> sink_by_ssrc_;
   std::multimap<uint8_t, RtpPacketSinkInterface*> sinks_by_pt_;
   std::map<std::pair<std::string, std::string>, RtpPacketSinkInterface*>
       sink_by_mid_and_rsid_;
@@ -190,12 +230,17 @@ class RtpDemuxer {
   // unknown.
   std::set<std::string> known_mids_;
 
-  // Records learned mappings of MID --> SSRC and RSID --> SSRC as packets are
-  // received.
-  // This is stored separately from the sink mappings because if a sink is
-  // removed we want to still remember these associations.
-  std::map<uint32_t, std::string> mid_by_ssrc_;
-  std::map<uint32_t, std::string> rsid_by_ssrc_;
+  // SSRC bindings, and the mappings of MID --> SSRC and RSID --> SSRC
+  // learned as packets are received. The learned mappings outlive the sink
+  // a SSRC is bound to, so that they are remembered if a sink is removed.
+  std::vector<SsrcEntry> ssrc_table_;
+  size_t ssrc_entries_ = 0;
+  size_t ssrc_bindings_ = 0;
+  mutable const SsrcEntry* last_entry_ = nullptr;
+
+  // Bumped whenever a change to the sinks or SSRC bindings may change where
+  // packets are routed, dropping the results cached in the SSRC entries.
+  uint64_t generation_ = 1;
 
   // Adds a binding from the SSRC to the given sink. Returns true if there was
   // not already a sink bound to the SSRC or if the sink replaced a different
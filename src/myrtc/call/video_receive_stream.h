@@ -176,6 +176,9 @@ class VideoReceiveStream {
       // See draft-holmer-rmcat-transport-wide-cc-extensions for details.
       bool transport_cc = false;
 
+      // See AudioReceiveStream::Config::Rtp::transport_id.
+      uint32_t transport_id = 0;
+
       // See LntfConfig for description.
       LntfConfig lntf;
 
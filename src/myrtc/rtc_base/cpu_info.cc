@@ -20,6 +20,7 @@
 #include <zircon/syscalls.h>
 #endif
 
+#include "rtc_base/arch.h"
 #include "rtc_base/logging.h"
 
 namespace internal {
@@ -69,4 +70,19 @@ uint32_t CpuInfo::DetectNumberOfCores() {
   return logical_cpus;
 }
 
+bool CpuInfo::Supports(Feature feature) {
+#if defined(WEBRTC_ARCH_X86_FAMILY) && (defined(__GNUC__) || defined(__clang__))
+  // The AVX2 check also covers OS support for saving the YMM registers.
+  static const bool sse2 = __builtin_cpu_supports("sse2");
+  static const bool avx2 = __builtin_cpu_supports("avx2");
+  switch (feature) {
+    case kSSE2:
+      return sse2;
+    case kAVX2:
+      return avx2;
+  }
+#endif
+  return false;
+}
+
 }  // namespace webrtc
@@ -17,8 +17,16 @@ namespace webrtc {
 
 class CpuInfo {
  public:
+  enum Feature {
+    kSSE2,
+    kAVX2,
+  };
+
   static uint32_t DetectNumberOfCores();
 
+  // Whether the processor and OS we run on support |feature|.
+  static bool Supports(Feature feature);
+
  private:
   CpuInfo() {}
 };
@@ -0,0 +1,62 @@
+/*
+ *  Copyright 2004 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef RTC_BASE_MODULE_LOCK_H_
+#define RTC_BASE_MODULE_LOCK_H_
+
+#include "rtc_base/checks.h"
+#include "rtc_base/constructor_magic.h"
+#include "rtc_base/critical_section.h"
+#include "rtc_base/sequence_checker.h"
+#include "rtc_base/thread_annotations.h"
+
+namespace rtc {
+
+#if defined(WEBRTC_SINGLE_THREAD_MODULES)
+
+// The lock of RTP/RTCP modules that run on a single worker task queue.
+// Taking it costs nothing; debug builds check that every acquisition happens
+// on the sequence that took it first.
+class RTC_LOCKABLE ModuleLock {
+ public:
+  ModuleLock() { sequence_checker_.Detach(); }
+
+  void Enter() const RTC_EXCLUSIVE_LOCK_FUNCTION() {
+    RTC_DCHECK(sequence_checker_.IsCurrent());
+  }
+  void Leave() const RTC_UNLOCK_FUNCTION() {}
+
+ private:
+  webrtc::SequenceChecker sequence_checker_;
+  RTC_DISALLOW_COPY_AND_ASSIGN(ModuleLock);
+};
+
+class RTC_SCOPED_LOCKABLE ModuleLockScope {
+ public:
+  explicit ModuleLockScope(const ModuleLock* lock)
+      RTC_EXCLUSIVE_LOCK_FUNCTION(lock) {
+    lock->Enter();
+  }
+  ~ModuleLockScope() RTC_UNLOCK_FUNCTION() {}
+
+ private:
+  RTC_DISALLOW_COPY_AND_ASSIGN(ModuleLockScope);
+};
+
+#else
+
+using ModuleLock = CriticalSection;
+using ModuleLockScope = CritScope;
+
+#endif  // defined(WEBRTC_SINGLE_THREAD_MODULES)
+
+}  // namespace rtc
+
+#endif  // RTC_BASE_MODULE_LOCK_H_
@@ -0,0 +1,121 @@
+/*
+ *  Copyright (c) 2016 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef RTC_BASE_RING_BUFFER_H_
+#define RTC_BASE_RING_BUFFER_H_
+
+#include <stddef.h>
+
+#include <utility>
+#include <vector>
+
+#include "rtc_base/checks.h"
+
+namespace rtc {
+
+// A double ended queue kept in one contiguous array whose size is a power of
+// two, so elements are found by masking a logical index. The array doubles
+// when full and is never shrunk.
+template <typename T>
+class RingBuffer {
+ public:
+  explicit RingBuffer(size_t initial_capacity = 16) {
+    size_t capacity = 1;
+    while (capacity < initial_capacity)
+      capacity <<= 1;
+    slots_.resize(capacity);
+  }
+
+  size_t size() const { return size_; }
+  bool empty() const { return size_ == 0; }
+  size_t capacity() const { return slots_.size(); }
+
+  // |index| counts from the front.
+  T& operator[](size_t index) {
+    RTC_DCHECK_LT(index, size_);
+    return slots_[(head_ + index) & (slots_.size() - 1)];
+  }
+  const T& operator[](size_t index) const {
+    RTC_DCHECK_LT(index, size_);
+    return slots_[(head_ + index) & (slots_.size() - 1)];
+  }
+
+  T& front() { return (*this)[0]; }
+  const T& front() const { return (*this)[0]; }
+  T& back() { return (*this)[size_ - 1]; }
+  const T& back() const { return (*this)[size_ - 1]; }
+
+  void push_back(T value) {
+    if (size_ == slots_.size())
+      Grow();
+    slots_[(head_ + size_) & (slots_.size() - 1)] = std::move(value);
+    ++size_;
+  }
+
+  void push_front(T value) {
+    if (size_ == slots_.size())
+      Grow();
+    head_ = (head_ - 1) & (slots_.size() - 1);
+    slots_[head_] = std::move(value);
+    ++size_;
+  }
+
+  void pop_front() {
+    RTC_DCHECK(!empty());
+    slots_[head_] = T();
+    head_ = (head_ + 1) & (slots_.size() - 1);
+    --size_;
+  }
+
+  void pop_back() {
+    RTC_DCHECK(!empty());
+    back() = T();
+    --size_;
+  }
+
+  void clear() {
+    while (!empty())
+      pop_front();
+    head_ = 0;
+  }
+
+  // Drops the elements matching |pred|, keeping the others in order.
+  template <typename Predicate>
+  void remove_if(Predicate pred) {
+    size_t kept = 0;
+    for (size_t i = 0; i < size_; ++i) {
+      T& element = (*this)[i];
+      if (pred(element))
+        continue;
+      if (kept != i)
+        (*this)[kept] = std::move(element);
+      ++kept;
+    }
+    while (size_ > kept)
+      pop_back();
+  }
+
+ private:
+  void Grow() {
+    std::vector<T> slots(slots_.size() * 2);
+    for (size_t i = 0; i < size_; ++i)
+      slots[i] = std::move((*this)[i]);
+    slots_.swap(slots);
+    head_ = 0;
+  }
+
+  std::vector<T> slots_;
+  size_t head_ = 0;
+  size_t size_ = 0;
+};
+
+}  // namespace rtc
+
+#endif  // RTC_BASE_RING_BUFFER_H_
@@ -112,6 +112,9 @@ class TaskQueueLibevent final : public TaskQueueBase {
   void PostTask(std::unique_ptr<QueuedTask> task) override;
   void PostDelayedTask(std::unique_ptr<QueuedTask> task,
                        uint32_t milliseconds) override;
+  void SetObserver(TaskQueueObserver* observer) override {
+    observer_ = observer;
+  }
 
  private:
   class SetTimerTask : public QueuedTask {
@@ -138,15 +141,25 @@ class TaskQueueLibevent final : public TaskQueueBase {
   };
   
   struct TimerEvent {
-    TimerEvent(TaskQueueLibevent* task_queue, std::unique_ptr<QueuedTask> task)
-        : task_queue_(task_queue), task_(std::move(task)) {}
+    TimerEvent(TaskQueueLibevent* task_queue,
+               std::unique_ptr<QueuedTask> task,
+               int64_t due_ns)
+        : task_queue_(task_queue), task_(std::move(task)), due_ns_(due_ns) {}
     ~TimerEvent() { event_del(&ev_); }
 
     event ev_;
     TaskQueueLibevent* task_queue_;
     std::unique_ptr<QueuedTask> task_;
+    const int64_t due_ns_;
+  };
+
+  struct PendingTask {
+    std::unique_ptr<QueuedTask> task;
+    int64_t posted_ns;
   };
 
+  void RunTask(std::unique_ptr<QueuedTask> task, int64_t since_ns, size_t depth);
+
   ~TaskQueueLibevent() override = default;
 
   static void ThreadMain(void* context);
@@ -160,9 +173,10 @@ class TaskQueueLibevent final : public TaskQueueBase {
   event wakeup_event_;
   rtc::PlatformThread thread_;
   rtc::CriticalSection pending_lock_;
-  std::list<std::unique_ptr<QueuedTask>> pending_ RTC_GUARDED_BY(pending_lock_);
+  std::list<PendingTask> pending_ RTC_GUARDED_BY(pending_lock_);
   // Holds a list of events pending timers for cleanup when the loop exits.
   std::set<TimerEvent*> pending_timers_;
+  TaskQueueObserver* observer_ = nullptr;
 };
 
 TaskQueueLibevent::TaskQueueLibevent(std::string_view queue_name,
@@ -211,16 +225,20 @@ void TaskQueueLibevent::Delete() {
 
 void TaskQueueLibevent::PostTask(std::unique_ptr<QueuedTask> task) {
   QueuedTask* task_id = task.get();  // Only used for comparison.
+  size_t depth;
   {
     rtc::CritScope lock(&pending_lock_);
-    pending_.push_back(std::move(task));
+    pending_.push_back({std::move(task), rtc::TimeNanos()});
+    depth = pending_.size();
   }
+  if (observer_)
+    observer_->OnTaskPosted(depth);
   char message = kRunTask;
   if (write(wakeup_pipe_in_, &message, sizeof(message)) != sizeof(message)) {
     RTC_LOG(WARNING) << "Failed to queue task.";
     rtc::CritScope lock(&pending_lock_);
-    pending_.remove_if([task_id](std::unique_ptr<QueuedTask>& t) {
-      return t.get() == task_id;
+    pending_.remove_if([task_id](PendingTask& t) {
+      return t.task.get() == task_id;
     });
   }
 }
@@ -228,7 +246,9 @@ void TaskQueueLibevent::PostTask(std::unique_ptr<QueuedTask> task) {
 void TaskQueueLibevent::PostDelayedTask(std::unique_ptr<QueuedTask> task,
                                         uint32_t milliseconds) {
   if (IsCurrent()) {
-    TimerEvent* timer = new TimerEvent(this, std::move(task));
+    TimerEvent* timer = new TimerEvent(
+        this, std::move(task),
+        rtc::TimeNanos() + milliseconds * rtc::kNumNanosecsPerMillisec);
     EventAssign(&timer->ev_, event_base_, -1, 0, &TaskQueueLibevent::RunTimer,
                 timer);
     pending_timers_.insert(timer);
@@ -268,16 +288,17 @@ void TaskQueueLibevent::OnWakeup(int socket,
       event_base_loopbreak(me->event_base_);
       break;
     case kRunTask: {
-      std::unique_ptr<QueuedTask> task;
+      PendingTask pending;
+      size_t depth;
       {
         rtc::CritScope lock(&me->pending_lock_);
         RTC_DCHECK(!me->pending_.empty());
-        task = std::move(me->pending_.front());
+        pending = std::move(me->pending_.front());
         me->pending_.pop_front();
-        RTC_DCHECK(task.get());
+        depth = me->pending_.size();
+        RTC_DCHECK(pending.task.get());
       }
-      if (!task->Run())
-        task.release();
+      me->RunTask(std::move(pending.task), pending.posted_ns, depth);
       break;
     }
     default:
@@ -289,12 +310,31 @@ void TaskQueueLibevent::OnWakeup(int socket,
 // static
 void TaskQueueLibevent::RunTimer(int, short, void* context) {
   TimerEvent* timer = static_cast<TimerEvent*>(context);
-  if (!timer->task_->Run())
-    timer->task_.release();
-  timer->task_queue_->pending_timers_.erase(timer);
+  TaskQueueLibevent* me = timer->task_queue_;
+  size_t depth = 0;
+  if (me->observer_) {
+    rtc::CritScope lock(&me->pending_lock_);
+    depth = me->pending_.size();
+  }
+  me->RunTask(std::move(timer->task_), timer->due_ns_, depth);
+  me->pending_timers_.erase(timer);
   delete timer;
 }
 
+void TaskQueueLibevent::RunTask(std::unique_ptr<QueuedTask> task,
+                                int64_t since_ns,
+                                size_t depth) {
+  if (!observer_) {
+    if (!task->Run())
+      task.release();
+    return;
+  }
+  int64_t start_ns = rtc::TimeNanos();
+  if (!task->Run())
+    task.release();
+  observer_->OnTaskRun(start_ns - since_ns, rtc::TimeNanos() - start_ns, depth);
+}
+
 class TaskQueueLibeventFactory final : public TaskQueueFactory {
  public:
   std::unique_ptr<TaskQueueBase, TaskQueueDeleter> 
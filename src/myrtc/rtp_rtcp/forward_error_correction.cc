@@ -605,22 +605,18 @@ bool ForwardErrorCorrection::FinishPacketRecovery(
 void ForwardErrorCorrection::XorHeaders(const Packet& src, Packet* dst) {
   uint8_t* dst_data = dst->data.data();
   const uint8_t* src_data = src.data.cdata();
-  // XOR the first 2 bytes of the header: V, P, X, CC, M, PT fields.
-  dst_data[0] ^= src_data[0];
-  dst_data[1] ^= src_data[1];
-
-  // XOR the length recovery field.
-  uint8_t src_payload_length_network_order[2];
-  ByteWriter<uint16_t>::WriteBigEndian(src_payload_length_network_order,
+  // The first 2 bytes of the header (V, P, X, CC, M, PT fields), the length
+  // recovery field and the 5th to 8th bytes (the timestamp field) are XORed
+  // as one word.
+  uint8_t src_header[8];
+  memcpy(src_header, src_data, sizeof(src_header));
+  ByteWriter<uint16_t>::WriteBigEndian(&src_header[2],
                                        src.data.size() - kRtpHeaderSize);
-  dst_data[2] ^= src_payload_length_network_order[0];
-  dst_data[3] ^= src_payload_length_network_order[1];
-
-  // XOR the 5th to 8th bytes of the header: the timestamp field.
-  dst_data[4] ^= src_data[4];
-  dst_data[5] ^= src_data[5];
-  dst_data[6] ^= src_data[6];
-  dst_data[7] ^= src_data[7];
+  uint64_t a, b;
+  memcpy(&a, dst_data, sizeof(a));
+  memcpy(&b, src_header, sizeof(b));
+  a ^= b;
+  memcpy(dst_data, &a, sizeof(a));
 
   // Skip the 9th to 12th bytes of the header.
 }
@@ -635,11 +631,8 @@ void ForwardErrorCorrection::XorPayloads(const Packet& src,
   if (dst_offset + payload_length > dst->data.size()) {
     dst->data.SetSize(dst_offset + payload_length);
   }
-  uint8_t* dst_data = dst->data.data();
-  const uint8_t* src_data = src.data.cdata();
-  for (size_t i = 0; i < payload_length; ++i) {
-    dst_data[dst_offset + i] ^= src_data[kRtpHeaderSize + i];
-  }
+  internal::XorBytes(dst->data.data() + dst_offset,
+                     src.data.cdata() + kRtpHeaderSize, payload_length);
 }
 
 bool ForwardErrorCorrection::RecoverPacket(const ReceivedFecPacket& fec_packet,
@@ -14,9 +14,14 @@
 
 #include <algorithm>
 
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+#include <immintrin.h>
+#endif
+
 #include "rtp_rtcp/fec_private_tables_bursty.h"
 #include "rtp_rtcp/fec_private_tables_random.h"
 #include "rtc_base/checks.h"
+#include "rtc_base/cpu_info.h"
 
 namespace {
 // Allow for different modes of protection for packets in UEP case.
@@ -515,5 +520,66 @@ void CopyColumn(uint8_t* new_mask,
   }
 }
 
+void XorBytes_C(uint8_t* dst, const uint8_t* src, size_t length) {
+  size_t i = 0;
+  for (; i + sizeof(uint64_t) <= length; i += sizeof(uint64_t)) {
+    uint64_t a, b;
+    memcpy(&a, dst + i, sizeof(a));
+    memcpy(&b, src + i, sizeof(b));
+    a ^= b;
+    memcpy(dst + i, &a, sizeof(a));
+  }
+  for (; i < length; ++i) {
+    dst[i] ^= src[i];
+  }
+}
+
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+
+void XorBytes_SSE2(uint8_t* dst, const uint8_t* src, size_t length) {
+  size_t i = 0;
+  for (; i + 16 <= length; i += 16) {
+    __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(dst + i));
+    __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_xor_si128(a, b));
+  }
+  XorBytes_C(dst + i, src + i, length - i);
+}
+
+__attribute__((target("avx2")))
+void XorBytes_AVX2(uint8_t* dst, const uint8_t* src, size_t length) {
+  size_t i = 0;
+  for (; i + 32 <= length; i += 32) {
+    __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(dst + i));
+    __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i),
+                        _mm256_xor_si256(a, b));
+  }
+  XorBytes_SSE2(dst + i, src + i, length - i);
+}
+
+#endif  // defined(WEBRTC_ARCH_X86_FAMILY)
+
+namespace {
+
+typedef void (*XorBytesFunc)(uint8_t*, const uint8_t*, size_t);
+
+XorBytesFunc SelectXorBytes() {
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+  if (CpuInfo::Supports(CpuInfo::kAVX2))
+    return XorBytes_AVX2;
+  if (CpuInfo::Supports(CpuInfo::kSSE2))
+    return XorBytes_SSE2;
+#endif
+  return XorBytes_C;
+}
+
+}  // namespace
+
+void XorBytes(uint8_t* dst, const uint8_t* src, size_t length) {
+  static const XorBytesFunc xor_bytes = SelectXorBytes();
+  xor_bytes(dst, src, length);
+}
+
 }  // namespace internal
 }  // namespace webrtc
@@ -14,6 +14,7 @@
 #include <stddef.h>
 #include <stdint.h>
 
+#include "rtc_base/arch.h"
 #include "rtc_base/array_view.h"
 #include "module/module_fec_types.h"
 
@@ -115,6 +116,17 @@ void CopyColumn(uint8_t* new_mask,
                 int new_bit_index,
                 int old_bit_index);
 
+// XORs |length| bytes of |src| into |dst|. An SSE2 or AVX2 kernel is picked
+// on first use, depending on what the CPU supports.
+void XorBytes(uint8_t* dst, const uint8_t* src, size_t length);
+
+// The kernels behind XorBytes(), exposed for tests and benchmarks.
+void XorBytes_C(uint8_t* dst, const uint8_t* src, size_t length);
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+void XorBytes_SSE2(uint8_t* dst, const uint8_t* src, size_t length);
+void XorBytes_AVX2(uint8_t* dst, const uint8_t* src, size_t length);
+#endif
+
 }  // namespace internal
 }  // namespace webrtc
 
@@ -18,7 +18,7 @@
 #include "module/module_common_types_public.h"
 #include "rtp_rtcp/rtp_rtcp_defines.h"
 #include "rtc_base/constructor_magic.h"
-#include "rtc_base/critical_section.h"
+#include "rtc_base/module_lock.h"
 #include "rtc_base/thread_annotations.h"
 
 namespace webrtc {
@@ -56,7 +56,7 @@ class PlayoutDelayOracle : public RtcpAckObserver {
   // The playout delay information is updated from the encoder thread(s).
   // The sequence number feedback is updated from the worker thread.
   // Guards access to data across multiple threads.
-  rtc::CriticalSection crit_sect_;
+  rtc::ModuleLock crit_sect_;
   // The oldest sequence number on which the current playout delay values have
   // been sent. When set, it means we need to attach extension to sent packets.
   std::optional<int64_t> unacked_sequence_number_ RTC_GUARDED_BY(crit_sect_);
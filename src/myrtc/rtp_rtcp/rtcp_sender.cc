@@ -65,7 +65,7 @@ class PacketContainer : public rtcp::CompoundPacket {
     Build(max_payload_length, [&](rtc::ArrayView<const uint8_t> packet) {
       if (transport_->SendRtcp(packet.data(), packet.size())) {
         bytes_sent += packet.size();
-        if (event_log_) {
+        if (event_log_ && event_log_->IsLogging()) {
           event_log_->Log(std::make_unique<RtcEventRtcpPacketOutgoing>(packet));
         }
       }
@@ -1004,7 +1004,7 @@ void RTCPSender::SendCombinedRtcpPacket(
   RTC_DCHECK_LE(max_packet_size, IP_PACKET_SIZE);
   auto callback = [&](rtc::ArrayView<const uint8_t> packet) {
     if (transport_->SendRtcp(packet.data(), packet.size())) {
-      if (event_log_)
+      if (event_log_ && event_log_->IsLogging())
         event_log_->Log(std::make_unique<RtcEventRtcpPacketOutgoing>(packet));
     }
   };
@@ -0,0 +1,238 @@
+/*
+ *  Copyright (c) 2016 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "rtp_rtcp/rtp_header_view.h"
+
+#include <cstring>
+
+#include "rtp_rtcp/byte_io.h"
+#include "rtc_base/logging.h"
+#include "rtc_base/safe_conversions.h"
+
+namespace webrtc {
+namespace {
+constexpr uint8_t kRtpVersion = 2;
+constexpr uint16_t kOneByteExtensionProfileId = 0xBEDE;
+constexpr uint16_t kTwoByteExtensionProfileId = 0x1000;
+constexpr size_t kOneByteExtensionHeaderLength = 1;
+constexpr size_t kTwoByteExtensionHeaderLength = 2;
+
+// FNV-1a, cheap enough for the few dozen bytes of a usual extension block.
+uint32_t Checksum(const uint8_t* data, size_t size) {
+  uint32_t hash = 2166136261u;
+  for (size_t i = 0; i < size; ++i) {
+    hash = (hash ^ data[i]) * 16777619u;
+  }
+  return hash;
+}
+}  // namespace
+
+constexpr size_t RtpHeaderView::kMaxExtensions;
+constexpr size_t RtpHeaderView::kFixedHeaderSize;
+
+size_t RtpHeaderView::ForEachExtension(const uint8_t* buffer,
+                                       size_t headers_size,
+                                       ExtensionVisitor visitor) {
+  if ((buffer[0] & 0x10) == 0) {
+    return 0;
+  }
+  const size_t number_of_crcs = buffer[0] & 0x0f;
+  const size_t profile_offset = kFixedHeaderSize + number_of_crcs * 4;
+  const size_t extension_offset = profile_offset + 4;
+  const size_t extensions_capacity = headers_size - extension_offset;
+  const uint16_t profile =
+      ByteReader<uint16_t>::ReadBigEndian(&buffer[profile_offset]);
+  if (profile != kOneByteExtensionProfileId &&
+      profile != kTwoByteExtensionProfileId) {
+    RTC_LOG(LS_WARNING) << "Unsupported rtp extension " << profile;
+    return 0;
+  }
+  const size_t extension_header_length = profile == kOneByteExtensionProfileId
+                                             ? kOneByteExtensionHeaderLength
+                                             : kTwoByteExtensionHeaderLength;
+  constexpr uint8_t kPaddingByte = 0;
+  constexpr uint8_t kPaddingId = 0;
+  constexpr uint8_t kOneByteHeaderExtensionReservedId = 15;
+  size_t extensions_size = 0;
+  while (extensions_size + extension_header_length < extensions_capacity) {
+    if (buffer[extension_offset + extensions_size] == kPaddingByte) {
+      extensions_size++;
+      continue;
+    }
+    int id;
+    uint8_t length;
+    if (profile == kOneByteExtensionProfileId) {
+      id = buffer[extension_offset + extensions_size] >> 4;
+      length = 1 + (buffer[extension_offset + extensions_size] & 0xf);
+      if (id == kOneByteHeaderExtensionReservedId ||
+          (id == kPaddingId && length != 1)) {
+        break;
+      }
+    } else {
+      id = buffer[extension_offset + extensions_size];
+      length = buffer[extension_offset + extensions_size + 1];
+    }
+
+    if (extensions_size + extension_header_length + length >
+        extensions_capacity) {
+      RTC_LOG(LS_WARNING) << "Oversized rtp header extension.";
+      break;
+    }
+
+    size_t offset =
+        extension_offset + extensions_size + extension_header_length;
+    if (!rtc::IsValueInRangeForNumericType<uint16_t>(offset)) {
+      RTC_DLOG(LS_WARNING) << "Oversized rtp header extension.";
+      break;
+    }
+
+    visitor(id, length, static_cast<uint16_t>(offset));
+    extensions_size += extension_header_length + length;
+  }
+  return extensions_size;
+}
+
+bool RtpHeaderView::Parse(const uint8_t* buffer, size_t size) {
+  Clear();
+  if (size < kFixedHeaderSize) {
+    return false;
+  }
+  const uint8_t version = buffer[0] >> 6;
+  if (version != kRtpVersion) {
+    return false;
+  }
+  const bool has_padding = (buffer[0] & 0x20) != 0;
+  const bool has_extension = (buffer[0] & 0x10) != 0;
+  const uint8_t number_of_crcs = buffer[0] & 0x0f;
+  if (size < kFixedHeaderSize + number_of_crcs * 4) {
+    return false;
+  }
+  size_t payload_offset = kFixedHeaderSize + number_of_crcs * 4;
+
+  uint8_t padding_size = 0;
+  if (has_padding) {
+    padding_size = buffer[size - 1];
+    if (padding_size == 0) {
+      RTC_LOG(LS_WARNING) << "Padding was set, but padding size is zero";
+      return false;
+    }
+  }
+
+  if (has_extension) {
+    /* RTP header extension, RFC 3550.
+     0                   1                   2                   3
+     0 1 2 3 4 5 6 7 8 9 0 1 2 3 4 5 6 7 8 9 0 1 2 3 4 5 6 7 8 9 0 1
+    +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+    |      defined by profile       |           length              |
+    +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+    |                        header extension                       |
+    |                             ....                              |
+    */
+    size_t extension_offset = payload_offset + 4;
+    if (extension_offset > size) {
+      Clear();
+      return false;
+    }
+    size_t extensions_capacity =
+        ByteReader<uint16_t>::ReadBigEndian(&buffer[payload_offset + 2]);
+    extensions_capacity *= 4;
+    if (extension_offset + extensions_capacity > size) {
+      Clear();
+      return false;
+    }
+    payload_offset = extension_offset + extensions_capacity;
+    extensions_size_ = ForEachExtension(
+        buffer, payload_offset, [this](int id, uint8_t length, uint16_t offset) {
+          ExtensionInfo* extension_info = FindOrCreateExtensionInfo(id);
+          if (extension_info == nullptr) {
+            extensions_truncated_ = true;
+            return;
+          }
+          if (extension_info->length != 0) {
+            RTC_LOG(LS_VERBOSE) << "Duplicate rtp header extension id " << id
+                                << ". Overwriting.";
+          }
+          extension_info->offset = offset;
+          extension_info->length = length;
+        });
+  }
+
+  if (payload_offset + padding_size > size) {
+    Clear();
+    return false;
+  }
+  memcpy(fixed_header_, buffer, kFixedHeaderSize);
+  extensions_checksum_ = Checksum(buffer + kFixedHeaderSize,
+                                  payload_offset - kFixedHeaderSize);
+  size_ = size;
+  payload_offset_ = payload_offset;
+  padding_size_ = padding_size;
+  return true;
+}
+
+void RtpHeaderView::Clear() {
+  memset(fixed_header_, 0, kFixedHeaderSize);
+  size_ = 0;
+  payload_offset_ = 0;
+  extensions_size_ = 0;
+  padding_size_ = 0;
+  num_extensions_ = 0;
+  extensions_truncated_ = false;
+  extensions_checksum_ = 0;
+}
+
+bool RtpHeaderView::Matches(const uint8_t* data, size_t size) const {
+  return size_ != 0 && size == size_ &&
+         memcmp(data, fixed_header_, kFixedHeaderSize) == 0 &&
+         Checksum(data + kFixedHeaderSize,
+                  payload_offset_ - kFixedHeaderSize) == extensions_checksum_;
+}
+
+uint16_t RtpHeaderView::SequenceNumber() const {
+  return ByteReader<uint16_t>::ReadBigEndian(&fixed_header_[2]);
+}
+
+uint32_t RtpHeaderView::Timestamp() const {
+  return ByteReader<uint32_t>::ReadBigEndian(&fixed_header_[4]);
+}
+
+uint32_t RtpHeaderView::Ssrc() const {
+  return ByteReader<uint32_t>::ReadBigEndian(&fixed_header_[8]);
+}
+
+rtc::ArrayView<const uint8_t> RtpHeaderView::FindExtension(const uint8_t* data,
+                                                           int id) const {
+  for (size_t i = 0; i < num_extensions_; ++i) {
+    const ExtensionInfo& extension = extensions_[i];
+    if (extension.id == id) {
+      return rtc::MakeArrayView(data + extension.offset, extension.length);
+    }
+  }
+  return nullptr;
+}
+
+RtpHeaderView::ExtensionInfo* RtpHeaderView::FindOrCreateExtensionInfo(
+    int id) {
+  for (size_t i = 0; i < num_extensions_; ++i) {
+    if (extensions_[i].id == id) {
+      return &extensions_[i];
+    }
+  }
+  if (num_extensions_ == kMaxExtensions) {
+    return nullptr;
+  }
+  ExtensionInfo& extension = extensions_[num_extensions_++];
+  extension.id = static_cast<uint8_t>(id);
+  extension.length = 0;
+  extension.offset = 0;
+  return &extension;
+}
+
+}  // namespace webrtc
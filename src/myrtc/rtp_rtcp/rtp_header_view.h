@@ -0,0 +1,118 @@
+/*
+ *  Copyright (c) 2016 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+#ifndef MODULES_RTP_RTCP_SOURCE_RTP_HEADER_VIEW_H_
+#define MODULES_RTP_RTCP_SOURCE_RTP_HEADER_VIEW_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "rtc_base/array_view.h"
+#include "rtc_base/function_view.h"
+#include "rtp_rtcp/rtp_header_extension_map.h"
+
+namespace webrtc {
+
+// Layout of an RTP header, found in a single pass over the packet so that the
+// layers a packet crosses on its way in can share one parse. Only the fixed
+// header and the offsets of the extensions are kept; extension values are
+// decoded when asked for. The view holds no pointer into the packet, so it can
+// travel with copies of the packet bytes.
+class RtpHeaderView {
+ public:
+  // Extensions with more distinct ids than this are left out of the view,
+  // see extensions_truncated().
+  static constexpr size_t kMaxExtensions = 16;
+  static constexpr size_t kFixedHeaderSize = 12;
+
+  struct ExtensionInfo {
+    uint8_t id;
+    uint8_t length;
+    uint16_t offset;  // From the start of the packet.
+  };
+
+  using ExtensionVisitor =
+      rtc::FunctionView<void(int id, uint8_t length, uint16_t offset)>;
+
+  // Walks the extension block of |buffer|, a packet whose headers, up to
+  // |headers_size|, are known to be well formed, calling |visitor| with each
+  // extension in the order they appear, duplicates included. Returns the bytes
+  // used by the extensions, without the trailing padding. This is the one
+  // reader of the one-byte and two-byte extension grammar.
+  static size_t ForEachExtension(const uint8_t* buffer,
+                                 size_t headers_size,
+                                 ExtensionVisitor visitor);
+
+  // Returns false, and leaves the view cleared, if |data| is not a valid RTP
+  // packet.
+  bool Parse(const uint8_t* data, size_t size);
+  void Clear();
+
+  // True if the view was parsed from a packet of |size| bytes with the fixed
+  // header, CSRCs and extension block found at |data|, ie it still describes
+  // that packet. The extension block is compared by checksum.
+  bool Matches(const uint8_t* data, size_t size) const;
+
+  bool Marker() const { return (fixed_header_[1] & 0x80) != 0; }
+  uint8_t PayloadType() const { return fixed_header_[1] & 0x7f; }
+  uint16_t SequenceNumber() const;
+  uint32_t Timestamp() const;
+  uint32_t Ssrc() const;
+
+  size_t size() const { return size_; }
+  size_t headers_size() const { return payload_offset_; }
+  size_t payload_size() const { return size_ - payload_offset_ - padding_size_; }
+  size_t padding_size() const { return padding_size_; }
+  // Bytes used by the extensions, without the trailing zero padding.
+  size_t extensions_size() const { return extensions_size_; }
+
+  rtc::ArrayView<const ExtensionInfo> extensions() const {
+    return rtc::MakeArrayView(extensions_, num_extensions_);
+  }
+  // True if the packet carries more than kMaxExtensions distinct ids, those
+  // past the limit missing from extensions(). Readers needing all of them
+  // walk the packet with ForEachExtension() instead, as RtpPacket does.
+  bool extensions_truncated() const { return extensions_truncated_; }
+
+  // Raw value of extension |id| in |data|, the packet the view describes.
+  // Empty if the packet does not carry it.
+  rtc::ArrayView<const uint8_t> FindExtension(const uint8_t* data,
+                                              int id) const;
+
+  template <typename Extension, typename... Values>
+  bool GetExtension(const uint8_t* data,
+                    const RtpHeaderExtensionMap& extension_map,
+                    Values... values) const {
+    int id = extension_map.GetId(Extension::kId);
+    if (id == RtpHeaderExtensionMap::kInvalidId)
+      return false;
+    rtc::ArrayView<const uint8_t> raw = FindExtension(data, id);
+    if (raw.empty())
+      return false;
+    return Extension::Parse(raw, values...);
+  }
+
+ private:
+  ExtensionInfo* FindOrCreateExtensionInfo(int id);
+
+  uint8_t fixed_header_[kFixedHeaderSize] = {0};
+  size_t size_ = 0;
+  size_t payload_offset_ = 0;
+  size_t extensions_size_ = 0;
+  uint8_t padding_size_ = 0;
+  uint8_t num_extensions_ = 0;
+  bool extensions_truncated_ = false;
+  // Checksum of the bytes between the fixed header and the payload.
+  uint32_t extensions_checksum_ = 0;
+  ExtensionInfo extensions_[kMaxExtensions];
+};
+
+}  // namespace webrtc
+
+#endif  // MODULES_RTP_RTCP_SOURCE_RTP_HEADER_VIEW_H_
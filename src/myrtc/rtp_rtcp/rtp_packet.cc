@@ -99,6 +99,18 @@ bool RtpPacket::Parse(rtc::CopyOnWriteBuffer buffer) {
   return true;
 }
 
+bool RtpPacket::Parse(rtc::CopyOnWriteBuffer buffer,
+                      const RtpHeaderView& header) {
+  if (!header.Matches(buffer.cdata(), buffer.size())) {
+    return Parse(std::move(buffer));
+  }
+  ApplyHeader(buffer.cdata(), header);
+  size_t buffer_size = buffer.size();
+  buffer_ = std::move(buffer);
+  RTC_DCHECK_EQ(size(), buffer_size);
+  return true;
+}
+
 std::vector<uint32_t> RtpPacket::Csrcs() const {
   size_t num_csrc = data()[0] & 0x0F;
   RTC_DCHECK_GE(capacity(), kFixedHeaderSize + num_csrc * 4);
@@ -440,121 +452,44 @@ void RtpPacket::Clear() {
 }
 
 bool RtpPacket::ParseBuffer(const uint8_t* buffer, size_t size) {
-  if (size < kFixedHeaderSize) {
-    return false;
-  }
-  const uint8_t version = buffer[0] >> 6;
-  if (version != kRtpVersion) {
+  RtpHeaderView header;
+  if (!header.Parse(buffer, size)) {
     return false;
   }
-  const bool has_padding = (buffer[0] & 0x20) != 0;
-  const bool has_extension = (buffer[0] & 0x10) != 0;
-  const uint8_t number_of_crcs = buffer[0] & 0x0f;
-  marker_ = (buffer[1] & 0x80) != 0;
-  payload_type_ = buffer[1] & 0x7f;
+  ApplyHeader(buffer, header);
+  return true;
+}
 
-  sequence_number_ = ByteReader<uint16_t>::ReadBigEndian(&buffer[2]);
-  timestamp_ = ByteReader<uint32_t>::ReadBigEndian(&buffer[4]);
-  ssrc_ = ByteReader<uint32_t>::ReadBigEndian(&buffer[8]);
-  if (size < kFixedHeaderSize + number_of_crcs * 4) {
-    return false;
+void RtpPacket::ApplyHeader(const uint8_t* buffer,
+                            const RtpHeaderView& header) {
+  marker_ = header.Marker();
+  payload_type_ = header.PayloadType();
+  sequence_number_ = header.SequenceNumber();
+  timestamp_ = header.Timestamp();
+  ssrc_ = header.Ssrc();
+  payload_offset_ = header.headers_size();
+  padding_size_ = header.padding_size();
+  payload_size_ = header.payload_size();
+  extensions_size_ = header.extensions_size();
+  extension_entries_.clear();
+  if (header.extensions_truncated()) {
+    ParseExtensions(buffer);
+    return;
   }
-  payload_offset_ = kFixedHeaderSize + number_of_crcs * 4;
-
-  if (has_padding) {
-    padding_size_ = buffer[size - 1];
-    if (padding_size_ == 0) {
-      RTC_LOG(LS_WARNING) << "Padding was set, but padding size is zero";
-      return false;
-    }
-  } else {
-    padding_size_ = 0;
+  for (const RtpHeaderView::ExtensionInfo& extension : header.extensions()) {
+    extension_entries_.emplace_back(extension.id, extension.length,
+                                    extension.offset);
   }
+}
 
-  extensions_size_ = 0;
-  extension_entries_.clear();
-  if (has_extension) {
-    /* RTP header extension, RFC 3550.
-     0                   1                   2                   3
-     0 1 2 3 4 5 6 7 8 9 0 1 2 3 4 5 6 7 8 9 0 1 2 3 4 5 6 7 8 9 0 1
-    +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
-    |      defined by profile       |           length              |
-    +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
-    |                        header extension                       |
-    |                             ....                              |
-    */
-    size_t extension_offset = payload_offset_ + 4;
-    if (extension_offset > size) {
-      return false;
-    }
-    uint16_t profile =
-        ByteReader<uint16_t>::ReadBigEndian(&buffer[payload_offset_]);
-    size_t extensions_capacity =
-        ByteReader<uint16_t>::ReadBigEndian(&buffer[payload_offset_ + 2]);
-    extensions_capacity *= 4;
-    if (extension_offset + extensions_capacity > size) {
-      return false;
-    }
-    if (profile != kOneByteExtensionProfileId &&
-        profile != kTwoByteExtensionProfileId) {
-      RTC_LOG(LS_WARNING) << "Unsupported rtp extension " << profile;
-    } else {
-      size_t extension_header_length = profile == kOneByteExtensionProfileId
-                                           ? kOneByteExtensionHeaderLength
-                                           : kTwoByteExtensionHeaderLength;
-      constexpr uint8_t kPaddingByte = 0;
-      constexpr uint8_t kPaddingId = 0;
-      constexpr uint8_t kOneByteHeaderExtensionReservedId = 15;
-      while (extensions_size_ + extension_header_length < extensions_capacity) {
-        if (buffer[extension_offset + extensions_size_] == kPaddingByte) {
-          extensions_size_++;
-          continue;
-        }
-        int id;
-        uint8_t length;
-        if (profile == kOneByteExtensionProfileId) {
-          id = buffer[extension_offset + extensions_size_] >> 4;
-          length = 1 + (buffer[extension_offset + extensions_size_] & 0xf);
-          if (id == kOneByteHeaderExtensionReservedId ||
-              (id == kPaddingId && length != 1)) {
-            break;
-          }
-        } else {
-          id = buffer[extension_offset + extensions_size_];
-          length = buffer[extension_offset + extensions_size_ + 1];
-        }
-
-        if (extensions_size_ + extension_header_length + length >
-            extensions_capacity) {
-          RTC_LOG(LS_WARNING) << "Oversized rtp header extension.";
-          break;
-        }
-
+void RtpPacket::ParseExtensions(const uint8_t* buffer) {
+  size_t extensions_size = RtpHeaderView::ForEachExtension(
+      buffer, payload_offset_, [this](int id, uint8_t length, uint16_t offset) {
         ExtensionInfo& extension_info = FindOrCreateExtensionInfo(id);
-        if (extension_info.length != 0) {
-          RTC_LOG(LS_VERBOSE)
-              << "Duplicate rtp header extension id " << id << ". Overwriting.";
-        }
-
-        size_t offset =
-            extension_offset + extensions_size_ + extension_header_length;
-        if (!rtc::IsValueInRangeForNumericType<uint16_t>(offset)) {
-          RTC_DLOG(LS_WARNING) << "Oversized rtp header extension.";
-          break;
-        }
-        extension_info.offset = static_cast<uint16_t>(offset);
+        extension_info.offset = offset;
         extension_info.length = length;
-        extensions_size_ += extension_header_length + length;
-      }
-    }
-    payload_offset_ = extension_offset + extensions_capacity;
-  }
-
-  if (payload_offset_ + padding_size_ > size) {
-    return false;
-  }
-  payload_size_ = size - payload_offset_ - padding_size_;
-  return true;
+      });
+  RTC_DCHECK_EQ(extensions_size, extensions_size_);
 }
 
 const RtpPacket::ExtensionInfo* RtpPacket::FindExtensionInfo(int id) const {
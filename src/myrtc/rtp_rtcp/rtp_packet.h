@@ -14,8 +14,10 @@
 #include <vector>
 
 #include "optional"
+#include "absl/container/inlined_vector.h"
 #include "rtc_base/array_view.h"
 #include "rtp_rtcp/rtp_header_extension_map.h"
+#include "rtp_rtcp/rtp_header_view.h"
 #include "rtp_rtcp/rtp_rtcp_defines.h"
 #include "rtc_base/copy_on_write_buffer.h"
 
@@ -48,6 +50,10 @@ class RtpPacket {
   // Parse and move given buffer into Packet.
   bool Parse(rtc::CopyOnWriteBuffer packet);
 
+  // Move given buffer into Packet, taking its layout from |header| when that
+  // was parsed from the same bytes instead of parsing them again.
+  bool Parse(rtc::CopyOnWriteBuffer packet, const RtpHeaderView& header);
+
   // Maps extensions id to their types.
   void IdentifyExtensions(const ExtensionManager& extensions);
 
@@ -160,6 +166,11 @@ class RtpPacket {
   // Helper function for Parse. Fill header fields using data in given buffer,
   // but does not touch packet own buffer, leaving packet in invalid state.
   bool ParseBuffer(const uint8_t* buffer, size_t size);
+  // Fills header fields from |header|, parsed from |buffer|.
+  void ApplyHeader(const uint8_t* buffer, const RtpHeaderView& header);
+  // Fills extension_entries_ walking the extension block of |buffer|, whose
+  // layout is already checked. Used when the header view was truncated.
+  void ParseExtensions(const uint8_t* buffer);
 
   // Returns pointer to extension info for a given id. Returns nullptr if not
   // found.
@@ -194,7 +205,8 @@ class RtpPacket {
   size_t payload_size_;
 
   ExtensionManager extensions_;
-  std::vector<ExtensionInfo> extension_entries_;
+  // Packets rarely carry more extensions than fit inline.
+  absl::InlinedVector<ExtensionInfo, 8> extension_entries_;
   size_t extensions_size_ = 0;  // Unaligned.
   rtc::CopyOnWriteBuffer buffer_;
 };
@@ -33,8 +33,11 @@ RtpPacketHistory::PacketState::PacketState() = default;
 RtpPacketHistory::PacketState::PacketState(const PacketState&) = default;
 RtpPacketHistory::PacketState::~PacketState() = default;
 
+RtpPacketHistory::StoredPacket::StoredPacket()
+    : pending_transmission_(false), insert_order_(0), times_retransmitted_(0) {}
+
 RtpPacketHistory::StoredPacket::StoredPacket(
-    std::unique_ptr<RtpPacketToSend> packet,
+    RtpPacketToSend packet,
     std::optional<int64_t> send_time_ms,
     uint64_t insert_order)
     : send_time_ms_(send_time_ms),
@@ -51,37 +54,47 @@ RtpPacketHistory::StoredPacket& RtpPacketHistory::StoredPacket::operator=(
     RtpPacketHistory::StoredPacket&&) = default;
 RtpPacketHistory::StoredPacket::~StoredPacket() = default;
 
+RtpPacketHistory::PaddingEntry RtpPacketHistory::StoredPacket::padding_entry()
+    const {
+  return {times_retransmitted_, insert_order_, packet_->SequenceNumber()};
+}
+
 void RtpPacketHistory::StoredPacket::IncrementTimesRetransmitted(
     PacketPrioritySet* priority_set) {
+  if (!priority_set) {
+    ++times_retransmitted_;
+    return;
+  }
   // Check if this StoredPacket is in the priority set. If so, we need to remove
   // it before updating |times_retransmitted_| since that is used in sorting,
   // and then add it back.
-  const bool in_priority_set = priority_set->erase(this) > 0;
+  const bool in_priority_set = priority_set->erase(padding_entry()) > 0;
   ++times_retransmitted_;
   if (in_priority_set) {
-    auto it = priority_set->insert(this);
+    auto it = priority_set->insert(padding_entry());
     RTC_DCHECK(it.second)
         << "ERROR: Priority set already contains matching packet! In set: "
            "insert order = "
-        << (*it.first)->insert_order_
-        << ", times retransmitted = " << (*it.first)->times_retransmitted_
+        << it.first->insert_order
+        << ", times retransmitted = " << it.first->times_retransmitted
         << ". Trying to add: insert order = " << insert_order_
         << ", times retransmitted = " << times_retransmitted_;
   }
 }
 
-bool RtpPacketHistory::MoreUseful::operator()(StoredPacket* lhs,
-                                              StoredPacket* rhs) const {
+bool RtpPacketHistory::MoreUseful::operator()(const PaddingEntry& lhs,
+                                              const PaddingEntry& rhs) const {
   // Prefer to send packets we haven't already sent as padding.
-  if (lhs->times_retransmitted() != rhs->times_retransmitted()) {
-    return lhs->times_retransmitted() < rhs->times_retransmitted();
+  if (lhs.times_retransmitted != rhs.times_retransmitted) {
+    return lhs.times_retransmitted < rhs.times_retransmitted;
   }
   // All else being equal, prefer newer packets.
-  return lhs->insert_order() > rhs->insert_order();
+  return lhs.insert_order > rhs.insert_order;
 }
 
-RtpPacketHistory::RtpPacketHistory(Clock* clock)
+RtpPacketHistory::RtpPacketHistory(Clock* clock, bool enable_padding_prio)
     : clock_(clock),
+      enable_padding_prio_(enable_padding_prio),
       number_to_store_(0),
       mode_(StorageMode::kDisabled),
       rtt_ms_(-1),
@@ -92,7 +105,7 @@ RtpPacketHistory::~RtpPacketHistory() {}
 void RtpPacketHistory::SetStorePacketsStatus(StorageMode mode,
                                              size_t number_to_store) {
   RTC_DCHECK_LE(number_to_store, kMaxCapacity);
-  rtc::CritScope cs(&lock_);
+  rtc::ModuleLockScope cs(&lock_);
   if (mode != StorageMode::kDisabled && mode_ != StorageMode::kDisabled) {
     RTC_LOG(LS_WARNING) << "Purging packet history in order to re-set status.";
   }
@@ -102,12 +115,12 @@ void RtpPacketHistory::SetStorePacketsStatus(StorageMode mode,
 }
 
 RtpPacketHistory::StorageMode RtpPacketHistory::GetStorageMode() const {
-  rtc::CritScope cs(&lock_);
+  rtc::ModuleLockScope cs(&lock_);
   return mode_;
 }
 
 void RtpPacketHistory::SetRtt(int64_t rtt_ms) {
-  rtc::CritScope cs(&lock_);
+  rtc::ModuleLockScope cs(&lock_);
   RTC_DCHECK_GE(rtt_ms, 0);
   rtt_ms_ = rtt_ms;
   // If storage is not disabled,  packets will be removed after a timeout
@@ -121,21 +134,26 @@ void RtpPacketHistory::SetRtt(int64_t rtt_ms) {
 void RtpPacketHistory::PutRtpPacket(std::unique_ptr<RtpPacketToSend> packet,
                                     std::optional<int64_t> send_time_ms) {
   RTC_DCHECK(packet);
-  rtc::CritScope cs(&lock_);
+  PutRtpPacket(std::move(*packet), send_time_ms);
+}
+
+void RtpPacketHistory::PutRtpPacket(RtpPacketToSend packet,
+                                    std::optional<int64_t> send_time_ms) {
+  rtc::ModuleLockScope cs(&lock_);
   int64_t now_ms = clock_->TimeInMilliseconds();
   if (mode_ == StorageMode::kDisabled) {
     return;
   }
 
-  RTC_DCHECK(packet->allow_retransmission());
+  RTC_DCHECK(packet.allow_retransmission());
   CullOldPackets(now_ms);
 
   // Store packet.
-  const uint16_t rtp_seq_no = packet->SequenceNumber();
+  const uint16_t rtp_seq_no = packet.SequenceNumber();
   int packet_index = GetPacketIndex(rtp_seq_no);
   if (packet_index >= 0u &&
       static_cast<size_t>(packet_index) < packet_history_.size() &&
-      packet_history_[packet_index].packet_ != nullptr) {
+      packet_history_[packet_index].packet_) {
     RTC_LOG(LS_WARNING) << "Duplicate packet inserted: " << rtp_seq_no;
     // Remove previous packet to avoid inconsistent state.
     RemovePacket(packet_index);
@@ -144,30 +162,34 @@ void RtpPacketHistory::PutRtpPacket(std::unique_ptr<RtpPacketToSend> packet,
 
   // Packet to be inserted ahead of first packet, expand front.
   for (; packet_index < 0; ++packet_index) {
-    packet_history_.emplace_front(nullptr, std::nullopt, 0);
+    packet_history_.push_front(StoredPacket());
   }
   // Packet to be inserted behind last packet, expand back.
   while (static_cast<int>(packet_history_.size()) <= packet_index) {
-    packet_history_.emplace_back(nullptr, std::nullopt, 0);
+    packet_history_.push_back(StoredPacket());
   }
 
   RTC_DCHECK_GE(packet_index, 0);
   RTC_DCHECK_LT(packet_index, packet_history_.size());
-  RTC_DCHECK(packet_history_[packet_index].packet_ == nullptr);
+  RTC_DCHECK(!packet_history_[packet_index].packet_);
 
-  packet_history_[packet_index] =
+  StoredPacket& stored_packet = packet_history_[packet_index];
+  stored_packet =
       StoredPacket(std::move(packet), send_time_ms, packets_inserted_++);
 
+  if (!enable_padding_prio_) {
+    return;
+  }
   if (padding_priority_.size() >= kMaxPaddingtHistory - 1) {
     padding_priority_.erase(std::prev(padding_priority_.end()));
   }
-  auto prio_it = padding_priority_.insert(&packet_history_[packet_index]);
+  auto prio_it = padding_priority_.insert(stored_packet.padding_entry());
   RTC_DCHECK(prio_it.second) << "Failed to insert packet into prio set.";
 }
 
 std::unique_ptr<RtpPacketToSend> RtpPacketHistory::GetPacketAndSetSendTime(
     uint16_t sequence_number) {
-  rtc::CritScope cs(&lock_);
+  rtc::ModuleLockScope cs(&lock_);
   if (mode_ == StorageMode::kDisabled) {
     return nullptr;
   }
@@ -183,7 +205,8 @@ std::unique_ptr<RtpPacketToSend> RtpPacketHistory::GetPacketAndSetSendTime(
   }
 
   if (packet->send_time_ms_) {
-    packet->IncrementTimesRetransmitted(&padding_priority_);
+    packet->IncrementTimesRetransmitted(
+        enable_padding_prio_ ? &padding_priority_ : nullptr);
   }
 
   // Update send-time and mark as no long in pacer queue.
@@ -206,7 +229,7 @@ std::unique_ptr<RtpPacketToSend> RtpPacketHistory::GetPacketAndMarkAsPending(
     uint16_t sequence_number,
     rtc::FunctionView<std::unique_ptr<RtpPacketToSend>(const RtpPacketToSend&)>
         encapsulate) {
-  rtc::CritScope cs(&lock_);
+  rtc::ModuleLockScope cs(&lock_);
   if (mode_ == StorageMode::kDisabled) {
     return nullptr;
   }
@@ -237,7 +260,7 @@ std::unique_ptr<RtpPacketToSend> RtpPacketHistory::GetPacketAndMarkAsPending(
 }
 
 void RtpPacketHistory::MarkPacketAsSent(uint16_t sequence_number) {
-  rtc::CritScope cs(&lock_);
+  rtc::ModuleLockScope cs(&lock_);
   if (mode_ == StorageMode::kDisabled) {
     return;
   }
@@ -253,12 +276,13 @@ void RtpPacketHistory::MarkPacketAsSent(uint16_t sequence_number) {
   // transmission count.
   packet->send_time_ms_ = clock_->TimeInMilliseconds();
   packet->pending_transmission_ = false;
-  packet->IncrementTimesRetransmitted(&padding_priority_);
+  packet->IncrementTimesRetransmitted(
+      enable_padding_prio_ ? &padding_priority_ : nullptr);
 }
 
 std::optional<RtpPacketHistory::PacketState> RtpPacketHistory::GetPacketState(
     uint16_t sequence_number) const {
-  rtc::CritScope cs(&lock_);
+  rtc::ModuleLockScope cs(&lock_);
   if (mode_ == StorageMode::kDisabled) {
     return std::nullopt;
   }
@@ -269,7 +293,7 @@ std::optional<RtpPacketHistory::PacketState> RtpPacketHistory::GetPacketState(
     return std::nullopt;
   }
   const StoredPacket& packet = packet_history_[packet_index];
-  if (packet.packet_ == nullptr) {
+  if (!packet.packet_) {
     return std::nullopt;
   }
 
@@ -306,13 +330,30 @@ std::unique_ptr<RtpPacketToSend> RtpPacketHistory::GetPayloadPaddingPacket() {
 std::unique_ptr<RtpPacketToSend> RtpPacketHistory::GetPayloadPaddingPacket(
     rtc::FunctionView<std::unique_ptr<RtpPacketToSend>(const RtpPacketToSend&)>
         encapsulate) {
-  rtc::CritScope cs(&lock_);
-  if (mode_ == StorageMode::kDisabled || padding_priority_.empty()) {
+  rtc::ModuleLockScope cs(&lock_);
+  if (mode_ == StorageMode::kDisabled) {
     return nullptr;
   }
 
-  auto best_packet_it = padding_priority_.begin();
-  StoredPacket* best_packet = *best_packet_it;
+  StoredPacket* best_packet = nullptr;
+  if (enable_padding_prio_) {
+    if (padding_priority_.empty()) {
+      return nullptr;
+    }
+    best_packet =
+        GetStoredPacket(padding_priority_.begin()->sequence_number);
+  } else {
+    // Without the priority index, resend the newest packet.
+    for (size_t i = packet_history_.size(); i > 0; --i) {
+      if (packet_history_[i - 1].packet_) {
+        best_packet = &packet_history_[i - 1];
+        break;
+      }
+    }
+  }
+  if (best_packet == nullptr) {
+    return nullptr;
+  }
   if (best_packet->pending_transmission_) {
     // Because PacedSender releases it's lock when it calls
     // GeneratePadding() there is the potential for a race where a new
@@ -328,14 +369,15 @@ std::unique_ptr<RtpPacketToSend> RtpPacketHistory::GetPayloadPaddingPacket(
   }
 
   best_packet->send_time_ms_ = clock_->TimeInMilliseconds();
-  best_packet->IncrementTimesRetransmitted(&padding_priority_);
+  best_packet->IncrementTimesRetransmitted(
+      enable_padding_prio_ ? &padding_priority_ : nullptr);
 
   return padding_packet;
 }
 
 void RtpPacketHistory::CullAcknowledgedPackets(
     rtc::ArrayView<const uint16_t> sequence_numbers) {
-  rtc::CritScope cs(&lock_);
+  rtc::ModuleLockScope cs(&lock_);
   for (uint16_t sequence_number : sequence_numbers) {
     int packet_index = GetPacketIndex(sequence_number);
     if (packet_index < 0 ||
@@ -347,7 +389,7 @@ void RtpPacketHistory::CullAcknowledgedPackets(
 }
 
 bool RtpPacketHistory::SetPendingTransmission(uint16_t sequence_number) {
-  rtc::CritScope cs(&lock_);
+  rtc::ModuleLockScope cs(&lock_);
   if (mode_ == StorageMode::kDisabled) {
     return false;
   }
@@ -362,7 +404,7 @@ bool RtpPacketHistory::SetPendingTransmission(uint16_t sequence_number) {
 }
 
 void RtpPacketHistory::Clear() {
-  rtc::CritScope cs(&lock_);
+  rtc::ModuleLockScope cs(&lock_);
   Reset();
 }
 
@@ -407,23 +449,23 @@ void RtpPacketHistory::CullOldPackets(int64_t now_ms) {
   }
 }
 
-std::unique_ptr<RtpPacketToSend> RtpPacketHistory::RemovePacket(
-    int packet_index) {
-  // Move the packet out from the StoredPacket container.
-  std::unique_ptr<RtpPacketToSend> rtp_packet =
-      std::move(packet_history_[packet_index].packet_);
+void RtpPacketHistory::RemovePacket(int packet_index) {
+  StoredPacket& stored_packet = packet_history_[packet_index];
+  if (!stored_packet.packet_) {
+    return;
+  }
 
   // Erase from padding priority set, if eligible.
-  padding_priority_.erase(&packet_history_[packet_index]);
+  if (enable_padding_prio_) {
+    padding_priority_.erase(stored_packet.padding_entry());
+  }
+  stored_packet.packet_.reset();
 
   if (packet_index == 0) {
-    while (!packet_history_.empty() &&
-           packet_history_.front().packet_ == nullptr) {
+    while (!packet_history_.empty() && !packet_history_.front().packet_) {
       packet_history_.pop_front();
     }
   }
-
-  return rtp_packet;
 }
 
 int RtpPacketHistory::GetPacketIndex(uint16_t sequence_number) const {
@@ -431,7 +473,7 @@ int RtpPacketHistory::GetPacketIndex(uint16_t sequence_number) const {
     return 0;
   }
 
-  RTC_DCHECK(packet_history_.front().packet_ != nullptr);
+  RTC_DCHECK(packet_history_.front().packet_);
   int first_seq = packet_history_.front().packet_->SequenceNumber();
   if (first_seq == sequence_number) {
     return 0;
@@ -456,7 +498,8 @@ int RtpPacketHistory::GetPacketIndex(uint16_t sequence_number) const {
 RtpPacketHistory::StoredPacket* RtpPacketHistory::GetStoredPacket(
     uint16_t sequence_number) {
   int index = GetPacketIndex(sequence_number);
-  if (index < 0 || static_cast<size_t>(index) >= packet_history_.size()) {
+  if (index < 0 || static_cast<size_t>(index) >= packet_history_.size() ||
+      !packet_history_[index].packet_) {
     return nullptr;
   }
   return &packet_history_[index];
@@ -11,22 +11,22 @@
 #ifndef MODULES_RTP_RTCP_SOURCE_RTP_PACKET_HISTORY_H_
 #define MODULES_RTP_RTCP_SOURCE_RTP_PACKET_HISTORY_H_
 
-#include <deque>
-#include <map>
 #include <memory>
+#include <optional>
 #include <set>
 #include <vector>
 
 #include "rtc_base/function_view.h"
+#include "rtp_rtcp/rtp_packet_to_send.h"
 #include "rtp_rtcp/rtp_rtcp_defines.h"
 #include "rtc_base/constructor_magic.h"
-#include "rtc_base/critical_section.h"
+#include "rtc_base/module_lock.h"
+#include "rtc_base/ring_buffer.h"
 #include "rtc_base/thread_annotations.h"
 
 namespace webrtc {
 
 class Clock;
-class RtpPacketToSend;
 
 class RtpPacketHistory {
  public:
@@ -62,7 +62,9 @@ class RtpPacketHistory {
   // With kStoreAndCull, always remove packets after 3x max(1000ms, 3x rtt).
   static constexpr int kPacketCullingDelayFactor = 3;
 
-  explicit RtpPacketHistory(Clock* clock);
+  // Without |enable_padding_prio| no padding priority index is kept, and
+  // GetPayloadPaddingPacket() returns the newest packet in the history.
+  RtpPacketHistory(Clock* clock, bool enable_padding_prio);
   ~RtpPacketHistory();
 
   // Set/get storage mode. Note that setting the state will clear the history,
@@ -78,6 +80,10 @@ class RtpPacketHistory {
   // be set accordingly.
   void PutRtpPacket(std::unique_ptr<RtpPacketToSend> packet,
                     std::optional<int64_t> send_time_ms);
+  // Same as above, but the packet is copied or moved straight into its slot
+  // in the history.
+  void PutRtpPacket(RtpPacketToSend packet,
+                    std::optional<int64_t> send_time_ms);
 
   // Gets stored RTP packet corresponding to the input |sequence number|.
   // Returns nullptr if packet is not found or was (re)sent too recently.
@@ -136,13 +142,22 @@ class RtpPacketHistory {
   void Clear();
 
  private:
-  struct MoreUseful;
-  class StoredPacket;
-  using PacketPrioritySet = std::set<StoredPacket*, MoreUseful>;
+  // Entry of the padding priority set. Slots of |packet_history_| move when it
+  // grows, so entries name their packet by sequence number.
+  struct PaddingEntry {
+    size_t times_retransmitted;
+    uint64_t insert_order;
+    uint16_t sequence_number;
+  };
+  struct MoreUseful {
+    bool operator()(const PaddingEntry& lhs, const PaddingEntry& rhs) const;
+  };
+  using PacketPrioritySet = std::set<PaddingEntry, MoreUseful>;
 
   class StoredPacket {
    public:
-    StoredPacket(std::unique_ptr<RtpPacketToSend> packet,
+    StoredPacket();
+    StoredPacket(RtpPacketToSend packet,
                  std::optional<int64_t> send_time_ms,
                  uint64_t insert_order);
     StoredPacket(StoredPacket&&);
@@ -151,13 +166,16 @@ class RtpPacketHistory {
 
     uint64_t insert_order() const { return insert_order_; }
     size_t times_retransmitted() const { return times_retransmitted_; }
+    PaddingEntry padding_entry() const;
+    // |priority_set| is null when the padding priority index is disabled.
     void IncrementTimesRetransmitted(PacketPrioritySet* priority_set);
 
     // The time of last transmission, including retransmissions.
     std::optional<int64_t> send_time_ms_;
 
-    // The actual packet.
-    std::unique_ptr<RtpPacketToSend> packet_;
+    // The actual packet, held in the slot itself. Empty for slots whose packet
+    // has been removed out of order.
+    std::optional<RtpPacketToSend> packet_;
 
     // True if the packet is currently in the pacer queue pending transmission.
     bool pending_transmission_;
@@ -170,10 +188,6 @@ class RtpPacketHistory {
     // Number of times RE-transmitted, ie excluding the first transmission.
     size_t times_retransmitted_;
   };
-  struct MoreUseful {
-    bool operator()(StoredPacket* lhs, StoredPacket* rhs) const;
-  };
-
   // Helper method used by GetPacketAndSetSendTime() and GetPacketState() to
   // check if packet has too recently been sent.
   bool VerifyRtt(const StoredPacket& packet, int64_t now_ms) const
@@ -181,9 +195,8 @@ class RtpPacketHistory {
   void Reset() RTC_EXCLUSIVE_LOCKS_REQUIRED(lock_);
   void CullOldPackets(int64_t now_ms) RTC_EXCLUSIVE_LOCKS_REQUIRED(lock_);
   // Removes the packet from the history, and context/mapping that has been
-  // stored. Returns the RTP packet instance contained within the StoredPacket.
-  std::unique_ptr<RtpPacketToSend> RemovePacket(int packet_index)
-      RTC_EXCLUSIVE_LOCKS_REQUIRED(lock_);
+  // stored.
+  void RemovePacket(int packet_index) RTC_EXCLUSIVE_LOCKS_REQUIRED(lock_);
   int GetPacketIndex(uint16_t sequence_number) const
       RTC_EXCLUSIVE_LOCKS_REQUIRED(lock_);
   StoredPacket* GetStoredPacket(uint16_t sequence_number)
@@ -192,23 +205,25 @@ class RtpPacketHistory {
       const StoredPacket& stored_packet);
 
   Clock* const clock_;
-  rtc::CriticalSection lock_;
+  const bool enable_padding_prio_;
+  rtc::ModuleLock lock_;
   size_t number_to_store_ RTC_GUARDED_BY(lock_);
   StorageMode mode_ RTC_GUARDED_BY(lock_);
   int64_t rtt_ms_ RTC_GUARDED_BY(lock_);
 
-  // Queue of stored packets, ordered by sequence number, with older packets in
-  // the front and new packets being added to the back. Note that there may be
+  // Ring of stored packets, ordered by sequence number, with older packets in
+  // the front and new packets being added to the back, so a packet's slot is
+  // its sequence number's distance from the front. Note that there may be
   // wrap-arounds so the back may have a lower sequence number.
   // Packets may also be removed out-of-order, in which case there will be
-  // instances of StoredPacket with |packet_| set to nullptr. The first and last
-  // entry in the queue will however always be populated.
-  std::deque<StoredPacket> packet_history_ RTC_GUARDED_BY(lock_);
+  // instances of StoredPacket with an empty |packet_|. The first entry in the
+  // ring will however always be populated.
+  rtc::RingBuffer<StoredPacket> packet_history_ RTC_GUARDED_BY(lock_);
 
   // Total number of packets with inserted.
   uint64_t packets_inserted_ RTC_GUARDED_BY(lock_);
   // Objects from |packet_history_| ordered by "most likely to be useful", used
-  // in GetPayloadPaddingPacket().
+  // in GetPayloadPaddingPacket(). Unused without |enable_padding_prio_|.
   PacketPrioritySet padding_priority_ RTC_GUARDED_BY(lock_);
 
   RTC_DISALLOW_IMPLICIT_CONSTRUCTORS(RtpPacketHistory);
@@ -117,6 +117,10 @@ class RtpRtcp : public Module, public RtcpFeedbackSenderInterface {
     // Corresponds to extmap-allow-mixed in SDP negotiation.
     bool extmap_allow_mixed = false;
 
+    // Keep the packet history's padding priority index. Without it, RTX
+    // payload padding resends the newest packet.
+    bool enable_padding_prio = true;
+
     // If set, field trials are read from |field_trials|, otherwise
     // defaults to  webrtc::FieldTrialBasedConfig.
     const WebRtcKeyValueConfig* field_trials = nullptr;
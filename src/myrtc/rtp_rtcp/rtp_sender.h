@@ -30,8 +30,8 @@
 #include "rtp_rtcp/rtp_packet_history.h"
 #include "rtp_rtcp/rtp_rtcp_config.h"
 #include "rtc_base/constructor_magic.h"
-#include "rtc_base/critical_section.h"
 #include "rtc_base/deprecation.h"
+#include "rtc_base/module_lock.h"
 #include "rtc_base/random.h"
 #include "rtc_base/rate_statistics.h"
 #include "rtc_base/thread_annotations.h"
@@ -226,7 +226,7 @@ class RTPSender {
   const std::unique_ptr<NonPacedPacketSender> non_paced_packet_sender_;
   RtpPacketSender* const paced_sender_;
   TransportFeedbackObserver* const transport_feedback_observer_;
-  rtc::CriticalSection send_critsect_;
+  rtc::ModuleLock send_critsect_;
 
   Transport* transport_;
   bool sending_media_ RTC_GUARDED_BY(send_critsect_);
@@ -241,7 +241,7 @@ class RTPSender {
   RtpPacketHistory packet_history_;
 
   // Statistics
-  rtc::CriticalSection statistics_crit_;
+  rtc::ModuleLock statistics_crit_;
   SendDelayMap send_delays_ RTC_GUARDED_BY(statistics_crit_);
   SendDelayMap::const_iterator max_delay_it_ RTC_GUARDED_BY(statistics_crit_);
   // The sum of delays over a kSendSideDelayWindowMs sliding window.
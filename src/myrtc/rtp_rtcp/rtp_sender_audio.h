@@ -21,7 +21,7 @@
 #include "rtp_rtcp/dtmf_queue.h"
 #include "rtp_rtcp/rtp_sender.h"
 #include "rtc_base/constructor_magic.h"
-#include "rtc_base/critical_section.h"
+#include "rtc_base/module_lock.h"
 #include "rtc_base/one_time_event.h"
 #include "rtc_base/thread_annotations.h"
 #include "rtc_base/clock.h"
@@ -68,7 +68,7 @@ class RTPSenderAudio {
   Clock* const clock_ = nullptr;
   RTPSender* const rtp_sender_ = nullptr;
 
-  rtc::CriticalSection send_audio_critsect_;
+  rtc::ModuleLock send_audio_critsect_;
 
   // DTMF.
   bool dtmf_event_is_on_ = false;
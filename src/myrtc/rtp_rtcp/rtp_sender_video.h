@@ -28,7 +28,7 @@
 #include "rtp_rtcp/rtp_sequence_number_map.h"
 #include "rtp_rtcp/rtp_video_header.h"
 #include "rtp_rtcp/ulpfec_generator.h"
-#include "rtc_base/critical_section.h"
+#include "rtc_base/module_lock.h"
 #include "rtc_base/one_time_event.h"
 #include "rtc_base/race_checker.h"
 #include "rtc_base/rate_statistics.h"
@@ -189,7 +189,7 @@ class RTPSenderVideo {
   PlayoutDelayOracle* const playout_delay_oracle_;
 
   // Should never be held when calling out of this class.
-  rtc::CriticalSection crit_;
+  rtc::ModuleLock crit_;
 
   // Maps sent packets' sequence numbers to a tuple consisting of:
   // 1. The timestamp, without the randomizing offset mandated by the RFC.
@@ -210,7 +210,7 @@ class RTPSenderVideo {
   FecProtectionParams delta_fec_params_ RTC_GUARDED_BY(crit_);
   FecProtectionParams key_fec_params_ RTC_GUARDED_BY(crit_);
 
-  rtc::CriticalSection stats_crit_;
+  rtc::ModuleLock stats_crit_;
   // Bitrate used for FEC payload, RED headers, RTP headers for FEC packets
   // and any padding overhead.
   RateStatistics fec_bitrate_ RTC_GUARDED_BY(stats_crit_);
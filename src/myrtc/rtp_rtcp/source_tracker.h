@@ -20,7 +20,7 @@
 #include "optional"
 #include "api/rtp_packet_infos.h"
 #include "api/rtp_source.h"
-#include "rtc_base/critical_section.h"
+#include "rtc_base/module_lock.h"
 #include "rtc_base/time_utils.h"
 #include "rtc_base/clock.h"
 
@@ -111,7 +111,7 @@ class SourceTracker {
   void PruneEntries(int64_t now_ms) const RTC_EXCLUSIVE_LOCKS_REQUIRED(lock_);
 
   Clock* const clock_;
-  rtc::CriticalSection lock_;
+  rtc::ModuleLock lock_;
 
   // Entries are stored in reverse chronological order (i.e. with the most
   // recently updated entries appearing first). Mutability is needed for timeout
@@ -42,7 +42,7 @@ UlpfecReceiverImpl::~UlpfecReceiverImpl() {
 }
 
 FecPacketCounter UlpfecReceiverImpl::GetPacketCounter() const {
-  rtc::CritScope cs(&crit_sect_);
+  rtc::ModuleLockScope cs(&crit_sect_);
   return packet_counter_;
 }
 
@@ -86,7 +86,7 @@ bool UlpfecReceiverImpl::AddReceivedRedPacket(const RtpPacket& rtp_packet,
                            "packet size; dropping.";
     return false;
   }
-  rtc::CritScope cs(&crit_sect_);
+  rtc::ModuleLockScope cs(&crit_sect_);
 
   static constexpr uint8_t kRedHeaderLength = 1;
 
@@ -22,7 +22,7 @@
 #include "rtp_rtcp/ulpfec_receiver.h"
 #include "rtp_rtcp/forward_error_correction.h"
 #include "rtp_rtcp/rtp_packet.h"
-#include "rtc_base/critical_section.h"
+#include "rtc_base/module_lock.h"
 
 namespace webrtc {
 
@@ -44,7 +44,7 @@ class UlpfecReceiverImpl : public UlpfecReceiver {
   const uint32_t ssrc_;
   const RtpHeaderExtensionMap extensions_;
 
-  rtc::CriticalSection crit_sect_;
+  rtc::ModuleLock crit_sect_;
   RecoveredPacketReceiver* recovered_packet_callback_;
   std::unique_ptr<ForwardErrorCorrection> fec_;
   // TODO(nisse): The AddReceivedRedPacket method adds one or two packets to
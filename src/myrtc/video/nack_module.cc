@@ -41,16 +41,45 @@ int64_t GetSendNackDelay() {
   }
   return kDefaultSendNackDelayMs;
 }
+
+// Inserts |seq_num| into |list|, sorted oldest first, unless already there.
+void InsertSeqNum(std::vector<uint16_t>* list, uint16_t seq_num) {
+  if (list->empty() || AheadOf(seq_num, list->back())) {
+    list->push_back(seq_num);
+    return;
+  }
+  auto it = std::lower_bound(list->begin(), list->end(), seq_num,
+                             DescendingSeqNumComp<uint16_t>());
+  if (it == list->end() || *it != seq_num)
+    list->insert(it, seq_num);
+}
+
+// Removes the sequence numbers older than |seq_num| from |list|.
+void EraseSeqNumsBefore(std::vector<uint16_t>* list, uint16_t seq_num) {
+  list->erase(list->begin(),
+              std::lower_bound(list->begin(), list->end(), seq_num,
+                               DescendingSeqNumComp<uint16_t>()));
+}
+
+bool ContainsSeqNum(const std::vector<uint16_t>& list, uint16_t seq_num) {
+  return std::binary_search(list.begin(), list.end(), seq_num,
+                            DescendingSeqNumComp<uint16_t>());
+}
 }  // namespace
 
 NackModule::NackInfo::NackInfo()
-    : seq_num(0), send_at_seq_num(0), sent_at_time(-1), retries(0) {}
+    : seq_num(0),
+      send_at_seq_num(0),
+      erased(false),
+      sent_at_time(-1),
+      retries(0) {}
 
 NackModule::NackInfo::NackInfo(uint16_t seq_num,
                                uint16_t send_at_seq_num,
                                int64_t created_at_time)
     : seq_num(seq_num),
       send_at_seq_num(send_at_seq_num),
+      erased(false),
       created_at_time(created_at_time),
       sent_at_time(-1),
       retries(0) {}
@@ -61,6 +90,7 @@ NackModule::NackModule(Clock* clock,
     : clock_(clock),
       nack_sender_(nack_sender),
       keyframe_request_sender_(keyframe_request_sender),
+      nack_list_size_(0),
       reordering_histogram_(kNumReorderingBuckets, kMaxReorderedPackets),
       initialized_(false),
       rtt_ms_(kDefaultRttMs),
@@ -79,7 +109,7 @@ int NackModule::OnReceivedPacket(uint16_t seq_num, bool is_keyframe) {
 int NackModule::OnReceivedPacket(uint16_t seq_num,
                                  bool is_keyframe,
                                  bool is_recovered) {
-  rtc::CritScope lock(&crit_);
+  rtc::ModuleLockScope lock(&crit_);
   // TODO(philipel): When the packet includes information whether it is
   //                 retransmitted or not, use that value instead. For
   //                 now set it to true, which will cause the reordering
@@ -89,7 +119,7 @@ int NackModule::OnReceivedPacket(uint16_t seq_num,
   if (!initialized_) {
     newest_seq_num_ = seq_num;
     if (is_keyframe)
-      keyframe_list_.insert(seq_num);
+      InsertSeqNum(&keyframe_list_, seq_num);
     initialized_ = true;
     return 0;
   }
@@ -101,11 +131,12 @@ int NackModule::OnReceivedPacket(uint16_t seq_num,
 
   if (AheadOf(newest_seq_num_, seq_num)) {
     // An out of order packet has been received.
-    auto nack_list_it = nack_list_.find(seq_num);
+    int index = FindNack(seq_num);
     int nacks_sent_for_packet = 0;
-    if (nack_list_it != nack_list_.end()) {
-      nacks_sent_for_packet = nack_list_it->second.retries;
-      nack_list_.erase(nack_list_it);
+    if (index >= 0) {
+      nacks_sent_for_packet = nack_list_[index].retries;
+      EraseNack(index);
+      TrimNackList();
     }
     if (!is_retransmitted)
       UpdateReorderingStatistics(seq_num);
@@ -114,20 +145,16 @@ int NackModule::OnReceivedPacket(uint16_t seq_num,
 
   // Keep track of new keyframes.
   if (is_keyframe)
-    keyframe_list_.insert(seq_num);
+    InsertSeqNum(&keyframe_list_, seq_num);
 
   // And remove old ones so we don't accumulate keyframes.
-  auto it = keyframe_list_.lower_bound(seq_num - kMaxPacketAge);
-  if (it != keyframe_list_.begin())
-    keyframe_list_.erase(keyframe_list_.begin(), it);
+  EraseSeqNumsBefore(&keyframe_list_, seq_num - kMaxPacketAge);
 
   if (is_recovered) {
-    recovered_list_.insert(seq_num);
+    InsertSeqNum(&recovered_list_, seq_num);
 
     // Remove old ones so we don't accumulate recovered packets.
-    auto it = recovered_list_.lower_bound(seq_num - kMaxPacketAge);
-    if (it != recovered_list_.begin())
-      recovered_list_.erase(recovered_list_.begin(), it);
+    EraseSeqNumsBefore(&recovered_list_, seq_num - kMaxPacketAge);
 
     // Do not send nack for packets recovered by FEC or RTX.
     return 0;
@@ -148,22 +175,20 @@ int NackModule::OnReceivedPacket(uint16_t seq_num,
 }
 
 void NackModule::ClearUpTo(uint16_t seq_num) {
-  rtc::CritScope lock(&crit_);
-  nack_list_.erase(nack_list_.begin(), nack_list_.lower_bound(seq_num));
-  keyframe_list_.erase(keyframe_list_.begin(),
-                       keyframe_list_.lower_bound(seq_num));
-  recovered_list_.erase(recovered_list_.begin(),
-                        recovered_list_.lower_bound(seq_num));
+  rtc::ModuleLockScope lock(&crit_);
+  EraseNacksBefore(seq_num);
+  EraseSeqNumsBefore(&keyframe_list_, seq_num);
+  EraseSeqNumsBefore(&recovered_list_, seq_num);
 }
 
 void NackModule::UpdateRtt(int64_t rtt_ms) {
-  rtc::CritScope lock(&crit_);
+  rtc::ModuleLockScope lock(&crit_);
   rtt_ms_ = rtt_ms;
 }
 
 void NackModule::Clear() {
-  rtc::CritScope lock(&crit_);
-  nack_list_.clear();
+  rtc::ModuleLockScope lock(&crit_);
+  ClearNackList();
   keyframe_list_.clear();
   recovered_list_.clear();
 }
@@ -177,7 +202,7 @@ void NackModule::Process() {
   if (nack_sender_) {
     std::vector<uint16_t> nack_batch;
     {
-      rtc::CritScope lock(&crit_);
+      rtc::ModuleLockScope lock(&crit_);
       nack_batch = GetNackBatch(kTimeOnly);
     }
 
@@ -204,12 +229,12 @@ void NackModule::Process() {
 
 bool NackModule::RemovePacketsUntilKeyFrame() {
   while (!keyframe_list_.empty()) {
-    auto it = nack_list_.lower_bound(*keyframe_list_.begin());
+    uint16_t keyframe = keyframe_list_.front();
 
-    if (it != nack_list_.begin()) {
+    if (nack_list_size_ > 0 && AheadOf(keyframe, nack_list_.front().seq_num)) {
       // We have found a keyframe that actually is newer than at least one
       // packet in the nack list.
-      nack_list_.erase(nack_list_.begin(), it);
+      EraseNacksBefore(keyframe);
       return true;
     }
 
@@ -223,20 +248,19 @@ bool NackModule::RemovePacketsUntilKeyFrame() {
 void NackModule::AddPacketsToNack(uint16_t seq_num_start,
                                   uint16_t seq_num_end) {
   // Remove old packets.
-  auto it = nack_list_.lower_bound(seq_num_end - kMaxPacketAge);
-  nack_list_.erase(nack_list_.begin(), it);
+  EraseNacksBefore(seq_num_end - kMaxPacketAge);
 
   // If the nack list is too large, remove packets from the nack list until
   // the latest first packet of a keyframe. If the list is still too large,
   // clear it and request a keyframe.
   uint16_t num_new_nacks = ForwardDiff(seq_num_start, seq_num_end);
-  if (nack_list_.size() + num_new_nacks > kMaxNackPackets) {
+  if (nack_list_size_ + num_new_nacks > kMaxNackPackets) {
     while (RemovePacketsUntilKeyFrame() &&
-           nack_list_.size() + num_new_nacks > kMaxNackPackets) {
+           nack_list_size_ + num_new_nacks > kMaxNackPackets) {
     }
 
-    if (nack_list_.size() + num_new_nacks > kMaxNackPackets) {
-      nack_list_.clear();
+    if (nack_list_size_ + num_new_nacks > kMaxNackPackets) {
+      ClearNackList();
       RTC_LOG(LS_WARNING) << "NACK list full, clearing NACK"
                              " list and requesting keyframe.";
       keyframe_request_sender_->RequestKeyFrame();
@@ -244,15 +268,77 @@ void NackModule::AddPacketsToNack(uint16_t seq_num_start,
     }
   }
 
+  // Squeeze out erased entries rather than growing a mostly erased ring.
+  if (nack_list_.size() + num_new_nacks > nack_list_.capacity() &&
+      nack_list_size_ < nack_list_.size() / 2) {
+    nack_list_.remove_if([](const NackInfo& info) { return info.erased; });
+  }
+
+  const uint16_t wait_packets = WaitNumberOfPackets(0.5);
+  const int64_t now_ms = clock_->TimeInMilliseconds();
   for (uint16_t seq_num = seq_num_start; seq_num != seq_num_end; ++seq_num) {
     // Do not send nack for packets that are already recovered by FEC or RTX
-    if (recovered_list_.find(seq_num) != recovered_list_.end())
+    if (!recovered_list_.empty() && ContainsSeqNum(recovered_list_, seq_num))
       continue;
-    NackInfo nack_info(seq_num, seq_num + WaitNumberOfPackets(0.5),
-                       clock_->TimeInMilliseconds());
-    RTC_DCHECK(nack_list_.find(seq_num) == nack_list_.end());
-    nack_list_[seq_num] = nack_info;
+    RTC_DCHECK_EQ(FindNack(seq_num), -1);
+    nack_list_.push_back(NackInfo(seq_num, seq_num + wait_packets, now_ms));
+    ++nack_list_size_;
+  }
+}
+
+int NackModule::FindNack(uint16_t seq_num) const {
+  if (nack_list_size_ == 0)
+    return -1;
+
+  // Offsets from the oldest entry grow along the list.
+  const uint16_t oldest = nack_list_.front().seq_num;
+  const uint16_t offset = seq_num - oldest;
+  if (offset > static_cast<uint16_t>(nack_list_.back().seq_num - oldest))
+    return -1;
+
+  size_t low = 0;
+  size_t high = nack_list_.size();
+  while (low < high) {
+    size_t mid = low + (high - low) / 2;
+    if (static_cast<uint16_t>(nack_list_[mid].seq_num - oldest) < offset) {
+      low = mid + 1;
+    } else {
+      high = mid;
+    }
   }
+
+  const NackInfo& info = nack_list_[low];
+  if (info.seq_num != seq_num || info.erased)
+    return -1;
+  return static_cast<int>(low);
+}
+
+void NackModule::EraseNack(size_t index) {
+  RTC_DCHECK(!nack_list_[index].erased);
+  nack_list_[index].erased = true;
+  --nack_list_size_;
+}
+
+void NackModule::TrimNackList() {
+  while (!nack_list_.empty() && nack_list_.front().erased)
+    nack_list_.pop_front();
+}
+
+void NackModule::EraseNacksBefore(uint16_t seq_num) {
+  while (!nack_list_.empty()) {
+    const NackInfo& info = nack_list_.front();
+    if (!info.erased) {
+      if (!AheadOf(seq_num, info.seq_num))
+        break;
+      --nack_list_size_;
+    }
+    nack_list_.pop_front();
+  }
+}
+
+void NackModule::ClearNackList() {
+  nack_list_.clear();
+  nack_list_size_ = 0;
 }
 
 std::vector<uint16_t> NackModule::GetNackBatch(NackFilterOptions options) {
@@ -260,29 +346,34 @@ std::vector<uint16_t> NackModule::GetNackBatch(NackFilterOptions options) {
   bool consider_timestamp = options != kSeqNumOnly;
   int64_t now_ms = clock_->TimeInMilliseconds();
   std::vector<uint16_t> nack_batch;
-  auto it = nack_list_.begin();
-  while (it != nack_list_.end()) {
+  for (size_t i = 0; i < nack_list_.size(); ++i) {
+    NackInfo& info = nack_list_[i];
+    if (info.erased)
+      continue;
     bool delay_timed_out =
-        now_ms - it->second.created_at_time >= send_nack_delay_ms_;
-    bool nack_on_rtt_passed = now_ms - it->second.sent_at_time >= rtt_ms_;
+        now_ms - info.created_at_time >= send_nack_delay_ms_;
+    bool nack_on_rtt_passed = now_ms - info.sent_at_time >= rtt_ms_;
     bool nack_on_seq_num_passed =
-        it->second.sent_at_time == -1 &&
-        AheadOrAt(newest_seq_num_, it->second.send_at_seq_num);
+        info.sent_at_time == -1 &&
+        AheadOrAt(newest_seq_num_, info.send_at_seq_num);
     if (delay_timed_out && ((consider_seq_num && nack_on_seq_num_passed) ||
                             (consider_timestamp && nack_on_rtt_passed))) {
-      nack_batch.emplace_back(it->second.seq_num);
-      ++it->second.retries;
-      it->second.sent_at_time = now_ms;
-      if (it->second.retries >= kMaxNackRetries) {
-        RTC_LOG(LS_WARNING) << "Sequence number " << it->second.seq_num
+      nack_batch.emplace_back(info.seq_num);
+      ++info.retries;
+      info.sent_at_time = now_ms;
+      if (info.retries >= kMaxNackRetries) {
+        RTC_LOG(LS_WARNING) << "Sequence number " << info.seq_num
                             << " removed from NACK list due to max retries.";
-        it = nack_list_.erase(it);
-      } else {
-        ++it;
+        EraseNack(i);
       }
-      continue;
     }
-    ++it;
+  }
+  // The scan above walked every erased entry too, so drop them once they
+  // outnumber the live ones.
+  if (nack_list_size_ < nack_list_.size() / 2) {
+    nack_list_.remove_if([](const NackInfo& info) { return info.erased; });
+  } else {
+    TrimNackList();
   }
   return nack_batch;
 }
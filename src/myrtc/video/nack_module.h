@@ -13,14 +13,13 @@
 
 #include <stdint.h>
 
-#include <map>
-#include <set>
 #include <vector>
 
 #include "module/module.h"
 #include "module/module_common_types.h"
 #include "video/histogram.h"
-#include "rtc_base/critical_section.h"
+#include "rtc_base/module_lock.h"
+#include "rtc_base/ring_buffer.h"
 #include "rtc_base/sequence_number_util.h"
 #include "rtc_base/thread_annotations.h"
 #include "rtc_base/clock.h"
@@ -60,6 +59,8 @@ class NackModule : public Module {
 
     uint16_t seq_num;
     uint16_t send_at_seq_num;
+    // Set once taken out of |nack_list_| while not at its front.
+    bool erased;
     int64_t created_at_time;
     int64_t sent_at_time;
     int retries;
@@ -67,6 +68,16 @@ class NackModule : public Module {
   void AddPacketsToNack(uint16_t seq_num_start, uint16_t seq_num_end)
       RTC_EXCLUSIVE_LOCKS_REQUIRED(crit_);
 
+  // Returns the position of |seq_num| in |nack_list_|, or -1.
+  int FindNack(uint16_t seq_num) const RTC_EXCLUSIVE_LOCKS_REQUIRED(crit_);
+  // Marks the entry at |index| erased; TrimNackList() must follow.
+  void EraseNack(size_t index) RTC_EXCLUSIVE_LOCKS_REQUIRED(crit_);
+  // Drops erased entries from the front of |nack_list_|.
+  void TrimNackList() RTC_EXCLUSIVE_LOCKS_REQUIRED(crit_);
+  // Removes the packets older than |seq_num| from |nack_list_|.
+  void EraseNacksBefore(uint16_t seq_num) RTC_EXCLUSIVE_LOCKS_REQUIRED(crit_);
+  void ClearNackList() RTC_EXCLUSIVE_LOCKS_REQUIRED(crit_);
+
   // Removes packets from the nack list until the next keyframe. Returns true
   // if packets were removed.
   bool RemovePacketsUntilKeyFrame() RTC_EXCLUSIVE_LOCKS_REQUIRED(crit_);
@@ -82,7 +93,7 @@ class NackModule : public Module {
   int WaitNumberOfPackets(float probability) const
       RTC_EXCLUSIVE_LOCKS_REQUIRED(crit_);
 
-  rtc::CriticalSection crit_;
+  rtc::ModuleLock crit_;
   Clock* const clock_;
   NackSender* const nack_sender_;
   KeyFrameRequestSender* const keyframe_request_sender_;
@@ -90,12 +101,16 @@ class NackModule : public Module {
   // TODO(philipel): Some of the variables below are consistently used on a
   // known thread (e.g. see |initialized_|). Those probably do not need
   // synchronized access.
-  std::map<uint16_t, NackInfo, DescendingSeqNumComp<uint16_t>> nack_list_
-      RTC_GUARDED_BY(crit_);
-  std::set<uint16_t, DescendingSeqNumComp<uint16_t>> keyframe_list_
-      RTC_GUARDED_BY(crit_);
-  std::set<uint16_t, DescendingSeqNumComp<uint16_t>> recovered_list_
-      RTC_GUARDED_BY(crit_);
+  // Packets are only ever appended in sequence number order, so the nack list
+  // is a ring sorted oldest first and searched by bisection. Entries removed
+  // from its middle are marked erased and dropped once they reach the front,
+  // which is always a live entry.
+  rtc::RingBuffer<NackInfo> nack_list_ RTC_GUARDED_BY(crit_);
+  // Number of entries of |nack_list_| not marked erased.
+  size_t nack_list_size_ RTC_GUARDED_BY(crit_);
+  // Both sorted oldest first; they rarely hold more than a few entries.
+  std::vector<uint16_t> keyframe_list_ RTC_GUARDED_BY(crit_);
+  std::vector<uint16_t> recovered_list_ RTC_GUARDED_BY(crit_);
   video_coding::Histogram reordering_histogram_ RTC_GUARDED_BY(crit_);
   bool initialized_ RTC_GUARDED_BY(crit_);
   int64_t rtt_ms_ RTC_GUARDED_BY(crit_);
@@ -0,0 +1,107 @@
+/*
+ *  Copyright (c) 2016 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "video/start_code_scanner.h"
+
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+#include <immintrin.h>
+#endif
+
+#include "rtc_base/cpu_info.h"
+
+namespace webrtc {
+
+size_t FindStartCode_C(const uint8_t* buffer, size_t buffer_size) {
+  if (buffer_size < 3)
+    return buffer_size;
+
+  // Given a 3-byte sequence we're looking at, if the 3rd byte isn't 1 or 0,
+  // no start sequence can begin in it and we skip ahead to the next one.
+  const size_t end = buffer_size - 2;
+  for (size_t i = 0; i < end;) {
+    if (buffer[i + 2] > 1) {
+      i += 3;
+    } else if (buffer[i + 2] == 1 && buffer[i + 1] == 0 && buffer[i] == 0) {
+      return i;
+    } else {
+      ++i;
+    }
+  }
+  return buffer_size;
+}
+
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+
+// Both vector kernels test every position of a block at once by comparing
+// three loads, shifted by one byte each, against {0 0 1}.
+size_t FindStartCode_SSE2(const uint8_t* buffer, size_t buffer_size) {
+  const __m128i zero = _mm_setzero_si128();
+  const __m128i one = _mm_set1_epi8(1);
+  size_t i = 0;
+  for (; i + 16 + 2 <= buffer_size; i += 16) {
+    const uint8_t* p = buffer + i;
+    __m128i b0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+    __m128i b1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + 1));
+    __m128i b2 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + 2));
+    __m128i hit = _mm_and_si128(
+        _mm_and_si128(_mm_cmpeq_epi8(b0, zero), _mm_cmpeq_epi8(b1, zero)),
+        _mm_cmpeq_epi8(b2, one));
+    int mask = _mm_movemask_epi8(hit);
+    if (mask)
+      return i + __builtin_ctz(mask);
+  }
+  return i + FindStartCode_C(buffer + i, buffer_size - i);
+}
+
+__attribute__((target("avx2")))
+size_t FindStartCode_AVX2(const uint8_t* buffer, size_t buffer_size) {
+  const __m256i zero = _mm256_setzero_si256();
+  const __m256i one = _mm256_set1_epi8(1);
+  size_t i = 0;
+  for (; i + 32 + 2 <= buffer_size; i += 32) {
+    const uint8_t* p = buffer + i;
+    __m256i b0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+    __m256i b1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + 1));
+    __m256i b2 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + 2));
+    __m256i hit = _mm256_and_si256(
+        _mm256_and_si256(_mm256_cmpeq_epi8(b0, zero),
+                         _mm256_cmpeq_epi8(b1, zero)),
+        _mm256_cmpeq_epi8(b2, one));
+    uint32_t mask = static_cast<uint32_t>(_mm256_movemask_epi8(hit));
+    if (mask)
+      return i + __builtin_ctz(mask);
+  }
+  return i + FindStartCode_SSE2(buffer + i, buffer_size - i);
+}
+
+#endif  // defined(WEBRTC_ARCH_X86_FAMILY)
+
+namespace {
+
+typedef size_t (*FindStartCodeFunc)(const uint8_t*, size_t);
+
+FindStartCodeFunc SelectFindStartCode() {
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+  if (CpuInfo::Supports(CpuInfo::kAVX2))
+    return FindStartCode_AVX2;
+  if (CpuInfo::Supports(CpuInfo::kSSE2))
+    return FindStartCode_SSE2;
+#endif
+  return FindStartCode_C;
+}
+
+}  // namespace
+
+size_t FindStartCode(const uint8_t* buffer, size_t buffer_size) {
+  static const FindStartCodeFunc find_start_code = SelectFindStartCode();
+  return find_start_code(buffer, buffer_size);
+}
+
+}  // namespace webrtc
@@ -0,0 +1,36 @@
+/*
+ *  Copyright (c) 2016 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef COMMON_VIDEO_START_CODE_SCANNER_H_
+#define COMMON_VIDEO_START_CODE_SCANNER_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "rtc_base/arch.h"
+
+namespace webrtc {
+
+// Returns the offset of the first {0 0 1} start sequence lying entirely
+// within |buffer|, or |buffer_size| if there is none. The search is the same
+// for H.264 and H.265 Annex B streams. An SSE2 or AVX2 kernel is picked on
+// first use, depending on what the CPU supports.
+size_t FindStartCode(const uint8_t* buffer, size_t buffer_size);
+
+// The kernels behind FindStartCode(), exposed for tests and benchmarks.
+size_t FindStartCode_C(const uint8_t* buffer, size_t buffer_size);
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+size_t FindStartCode_SSE2(const uint8_t* buffer, size_t buffer_size);
+size_t FindStartCode_AVX2(const uint8_t* buffer, size_t buffer_size);
+#endif
+
+}  // namespace webrtc
+
+#endif  // COMMON_VIDEO_START_CODE_SCANNER_H_
@@ -96,16 +96,8 @@ int AudioFrameConstructor::deliverVideoData_(
   return 0;
 }
 
-int AudioFrameConstructor::deliverAudioData_(
-    std::shared_ptr<erizo::DataPacket> audio_packet) {
-  if (audio_packet->length <= 0) {
-    return 0;
-  }
-
-  // support audio transport-cc, 
-  // see @https://github.com/anjisuan783/media_lib/issues/8
-
-  RTCPHeader* chead = reinterpret_cast<RTCPHeader*>(audio_packet->data);
+int AudioFrameConstructor::deliverRtcp(char* buf, int len) {
+  RTCPHeader* chead = reinterpret_cast<RTCPHeader*>(buf);
   uint8_t packetType = chead->getPacketType();
   assert(packetType != RTCP_Receiver_PT && 
          packetType != RTCP_PS_Feedback_PT && 
@@ -116,21 +108,44 @@ int AudioFrameConstructor::deliverAudioData_(
        packetType == RTCP_Sender_PT || 
        packetType == RTCP_XR_PT) ) {
     onSr((erizo::RtcpHeader*)chead);
-    audioReceive_->onRtpData(audio_packet->data, audio_packet->length);
-    return audio_packet->length;
+    audioReceive_->onRtpData(buf, len);
+    return len;
   }
+  return 0;
+}
 
-  if (packetType >= RTCP_MIN_PT && packetType <= RTCP_MAX_PT) {
+int AudioFrameConstructor::deliverAudioRtcp_(const erizo::DataPacketView& block) {
+  if (block.length <= 0) {
     return 0;
   }
+  return deliverRtcp(block.data(), block.length);
+}
+
+int AudioFrameConstructor::deliverAudioData_(
+    std::shared_ptr<erizo::DataPacket> audio_packet) {
+  if (audio_packet->length <= 0) {
+    return 0;
+  }
+
+  // support audio transport-cc, 
+  // see @https://github.com/anjisuan783/media_lib/issues/8
+
+  RTCPHeader* chead = reinterpret_cast<RTCPHeader*>(audio_packet->data);
+  uint8_t packetType = chead->getPacketType();
+  if (packetType >= RTCP_MIN_PT && packetType <= RTCP_MAX_PT) {
+    return deliverRtcp(audio_packet->data, audio_packet->length);
+  }
 
   RTPHeader* head = reinterpret_cast<RTPHeader*>(audio_packet->data);
   if (!ssrc_ && head->getSSRC()) {
     createAudioReceiver();
   }
 
-  if (audioReceive_)
-    audioReceive_->onRtpData(audio_packet->data, audio_packet->length);
+  if (audioReceive_) {
+    const rtc_adapter::AdapterPacket packet{
+        audio_packet->data, audio_packet->length, audio_packet->parsedHeader()};
+    audioReceive_->onRtpDataBatch(rtc::MakeArrayView(&packet, 1));
+  }
 
   FrameFormat frameFormat;
   Frame frame;
@@ -168,6 +183,14 @@ int AudioFrameConstructor::deliverAudioData_(
   return audio_packet->length;
 }
 
+bool AudioFrameConstructor::getStats(rtc_adapter::AdapterRtpStats& stats) {
+  if (!audioReceive_) {
+    return false;
+  }
+  audioReceive_->getStats(stats);
+  return true;
+}
+
 void AudioFrameConstructor::onFeedback(const FeedbackMsg& msg) {
   if (msg.type == owt_base::AUDIO_FEEDBACK) {
     if (msg.cmd == RTCP_PACKET && fb_sink_)
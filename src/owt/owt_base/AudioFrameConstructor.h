@@ -40,6 +40,8 @@ class AudioFrameConstructor final : public erizo::MediaSink,
   void bindTransport(erizo::MediaSource* source, erizo::FeedbackSink* fbSink);
   void unbindTransport();
   void enable(bool enabled) { enabled_ = enabled; }
+  // Counters of the receive stream, false before it is created.
+  bool getStats(rtc_adapter::AdapterRtpStats& stats);
 
   // Implements the FrameSource interfaces.
   void onFeedback(const FeedbackMsg& msg);
@@ -49,6 +51,8 @@ class AudioFrameConstructor final : public erizo::MediaSink,
   int deliverAudioData_(std::shared_ptr<erizo::DataPacket> audio_packet) override;
   int deliverVideoData_(std::shared_ptr<erizo::DataPacket> video_packet) override;
   int deliverEvent_(erizo::MediaEventPtr event) override;
+  int deliverAudioRtcp_(const erizo::DataPacketView& block) override;
+  int deliverRtcp(char* buf, int len);
 
   void onAdapterData(char* data, int len) override;
   void close();
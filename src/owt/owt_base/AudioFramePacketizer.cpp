@@ -1,6 +1,7 @@
 #include "owt_base/AudioFramePacketizer.h"
 #include "owt_base/AudioUtilitiesNew.h"
-#include "myrtc/api/task_queue_base.h"
+#include "myrtc/api/task_queue_base.h"
+
 #include "rtc_adapter/thread/StaticTaskQueueFactory.h"
 
 using namespace rtc_adapter;
@@ -50,6 +51,15 @@ int AudioFramePacketizer::deliverFeedback_(
   return 0;
 }
 
+int AudioFramePacketizer::deliverFeedbackBlock_(
+    const erizo::DataPacketView& block) {
+  if (audioSend_) {
+    audioSend_->onRtcpData(block.data(), block.length);
+    return block.length;
+  }
+  return 0;
+}
+
 void AudioFramePacketizer::receiveRtpData(char* buf, int len, 
     erizoExtra::DataType type, uint32_t channelId) {
   if (!audio_sink_) {
@@ -102,6 +112,14 @@ bool AudioFramePacketizer::init(AudioFramePacketizer::Config& config) {
 
 void AudioFramePacketizer::onAdapterStats(const AdapterStats& stats) {}
 
+bool AudioFramePacketizer::getStats(rtc_adapter::AdapterRtpStats& stats) {
+  if (!audioSend_) {
+    return false;
+  }
+  audioSend_->getStats(stats);
+  return true;
+}
+
 void AudioFramePacketizer::onAdapterData(char* data, int len) {
   if (audio_sink_) {
     audio_sink_->deliverAudioData(
@@ -42,6 +42,8 @@ class AudioFramePacketizer
   void unbindTransport();
   void enable(bool enable) { enable_ = enable; }
   uint32_t getSsrc() { return ssrc_; }
+  // Counters of the send stream, false before it is created.
+  bool getStats(rtc_adapter::AdapterRtpStats& stats);
 
   // Implements FrameDestination.
   void onFrame(const Frame&);
@@ -60,6 +62,7 @@ class AudioFramePacketizer
 
   // Implement erizo::FeedbackSink
   int deliverFeedback_(std::shared_ptr<erizo::DataPacket> data_packet);
+  int deliverFeedbackBlock_(const erizo::DataPacketView& block) override;
   // Implement erizo::MediaSource
   int sendPLI();
 
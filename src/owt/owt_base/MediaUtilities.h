@@ -5,6 +5,9 @@
 #ifndef MediaUtilities_h
 #define MediaUtilities_h
 
+#include "h/rtc_media_frame.h"
+#include "video/start_code_scanner.h"
+
 namespace owt_base {
 
 static int partial_linear_bitrate[][2] = {
@@ -51,45 +54,24 @@ inline int findNALU(uint8_t* buf,
                     int* nal_start, 
                     int* nal_end, 
                     int* sc_len) {
-  int i = 0;
   *nal_start = 0;
   *nal_end = 0;
   *sc_len = 0;
 
-  while (true) {
-    if (size < i + 3)
-      return -1; /* Did not find NAL start */
-
-    /* ( next_bits( 24 ) == {0, 0, 1} ) */
-    if (buf[i] == 0 && buf[i + 1] == 0 && buf[i + 2] == 1) {
-      i += 3;
-      *sc_len = 3;
-      break;
-    }
+  if (size < 3)
+    return -1;
 
-    /* ( next_bits( 32 ) == {0, 0, 0, 1} ) */
-    if (size > i + 3 && 
-        buf[i] == 0 && 
-        buf[i + 1] == 0 && 
-        buf[i + 2] == 0 && 
-        buf[i + 3] == 1) {
-      i += 4;
-      *sc_len = 4;
-      break;
-    }
-
-    ++i;
-  }
+  int i = webrtc::FindStartCode(buf, size);
+  if (i == size)
+    return -1; /* Did not find NAL start */
 
+  /* {0, 0, 0, 1} is a {0, 0, 1} preceded by a zero byte */
+  *sc_len = (i > 0 && buf[i - 1] == 0) ? 4 : 3;
+  i += 3;
   *nal_start = i;
 
-  /*( next_bits( 24 ) != {0, 0, 1} )*/
-  while ((size > i + 2) &&
-         (buf[i] != 0 || buf[i + 1] != 0 || buf[i + 2] != 1)) {
-    ++i;
-  }
-
-  if (size <= i + 2) {
+  i += webrtc::FindStartCode(buf + i, size - i);
+  if (i == size) {
     *nal_end = size;
   } else if (buf[i - 1] == 0) {
     *nal_end = i - 1;
@@ -100,6 +82,49 @@ inline int findNALU(uint8_t* buf,
   return (*nal_end - *nal_start);
 }
 
+// Records the NAL units of the Annex-B |buf| in |info|. Frames with more
+// units than fit are left without an index.
+inline void buildNaluIndex(uint8_t* buf, int size, VideoFrameSpecificInfo& info) {
+  info.naluCount = 0;
+  int nalu_start_offset = 0;
+  int nalu_end_offset = 0;
+  int sc_len = 0;
+  int position = 0;
+  uint8_t count = 0;
+  while (position < size) {
+    int nalu_length = findNALU(buf + position, size - position,
+        &nalu_start_offset, &nalu_end_offset, &sc_len);
+    if (nalu_length < 0) {
+      break;
+    }
+    if (count == kMaxNalusPerFrame) {
+      return;
+    }
+    NaluInfo& nalu = info.nalus[count++];
+    nalu.offset = position + nalu_start_offset;
+    nalu.length = nalu_length;
+    nalu.type = nalu_length > 0 ? (buf[nalu.offset] & 0x1F) : 0;
+    position += nalu_start_offset + nalu_length;
+  }
+  info.naluCount = count;
+}
+
+// Whether |info| carries a NAL index that fits a |size| byte payload.
+inline bool hasNaluIndex(const VideoFrameSpecificInfo& info, uint32_t size) {
+  if (info.naluCount == 0 || info.naluCount > kMaxNalusPerFrame) {
+    return false;
+  }
+  uint32_t end = 0;
+  for (int i = 0; i < info.naluCount; ++i) {
+    const NaluInfo& nalu = info.nalus[i];
+    if (nalu.offset < end || nalu.offset + nalu.length > size) {
+      return false;
+    }
+    end = nalu.offset + nalu.length;
+  }
+  return true;
+}
+
 #if 0
 inline bool isH264KeyFrame(uint8_t *data, size_t len) {
   if (len < 5) {
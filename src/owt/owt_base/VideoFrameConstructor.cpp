@@ -8,6 +8,7 @@
 #include <future>
 #include <random>
 #include "common/rtputils.h"
+#include "erizo/rtp/RtpUtils.h"
 #include "myrtc/api/task_queue_base.h"
 
 using namespace rtc_adapter;
@@ -63,7 +64,21 @@ int32_t VideoFrameConstructor::RequestKeyFrame() {
 }
 
 bool VideoFrameConstructor::setBitrate(uint32_t kbps) {
-  // At present we do not react on this request
+  if (!fb_sink_ || !ssrc_ || !kbps) {
+    return false;
+  }
+  fb_sink_->deliverFeedback(
+      erizo::RtpUtils::createREMB(0, {ssrc_}, kbps * 1000));
+  sentBitrateKbps_ = kbps;
+  return true;
+}
+
+bool VideoFrameConstructor::getStats(rtc_adapter::AdapterRtpStats& stats) {
+  if (!videoReceive_) {
+    return false;
+  }
+  videoReceive_->getStats(stats);
+  stats.bwe_bps = sentBitrateKbps_ * 1000;
   return true;
 }
 
@@ -96,9 +111,8 @@ void VideoFrameConstructor::onAdapterData(char* data, int len) {
   }
 }
 
-int VideoFrameConstructor::deliverVideoData_(
-    std::shared_ptr<erizo::DataPacket> video_packet) {
-  RTCPHeader* chead = reinterpret_cast<RTCPHeader*>(video_packet->data);
+int VideoFrameConstructor::deliverRtcp(char* buf, int len) {
+  RTCPHeader* chead = reinterpret_cast<RTCPHeader*>(buf);
   uint8_t packetType = chead->getPacketType();
 
   assert(packetType != RTCP_Receiver_PT && 
@@ -108,12 +122,22 @@ int VideoFrameConstructor::deliverVideoData_(
       (packetType == RTCP_SDES_PT || 
        packetType == RTCP_Sender_PT || 
        packetType == RTCP_XR_PT) ) {
-    videoReceive_->onRtpData(video_packet->data, video_packet->length);
-    return video_packet->length;
+    videoReceive_->onRtpData(buf, len);
+    return len;
   }
+  return 0;
+}
 
+int VideoFrameConstructor::deliverVideoRtcp_(const erizo::DataPacketView& block) {
+  return deliverRtcp(block.data(), block.length);
+}
+
+int VideoFrameConstructor::deliverVideoData_(
+    std::shared_ptr<erizo::DataPacket> video_packet) {
+  RTCPHeader* chead = reinterpret_cast<RTCPHeader*>(video_packet->data);
+  uint8_t packetType = chead->getPacketType();
   if (packetType >= RTCP_MIN_PT && packetType <= RTCP_MAX_PT) {
-    return 0;
+    return deliverRtcp(video_packet->data, video_packet->length);
   }
 
   RTPHeader* head = reinterpret_cast<RTPHeader*>(video_packet->data);
@@ -121,12 +145,41 @@ int VideoFrameConstructor::deliverVideoData_(
     createReceiveVideo(head->getSSRC());
   }
   if (videoReceive_) {
-    videoReceive_->onRtpData(video_packet->data, video_packet->length);
+    const rtc_adapter::AdapterPacket packet{
+        video_packet->data, video_packet->length, video_packet->parsedHeader(),
+        video_packet->latencyTrace()};
+    videoReceive_->onRtpDataBatch(rtc::MakeArrayView(&packet, 1));
   }
 
   return video_packet->length;
 }
 
+int VideoFrameConstructor::deliverVideoDataBatch_(erizo::PacketSpan packets) {
+  int total = 0;
+  for (const auto& packet : packets) {
+    RTCPHeader* chead = reinterpret_cast<RTCPHeader*>(packet->data);
+    uint8_t packetType = chead->getPacketType();
+    if (packetType >= RTCP_MIN_PT && packetType <= RTCP_MAX_PT) {
+      total += deliverRtcp(packet->data, packet->length);
+      continue;
+    }
+
+    RTPHeader* head = reinterpret_cast<RTPHeader*>(packet->data);
+    if (!ssrc_ && head->getSSRC()) {
+      createReceiveVideo(head->getSSRC());
+    }
+    adapterBatch_.push_back({packet->data, packet->length,
+                             packet->parsedHeader(), packet->latencyTrace()});
+    total += packet->length;
+  }
+
+  if (videoReceive_ && !adapterBatch_.empty()) {
+    videoReceive_->onRtpDataBatch(adapterBatch_);
+  }
+  adapterBatch_.clear();
+  return total;
+}
+
 int VideoFrameConstructor::deliverAudioData_(
     std::shared_ptr<erizo::DataPacket> audio_packet) {
   assert(false);
@@ -138,26 +191,48 @@ void VideoFrameConstructor::onTimeout() {
       RequestKeyFrame();
   }
   pendingKeyFrameRequests_ = 0;
+
+  // Lowest estimate any subscriber reported during the last period
+  uint32_t kbps = bitrateHintKbps_.exchange(0);
+  if (kbps) {
+    setBitrate(kbps);
+  }
 }
 
 void VideoFrameConstructor::onFeedback(const FeedbackMsg& msg) {
   if (msg.type != owt_base::VIDEO_FEEDBACK) {
     return;
   }
+
+  if (msg.cmd == SET_BITRATE) {
+    // Keep the minimum, it goes upstream on the next timer tick.
+    uint32_t kbps = msg.data.kbps;
+    uint32_t current = bitrateHintKbps_.load();
+    while ((current == 0 || kbps < current) && 
+           !bitrateHintKbps_.compare_exchange_weak(current, kbps)) {
+    }
+    return;
+  }
+
+  if (msg.cmd != REQUEST_KEY_FRAME) {
+    return;
+  }
+
+  // Requests arriving before the worker got to the previous ones ride along.
+  if (keyFrameRequests_.fetch_add(1) != 0) {
+    return;
+  }
+
   auto share_this = 
       std::dynamic_pointer_cast<VideoFrameConstructor>(shared_from_this());
   std::weak_ptr<VideoFrameConstructor> weak_this = share_this;
   
-  worker_->task([msg, weak_this, this]() {
+  worker_->task([weak_this, this]() {
     if (auto share_this = weak_this.lock()) {
-      if (msg.cmd == REQUEST_KEY_FRAME) {
-        if (!pendingKeyFrameRequests_) {
-          RequestKeyFrame();
-        }
-        ++pendingKeyFrameRequests_;
-      } else if (msg.cmd == SET_BITRATE) {
-        setBitrate(msg.data.kbps);
-      }      
+      if (!pendingKeyFrameRequests_) {
+        RequestKeyFrame();
+      }
+      pendingKeyFrameRequests_ += keyFrameRequests_.exchange(0);
     }
   });
 }
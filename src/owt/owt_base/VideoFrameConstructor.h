@@ -5,6 +5,7 @@
 #ifndef VideoFrameConstructor_h
 #define VideoFrameConstructor_h
 
+#include <atomic>
 #include <memory>
 #include "common/logger.h"
 
@@ -72,6 +73,9 @@ public:
 
   bool setBitrate(uint32_t kbps);
 
+  // Counters of the receive stream, false before it is created.
+  bool getStats(rtc_adapter::AdapterRtpStats& stats);
+
 private:
   config config_;
 
@@ -80,6 +84,9 @@ private:
   // Implement erizo::MediaSink
   int deliverAudioData_(std::shared_ptr<erizo::DataPacket> audio_packet) override;
   int deliverVideoData_(std::shared_ptr<erizo::DataPacket> video_packet) override;
+  int deliverVideoDataBatch_(erizo::PacketSpan packets) override;
+  int deliverVideoRtcp_(const erizo::DataPacketView& block) override;
+  int deliverRtcp(char* buf, int len);
   int deliverEvent_(erizo::MediaEventPtr event) override { return 0; }
   void close();
 
@@ -89,10 +96,18 @@ private:
   erizo::MediaSource* transport_{nullptr};
   uint32_t pendingKeyFrameRequests_{0};
 
+  // Feedback from the subscribers, possibly on other workers, folded into
+  // one upstream key frame request and one REMB per timer tick.
+  std::atomic<uint32_t> keyFrameRequests_{0};
+  std::atomic<uint32_t> bitrateHintKbps_{0};
+  // Last REMB sent upstream
+  uint32_t sentBitrateKbps_{0};
+
   VideoInfoListener* videoInfoListener_;
 
   std::shared_ptr<rtc_adapter::RtcAdapter> rtcAdapter_;
   rtc_adapter::VideoReceiveAdapter* videoReceive_{nullptr};
+  std::vector<rtc_adapter::AdapterPacket> adapterBatch_;
 
   wa::Worker* worker_;
 };
@@ -85,6 +85,14 @@ void VideoFramePacketizer::enable(bool enabled) {
   }
 }
 
+bool VideoFramePacketizer::getStats(rtc_adapter::AdapterRtpStats& stats) {
+  if (!m_videoSend) {
+    return false;
+  }
+  m_videoSend->getStats(stats);
+  return true;
+}
+
 void VideoFramePacketizer::onFeedback(const FeedbackMsg& msg) {
   deliverFeedbackMsg(msg);
 }
@@ -94,8 +102,14 @@ void VideoFramePacketizer::onAdapterData(char* data, int len) {
     return;
   }
 
-  video_sink_->deliverVideoData(std::make_shared<erizo::DataPacket>(
-      0, data, len, erizo::VIDEO_PACKET));
+  auto packet = std::make_shared<erizo::DataPacket>(
+      0, data, len, erizo::VIDEO_PACKET);
+  if (m_sendTrace.active()) {
+    wa::LatencyTracer::stage(wa::LatencyStage::kPacketize, m_sendTrace);
+    packet->metadata().trace = m_sendTrace;
+    m_sendTrace = wa::LatencyTrace{};
+  }
+  video_sink_->deliverVideoData(std::move(packet));
 }
 
 void VideoFramePacketizer::onFrame(const Frame& frame) {
@@ -110,6 +124,9 @@ void VideoFramePacketizer::onFrame(const Frame& frame) {
       }
 
       if (m_videoSend) {
+        if (frame.traceStartNs) {
+          m_sendTrace = wa::LatencyTrace{frame.traceStartNs, frame.traceLastNs};
+        }
         m_videoSend->onFrame(frame);
       }
     }
@@ -135,5 +152,14 @@ int VideoFramePacketizer::deliverFeedback_(std::shared_ptr<erizo::DataPacket> da
   return 0;
 }
 
+int VideoFramePacketizer::deliverFeedbackBlock_(
+    const erizo::DataPacketView& block) {
+  if (m_videoSend) {
+    m_videoSend->onRtcpData(block.data(), block.length);
+    return block.length;
+  }
+  return 0;
+}
+
 } //namespace owt
 
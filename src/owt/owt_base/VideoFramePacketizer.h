@@ -49,6 +49,8 @@ class VideoFramePacketizer
   void unbindTransport();
   void enable(bool enabled);
   uint32_t getSsrc() { return m_ssrc; }
+  // Counters of the send stream, false before it is created.
+  bool getStats(rtc_adapter::AdapterRtpStats& stats);
 
   // Implements FrameDestination.
   void onFrame(const Frame&);
@@ -67,6 +69,7 @@ class VideoFramePacketizer
 
   // Implement erizo::FeedbackSink
   int deliverFeedback_(std::shared_ptr<erizo::DataPacket> data_packet);
+  int deliverFeedbackBlock_(const erizo::DataPacketView& block) override;
   // Implement erizo::MediaSource
   int sendPLI() { return 0; }
 
@@ -81,6 +84,8 @@ class VideoFramePacketizer
   uint16_t m_sendFrameCount{0};
   std::shared_ptr<rtc_adapter::RtcAdapter> m_rtcAdapter;
   rtc_adapter::VideoSendAdapter* m_videoSend{nullptr};
+  // Trace of the last frame handed to m_videoSend, given to its first packet.
+  wa::LatencyTrace m_sendTrace;
 
   std::unique_ptr<rtc::TaskQueue> task_queue_;
 };
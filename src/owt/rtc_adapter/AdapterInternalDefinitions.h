@@ -5,18 +5,57 @@
 #ifndef RTC_ADAPTER_ADAPTER_INTERNAL_DEFINITIONS_H_
 #define RTC_ADAPTER_ADAPTER_INTERNAL_DEFINITIONS_H_
 
+#include <array>
+
 #include "api/task_queue_factory.h"
 #include "call/call.h"
+#include "rtc_base/copy_on_write_buffer.h"
 #include "rtc_base/task_queue.h"
+#include "utility/process_thread.h"
+#include "rtc_adapter/RtcAdapter.h"
 
 namespace rtc_adapter {
 
 class CallOwner {
 public:
-    virtual std::shared_ptr<webrtc::Call> call() = 0;
+    // Returns the Call the receive stream of |config| is to live in, and in
+    // |transport_id| the transport of the Call its feedback belongs to.
+    virtual std::shared_ptr<webrtc::Call> receiveCall(
+        const RtcAdapter::Config& config, uint32_t* transport_id) = 0;
+    // Gives back what receiveCall() claimed, once the stream is destroyed.
+    virtual void releaseReceiveCall(const RtcAdapter::Config& config) = 0;
     //virtual std::shared_ptr<webrtc::TaskQueueFactory> taskQueueFactory() = 0;
     virtual std::shared_ptr<rtc::TaskQueue> taskQueue() = 0;
     virtual std::shared_ptr<webrtc::RtcEventLog> eventLog() = 0;
+    // Drives the RtpRtcp modules of the senders; shared by the worker.
+    virtual std::shared_ptr<webrtc::ProcessThread> moduleScheduler() = 0;
+};
+
+// Recycles the buffers incoming RTP is handed to webrtc::Call in. Call only
+// keeps a reference while DeliverPacket runs, so by the time a slot comes
+// round again it is normally unshared and SetData() refills it in place
+// instead of allocating. A slot still referenced gets a fresh buffer.
+class ReceiveBufferPool {
+public:
+  static constexpr size_t kPoolSize = 8;
+  static constexpr size_t kBufferCapacity = 1500;
+
+  ReceiveBufferPool() {
+    for (auto& buffer : buffers_) {
+      buffer = rtc::CopyOnWriteBuffer(0, kBufferCapacity);
+    }
+  }
+
+  const rtc::CopyOnWriteBuffer& Fill(const char* data, size_t len) {
+    rtc::CopyOnWriteBuffer& buffer = buffers_[next_];
+    next_ = (next_ + 1) % kPoolSize;
+    buffer.SetData(data, len);
+    return buffer;
+  }
+
+private:
+  std::array<rtc::CopyOnWriteBuffer, kPoolSize> buffers_;
+  size_t next_{0};
 };
 
 } // namespace rtc_adaptor
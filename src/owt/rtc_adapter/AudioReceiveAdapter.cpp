@@ -12,6 +12,7 @@ AudioReceiveAdapterImpl::AudioReceiveAdapterImpl(
     CallOwner* owner, const RtcAdapter::Config& config)
     : config_(config), owner_(owner), rtcpListener_(config.rtp_listener) {
   assert(owner != nullptr);
+  call_ = owner_->receiveCall(config_, &transportId_);
   CreateReceiveAudio();
 }
 
@@ -21,12 +22,13 @@ AudioReceiveAdapterImpl::~AudioReceiveAdapterImpl() {
     call()->DestroyAudioReceiveStream(audioRecvStream_);
     audioRecvStream_ = nullptr;
   }
+  owner_->releaseReceiveCall(config_);
 }
 
 int AudioReceiveAdapterImpl::onRtpData(char* data, int len) {
   auto rv = call()->Receiver()->DeliverPacket(
           webrtc::MediaType::AUDIO,
-          rtc::CopyOnWriteBuffer(data, len),
+          rtpBuffers_.Fill(data, len),
           rtc::TimeUTCMicros());
   if (webrtc::PacketReceiver::DELIVERY_OK != rv) {
     OLOG_ERROR_THIS("AudioReceiveAdapterImpl DeliverPacket failed code:" << rv);
@@ -34,6 +36,42 @@ int AudioReceiveAdapterImpl::onRtpData(char* data, int len) {
   return len;
 }
 
+int AudioReceiveAdapterImpl::onRtpDataBatch(AdapterPacketSpan packets) {
+  // One receiver lookup and one arrival time for the whole batch
+  webrtc::PacketReceiver* receiver = call()->Receiver();
+  int64_t packet_time_us = rtc::TimeUTCMicros();
+  int total = 0;
+  for (const auto& packet : packets) {
+    auto rv = packet.header
+        ? receiver->DeliverRtpPacket(
+              webrtc::MediaType::AUDIO,
+              rtpBuffers_.Fill(packet.data, packet.len),
+              *packet.header,
+              packet_time_us)
+        : receiver->DeliverPacket(
+              webrtc::MediaType::AUDIO,
+              rtpBuffers_.Fill(packet.data, packet.len),
+              packet_time_us);
+    if (webrtc::PacketReceiver::DELIVERY_OK != rv) {
+      OLOG_ERROR_THIS("AudioReceiveAdapterImpl DeliverPacket failed code:" << rv);
+    }
+    total += packet.len;
+  }
+  return total;
+}
+
+void AudioReceiveAdapterImpl::getStats(AdapterRtpStats& stats) {
+  if (!audioRecvStream_) {
+    return;
+  }
+  webrtc::AudioReceiveStream::Stats recv = audioRecvStream_->GetStats();
+  stats.ssrc = recv.remote_ssrc;
+  stats.packets = recv.packets_rcvd;
+  stats.bytes = recv.payload_bytes_rcvd + recv.header_and_padding_bytes_rcvd;
+  stats.packets_lost = recv.packets_lost;
+  stats.jitter_ms = recv.jitter_ms;
+}
+
 bool AudioReceiveAdapterImpl::SendRtp(const uint8_t*,
                                       size_t,
                                       const webrtc::PacketOptions&) {
@@ -61,6 +99,7 @@ void AudioReceiveAdapterImpl::CreateReceiveAudio() {
   //config rtp 
   audio_recv_config.rtp.remote_ssrc = config_.ssrc;
   audio_recv_config.rtp.local_ssrc = kLocalSsrc;
+  audio_recv_config.rtp.transport_id = transportId_;
    
   if (config_.transport_cc != -1) {
     audio_recv_config.rtp.transport_cc = true;
@@ -23,6 +23,8 @@ class AudioReceiveAdapterImpl : public AudioReceiveAdapter,
   AudioReceiveAdapterImpl(CallOwner* owner, const RtcAdapter::Config& config);
   ~AudioReceiveAdapterImpl() override;
   int onRtpData(char* data, int len) override;
+  int onRtpDataBatch(AdapterPacketSpan packets) override;
+  void getStats(AdapterRtpStats& stats) override;
   bool SendRtp(const uint8_t* packet,
                size_t length,
                const webrtc::PacketOptions& options) override;
@@ -31,12 +33,15 @@ class AudioReceiveAdapterImpl : public AudioReceiveAdapter,
  private:
   void CreateReceiveAudio();
   std::shared_ptr<webrtc::Call> call() {
-     return owner_ ? owner_->call() : nullptr;
+     return call_;
   }
 
  private:
   RtcAdapter::Config config_;
   CallOwner* owner_{nullptr};
+  std::shared_ptr<webrtc::Call> call_;
+  uint32_t transportId_{0};
+  ReceiveBufferPool rtpBuffers_;
   webrtc::AudioReceiveStream* audioRecvStream_{nullptr};
   AdapterDataListener* rtcpListener_;
 };
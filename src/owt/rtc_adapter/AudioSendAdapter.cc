@@ -4,14 +4,15 @@
 
 #include "rtc_adapter/AudioSendAdapter.h"
 
+#include <cstring>
 #include <memory>
 
 #include "rtc_base/logging.h"
+#include "rtp_rtcp/rtp_header_view.h"
 #include "rtp_rtcp/rtp_packet.h"
 #include "owt_base/AudioUtilitiesNew.h"
 #include "owt_base/TaskRunnerPool.h"
 #include "common/rtputils.h"
-#include "rtc_adapter/thread/ProcessThreadMock.h"
 
 using namespace owt_base;
 
@@ -26,11 +27,11 @@ AudioSendAdapterImpl::AudioSendAdapterImpl(
       seqNo_(0),
       ssrc_(0),
       ssrcGenerator_(SsrcGenerator::GetSsrcGenerator()), 
+      eventLog_(callowner->eventLog()),
       config_(config), 
       rtpListener_(config.rtp_listener), 
       statsListener_(config.stats_listener), 
-      taskRunner_{std::make_unique<ProcessThreadMock>(
-          callowner->taskQueue().get())} {
+      taskRunner_{callowner->moduleScheduler()} {
   ssrc_ = ssrcGenerator_->CreateSsrc();
   ssrcGenerator_->RegisterSsrc(ssrc_);
   init();
@@ -48,6 +49,22 @@ int AudioSendAdapterImpl::onRtcpData(char* data, int len) {
   return len;
 }
 
+bool AudioSendAdapterImpl::rewriteMid(uint8_t* rtp, size_t length) {
+  webrtc::RtpHeaderView header;
+  if (!header.Parse(rtp, length)) {
+    return false;
+  }
+  rtc::ArrayView<const uint8_t> mid =
+      header.FindExtension(rtp, extensions_.GetId(webrtc::kRtpExtensionMid));
+  if (mid.size() != mid_.size()) {
+    return false;
+  }
+  // Same length, so the value is overwritten in place, the way
+  // updateSeqNo() rewrites the sequence number.
+  memcpy(const_cast<uint8_t*>(mid.data()), mid_.data(), mid_.size());
+  return true;
+}
+
 void AudioSendAdapterImpl::onFrame(const Frame& frame) {
   if (frame.format != frameFormat_) {
     frameFormat_ = frame.format;
@@ -58,8 +75,13 @@ void AudioSendAdapterImpl::onFrame(const Frame& frame) {
     // FIXME: Temporarily use Frame to carry rtp-packets
     // due to the premature AudioFrameConstructor implementation.
     updateSeqNo(frame.payload);
+    ++forwardedPackets_;
+    forwardedBytes_ += frame.length;
     if (rtpListener_) {
-      if (!mid_.empty()) {
+      if (!mid_.empty() && rewriteMid(frame.payload, frame.length)) {
+        rtpListener_->onAdapterData(
+            reinterpret_cast<char*>(frame.payload), frame.length);
+      } else if (!mid_.empty()) {
         webrtc::RtpPacket packet(&extensions_);
         packet.Parse(frame.payload, frame.length);
         packet.SetExtension<webrtc::RtpMid>(mid_);
@@ -95,7 +117,6 @@ void AudioSendAdapterImpl::onFrame(const Frame& frame) {
 
 bool AudioSendAdapterImpl::init() {
   clock_ = webrtc::Clock::GetRealTimeClock();
-  eventLog_ = std::make_unique<webrtc::RtcEventLogNull>();
 
   webrtc::RtpRtcp::Configuration configuration;
   configuration.clock = clock_;
@@ -105,6 +126,8 @@ bool AudioSendAdapterImpl::init() {
   configuration.event_log = eventLog_.get();
   configuration.local_media_ssrc = ssrc_;
   configuration.extmap_allow_mixed = true;
+  // No pacer, so no RTX payload padding to rank history packets for.
+  configuration.enable_padding_prio = false;
 
   if (config_.rtx_ssrc) {
     configuration.rtx_send_ssrc = config_.rtx_ssrc;
@@ -154,11 +177,33 @@ bool AudioSendAdapterImpl::setSendCodec(FrameFormat format) {
   }
 
   rtpRtcp_->RegisterSendPayloadFrequency(codec.pltype, codec.plfreq);
+  plfreq_ = codec.plfreq;
   senderAudio_->RegisterAudioPayload("audio", codec.pltype,
       codec.plfreq, codec.channels, 0);
   return true;
 }
 
+void AudioSendAdapterImpl::getStats(AdapterRtpStats& stats) {
+  webrtc::StreamDataCounters rtp;
+  webrtc::StreamDataCounters rtx;
+  rtpRtcp_->GetSendStreamDataCounters(&rtp, &rtx);
+  stats.ssrc = ssrc_;
+  stats.packets = forwardedPackets_ + rtp.transmitted.packets;
+  stats.bytes = forwardedBytes_ + rtp.transmitted.TotalBytes();
+  for (const webrtc::ReportBlockData& block : rtpRtcp_->GetLatestReportBlockData()) {
+    if (block.report_block().source_ssrc != ssrc_) {
+      continue;
+    }
+    stats.packets_lost = block.report_block().packets_lost;
+    if (plfreq_ >= 1000) {
+      stats.jitter_ms = block.report_block().jitter / (plfreq_ / 1000);
+    }
+    if (block.has_rtt()) {
+      stats.rtt_ms = block.last_rtt_ms();
+    }
+  }
+}
+
 void AudioSendAdapterImpl::close() {
   taskRunner_->DeRegisterModule(rtpRtcp_.get());
 }
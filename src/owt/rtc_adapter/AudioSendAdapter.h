@@ -33,6 +33,7 @@ public:
   void onFrame(const owt_base::Frame&) override;
   int onRtcpData(char* data, int len) override;
   uint32_t ssrc() override { return ssrc_; }
+  void getStats(AdapterRtpStats& stats) override;
 
   // Implement webrtc::Transport
   bool SendRtp(const uint8_t* packet,
@@ -45,6 +46,9 @@ public:
   bool setSendCodec(owt_base::FrameFormat format);
   void close();
   void updateSeqNo(uint8_t* rtp);
+  // Writes mid_ over the MID the packet already carries, if it has the
+  // same length. Returns false when the packet has to be rebuilt instead.
+  bool rewriteMid(uint8_t* rtp, size_t length);
  private: 
   std::unique_ptr<webrtc::RtpRtcp> rtpRtcp_;
 
@@ -54,9 +58,14 @@ public:
   uint16_t seqNo_;
   uint32_t ssrc_;
   owt_base::SsrcGenerator* const ssrcGenerator_;
+  // RTP packets of the publisher forwarded as they are, bypassing rtpRtcp_
+  uint64_t forwardedPackets_{0};
+  uint64_t forwardedBytes_{0};
+  int plfreq_{0};
 
   webrtc::Clock* clock_;
-  std::unique_ptr<webrtc::RtcEventLog> eventLog_;
+  // The connection's, shared with its other streams
+  std::shared_ptr<webrtc::RtcEventLog> eventLog_;
   std::unique_ptr<webrtc::RTPSenderAudio> senderAudio_;
 
   RtcAdapter::Config config_;
@@ -67,7 +76,7 @@ public:
   webrtc::RtpHeaderExtensionMap extensions_;
   std::string mid_;
   
-  std::unique_ptr<webrtc::ProcessThread> taskRunner_;
+  std::shared_ptr<webrtc::ProcessThread> taskRunner_;
 };
 } //namespace rtc_adapter
 #endif /* RTC_ADAPTER_AUDIO_SEND_ADAPTER_ */
@@ -4,13 +4,18 @@
 
 #include "RtcAdapter.h"
 
+#include <map>
 #include <memory>
 #include <mutex>
+#include <unordered_map>
 
 #include "rtc_base/clock.h"
+#include "rtc_base/logging.h"
+#include "rtc_adapter/thread/ModuleScheduler.h"
 #include "rtc_adapter/thread/ProcessThreadMock.h"
 #include "rtc_adapter/thread/StaticTaskQueueFactory.h"
 #include "rtc_adapter/AdapterInternalDefinitions.h"
+#include "rtc_adapter/RtcEventLogImpl.h"
 #include "rtc_adapter/AudioSendAdapter.h"
 #include "rtc_adapter/VideoSendAdapter.h"
 #include "rtc_adapter/AudioReceiveAdapter.h"
@@ -18,12 +23,136 @@
 
 namespace rtc_adapter {
 
+namespace {
+
+std::unique_ptr<webrtc::Call> createCall(webrtc::RtcEventLog* eventLog,
+                                         webrtc::TaskQueueFactory* factory,
+                                         rtc::TaskQueue* taskQueue) {
+  webrtc::Call::Config call_config(eventLog);
+  call_config.task_queue_factory = factory;
+
+  std::unique_ptr<webrtc::ProcessThread> moduleThread =
+    std::make_unique<ProcessThreadMock>(taskQueue);
+
+  return std::unique_ptr<webrtc::Call>(
+    webrtc::Call::Create(call_config,
+                         webrtc::Clock::GetRealTimeClock(),
+                         std::move(moduleThread)));
+}
+
+} // namespace
+
+/////////////////////////
+//WorkerCall
+// The webrtc::Call hosting the receive streams of every connection of one
+// worker. Call tells the streams apart by SSRC, so an SSRC is only handed to
+// one connection at a time; each connection gets a transport id of its own
+// so its transport-cc feedback is estimated and sent apart from the others.
+class WorkerCall : public std::enable_shared_from_this<WorkerCall> {
+public:
+  // Returns the Call of the worker behind |task_queue|, creating it when the
+  // worker has none alive.
+  static std::shared_ptr<WorkerCall> ForTaskQueue(webrtc::TaskQueueBase*);
+
+  explicit WorkerCall(webrtc::TaskQueueBase*);
+  ~WorkerCall();
+
+  // Keeps this alive as long as the Call is in use.
+  std::shared_ptr<webrtc::Call> call() {
+    return std::shared_ptr<webrtc::Call>(shared_from_this(), call_.get());
+  }
+
+  uint32_t newTransportId() { return ++lastTransportId_; }
+
+  // Claims the SSRCs of a stream for |transport_id|. Fails if another
+  // transport holds one of them.
+  bool addStream(uint32_t transport_id, uint32_t ssrc, uint32_t rtx_ssrc);
+  void removeStream(uint32_t transport_id, uint32_t ssrc, uint32_t rtx_ssrc);
+
+private:
+  webrtc::TaskQueueBase* const taskQueueBase_;
+  std::unique_ptr<webrtc::TaskQueueFactory> m_taskQueueFactory;
+  std::unique_ptr<rtc::TaskQueue> m_taskQueue;
+  // Its events mix the connections of the worker, so none are logged.
+  std::unique_ptr<webrtc::RtcEventLog> m_eventLog;
+  std::unique_ptr<webrtc::Call> call_;
+  uint32_t lastTransportId_{0};
+  std::unordered_map<uint32_t, uint32_t> transportBySsrc_;
+};
+
+namespace {
+
+std::mutex g_calls_lock;
+std::unordered_map<webrtc::TaskQueueBase*, std::weak_ptr<WorkerCall>> g_calls;
+
+} // namespace
+
+std::shared_ptr<WorkerCall> WorkerCall::ForTaskQueue(
+    webrtc::TaskQueueBase* task_queue) {
+  std::lock_guard<std::mutex> guard(g_calls_lock);
+  std::weak_ptr<WorkerCall>& slot = g_calls[task_queue];
+  std::shared_ptr<WorkerCall> call = slot.lock();
+  if (!call) {
+    call = std::make_shared<WorkerCall>(task_queue);
+    slot = call;
+  }
+  return call;
+}
+
+WorkerCall::WorkerCall(webrtc::TaskQueueBase* p)
+  : taskQueueBase_(p),
+    m_taskQueueFactory(createDummyTaskQueueFactory(p)),
+    m_taskQueue(std::make_unique<rtc::TaskQueue>(m_taskQueueFactory->CreateTaskQueue(
+                "WorkerCallTaskQueue",
+                webrtc::TaskQueueFactory::Priority::NORMAL))),
+    m_eventLog(std::make_unique<webrtc::RtcEventLogNull>()),
+    call_(createCall(m_eventLog.get(), m_taskQueueFactory.get(), m_taskQueue.get())) {
+}
+
+WorkerCall::~WorkerCall() {
+  RTC_DCHECK(transportBySsrc_.empty());
+  call_.reset();
+  std::lock_guard<std::mutex> guard(g_calls_lock);
+  auto found = g_calls.find(taskQueueBase_);
+  if (found != g_calls.end() && found->second.expired()) {
+    g_calls.erase(found);
+  }
+}
+
+bool WorkerCall::addStream(uint32_t transport_id, uint32_t ssrc,
+                           uint32_t rtx_ssrc) {
+  for (uint32_t claimed : {ssrc, rtx_ssrc}) {
+    if (claimed == 0) {
+      continue;
+    }
+    auto found = transportBySsrc_.find(claimed);
+    if (found != transportBySsrc_.end() && found->second != transport_id) {
+      return false;
+    }
+  }
+  transportBySsrc_[ssrc] = transport_id;
+  if (rtx_ssrc != 0) {
+    transportBySsrc_[rtx_ssrc] = transport_id;
+  }
+  return true;
+}
+
+void WorkerCall::removeStream(uint32_t transport_id, uint32_t ssrc,
+                              uint32_t rtx_ssrc) {
+  for (uint32_t claimed : {ssrc, rtx_ssrc}) {
+    auto found = transportBySsrc_.find(claimed);
+    if (found != transportBySsrc_.end() && found->second == transport_id) {
+      transportBySsrc_.erase(found);
+    }
+  }
+}
+
 /////////////////////////
 //RtcAdapterImpl
 class RtcAdapterImpl : public RtcAdapter,
                        public CallOwner {
 public:
-  RtcAdapterImpl(webrtc::TaskQueueBase*);
+  RtcAdapterImpl(webrtc::TaskQueueBase*, bool shareCall);
   virtual ~RtcAdapterImpl();
 
   // Implement RtcAdapter
@@ -39,10 +168,18 @@ public:
   AudioSendAdapter* createAudioSender(const Config&) override;
   void destoryAudioSender(AudioSendAdapter*) override;
 
+  bool startEventLog(const std::string& file_prefix) override;
+  void stopEventLog() override;
+
   // Implement CallOwner
-  std::shared_ptr<webrtc::Call> call() override { return call_; }
+  std::shared_ptr<webrtc::Call> receiveCall(const Config&,
+                                            uint32_t* transport_id) override;
+  void releaseReceiveCall(const Config&) override;
   std::shared_ptr<rtc::TaskQueue> taskQueue() override { return m_taskQueue; }
   std::shared_ptr<webrtc::RtcEventLog> eventLog() override { return m_eventLog; }
+  std::shared_ptr<webrtc::ProcessThread> moduleScheduler() override {
+    return m_moduleScheduler;
+  }
 
 private:
   void initCall();
@@ -51,14 +188,25 @@ private:
   std::shared_ptr<rtc::TaskQueue> m_taskQueue;
   std::shared_ptr<webrtc::RtcEventLog> m_eventLog;
   std::shared_ptr<webrtc::Call> call_;
+  std::shared_ptr<ModuleScheduler> m_moduleScheduler;
+  // Set when the receive streams go to the Call of the worker.
+  std::shared_ptr<WorkerCall> m_workerCall;
+  uint32_t m_transportId{0};
+  // SSRCs of the streams placed in the Call of the worker.
+  std::map<uint32_t, uint32_t> m_sharedStreams;
 };
 
-RtcAdapterImpl::RtcAdapterImpl(webrtc::TaskQueueBase* p)
+RtcAdapterImpl::RtcAdapterImpl(webrtc::TaskQueueBase* p, bool shareCall)
   : m_taskQueueFactory(createDummyTaskQueueFactory(p)),
     m_taskQueue(std::make_shared<rtc::TaskQueue>(m_taskQueueFactory->CreateTaskQueue(
                 "CallTaskQueue",
                 webrtc::TaskQueueFactory::Priority::NORMAL))),
-    m_eventLog(std::make_shared<webrtc::RtcEventLogNull>()) {
+    m_eventLog(std::make_shared<RtcEventLogImpl>(p)),
+    m_moduleScheduler(ModuleScheduler::ForTaskQueue(p)) {
+  if (shareCall) {
+    m_workerCall = WorkerCall::ForTaskQueue(p);
+    m_transportId = m_workerCall->newTransportId();
+  }
 }
 
 RtcAdapterImpl::~RtcAdapterImpl() {
@@ -69,20 +217,35 @@ void RtcAdapterImpl::initCall() {
     return;
   }
   
-  webrtc::Call::Config call_config(m_eventLog.get());
-  call_config.task_queue_factory = m_taskQueueFactory.get();
+  call_ = createCall(m_eventLog.get(), m_taskQueueFactory.get(), m_taskQueue.get());
+}
 
-  std::unique_ptr<webrtc::ProcessThread> moduleThread =
-    std::make_unique<ProcessThreadMock>(m_taskQueue.get());
-    
-  call_.reset(
-    webrtc::Call::Create(call_config, 
-                         webrtc::Clock::GetRealTimeClock(), 
-                         std::move(moduleThread)));
+std::shared_ptr<webrtc::Call> RtcAdapterImpl::receiveCall(
+    const Config& config, uint32_t* transport_id) {
+  if (m_workerCall) {
+    if (m_workerCall->addStream(m_transportId, config.ssrc, config.rtx_ssrc)) {
+      m_sharedStreams[config.ssrc] = config.rtx_ssrc;
+      *transport_id = m_transportId;
+      return m_workerCall->call();
+    }
+    RTC_LOG(LS_WARNING) << "ssrc " << config.ssrc
+                        << " taken in the worker call, using a private one";
+  }
+  initCall();
+  *transport_id = 0;
+  return call_;
+}
+
+void RtcAdapterImpl::releaseReceiveCall(const Config& config) {
+  auto found = m_sharedStreams.find(config.ssrc);
+  if (found == m_sharedStreams.end()) {
+    return;
+  }
+  m_workerCall->removeStream(m_transportId, found->first, found->second);
+  m_sharedStreams.erase(found);
 }
 
 VideoReceiveAdapter* RtcAdapterImpl::createVideoReceiver(const Config& config) {
-  initCall();
   return new VideoReceiveAdapterImpl(this, config);
 }
 
@@ -101,7 +264,6 @@ void RtcAdapterImpl::destoryVideoSender(VideoSendAdapter* video_send_adapter) {
 }
 
 AudioReceiveAdapter* RtcAdapterImpl::createAudioReceiver(const Config& config) {
-  initCall();
   return new AudioReceiveAdapterImpl(this, config);
 }
 
@@ -119,16 +281,27 @@ void RtcAdapterImpl::destoryAudioSender(AudioSendAdapter* audio_send_adapter) {
   delete impl;
 }
 
+bool RtcAdapterImpl::startEventLog(const std::string& file_prefix) {
+  return m_eventLog->StartLogging(
+      std::make_unique<RotatingEventLogOutput>(file_prefix),
+      webrtc::RtcEventLog::kImmediateOutput);
+}
+
+void RtcAdapterImpl::stopEventLog() {
+  m_eventLog->StopLogging();
+}
+
 /////////////////////////
 //RtcAdapterFactory
-RtcAdapterFactory::RtcAdapterFactory(webrtc::TaskQueueBase* task_queue) 
-  : task_queue_(task_queue) {
+RtcAdapterFactory::RtcAdapterFactory(webrtc::TaskQueueBase* task_queue,
+                                     bool shareCall)
+  : task_queue_(task_queue), share_call_(shareCall) {
 }
 
 std::shared_ptr<RtcAdapter> RtcAdapterFactory::CreateRtcAdapter() {
   if (!adapter_) {
     adapter_ = std::dynamic_pointer_cast<RtcAdapter>(
-        std::make_shared<RtcAdapterImpl>(task_queue_));
+        std::make_shared<RtcAdapterImpl>(task_queue_, share_call_));
   }
   return adapter_;
 }
@@ -6,7 +6,10 @@
 #define RTC_ADAPTER_RTC_ADAPTER_H_
 
 #include "myrtc/api/task_queue_base.h"
+#include "myrtc/rtc_base/array_view.h"
+#include "myrtc/rtp_rtcp/rtp_header_view.h"
 #include "owt_base/MediaFramePipeline.h"
+#include "utils/LatencyTracer.h"
 
 namespace rtc_adapter {
 
@@ -45,10 +48,48 @@ public:
   virtual ~AdapterStatsListener() = default;
 };
 
+// One packet of a batch handed to the receive adapters.
+struct AdapterPacket {
+  char* data;
+  int len;
+  // Header parsed on arrival, if any, so Call need not parse it again.
+  const webrtc::RtpHeaderView* header = nullptr;
+  // Carried over to the frame the packet ends up in.
+  wa::LatencyTrace trace;
+};
+
+using AdapterPacketSpan = rtc::ArrayView<const AdapterPacket>;
+
+// Counters of one RTP stream, read on the task queue of the adapter. RTCP
+// counts are the feedback sent for a receive stream, and the feedback
+// received for a send stream.
+struct AdapterRtpStats {
+  uint32_t ssrc = 0;
+  uint64_t packets = 0;
+  uint64_t bytes = 0;
+  int32_t packets_lost = 0;
+  uint32_t jitter_ms = 0;
+  uint32_t nack_count = 0;
+  uint32_t pli_count = 0;
+  uint32_t fir_count = 0;
+  uint32_t key_frames = 0;
+  // REMB of the peer for a send stream
+  uint32_t bwe_bps = 0;
+  int64_t rtt_ms = -1;
+};
+
 class VideoReceiveAdapter {
 public:
   virtual int onRtpData(char* data, int len) = 0;
+  virtual int onRtpDataBatch(AdapterPacketSpan packets) {
+    int total = 0;
+    for (const auto& packet : packets) {
+      total += onRtpData(packet.data, packet.len);
+    }
+    return total;
+  }
   virtual void requestKeyFrame() = 0;
+  virtual void getStats(AdapterRtpStats&) = 0;
 
   virtual ~VideoReceiveAdapter() = default;
 };
@@ -59,6 +100,7 @@ public:
   virtual int onRtcpData(char* data, int len) = 0;
   virtual uint32_t ssrc() = 0;
   virtual void reset() = 0;
+  virtual void getStats(AdapterRtpStats&) = 0;
 
   virtual ~VideoSendAdapter() = default;
 };
@@ -66,6 +108,14 @@ public:
 class AudioReceiveAdapter {
 public:
   virtual int onRtpData(char* data, int len) = 0;
+  virtual int onRtpDataBatch(AdapterPacketSpan packets) {
+    int total = 0;
+    for (const auto& packet : packets) {
+      total += onRtpData(packet.data, packet.len);
+    }
+    return total;
+  }
+  virtual void getStats(AdapterRtpStats&) = 0;
 
   virtual ~AudioReceiveAdapter() = default;
 };
@@ -75,6 +125,7 @@ public:
   virtual void onFrame(const owt_base::Frame&) = 0;
   virtual int onRtcpData(char* data, int len) = 0;
   virtual uint32_t ssrc() = 0;
+  virtual void getStats(AdapterRtpStats&) = 0;
 
   virtual ~AudioSendAdapter() = default;
 };
@@ -116,16 +167,25 @@ public:
   virtual AudioSendAdapter* createAudioSender(const Config&) = 0;
   virtual void destoryAudioSender(AudioSendAdapter*) = 0;
 
+  // Writes the events of this adapter's calls and streams to rotating
+  // <file_prefix>-<n>.rtclog files, see RtcEventLogImpl.h. False if the
+  // first file can not be opened.
+  virtual bool startEventLog(const std::string& file_prefix) = 0;
+  virtual void stopEventLog() = 0;
+
   virtual ~RtcAdapter() = default;
 };
 
 class RtcAdapterFactory {
  public:
-  RtcAdapterFactory(webrtc::TaskQueueBase*);
+  // With |shareCall| the receive streams go to the one webrtc::Call of the
+  // worker behind the task queue, instead of a Call per adapter.
+  RtcAdapterFactory(webrtc::TaskQueueBase*, bool shareCall = false);
   std::shared_ptr<RtcAdapter> CreateRtcAdapter();
  private:
   std::shared_ptr<RtcAdapter> adapter_;
   webrtc::TaskQueueBase* task_queue_;
+  bool share_call_;
 };
 
 } // namespace rtc_adapter
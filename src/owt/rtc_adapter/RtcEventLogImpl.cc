@@ -0,0 +1,701 @@
+//
+// Copyright (c) 2021- anjisuan783
+//
+// SPDX-License-Identifier: MIT
+//
+
+#include "rtc_adapter/RtcEventLogImpl.h"
+
+#include <sys/prctl.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>  // NOLINT
+#include <condition_variable>  // NOLINT
+#include <cstring>
+#include <mutex>
+#include <thread>  // NOLINT
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+
+#include "logging/rtc_event_alr_state.h"
+#include "logging/rtc_event_audio_receive_stream_config.h"
+#include "logging/rtc_event_bwe_update_delay_based.h"
+#include "logging/rtc_event_bwe_update_loss_based.h"
+#include "logging/rtc_event_probe_cluster_created.h"
+#include "logging/rtc_event_probe_result_failure.h"
+#include "logging/rtc_event_probe_result_success.h"
+#include "logging/rtc_event_remote_estimate.h"
+#include "logging/rtc_event_route_change.h"
+#include "logging/rtc_event_rtcp_packet_incoming.h"
+#include "logging/rtc_event_rtcp_packet_outgoing.h"
+#include "logging/rtc_event_rtp_packet_incoming.h"
+#include "logging/rtc_event_rtp_packet_outgoing.h"
+#include "logging/rtc_event_video_receive_stream_config.h"
+#include "logging/rtc_event_video_send_stream_config.h"
+#include "logging/rtc_stream_config.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/logging.h"
+#include "rtc_base/time_utils.h"
+#include "rtp_rtcp/rtp_header_extensions.h"
+
+namespace rtc_adapter {
+
+const char kRtcEventLogMagic[8] = {'W', 'A', 'R', 'T', 'C', 'L', 'O', 'G'};
+
+namespace {
+
+using webrtc::RtcEvent;
+
+// Per worker, at most this much waits for the drain thread.
+constexpr size_t kBufferBytes = 1 << 20;
+constexpr auto kDrainPeriod = std::chrono::milliseconds(100);
+// RTCP packets longer than this are cut.
+constexpr size_t kMaxPayload = 1536;
+
+static const char* const thread_name = "Event Log";
+
+std::atomic<uint32_t> g_next_log_id{0};
+
+// Writes varints and bytes into a fixed buffer, stopping at its end.
+class Encoder {
+ public:
+  Encoder(uint8_t* data, size_t capacity) : data_{data}, capacity_{capacity} {}
+
+  void varint(uint64_t value) {
+    while (value >= 0x80 && size_ < capacity_) {
+      data_[size_++] = static_cast<uint8_t>(value | 0x80);
+      value >>= 7;
+    }
+    if (size_ < capacity_) {
+      data_[size_++] = static_cast<uint8_t>(value);
+    }
+  }
+
+  void zigzag(int64_t value) {
+    varint((static_cast<uint64_t>(value) << 1) ^
+           static_cast<uint64_t>(value >> 63));
+  }
+
+  void bytes(const uint8_t* data, size_t len) {
+    len = std::min(len, capacity_ - size_);
+    memcpy(data_ + size_, data, len);
+    size_ += len;
+  }
+
+  void string(const std::string& value) {
+    varint(value.size());
+    bytes(reinterpret_cast<const uint8_t*>(value.data()), value.size());
+  }
+
+  size_t size() const { return size_; }
+
+ private:
+  uint8_t* data_;
+  size_t capacity_;
+  size_t size_{0};
+};
+
+// local_ssrc remote_ssrc rtx_ssrc remb rtcp_mode
+// extensions:varint {id uri:string}* codecs:varint {name:string pt rtx_pt}*
+void encodeStreamConfig(const webrtc::rtclog::StreamConfig& config,
+                        Encoder& out) {
+  out.varint(config.local_ssrc);
+  out.varint(config.remote_ssrc);
+  out.varint(config.rtx_ssrc);
+  out.varint(config.remb);
+  out.varint(static_cast<uint64_t>(config.rtcp_mode));
+  out.varint(config.rtp_extensions.size());
+  for (const auto& extension : config.rtp_extensions) {
+    out.varint(extension.id);
+    out.string(extension.uri);
+  }
+  out.varint(config.codecs.size());
+  for (const auto& codec : config.codecs) {
+    out.string(codec.payload_name);
+    out.varint(codec.payload_type);
+    out.zigzag(codec.rtx_payload_type);
+  }
+}
+
+// ssrc seq timestamp pt|marker<<7 header_length payload_length
+// padding_length transport_seq+1, 0 without the extension
+template <typename Event>
+void encodeRtp(const Event& event, Encoder& out) {
+  const webrtc::RtpPacket& header = event.header();
+  out.varint(header.Ssrc());
+  out.varint(header.SequenceNumber());
+  out.varint(header.Timestamp());
+  out.varint(header.PayloadType() | (header.Marker() ? 0x80 : 0));
+  out.varint(event.header_length());
+  out.varint(event.payload_length());
+  out.varint(event.padding_length());
+  uint16_t transport_seq = 0;
+  if (header.template GetExtension<webrtc::TransportSequenceNumber>(
+          &transport_seq)) {
+    out.varint(transport_seq + 1);
+  } else {
+    out.varint(0);
+  }
+}
+
+void encodeEvent(const RtcEvent& event, Encoder& out) {
+  switch (event.GetType()) {
+    case RtcEvent::Type::AlrStateEvent: {
+      // in_alr
+      auto& alr = static_cast<const webrtc::RtcEventAlrState&>(event);
+      out.varint(alr.in_alr());
+      break;
+    }
+    case RtcEvent::Type::RouteChangeEvent: {
+      // connected overhead
+      auto& route = static_cast<const webrtc::RtcEventRouteChange&>(event);
+      out.varint(route.connected());
+      out.varint(route.overhead());
+      break;
+    }
+    case RtcEvent::Type::RemoteEstimateEvent: {
+      // lower_bps upper_bps, zigzag and -1 when unknown
+      auto& estimate = static_cast<const webrtc::RtcEventRemoteEstimate&>(event);
+      out.zigzag(estimate.link_capacity_lower_.bps_or(-1));
+      out.zigzag(estimate.link_capacity_upper_.bps_or(-1));
+      break;
+    }
+    case RtcEvent::Type::BweUpdateDelayBased: {
+      // bitrate_bps detector_state
+      auto& bwe =
+          static_cast<const webrtc::RtcEventBweUpdateDelayBased&>(event);
+      out.varint(bwe.bitrate_bps());
+      out.varint(static_cast<uint64_t>(bwe.detector_state()));
+      break;
+    }
+    case RtcEvent::Type::BweUpdateLossBased: {
+      // bitrate_bps fraction_loss total_packets
+      auto& bwe = static_cast<const webrtc::RtcEventBweUpdateLossBased&>(event);
+      out.varint(bwe.bitrate_bps());
+      out.varint(bwe.fraction_loss());
+      out.varint(bwe.total_packets());
+      break;
+    }
+    case RtcEvent::Type::ProbeClusterCreated: {
+      // id bitrate_bps min_probes min_bytes
+      auto& probe =
+          static_cast<const webrtc::RtcEventProbeClusterCreated&>(event);
+      out.varint(probe.id());
+      out.varint(probe.bitrate_bps());
+      out.varint(probe.min_probes());
+      out.varint(probe.min_bytes());
+      break;
+    }
+    case RtcEvent::Type::ProbeResultFailure: {
+      // id reason
+      auto& probe =
+          static_cast<const webrtc::RtcEventProbeResultFailure&>(event);
+      out.varint(probe.id());
+      out.varint(static_cast<uint64_t>(probe.failure_reason()));
+      break;
+    }
+    case RtcEvent::Type::ProbeResultSuccess: {
+      // id bitrate_bps
+      auto& probe =
+          static_cast<const webrtc::RtcEventProbeResultSuccess&>(event);
+      out.varint(probe.id());
+      out.varint(probe.bitrate_bps());
+      break;
+    }
+    case RtcEvent::Type::RtcpPacketIncoming: {
+      // the packet, cut at kMaxPayload
+      auto& rtcp =
+          static_cast<const webrtc::RtcEventRtcpPacketIncoming&>(event);
+      out.bytes(rtcp.packet().data(), rtcp.packet().size());
+      break;
+    }
+    case RtcEvent::Type::RtcpPacketOutgoing: {
+      auto& rtcp =
+          static_cast<const webrtc::RtcEventRtcpPacketOutgoing&>(event);
+      out.bytes(rtcp.packet().data(), rtcp.packet().size());
+      break;
+    }
+    case RtcEvent::Type::RtpPacketIncoming:
+      encodeRtp(static_cast<const webrtc::RtcEventRtpPacketIncoming&>(event),
+                out);
+      break;
+    case RtcEvent::Type::RtpPacketOutgoing: {
+      // as incoming, then probe_cluster_id zigzag
+      auto& rtp = static_cast<const webrtc::RtcEventRtpPacketOutgoing&>(event);
+      encodeRtp(rtp, out);
+      out.zigzag(rtp.probe_cluster_id());
+      break;
+    }
+    case RtcEvent::Type::AudioReceiveStreamConfig:
+      encodeStreamConfig(
+          static_cast<const webrtc::RtcEventAudioReceiveStreamConfig&>(event)
+              .config(),
+          out);
+      break;
+    case RtcEvent::Type::VideoReceiveStreamConfig:
+      encodeStreamConfig(
+          static_cast<const webrtc::RtcEventVideoReceiveStreamConfig&>(event)
+              .config(),
+          out);
+      break;
+    case RtcEvent::Type::VideoSendStreamConfig:
+      encodeStreamConfig(
+          static_cast<const webrtc::RtcEventVideoSendStreamConfig&>(event)
+              .config(),
+          out);
+      break;
+    default:
+      // Not logged by this stack, the type and time only.
+      break;
+  }
+}
+
+// type:u8 delta_us:zigzag length:varint payload
+void appendRecord(std::string* out, uint8_t type, int64_t delta_us,
+                  const uint8_t* payload, size_t length) {
+  uint8_t header[24];
+  Encoder encoder(header, sizeof(header));
+  encoder.bytes(&type, 1);
+  encoder.zigzag(delta_us);
+  encoder.varint(length);
+  out->append(reinterpret_cast<char*>(header), encoder.size());
+  out->append(reinterpret_cast<const char*>(payload), length);
+}
+
+struct BufferedRecord {
+  int64_t timestamp_us;
+  uint32_t log_id;
+  uint16_t length;
+  uint8_t type;
+};
+
+} // namespace
+
+/////////////////////////
+//EventLogBuffer
+// Records of the logs of one worker, written by the worker thread and read by
+// the drain thread. Single producer, single consumer, no lock on either side.
+class EventLogBuffer {
+public:
+  // Returns the buffer of the worker behind |task_queue|, creating it when
+  // the worker has none alive.
+  static std::shared_ptr<EventLogBuffer> ForTaskQueue(
+      webrtc::TaskQueueBase* task_queue);
+
+  explicit EventLogBuffer(webrtc::TaskQueueBase* task_queue)
+    : task_queue_{task_queue},
+      data_{new uint8_t[kBufferBytes]} {
+  }
+
+  ~EventLogBuffer();
+
+  // Worker thread. False when the record does not fit.
+  bool push(const BufferedRecord& record, const uint8_t* payload) {
+    uint64_t head = head_.load(std::memory_order_relaxed);
+    uint64_t tail = tail_.load(std::memory_order_acquire);
+    size_t size = sizeof(record) + record.length;
+    if (kBufferBytes - (head - tail) < size) {
+      return false;
+    }
+    copyIn(head, reinterpret_cast<const uint8_t*>(&record), sizeof(record));
+    copyIn(head + sizeof(record), payload, record.length);
+    head_.store(head + size, std::memory_order_release);
+    return true;
+  }
+
+  // Drain thread. False when empty.
+  bool pop(BufferedRecord* record, uint8_t* payload) {
+    uint64_t tail = tail_.load(std::memory_order_relaxed);
+    uint64_t head = head_.load(std::memory_order_acquire);
+    if (head == tail) {
+      return false;
+    }
+    copyOut(tail, reinterpret_cast<uint8_t*>(record), sizeof(*record));
+    copyOut(tail + sizeof(*record), payload, record->length);
+    tail_.store(tail + sizeof(*record) + record->length,
+                std::memory_order_release);
+    return true;
+  }
+
+private:
+  static_assert((kBufferBytes & (kBufferBytes - 1)) == 0, "power of two");
+
+  void copyIn(uint64_t position, const uint8_t* data, size_t len) {
+    size_t offset = position & (kBufferBytes - 1);
+    size_t first = std::min(len, kBufferBytes - offset);
+    memcpy(data_.get() + offset, data, first);
+    memcpy(data_.get(), data + first, len - first);
+  }
+
+  void copyOut(uint64_t position, uint8_t* data, size_t len) {
+    size_t offset = position & (kBufferBytes - 1);
+    size_t first = std::min(len, kBufferBytes - offset);
+    memcpy(data, data_.get() + offset, first);
+    memcpy(data + first, data_.get(), len - first);
+  }
+
+  webrtc::TaskQueueBase* const task_queue_;
+  std::unique_ptr<uint8_t[]> data_;
+  // Bytes ever written and read, apart on their own cache lines.
+  alignas(64) std::atomic<uint64_t> head_{0};
+  alignas(64) std::atomic<uint64_t> tail_{0};
+};
+
+namespace {
+
+std::mutex g_buffers_lock;
+std::unordered_map<webrtc::TaskQueueBase*, std::weak_ptr<EventLogBuffer>> g_buffers;
+
+} // namespace
+
+std::shared_ptr<EventLogBuffer> EventLogBuffer::ForTaskQueue(
+    webrtc::TaskQueueBase* task_queue) {
+  std::lock_guard<std::mutex> guard(g_buffers_lock);
+  std::weak_ptr<EventLogBuffer>& slot = g_buffers[task_queue];
+  std::shared_ptr<EventLogBuffer> buffer = slot.lock();
+  if (!buffer) {
+    buffer = std::make_shared<EventLogBuffer>(task_queue);
+    slot = buffer;
+  }
+  return buffer;
+}
+
+EventLogBuffer::~EventLogBuffer() {
+  std::lock_guard<std::mutex> guard(g_buffers_lock);
+  auto found = g_buffers.find(task_queue_);
+  if (found != g_buffers.end() && found->second.expired()) {
+    g_buffers.erase(found);
+  }
+}
+
+/////////////////////////
+//EventLogDrainer
+// The thread moving the records of every worker buffer to the outputs. It
+// owns the outputs; the workers only queue additions and removals, so they
+// never wait on a file.
+class EventLogDrainer {
+public:
+  static EventLogDrainer& instance() {
+    static EventLogDrainer drainer;
+    return drainer;
+  }
+
+  void add(uint32_t log_id, std::shared_ptr<EventLogBuffer> buffer,
+           std::unique_ptr<webrtc::RtcEventLogOutput> output) {
+    std::lock_guard<std::mutex> guard(lock_);
+    added_.push_back({log_id, std::move(buffer), std::move(output)});
+    if (!thread_) {
+      thread_ = std::make_unique<std::thread>([this] { run(); });
+    }
+    cond_.notify_one();
+  }
+
+  // The output is closed after the records already buffered are written,
+  // followed by a dropped record of |dropped| the log could not buffer.
+  void remove(uint32_t log_id, uint64_t dropped) {
+    std::lock_guard<std::mutex> guard(lock_);
+    removed_.push_back({log_id, dropped});
+  }
+
+private:
+  struct Sink {
+    uint32_t log_id;
+    std::shared_ptr<EventLogBuffer> buffer;
+    std::unique_ptr<webrtc::RtcEventLogOutput> output;
+    std::string batch;
+    int64_t last_us{0};
+  };
+
+  EventLogDrainer() = default;
+
+  ~EventLogDrainer() {
+    {
+      std::lock_guard<std::mutex> guard(lock_);
+      stopped_ = true;
+    }
+    cond_.notify_one();
+    if (thread_) {
+      thread_->join();
+    }
+  }
+
+  void run() {
+    prctl(PR_SET_NAME, reinterpret_cast<unsigned long>(thread_name));
+    bool stopped = false;
+    while (!stopped) {
+      std::vector<std::pair<uint32_t, uint64_t>> removed;
+      {
+        std::unique_lock<std::mutex> guard(lock_);
+        if (sinks_.empty() && added_.empty()) {
+          cond_.wait(guard, [this] { return stopped_ || !added_.empty(); });
+        } else {
+          cond_.wait_for(guard, kDrainPeriod);
+        }
+        stopped = stopped_;
+        takeAdded();
+        removed.swap(removed_);
+      }
+      drain();
+      for (auto& log : removed) {
+        auto found = sinks_.find(log.first);
+        if (found == sinks_.end()) {
+          continue;
+        }
+        Sink& sink = found->second;
+        if (log.second) {
+          uint8_t payload[10];
+          Encoder dropped(payload, sizeof(payload));
+          dropped.varint(log.second);
+          append(&sink, kRtcEventLogDroppedRecord, rtc::TimeMicros(), payload,
+                 dropped.size());
+          write(&sink);
+        }
+        sink.output->Flush();
+        sinks_.erase(found);
+      }
+    }
+    for (auto& sink : sinks_) {
+      sink.second.output->Flush();
+    }
+    sinks_.clear();
+  }
+
+  // With |lock_| held.
+  void takeAdded() {
+    for (auto& sink : added_) {
+      uint32_t log_id = sink.log_id;
+      sinks_[log_id] = std::move(sink);
+    }
+    added_.clear();
+  }
+
+  Sink* findSink(uint32_t log_id) {
+    auto found = sinks_.find(log_id);
+    if (found == sinks_.end()) {
+      // Added after this round started, its records still came before.
+      std::lock_guard<std::mutex> guard(lock_);
+      takeAdded();
+      found = sinks_.find(log_id);
+      if (found == sinks_.end()) {
+        return nullptr;
+      }
+    }
+    return &found->second;
+  }
+
+  void drain() {
+    std::unordered_set<EventLogBuffer*> buffers;
+    for (auto& sink : sinks_) {
+      buffers.insert(sink.second.buffer.get());
+    }
+
+    BufferedRecord record;
+    uint8_t payload[kMaxPayload];
+    for (EventLogBuffer* buffer : buffers) {
+      while (buffer->pop(&record, payload)) {
+        Sink* sink = findSink(record.log_id);
+        if (sink) {
+          append(sink, record.type, record.timestamp_us, payload,
+                 record.length);
+        }
+      }
+    }
+
+    for (auto& sink : sinks_) {
+      write(&sink.second);
+    }
+  }
+
+  static void append(Sink* sink, uint8_t type, int64_t timestamp_us,
+                     const uint8_t* payload, size_t length) {
+    if (sink->batch.empty()) {
+      // Every batch starts over from an absolute time.
+      uint8_t time[10];
+      Encoder sync(time, sizeof(time));
+      sync.varint(timestamp_us);
+      appendRecord(&sink->batch, kRtcEventLogSyncRecord, 0, time, sync.size());
+      sink->last_us = timestamp_us;
+    }
+    appendRecord(&sink->batch, type, timestamp_us - sink->last_us, payload,
+                 length);
+    sink->last_us = timestamp_us;
+  }
+
+  // The batch in one Write(), so a file is only cut between batches.
+  static void write(Sink* sink) {
+    if (sink->batch.empty()) {
+      return;
+    }
+    if (sink->output->IsActive() && !sink->output->Write(sink->batch)) {
+      RTC_LOG(LS_WARNING) << "event log " << sink->log_id
+                          << " output failed, stop writing it";
+    }
+    sink->batch.clear();
+  }
+
+  std::mutex lock_;
+  std::condition_variable cond_;
+  std::vector<Sink> added_;
+  std::vector<std::pair<uint32_t, uint64_t>> removed_;
+  bool stopped_{false};
+  std::unique_ptr<std::thread> thread_;
+
+  // Drain thread only
+  std::unordered_map<uint32_t, Sink> sinks_;
+};
+
+/////////////////////////
+//RtcEventLogImpl
+RtcEventLogImpl::RtcEventLogImpl(webrtc::TaskQueueBase* task_queue)
+  : buffer_(EventLogBuffer::ForTaskQueue(task_queue)) {
+}
+
+RtcEventLogImpl::~RtcEventLogImpl() {
+  StopLogging();
+}
+
+bool RtcEventLogImpl::StartLogging(
+    std::unique_ptr<webrtc::RtcEventLogOutput> output, int64_t) {
+  if (!output || !output->IsActive()) {
+    return false;
+  }
+  if (IsLogging()) {
+    StopLogging();
+  }
+  // A new id for every output, records still buffered for the previous one
+  // are not mixed in.
+  id_ = ++g_next_log_id;
+  EventLogDrainer::instance().add(id_, buffer_, std::move(output));
+  logging_.store(true, std::memory_order_relaxed);
+  for (const auto& config : config_history_) {
+    push(*config);
+  }
+  return true;
+}
+
+void RtcEventLogImpl::StopLogging() {
+  if (!IsLogging()) {
+    return;
+  }
+  logging_.store(false, std::memory_order_relaxed);
+  // The drops after the last record buffered are written at the close.
+  EventLogDrainer::instance().remove(id_, dropped_);
+  dropped_ = 0;
+}
+
+void RtcEventLogImpl::Log(std::unique_ptr<webrtc::RtcEvent> event) {
+  if (IsLogging()) {
+    push(*event);
+  }
+  if (event->IsConfigEvent() && config_history_.size() < kMaxConfigHistory) {
+    config_history_.push_back(std::move(event));
+  }
+}
+
+bool RtcEventLogImpl::pushDropped() {
+  if (!dropped_) {
+    return true;
+  }
+  uint8_t payload[10];
+  Encoder dropped(payload, sizeof(payload));
+  dropped.varint(dropped_);
+  BufferedRecord record;
+  record.log_id = id_;
+  record.type = kRtcEventLogDroppedRecord;
+  record.timestamp_us = rtc::TimeMicros();
+  record.length = static_cast<uint16_t>(dropped.size());
+  if (!buffer_->push(record, payload)) {
+    return false;
+  }
+  dropped_ = 0;
+  return true;
+}
+
+void RtcEventLogImpl::push(const webrtc::RtcEvent& event) {
+  if (!pushDropped()) {
+    ++dropped_;
+    return;
+  }
+
+  uint8_t payload[kMaxPayload];
+  BufferedRecord record;
+  record.log_id = id_;
+  Encoder out(payload, sizeof(payload));
+  encodeEvent(event, out);
+  record.type = static_cast<uint8_t>(event.GetType());
+  record.timestamp_us = event.timestamp_us();
+  record.length = static_cast<uint16_t>(out.size());
+  if (!buffer_->push(record, payload)) {
+    ++dropped_;
+  }
+}
+
+/////////////////////////
+//RotatingEventLogOutput
+RotatingEventLogOutput::RotatingEventLogOutput(const std::string& prefix,
+                                               size_t max_file_bytes,
+                                               int max_files)
+  : prefix_(prefix),
+    max_file_bytes_(max_file_bytes),
+    max_files_(std::max(max_files, 1)) {
+  openNext();
+}
+
+RotatingEventLogOutput::~RotatingEventLogOutput() {
+  if (file_) {
+    fclose(file_);
+  }
+}
+
+bool RotatingEventLogOutput::IsActive() const {
+  return file_ != nullptr;
+}
+
+bool RotatingEventLogOutput::Write(const std::string& output) {
+  if (file_ && file_bytes_ >= max_file_bytes_) {
+    openNext();
+  }
+  if (!file_) {
+    return false;
+  }
+  if (fwrite(output.data(), 1, output.size(), file_) != output.size()) {
+    fclose(file_);
+    file_ = nullptr;
+    return false;
+  }
+  file_bytes_ += output.size();
+  return true;
+}
+
+void RotatingEventLogOutput::Flush() {
+  if (file_) {
+    fflush(file_);
+  }
+}
+
+std::string RotatingEventLogOutput::fileName(int index) const {
+  return prefix_ + "-" + std::to_string(index) + ".rtclog";
+}
+
+bool RotatingEventLogOutput::openNext() {
+  if (file_) {
+    fclose(file_);
+  }
+  ++index_;
+  file_ = fopen(fileName(index_).c_str(), "wb");
+  if (!file_) {
+    RTC_LOG(LS_WARNING) << "can not open " << fileName(index_);
+    return false;
+  }
+  fwrite(kRtcEventLogMagic, 1, sizeof(kRtcEventLogMagic), file_);
+  fwrite(&kRtcEventLogVersion, 1, 1, file_);
+  file_bytes_ = sizeof(kRtcEventLogMagic) + 1;
+  if (index_ >= max_files_) {
+    remove(fileName(index_ - max_files_).c_str());
+  }
+  return true;
+}
+
+} // namespace rtc_adapter
@@ -0,0 +1,108 @@
+//
+// Copyright (c) 2021- anjisuan783
+//
+// SPDX-License-Identifier: MIT
+//
+
+#ifndef RTC_ADAPTER_RTC_EVENT_LOG_IMPL_
+#define RTC_ADAPTER_RTC_EVENT_LOG_IMPL_
+
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "api/rtc_event_log.h"
+#include "api/task_queue_base.h"
+
+namespace rtc_adapter {
+
+// Binary format of the event log files, little room for anything but the
+// numbers, as varints where they can be small:
+//
+//   file    := magic version record*
+//   magic   := "WARTCLOG", version := u8 1
+//   record  := type:u8 delta_us:zigzag-varint length:varint payload[length]
+//
+// |type| is a webrtc::RtcEvent::Type, or one of the kRtcEventLog*Record
+// below. |delta_us| is from the previous record of the file; the first record
+// of every batch is a sync record giving the absolute rtc::TimeMicros(), so
+// a file can be cut at any batch. The payload of each type is described in
+// RtcEventLogImpl.cc, readers skip the types they do not know.
+extern const char kRtcEventLogMagic[8];
+constexpr uint8_t kRtcEventLogVersion = 1;
+// Payload: the absolute time in us, as a varint.
+constexpr uint8_t kRtcEventLogSyncRecord = 0xff;
+// Payload: events of this log dropped on a full buffer since the last one.
+constexpr uint8_t kRtcEventLogDroppedRecord = 0xfe;
+
+class EventLogBuffer;
+
+// RtcEventLog of one connection. Events are encoded on the worker thread into
+// a lock-free buffer shared by the logs of that worker, and a background
+// thread shared by all workers drains it to the outputs. While not logging,
+// Log() only drops the event, and IsLogging() lets the per packet call sites
+// skip building it.
+class RtcEventLogImpl final : public webrtc::RtcEventLog {
+ public:
+  // All calls on the worker behind |task_queue|.
+  explicit RtcEventLogImpl(webrtc::TaskQueueBase* task_queue);
+  ~RtcEventLogImpl() override;
+
+  // Implements webrtc::RtcEventLog
+  // |output_period_ms| is not used, the buffer is drained every 100ms.
+  bool StartLogging(std::unique_ptr<webrtc::RtcEventLogOutput> output,
+                    int64_t output_period_ms) override;
+  // Returns at once, the output is closed once what was logged before has
+  // been written.
+  void StopLogging() override;
+  void Log(std::unique_ptr<webrtc::RtcEvent> event) override;
+
+ private:
+  // Stream configs are kept to be replayed by every StartLogging().
+  static constexpr size_t kMaxConfigHistory = 32;
+
+  void push(const webrtc::RtcEvent& event);
+  // False while the buffer has no room for the record of |dropped_|.
+  bool pushDropped();
+
+  // Of the current output, in the records of the shared buffer.
+  uint32_t id_{0};
+  std::shared_ptr<EventLogBuffer> buffer_;
+  // Log() calls dropped on a full buffer, reported with the next one.
+  uint64_t dropped_{0};
+  std::vector<std::unique_ptr<webrtc::RtcEvent>> config_history_;
+};
+
+// Writes <prefix>-<n>.rtclog, going on to the next n once a file passed
+// |max_file_bytes| and removing the files older than the last |max_files|.
+class RotatingEventLogOutput final : public webrtc::RtcEventLogOutput {
+ public:
+  static constexpr size_t kDefaultMaxFileBytes = 16 * 1024 * 1024;
+  static constexpr int kDefaultMaxFiles = 8;
+
+  RotatingEventLogOutput(const std::string& prefix,
+                         size_t max_file_bytes = kDefaultMaxFileBytes,
+                         int max_files = kDefaultMaxFiles);
+  ~RotatingEventLogOutput() override;
+
+  // Implements webrtc::RtcEventLogOutput
+  bool IsActive() const override;
+  bool Write(const std::string& output) override;
+  void Flush() override;
+
+ private:
+  std::string fileName(int index) const;
+  bool openNext();
+
+  const std::string prefix_;
+  const size_t max_file_bytes_;
+  const int max_files_;
+  FILE* file_{nullptr};
+  int index_{-1};
+  size_t file_bytes_{0};
+};
+
+} // namespace rtc_adapter
+
+#endif
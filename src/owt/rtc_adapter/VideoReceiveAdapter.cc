@@ -9,7 +9,10 @@
 #include "video/video_error_codes.h"
 #include "video/timing.h"
 #include "rtc_base/time_utils.h"
+#include "module/module_common_types_public.h"
+#include "rtp_rtcp/byte_io.h"
 #include "common/rtputils.h"
+#include "owt_base/MediaUtilities.h"
 
 // using namespace webrtc;
 using namespace owt_base;
@@ -22,15 +25,19 @@ const uint32_t kBufferSize = 8192;
 // Local SSRC has no meaning for receive stream here
 const uint32_t kLocalSsrc = 1;
 
-static void dump(void* index, FrameFormat format, uint8_t* buf, int len) {
-  char dumpFileName[128];
-
-  snprintf(dumpFileName, 128, "/tmp/postConstructor-%p.%s", index, getFormatStr(format));
-  FILE* bsDumpfp = fopen(dumpFileName, "ab");
-  if (bsDumpfp) {
-      fwrite(buf, 1, len, bsDumpfp);
-      fclose(bsDumpfp);
+// The file is opened on the first frame and written by the background
+// AsyncFileWriter thread, the media thread never waits on the disk.
+static void dump(std::shared_ptr<wa::AsyncFileWriter>& dumpFile, 
+                 void* index, FrameFormat format, uint8_t* buf, int len) {
+  if (!dumpFile) {
+    char dumpFileName[128];
+    snprintf(dumpFileName, 128, "/tmp/postConstructor-%p.%s", index, getFormatStr(format));
+    dumpFile = wa::AsyncFileWriter::open(dumpFileName);
+    if (!dumpFile) {
+      return;
+    }
   }
+  dumpFile->write(buf, len);
 }
 
 ///////////////////////////////////
@@ -90,6 +97,23 @@ int32_t VideoReceiveAdapterImpl::AdapterDecoder::Decode(
   frame.additionalInfo.video.height = height_;
   frame.additionalInfo.video.isKeyFrame = 
       (encodedImage._frameType == webrtc::VideoFrameType::kVideoFrameKey);
+  if (format == FRAME_FORMAT_H264) {
+    // Scanned once here rather than by every subscriber's packetizer
+    buildNaluIndex(frame.payload, frame.length, frame.additionalInfo.video);
+  }
+
+  if (parent_ && parent_->frameTrace_.active()) {
+    if (frame.timeStamp == parent_->traceTimestamp_) {
+      wa::LatencyTracer::stage(wa::LatencyStage::kFrame, parent_->frameTrace_);
+      frame.traceStartNs = parent_->frameTrace_.start_ns;
+      frame.traceLastNs = parent_->frameTrace_.last_ns;
+      parent_->frameTrace_ = wa::LatencyTrace{};
+    } else if (webrtc::IsNewerTimestamp(frame.timeStamp,
+                                        parent_->traceTimestamp_)) {
+      // The traced frame was never completed
+      parent_->frameTrace_ = wa::LatencyTrace{};
+    }
+  }
 
   if (parent_) {
     if (parent_->frameListener_) {
@@ -122,7 +146,7 @@ int32_t VideoReceiveAdapterImpl::AdapterDecoder::Decode(
     if (parent_->enableDump_ && 
         (frame.format == FRAME_FORMAT_H264 || 
          frame.format == FRAME_FORMAT_H265)) {
-      dump(this, frame.format, frame.payload, frame.length);
+      dump(parent_->dumpFile_, this, frame.format, frame.payload, frame.length);
     }
     // Request key frame
     if (parent_->reqKeyFrame_) {
@@ -146,6 +170,7 @@ VideoReceiveAdapterImpl::VideoReceiveAdapterImpl(
     statsListener_(config.stats_listener), 
     owner_(owner) {
     assert(owner_ != nullptr);
+    call_ = owner_->receiveCall(config_, &transportId_);
     CreateReceiveVideo();
 }
 
@@ -155,6 +180,7 @@ VideoReceiveAdapterImpl::~VideoReceiveAdapterImpl() {
     call()->DestroyVideoReceiveStream(videoRecvStream_);
     videoRecvStream_ = nullptr;
   }
+  owner_->releaseReceiveCall(config_);
 }
 
 void VideoReceiveAdapterImpl::OnFrame(const webrtc::VideoFrame& video_frame) {
@@ -170,6 +196,7 @@ void VideoReceiveAdapterImpl::CreateReceiveVideo() {
   //config rtp 
   video_recv_config.rtp.remote_ssrc = config_.ssrc;
   video_recv_config.rtp.local_ssrc = kLocalSsrc;
+  video_recv_config.rtp.transport_id = transportId_;
   
   video_recv_config.rtp.rtcp_mode = webrtc::RtcpMode::kCompound;
     
@@ -215,6 +242,23 @@ void VideoReceiveAdapterImpl::requestKeyFrame() {
   reqKeyFrame_ = true;
 }
 
+void VideoReceiveAdapterImpl::getStats(AdapterRtpStats& stats) {
+  if (!videoRecvStream_) {
+    return;
+  }
+  webrtc::VideoReceiveStream::Stats recv = videoRecvStream_->GetStats();
+  stats.ssrc = recv.ssrc;
+  stats.packets = recv.rtp_stats.packet_counter.packets;
+  stats.bytes = recv.rtp_stats.packet_counter.TotalBytes();
+  stats.packets_lost = recv.rtp_stats.packets_lost;
+  stats.jitter_ms =
+      recv.rtp_stats.jitter / (webrtc::kVideoPayloadTypeFrequency / 1000);
+  stats.nack_count = recv.rtcp_packet_type_counts.nack_packets;
+  stats.pli_count = recv.rtcp_packet_type_counts.pli_packets;
+  stats.fir_count = recv.rtcp_packet_type_counts.fir_packets;
+  stats.key_frames = recv.frame_counts.key_frames;
+}
+
 std::vector<webrtc::SdpVideoFormat> 
 VideoReceiveAdapterImpl::GetSupportedFormats() const {
   return std::vector<webrtc::SdpVideoFormat>{
@@ -232,7 +276,7 @@ VideoReceiveAdapterImpl::CreateVideoDecoder(
 int VideoReceiveAdapterImpl::onRtpData(char* data, int len) {
   auto rv = call()->Receiver()->DeliverPacket(
           webrtc::MediaType::VIDEO,
-          rtc::CopyOnWriteBuffer(data, len),
+          rtpBuffers_.Fill(data, len),
           rtc::TimeUTCMicros());
   if (webrtc::PacketReceiver::DELIVERY_OK != rv) {
     OLOG_ERROR_THIS("VideoReceiveAdapterImpl DeliverPacket failed code:" << rv);
@@ -240,6 +284,36 @@ int VideoReceiveAdapterImpl::onRtpData(char* data, int len) {
   return len;
 }
 
+int VideoReceiveAdapterImpl::onRtpDataBatch(AdapterPacketSpan packets) {
+  // One receiver lookup and one arrival time for the whole batch
+  webrtc::PacketReceiver* receiver = call()->Receiver();
+  int64_t packet_time_us = rtc::TimeUTCMicros();
+  int total = 0;
+  for (const auto& packet : packets) {
+    if (packet.trace.active() && !frameTrace_.active() &&
+        packet.len >= static_cast<int>(webrtc::RtpHeaderView::kFixedHeaderSize)) {
+      frameTrace_ = packet.trace;
+      traceTimestamp_ = webrtc::ByteReader<uint32_t>::ReadBigEndian(
+          reinterpret_cast<const uint8_t*>(packet.data) + 4);
+    }
+    auto rv = packet.header
+        ? receiver->DeliverRtpPacket(
+              webrtc::MediaType::VIDEO,
+              rtpBuffers_.Fill(packet.data, packet.len),
+              *packet.header,
+              packet_time_us)
+        : receiver->DeliverPacket(
+              webrtc::MediaType::VIDEO,
+              rtpBuffers_.Fill(packet.data, packet.len),
+              packet_time_us);
+    if (webrtc::PacketReceiver::DELIVERY_OK != rv) {
+      OLOG_ERROR_THIS("VideoReceiveAdapterImpl DeliverPacket failed code:" << rv);
+    }
+    total += packet.len;
+  }
+  return total;
+}
+
 bool VideoReceiveAdapterImpl::SendRtp(const uint8_t* data, size_t len, 
     const webrtc::PacketOptions& options) {
   OLOG_WARN_THIS("VideoReceiveAdapterImpl SendRtp called");
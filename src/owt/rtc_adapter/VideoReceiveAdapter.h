@@ -17,6 +17,7 @@
 
 #include "rtc_adapter/AdapterInternalDefinitions.h"
 #include "rtc_adapter/RtcAdapter.h"
+#include "utils/AsyncFileWriter.h"
 
 namespace rtc_adapter {
 
@@ -30,7 +31,9 @@ public:
   virtual ~VideoReceiveAdapterImpl();
   // Implement VideoReceiveAdapter
   int onRtpData(char* data, int len) override;
+  int onRtpDataBatch(AdapterPacketSpan packets) override;
   void requestKeyFrame() override;
+  void getStats(AdapterRtpStats& stats) override;
 
   // Implements rtc::VideoSinkInterface<VideoFrame>.
   void OnFrame(const webrtc::VideoFrame& video_frame) override;
@@ -76,10 +79,11 @@ private:
   void CreateReceiveVideo();
 
   std::shared_ptr<webrtc::Call> call() {
-    return owner_ ? owner_->call() : nullptr;
+    return call_;
   }
 
   bool enableDump_{false};
+  std::shared_ptr<wa::AsyncFileWriter> dumpFile_;
   RtcAdapter::Config config_;
   // Video Statistics collected in decoder thread
   owt_base::FrameFormat format_;
@@ -92,6 +96,14 @@ private:
 
   bool reqKeyFrame_{false};
   CallOwner* owner_{nullptr};
+  std::shared_ptr<webrtc::Call> call_;
+  uint32_t transportId_{0};
+  ReceiveBufferPool rtpBuffers_;
+
+  // Earliest traced packet of the frame with RTP timestamp traceTimestamp_,
+  // handed to that frame once it is complete.
+  wa::LatencyTrace frameTrace_;
+  uint32_t traceTimestamp_{0};
 
   webrtc::VideoReceiveStream* videoRecvStream_{nullptr};
 };
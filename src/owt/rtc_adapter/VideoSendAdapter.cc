@@ -4,17 +4,20 @@
 
 #include "rtc_adapter/VideoSendAdapter.h"
 
+#include <algorithm>
+#include <limits>
+
 #include "api/rtc_event_log.h"
 #include "api/video_codec_type.h"
 #include "api/video_codec.h"
 #include "module/module_common_types.h"
 #include "rtp_rtcp/rtp_video_header.h"
 #include "rtc_base/logging.h"
+#include "video/start_code_scanner.h"
 
 #include "common/rtputils.h"
 #include "owt_base/MediaUtilities.h"
 #include "owt_base/TaskRunnerPool.h"
-#include "rtc_adapter/thread/ProcessThreadMock.h"
 
 using namespace owt_base;
 
@@ -24,99 +27,74 @@ namespace rtc_adapter {
 // in up to 2 times max video bitrate if the bandwidth estimate allows it.
 static const int TRANSMISSION_MAXBITRATE_MULTIPLIER = 2;
 
+// Upper bound on how often one subscriber asks the publisher for a key frame
+// or reports its bandwidth estimate.
+static const int64_t kKeyFrameRequestIntervalMs = 500;
+static const int64_t kBitrateHintIntervalMs = 1000;
+
 static int getNextNaluPosition(uint8_t* buffer, int buffer_size, bool& is_aud_or_sei) {
   if (buffer_size < 4) {
     return -1;
   }
   is_aud_or_sei = false;
-  uint8_t* head = buffer;
-  uint8_t* end = buffer + buffer_size - 4;
-  while (head < end) {
-    if (head[0]) {
-      head++;
-      continue;
-    }
-    if (head[1]) {
-      head += 2;
-      continue;
-    }
-    if (head[2]) {
-      head += 3;
-      continue;
-    }
-    if (head[3] != 0x01) {
-      head++;
-      continue;
-    }
-    if (((head[4] & 0x1F) == 9) || ((head[4] & 0x1F) == 6)) {
-      is_aud_or_sei = true;
+  // Only {0 0 0 1} start sequences followed by a header byte count here.
+  const int end = buffer_size - 1;
+  int pos = webrtc::FindStartCode(buffer, end);
+  while (pos < end) {
+    if (pos > 0 && buffer[pos - 1] == 0) {
+      uint8_t type = buffer[pos + 3] & 0x1F;
+      if (type == 9 || type == 6) {
+        is_aud_or_sei = true;
+      }
+      return pos - 1;
     }
-
-    return static_cast<int>(head - buffer);
+    pos += 3;
+    pos += webrtc::FindStartCode(buffer + pos, end - pos);
   }
   return -1;
 }
 
-#define MAX_NALS_PER_FRAME 128
+// Each NALU is moved down over the dropped ones as soon as the next start
+// code is found, the scan only reads bytes past what has been written, so
+// there is no bound on how many NALUs a frame has.
 static int dropAUDandSEI(uint8_t* framePayload, int frameLength) {
-  uint8_t* origin_pkt_data = framePayload;
-  int origin_pkt_length = frameLength;
-  uint8_t* head = origin_pkt_data;
-
-  std::vector<int> nal_offset;
-  std::vector<bool> nal_type_is_aud_or_sei;
-  std::vector<int> nal_size;
-  bool is_aud_or_sei = false, has_aud_or_sei = false;
-
-  int sc_positions_length = 0;
-  int sc_position = 0;
-  while (sc_positions_length < MAX_NALS_PER_FRAME) {
-    int nalu_position = getNextNaluPosition(origin_pkt_data + sc_position,
-        origin_pkt_length - sc_position, is_aud_or_sei);
-    if (nalu_position < 0) {
-        break;
-    }
-    sc_position += nalu_position;
-    nal_offset.push_back(sc_position); //include start code.
-    sc_position += 4;
-    sc_positions_length++;
-    if (is_aud_or_sei) {
-      has_aud_or_sei = true;
-      nal_type_is_aud_or_sei.push_back(true);
-    } else {
-      nal_type_is_aud_or_sei.push_back(false);
-    }
-  }
-  if (sc_positions_length == 0 || !has_aud_or_sei)
-      return frameLength;
-  // Calculate size of each NALs
-  for (unsigned int count = 0; count < nal_offset.size(); count++) {
-    if (count + 1 == nal_offset.size()) {
-      nal_size.push_back(origin_pkt_length - nal_offset[count]);
-    } else {
-      nal_size.push_back(nal_offset[count + 1] - nal_offset[count]);
+  bool is_aud_or_sei = false;
+  const int first = getNextNaluPosition(framePayload, frameLength, is_aud_or_sei);
+  // -1 until an AUD or SEI is found, the frame is left as it is without one.
+  int new_size = -1;
+  int nal_start = first;
+  while (nal_start >= 0) {
+    bool drop = is_aud_or_sei;
+    int next = nal_start + 4; //skip start code.
+    int nalu_position = getNextNaluPosition(framePayload + next,
+        frameLength - next, is_aud_or_sei);
+    int nal_end = nalu_position < 0 ? frameLength : next + nalu_position;
+    if (drop && new_size < 0) {
+      new_size = nal_start - first;
+      memmove(framePayload, framePayload + first, new_size);
+    } else if (!drop && new_size >= 0) {
+      memmove(framePayload + new_size, framePayload + nal_start,
+              nal_end - nal_start);
+      new_size += nal_end - nal_start;
     }
+    nal_start = nalu_position < 0 ? -1 : nal_end;
   }
-  // remove in place the AUD NALs
-  int new_size = 0;
-  for (unsigned int i = 0; i < nal_offset.size(); i++) {
-    if (!nal_type_is_aud_or_sei[i]) {
-      memmove(head + new_size, head + nal_offset[i], nal_size[i]);
-      new_size += nal_size[i];
-    }
-  }
-  return new_size;
+  return new_size < 0 ? frameLength : new_size;
 }
 
-static void dump(void* index, FrameFormat format, uint8_t* buf, int len) {
-  char dumpFileName[128];
-
-  snprintf(dumpFileName, 128, "/tmp/prePacketizer-%p.%s", index, getFormatStr(format));
-  FILE* bsDumpfp = fopen(dumpFileName, "ab");
-  if (bsDumpfp) {
-      fwrite(buf, 1, len, bsDumpfp);
-      fclose(bsDumpfp);
+// The file is opened on the first frame and written by the background
+// AsyncFileWriter thread, the media thread never waits on the disk.
+static void dump(std::shared_ptr<wa::AsyncFileWriter>& dumpFile, 
+                 void* index, FrameFormat format, uint8_t* buf, int len) {
+  if (!dumpFile) {
+    char dumpFileName[128];
+    snprintf(dumpFileName, 128, "/tmp/prePacketizer-%p.%s", index, getFormatStr(format));
+    dumpFile = wa::AsyncFileWriter::open(dumpFileName);
+    if (!dumpFile) {
+      return;
+    }
   }
+  dumpFile->write(buf, len);
 }
 
 //VideoSendAdapterImpl
@@ -125,11 +103,11 @@ VideoSendAdapterImpl::VideoSendAdapterImpl(CallOwner* callowner,
     : config_(config),
       frameFormat_(FRAME_FORMAT_UNKNOWN),
       ssrcGenerator_(SsrcGenerator::GetSsrcGenerator()),
+      eventLog_(callowner->eventLog()),
       feedbackListener_(config.feedback_listener),
       dataListener_(config.rtp_listener),
       statsListener_(config.stats_listener),
-      taskRunner_(std::make_unique<ProcessThreadMock>(
-          callowner->taskQueue().get())) {
+      taskRunner_(callowner->moduleScheduler()) {
     ssrc_ = ssrcGenerator_->CreateSsrc();
     ssrcGenerator_->RegisterSsrc(ssrc_);
     init();
@@ -146,17 +124,20 @@ bool VideoSendAdapterImpl::init() {
       m_clock, 1000));
 
   //configure rtp_rtcp
-  eventLog_ = std::make_unique<webrtc::RtcEventLogNull>();
   webrtc::RtpRtcp::Configuration configuration;
   configuration.clock = m_clock;
   configuration.audio = false;
   configuration.receiver_only = false;
   configuration.outgoing_transport = this;
   configuration.intra_frame_callback = this;
+  configuration.bandwidth_callback = this;
+  configuration.rtcp_packet_type_counter_observer = this;
   configuration.event_log = eventLog_.get();
   configuration.retransmission_rate_limiter = retransmissionRateLimiter_.get();
   configuration.local_media_ssrc = ssrc_;
   configuration.extmap_allow_mixed = true;
+  // No pacer, so no RTX payload padding to rank history packets for.
+  configuration.enable_padding_prio = false;
 
   if (config_.rtx_ssrc) {
     configuration.rtx_send_ssrc = config_.rtx_ssrc;
@@ -226,10 +207,7 @@ void VideoSendAdapterImpl::onFrame(const Frame& frame) {
 
   if (!keyFrameArrived_) {
     if (!frame.additionalInfo.video.isKeyFrame) {
-      if (feedbackListener_) {
-        FeedbackMsg feedback = {.type = VIDEO_FEEDBACK, .cmd = REQUEST_KEY_FRAME };
-        feedbackListener_->onFeedback(feedback);
-      }
+      requestKeyFrame();
       return;
     }
     
@@ -253,6 +231,9 @@ void VideoSendAdapterImpl::onFrame(const Frame& frame) {
       frameHeight_ = frame.additionalInfo.video.height;
   }
 
+  if (frame.additionalInfo.video.isKeyFrame) {
+    ++keyFramesSent_;
+  }
   h.frame_type = frame.additionalInfo.video.isKeyFrame ? 
                  VideoFrameType::kVideoFrameKey : 
                  VideoFrameType::kVideoFrameDelta;
@@ -262,7 +243,7 @@ void VideoSendAdapterImpl::onFrame(const Frame& frame) {
 
   int frame_length = frame.length;
   if (enableDump_) {
-    dump(this, frame.format, frame.payload, frame_length);
+    dump(dumpFile_, this, frame.format, frame.payload, frame_length);
   }
 
   /*FIXME: temporarily filter out AUD because chrome M59 could NOT handle it correctly.
@@ -272,15 +253,25 @@ void VideoSendAdapterImpl::onFrame(const Frame& frame) {
   }
   */
   
+  RTPFragmentationHeader frag_info;
+  h.codec = webrtc::VideoCodecType::kVideoCodecH264;
+
+  const VideoFrameSpecificInfo& info = frame.additionalInfo.video;
+  if (hasNaluIndex(info, frame_length)) {
+    frag_info.VerifyAndAllocateFragmentationHeader(info.naluCount);
+    for (int i = 0; i < info.naluCount; ++i) {
+      frag_info.fragmentationOffset[i] = info.nalus[i].offset;
+      frag_info.fragmentationLength[i] = info.nalus[i].length;
+    }
+  }
+
+  // Frames arriving without an index are scanned for start codes
   int nalu_found_length = 0;
   uint8_t* buffer_start = frame.payload;
-  int buffer_length = frame_length;
+  int buffer_length = frag_info.fragmentationVectorSize ? 0 : frame_length;
   int nalu_start_offset = 0;
   int nalu_end_offset = 0;
   int sc_len = 0;
-  RTPFragmentationHeader frag_info;
-
-  h.codec = webrtc::VideoCodecType::kVideoCodecH264;
   while (buffer_length > 0) {
     nalu_found_length = findNALU(buffer_start,
                                  buffer_length,
@@ -347,11 +338,73 @@ bool VideoSendAdapterImpl::SendRtcp(const uint8_t* data, size_t length) {
   return false;
 }
 
+void VideoSendAdapterImpl::requestKeyFrame() {
+  if (!feedbackListener_) {
+    return;
+  }
+  int64_t now_ms = m_clock->TimeInMilliseconds();
+  if (lastKeyFrameRequestMs_ != -1 && 
+      now_ms - lastKeyFrameRequestMs_ < kKeyFrameRequestIntervalMs) {
+    return;
+  }
+  lastKeyFrameRequestMs_ = now_ms;
+  FeedbackMsg feedback(VIDEO_FEEDBACK, REQUEST_KEY_FRAME);
+  feedbackListener_->onFeedback(feedback);
+}
+
 void VideoSendAdapterImpl::OnReceivedIntraFrameRequest(uint32_t ssrc) {
   RTC_DLOG(LS_INFO) << "onReceivedIntraFrameRequest.";
-  if (feedbackListener_) {
-    FeedbackMsg feedback = {.type = VIDEO_FEEDBACK, .cmd = REQUEST_KEY_FRAME };
-    feedbackListener_->onFeedback(feedback);
+  requestKeyFrame();
+}
+
+void VideoSendAdapterImpl::OnReceivedEstimatedBitrate(uint32_t bitrate) {
+  remoteEstimateBps_ = bitrate;
+  if (!feedbackListener_) {
+    return;
+  }
+  uint32_t kbps = std::min<uint32_t>(bitrate / 1000, 
+      std::numeric_limits<unsigned short>::max());
+  int64_t now_ms = m_clock->TimeInMilliseconds();
+  // Pass a drop on right away, anything else once per interval.
+  if (lastBitrateHintMs_ != -1 && 
+      kbps >= lastBitrateHintKbps_ &&
+      now_ms - lastBitrateHintMs_ < kBitrateHintIntervalMs) {
+    return;
+  }
+  lastBitrateHintMs_ = now_ms;
+  lastBitrateHintKbps_ = kbps;
+  FeedbackMsg feedback(VIDEO_FEEDBACK, SET_BITRATE);
+  feedback.data.kbps = static_cast<unsigned short>(kbps);
+  feedbackListener_->onFeedback(feedback);
+}
+
+void VideoSendAdapterImpl::RtcpPacketTypesCounterUpdated(
+    uint32_t ssrc, const webrtc::RtcpPacketTypeCounter& packet_counter) {
+  rtcpCounter_ = packet_counter;
+}
+
+void VideoSendAdapterImpl::getStats(AdapterRtpStats& stats) {
+  webrtc::StreamDataCounters rtp;
+  webrtc::StreamDataCounters rtx;
+  rtpRtcp_->GetSendStreamDataCounters(&rtp, &rtx);
+  stats.ssrc = ssrc_;
+  stats.packets = rtp.transmitted.packets + rtx.transmitted.packets;
+  stats.bytes = rtp.transmitted.TotalBytes() + rtx.transmitted.TotalBytes();
+  stats.nack_count = rtcpCounter_.nack_packets;
+  stats.pli_count = rtcpCounter_.pli_packets;
+  stats.fir_count = rtcpCounter_.fir_packets;
+  stats.key_frames = keyFramesSent_;
+  stats.bwe_bps = remoteEstimateBps_;
+  for (const webrtc::ReportBlockData& block : rtpRtcp_->GetLatestReportBlockData()) {
+    if (block.report_block().source_ssrc != ssrc_) {
+      continue;
+    }
+    stats.packets_lost = block.report_block().packets_lost;
+    stats.jitter_ms =
+        block.report_block().jitter / (webrtc::kVideoPayloadTypeFrequency / 1000);
+    if (block.has_rtt()) {
+      stats.rtt_ms = block.last_rtt_ms();
+    }
   }
 }
 
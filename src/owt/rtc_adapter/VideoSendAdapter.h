@@ -20,13 +20,16 @@
 #include "owt_base/SsrcGenerator.h"
 #include "rtc_base/location.h"
 #include "utility/process_thread.h"
+#include "utils/AsyncFileWriter.h"
 
 
 namespace rtc_adapter {
 
 class VideoSendAdapterImpl : public VideoSendAdapter,
                              public webrtc::Transport,
-                             public webrtc::RtcpIntraFrameObserver {
+                             public webrtc::RtcpIntraFrameObserver,
+                             public webrtc::RtcpBandwidthObserver,
+                             public webrtc::RtcpPacketTypeCounterObserver {
  public:
   VideoSendAdapterImpl(CallOwner* owner, const RtcAdapter::Config& config);
   ~VideoSendAdapterImpl();
@@ -35,6 +38,7 @@ class VideoSendAdapterImpl : public VideoSendAdapter,
   void onFrame(const owt_base::Frame&) override;
   int onRtcpData(char* data, int len) override;
   void reset() override;
+  void getStats(AdapterRtpStats& stats) override;
 
   uint32_t ssrc() { return ssrc_; }
 
@@ -47,10 +51,23 @@ class VideoSendAdapterImpl : public VideoSendAdapter,
   // Implements webrtc::RtcpIntraFrameObserver.
   void OnReceivedIntraFrameRequest(uint32_t ssrc) override;
 
+  // Implements webrtc::RtcpBandwidthObserver.
+  void OnReceivedEstimatedBitrate(uint32_t bitrate) override;
+  void OnReceivedRtcpReceiverReport(const webrtc::ReportBlockList& report_blocks,
+                                    int64_t rtt,
+                                    int64_t now_ms) override { }
+
+  // Implements webrtc::RtcpPacketTypeCounterObserver.
+  void RtcpPacketTypesCounterUpdated(
+      uint32_t ssrc,
+      const webrtc::RtcpPacketTypeCounter& packet_counter) override;
+
  private:
   bool init();
+  void requestKeyFrame();
 
   bool enableDump_{false};
+  std::shared_ptr<wa::AsyncFileWriter> dumpFile_;
   RtcAdapter::Config config_;
 
   bool keyFrameArrived_{false};
@@ -66,7 +83,19 @@ class VideoSendAdapterImpl : public VideoSendAdapter,
   webrtc::Clock* m_clock{nullptr};
   int64_t timeStampOffset_{0};
 
-  std::unique_ptr<webrtc::RtcEventLog> eventLog_;
+  // Upstream feedback is rate limited, the constructor folds it together
+  // with the other subscribers' one.
+  int64_t lastKeyFrameRequestMs_{-1};
+  int64_t lastBitrateHintMs_{-1};
+  uint32_t lastBitrateHintKbps_{0};
+
+  // Stats
+  webrtc::RtcpPacketTypeCounter rtcpCounter_;
+  uint32_t keyFramesSent_{0};
+  uint32_t remoteEstimateBps_{0};
+
+  // The connection's, shared with its other streams
+  std::shared_ptr<webrtc::RtcEventLog> eventLog_;
   std::unique_ptr<webrtc::RTPSenderVideo> senderVideo_;
   std::unique_ptr<webrtc::PlayoutDelayOracle> playoutDelayOracle_;
   std::unique_ptr<webrtc::FieldTrialBasedConfig> fieldTrialConfig_;
@@ -76,7 +105,7 @@ class VideoSendAdapterImpl : public VideoSendAdapter,
   AdapterDataListener* dataListener_;
   AdapterStatsListener* statsListener_;
 
-  std::unique_ptr<webrtc::ProcessThread> taskRunner_;
+  std::shared_ptr<webrtc::ProcessThread> taskRunner_;
 };
 
 } //namespace owt
@@ -0,0 +1,191 @@
+//
+// Copyright (c) 2021- anjisuan783
+//
+// SPDX-License-Identifier: MIT
+//
+
+#include "rtc_adapter/thread/ModuleScheduler.h"
+
+#include <mutex>
+
+#include "rtc_base/checks.h"
+#include "rtc_base/logging.h"
+#include "rtc_base/time_utils.h"
+#include "rtc_base/to_queued_task.h"
+
+namespace rtc_adapter {
+
+namespace {
+
+int64_t GetNextCallbackTime(webrtc::Module* module, int64_t time_now) {
+  int64_t interval = module->TimeUntilNextProcess();
+  if (interval < 0) {
+    // Falling behind, we should call the callback now.
+    return time_now;
+  }
+  return time_now + interval;
+}
+
+std::mutex g_schedulers_lock;
+std::unordered_map<webrtc::TaskQueueBase*, std::weak_ptr<ModuleScheduler>>
+    g_schedulers;
+
+}  // namespace
+
+std::shared_ptr<ModuleScheduler> ModuleScheduler::ForTaskQueue(
+    webrtc::TaskQueueBase* task_queue) {
+  std::lock_guard<std::mutex> guard(g_schedulers_lock);
+  std::weak_ptr<ModuleScheduler>& slot = g_schedulers[task_queue];
+  std::shared_ptr<ModuleScheduler> scheduler = slot.lock();
+  if (!scheduler) {
+    scheduler = std::make_shared<ModuleScheduler>(task_queue);
+    slot = scheduler;
+  }
+  return scheduler;
+}
+
+ModuleScheduler::ModuleScheduler(webrtc::TaskQueueBase* task_queue)
+  : task_queue_{task_queue} {
+  RTC_CHECK(task_queue_);
+  thread_checker_.Detach();
+}
+
+ModuleScheduler::~ModuleScheduler() {
+  RTC_DCHECK(modules_.empty());
+  std::lock_guard<std::mutex> guard(g_schedulers_lock);
+  auto found = g_schedulers.find(task_queue_);
+  if (found != g_schedulers.end() && found->second.expired()) {
+    g_schedulers.erase(found);
+  }
+}
+
+// Implements ProcessThread
+void ModuleScheduler::WakeUp(webrtc::Module* module) {
+  RTC_DCHECK(thread_checker_.IsCurrent());
+
+  auto found = modules_.find(module);
+  if (found == modules_.end()) {
+    RTC_DLOG(LS_ERROR) << "WakeUp module not found " << module;
+    return;
+  }
+
+  Schedule(module, found->second, rtc::TimeMillis());
+  ArmTimer();
+}
+
+// Implements ProcessThread
+void ModuleScheduler::PostTask(std::unique_ptr<webrtc::QueuedTask> task) {
+  task_queue_->PostTask(std::move(task));
+}
+
+// Implements ProcessThread
+void ModuleScheduler::RegisterModule(webrtc::Module* module,
+                                     const rtc::Location& from) {
+  RTC_DCHECK(module) << from.ToString();
+  RTC_DCHECK(thread_checker_.IsCurrent());
+
+  auto insert_result = modules_.emplace(module, ModuleState{from});
+  RTC_DCHECK(insert_result.second)
+        << "Already registered here: " <<
+           insert_result.first->second.location.ToString() << "\n"
+        << "Now attempting from here: " << from.ToString();
+
+  module->ProcessThreadAttached(this);
+
+  Schedule(module, insert_result.first->second,
+           GetNextCallbackTime(module, rtc::TimeMillis()));
+  ArmTimer();
+}
+
+// Implements ProcessThread
+void ModuleScheduler::DeRegisterModule(webrtc::Module* module) {
+  RTC_DCHECK(module);
+  RTC_DCHECK(thread_checker_.IsCurrent());
+
+  // Notify the module that it's been detached.
+  module->ProcessThreadAttached(nullptr);
+
+  // Its heap entries are dropped as they come due.
+  modules_.erase(module);
+}
+
+void ModuleScheduler::Schedule(webrtc::Module* module,
+                               ModuleState& state,
+                               int64_t time) {
+  deadlines_.push(Deadline{time, module, ++state.generation});
+}
+
+void ModuleScheduler::ArmTimer() {
+  // Drop entries of modules rescheduled or deregistered since.
+  while (!deadlines_.empty()) {
+    const Deadline& top = deadlines_.top();
+    auto found = modules_.find(top.module);
+    if (found != modules_.end() && found->second.generation == top.generation) {
+      break;
+    }
+    deadlines_.pop();
+  }
+
+  if (deadlines_.empty()) {
+    return;
+  }
+
+  int64_t deadline = deadlines_.top().time;
+  if (timer_armed_ && timer_deadline_ <= deadline) {
+    return;
+  }
+
+  timer_armed_ = true;
+  timer_deadline_ = deadline;
+  uint32_t generation = ++timer_generation_;
+  std::weak_ptr<ModuleScheduler> weak_this = weak_from_this();
+  auto task = webrtc::ToQueuedTask([weak_this, generation]() {
+    auto self = weak_this.lock();
+    if (!self || self->timer_generation_ != generation) {
+      return;
+    }
+    self->timer_armed_ = false;
+    self->Process();
+  });
+
+  int64_t time_to_wait = deadline - rtc::TimeMillis();
+  if (time_to_wait > 0) {
+    task_queue_->PostDelayedTask(std::move(task),
+                                 static_cast<uint32_t>(time_to_wait));
+  } else {
+    task_queue_->PostTask(std::move(task));
+  }
+}
+
+void ModuleScheduler::Process() {
+  RTC_DCHECK(thread_checker_.IsCurrent());
+
+  int64_t now = rtc::TimeMillis();
+  while (!deadlines_.empty() && deadlines_.top().time <= now) {
+    due_.push_back(deadlines_.top());
+    deadlines_.pop();
+  }
+
+  for (const Deadline& due : due_) {
+    auto found = modules_.find(due.module);
+    if (found == modules_.end() ||
+        found->second.generation != due.generation) {
+      continue;
+    }
+
+    due.module->Process();
+
+    // Process() may have deregistered or woken up the module.
+    found = modules_.find(due.module);
+    if (found != modules_.end() &&
+        found->second.generation == due.generation) {
+      Schedule(due.module, found->second,
+               GetNextCallbackTime(due.module, rtc::TimeMillis()));
+    }
+  }
+  due_.clear();
+
+  ArmTimer();
+}
+
+} // namespace rtc_adapter
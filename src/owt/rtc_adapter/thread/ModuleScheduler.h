@@ -0,0 +1,95 @@
+//
+// Copyright (c) 2021- anjisuan783
+//
+// SPDX-License-Identifier: MIT
+//
+
+#ifndef RTC_ADAPTER_THREAD_MODULE_SCHEDULER_
+#define RTC_ADAPTER_THREAD_MODULE_SCHEDULER_
+
+#include <memory>
+#include <queue>
+#include <unordered_map>
+#include <vector>
+
+#include "api/task_queue_base.h"
+#include "rtc_base/location.h"
+#include "rtc_base/thread_checker.h"
+#include "module/module.h"
+#include "utility/process_thread.h"
+
+namespace rtc_adapter {
+
+// ModuleScheduler drives the modules of every sender on one worker. Modules
+// wait in a min-heap keyed by their next deadline, only the due ones are
+// processed, and a single timer is armed for the earliest remaining one.
+class ModuleScheduler : public webrtc::ProcessThread,
+                        public std::enable_shared_from_this<ModuleScheduler> {
+ public:
+  // Returns the scheduler of the worker behind |task_queue|, creating it when
+  // the worker has none alive.
+  static std::shared_ptr<ModuleScheduler> ForTaskQueue(
+      webrtc::TaskQueueBase* task_queue);
+
+  explicit ModuleScheduler(webrtc::TaskQueueBase*);
+  ~ModuleScheduler() override;
+
+  // Implements ProcessThread
+  void Start() override {}
+
+  // Implements ProcessThread
+  // Stop() has no effect, the worker owns the thread
+  void Stop() override {}
+
+  // Implements ProcessThread
+  void WakeUp(webrtc::Module* module) override;
+
+  // Implements ProcessThread
+  void PostTask(std::unique_ptr<webrtc::QueuedTask> task) override;
+
+  // Implements ProcessThread
+  void RegisterModule(webrtc::Module* module, const rtc::Location& from) override;
+
+  // Implements ProcessThread
+  void DeRegisterModule(webrtc::Module* module) override;
+
+ private:
+  struct ModuleState {
+    rtc::Location location;
+    // Bumped on every reschedule, so older heap entries can be told apart.
+    uint32_t generation = 0;
+  };
+
+  struct Deadline {
+    int64_t time;
+    webrtc::Module* module;
+    uint32_t generation;
+    bool operator>(const Deadline& other) const {
+      return time > other.time;
+    }
+  };
+
+  void Schedule(webrtc::Module* module, ModuleState& state, int64_t time);
+  void ArmTimer();
+  void Process();
+
+  webrtc::TaskQueueBase* const task_queue_;
+
+  std::unordered_map<webrtc::Module*, ModuleState> modules_;
+  std::priority_queue<Deadline, std::vector<Deadline>, std::greater<Deadline>>
+      deadlines_;
+  // Entries taken off the heap by one Process() run.
+  std::vector<Deadline> due_;
+
+  // The single pending timer; a timer whose generation no longer matches
+  // was superseded by an earlier one and does nothing when it fires.
+  bool timer_armed_ = false;
+  int64_t timer_deadline_ = 0;
+  uint32_t timer_generation_ = 0;
+
+  webrtc::SequenceChecker thread_checker_;
+};
+
+} // namespace rtc_adapter
+
+#endif //RTC_ADAPTER_THREAD_MODULE_SCHEDULER_
@@ -0,0 +1,123 @@
+// Copyright (c) 2021- anjisuan783
+//
+// SPDX-License-Identifier: MIT
+
+// Times the FEC XOR kernels over the packet masks of fec_private_tables,
+// protecting 1 to 48 media packets with half as many FEC packets.
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <vector>
+
+#include "rtc_base/cpu_info.h"
+#include "rtp_rtcp/forward_error_correction_internal.h"
+
+namespace {
+
+const int kRounds = 200;
+const size_t kPayloadSize = 1200;
+
+typedef void (*XorKernel)(uint8_t*, const uint8_t*, size_t);
+
+struct Masks {
+  int num_media;
+  int num_fec;
+  std::vector<uint8_t> bytes;
+  size_t row_size;
+};
+
+std::vector<Masks> makeMasks(webrtc::FecMaskType type) {
+  std::vector<Masks> all;
+  for (int k = 1; k <= static_cast<int>(webrtc::kUlpfecMaxMediaPackets); ++k) {
+    webrtc::internal::PacketMaskTable table(type, k);
+    Masks m;
+    m.num_media = k;
+    m.num_fec = std::max(1, k / 2);
+    m.row_size = webrtc::internal::PacketMaskSize(k);
+    m.bytes.resize(m.num_fec * m.row_size);
+    webrtc::internal::GeneratePacketMasks(k, m.num_fec, 0, false, &table,
+                                          m.bytes.data());
+    all.push_back(std::move(m));
+  }
+  return all;
+}
+
+// XORs every protected media payload into its FEC payload, like
+// ForwardErrorCorrection::GenerateFecPayloads. Returns a checksum.
+uint32_t encode(XorKernel kernel, const Masks& m,
+                const std::vector<std::vector<uint8_t>>& media,
+                std::vector<std::vector<uint8_t>>& fec) {
+  uint32_t sum = 0;
+  for (int f = 0; f < m.num_fec; ++f) {
+    memset(fec[f].data(), 0, kPayloadSize);
+    const uint8_t* row = &m.bytes[f * m.row_size];
+    for (int i = 0; i < m.num_media; ++i) {
+      if (row[i / 8] & (1 << (7 - i % 8)))
+        kernel(fec[f].data(), media[i].data(), media[i].size());
+    }
+    sum = sum * 31 + fec[f][0] + fec[f][kPayloadSize - 1];
+  }
+  return sum;
+}
+
+void run(const char* name, XorKernel kernel, const std::vector<Masks>& masks,
+         const std::vector<std::vector<uint8_t>>& media, uint32_t expected) {
+  std::vector<std::vector<uint8_t>> fec(
+      webrtc::kUlpfecMaxMediaPackets, std::vector<uint8_t>(kPayloadSize));
+  printf("%-5s", name);
+  uint32_t sum = 0;
+  for (const Masks& m : masks) {
+    auto begin = std::chrono::steady_clock::now();
+    for (int r = 0; r < kRounds; ++r) {
+      sum += encode(kernel, m, media, fec);
+    }
+    auto elapsed = std::chrono::duration<double>(
+        std::chrono::steady_clock::now() - begin).count();
+    if (m.num_media % 8 == 0 || m.num_media == 1) {
+      printf(" %2d:%7.2fus", m.num_media, elapsed * 1e6 / kRounds);
+    }
+  }
+  printf("\n");
+  if (expected && sum != expected) {
+    printf("%s produced different FEC payloads\n", name);
+    exit(1);
+  }
+}
+
+}  // namespace
+
+int main() {
+  std::mt19937 rng(48);
+  std::vector<std::vector<uint8_t>> media(webrtc::kUlpfecMaxMediaPackets);
+  for (auto& payload : media) {
+    // Odd sizes exercise the kernels' tails.
+    payload.resize(kPayloadSize - rng() % 64);
+    for (auto& b : payload)
+      b = static_cast<uint8_t>(rng());
+  }
+
+  const char* kTypeNames[] = {"random", "bursty"};
+  for (auto type : {webrtc::kFecMaskRandom, webrtc::kFecMaskBursty}) {
+    std::vector<Masks> masks = makeMasks(type);
+    std::vector<std::vector<uint8_t>> fec(
+        webrtc::kUlpfecMaxMediaPackets, std::vector<uint8_t>(kPayloadSize));
+    uint32_t expected = 0;
+    for (int r = 0; r < kRounds; ++r) {
+      for (const Masks& m : masks)
+        expected += encode(webrtc::internal::XorBytes_C, m, media, fec);
+    }
+    printf("%s masks, us per FEC block by media packet count\n",
+           kTypeNames[type]);
+    run("C", webrtc::internal::XorBytes_C, masks, media, expected);
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+    run("SSE2", webrtc::internal::XorBytes_SSE2, masks, media, expected);
+    if (webrtc::CpuInfo::Supports(webrtc::CpuInfo::kAVX2))
+      run("AVX2", webrtc::internal::XorBytes_AVX2, masks, media, expected);
+#endif
+    run("auto", webrtc::internal::XorBytes, masks, media, expected);
+  }
+  return 0;
+}
@@ -0,0 +1,758 @@
+// Copyright (c) 2021- anjisuan783
+//
+// SPDX-License-Identifier: MIT
+
+#include "test/loopback_harness.h"
+
+#include <sys/resource.h>
+#include <sys/socket.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <future>
+#include <random>
+#include <sstream>
+#include <thread>
+
+#include "h/rtc_stack_api.h"
+#include "erizo/rtp/RtpHeaders.h"
+#include "myrtc/rtp_rtcp/nack.h"
+#include "myrtc/rtp_rtcp/receiver_report.h"
+#include "myrtc/rtp_rtcp/transport_feedback.h"
+
+namespace loopback {
+
+namespace {
+
+const char kTransportCcUri[] =
+    "http://www.ietf.org/id/draft-holmer-rmcat-transport-wide-cc-extensions-01";
+const char kMidUri[] = "urn:ietf:params:rtp-hdrext:sdes:mid";
+
+const int kFeedbackTickMs = 20;
+const int kTransportFeedbackMs = 100;
+const int kReceiverReportMs = 1000;
+const int64_t kNackIntervalNs = 30 * 1000 * 1000;
+const int kMaxNackTries = 3;
+const int kMaxNackGap = 500;
+
+const char kStampMagic[] = "WAts";
+
+// Value of the one-byte header extension |id| of an RTP packet, or nullptr.
+const uint8_t* findExtension(const uint8_t* p, int length, int id,
+                             int* ext_length) {
+  const erizo::RtpHeader* header = reinterpret_cast<const erizo::RtpHeader*>(p);
+  if (id <= 0 || !header->getExtension() || header->getExtId() != 0xBEDE ||
+      header->getHeaderLength() > length) {
+    return nullptr;
+  }
+  const uint8_t* ext = p + 16;
+  const uint8_t* end = p + header->getHeaderLength();
+  while (ext < end) {
+    if (*ext == 0) {
+      ++ext;
+      continue;
+    }
+    int ext_id = *ext >> 4;
+    int len = (*ext & 0xf) + 1;
+    if (ext_id == 15 || ext + 1 + len > end) {
+      break;
+    }
+    if (ext_id == id) {
+      *ext_length = len;
+      return ext + 1;
+    }
+    ext += 1 + len;
+  }
+  return nullptr;
+}
+
+int64_t unwrap(int64_t* last, uint16_t seq) {
+  int64_t unwrapped =
+      *last + static_cast<int16_t>(seq - static_cast<uint16_t>(*last));
+  if (*last < 0) {
+    unwrapped = seq;
+  }
+  *last = unwrapped;
+  return unwrapped;
+}
+
+class ServerSink : public wa::WebrtcAgentSink {
+ public:
+  ServerSink(Channel* channel, const std::string& id)
+      : channel_(channel), id_(id) {}
+
+  void onFailed(const std::string& reason) override {
+    channel_->send("failed", id_, reason);
+  }
+  // The answer carries the candidates of the lite agent.
+  void onCandidate(const std::string&) override {}
+  void onReady() override {
+    channel_->send("ready", id_, "");
+  }
+  void onAnswer(const std::string& sdp) override {
+    channel_->send("answer", id_, sdp);
+  }
+  void onFrame(const owt_base::Frame&) override {}
+  void onStat() override {}
+
+ private:
+  Channel* channel_;
+  std::string id_;
+};
+
+std::vector<wa::TTrackInfo> loadTracks() {
+  wa::TTrackInfo audio;
+  audio.mid_ = "0";
+  audio.type_ = wa::media_audio;
+  audio.preference_.format_ = wa::p_opus;
+  wa::TTrackInfo video;
+  video.mid_ = "1";
+  video.type_ = wa::media_video;
+  video.preference_.format_ = wa::p_h264;
+  video.preference_.profile_ = "42e01f";
+  return {audio, video};
+}
+
+}  // namespace
+
+int64_t nowNs() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+      std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+int64_t cpuNs() {
+  struct rusage usage;
+  getrusage(RUSAGE_SELF, &usage);
+  return (usage.ru_utime.tv_sec + usage.ru_stime.tv_sec) * 1000000000LL +
+         (usage.ru_utime.tv_usec + usage.ru_stime.tv_usec) * 1000LL;
+}
+
+void runOn(wa::Worker* worker, std::function<void()> f) {
+  auto done = std::make_shared<std::promise<void>>();
+  std::future<void> future = done->get_future();
+  worker->task([f, done] {
+    f();
+    done->set_value();
+  });
+  future.wait();
+}
+
+void writeStamp(uint8_t* p, int64_t ns) {
+  static const char kHex[] = "0123456789abcdef";
+  memcpy(p, kStampMagic, 4);
+  for (int i = 0; i < 16; ++i) {
+    p[4 + i] = kHex[(ns >> ((15 - i) * 4)) & 0xf];
+  }
+}
+
+int64_t readStamp(const uint8_t* payload, int length) {
+  int end = std::min(length, 32) - static_cast<int>(kStampSize);
+  for (int i = 0; i <= end; ++i) {
+    if (memcmp(payload + i, kStampMagic, 4) != 0) {
+      continue;
+    }
+    int64_t ns = 0;
+    for (int j = 0; j < 16; ++j) {
+      char c = payload[i + 4 + j];
+      ns = (ns << 4) | (c <= '9' ? c - '0' : c - 'a' + 10);
+    }
+    return ns;
+  }
+  return 0;
+}
+
+int writeRtpHeader(uint8_t* p, uint8_t payload_type, bool marker, uint16_t seq,
+                   uint32_t timestamp, uint32_t ssrc, uint16_t transport_seq,
+                   char mid) {
+  erizo::RtpHeader* header = reinterpret_cast<erizo::RtpHeader*>(p);
+  *header = erizo::RtpHeader();
+  header->setPayloadType(payload_type);
+  header->setMarker(marker);
+  header->setSeqNumber(seq);
+  header->setTimestamp(timestamp);
+  header->setSSRC(ssrc);
+  header->setExtension(1);
+  header->setExtId(0xBEDE);
+  header->setExtLength(2);
+  uint8_t* ext = p + 16;
+  ext[0] = (kTransportCcExtId << 4) | 1;
+  ext[1] = transport_seq >> 8;
+  ext[2] = transport_seq & 0xff;
+  ext[3] = kMidExtId << 4;
+  ext[4] = mid;
+  ext[5] = ext[6] = ext[7] = 0;
+  return header->getHeaderLength();
+}
+
+// Channel
+
+bool Channel::send(const std::string& type, const std::string& id,
+                   const std::string& body) {
+  std::string data = type + " " + (id.empty() ? "-" : id) + " " +
+                     std::to_string(body.size()) + "\n" + body;
+  std::lock_guard<std::mutex> guard(send_lock_);
+  size_t sent = 0;
+  while (sent < data.size()) {
+    ssize_t n = ::send(fd_, data.data() + sent, data.size() - sent,
+                       MSG_NOSIGNAL);
+    if (n <= 0) {
+      return false;
+    }
+    sent += n;
+  }
+  return true;
+}
+
+bool Channel::receive(Message* message) {
+  size_t newline;
+  while ((newline = buffer_.find('\n')) == std::string::npos) {
+    if (!fill()) {
+      return false;
+    }
+  }
+  std::istringstream header(buffer_.substr(0, newline));
+  size_t length = 0;
+  header >> message->type >> message->id >> length;
+  buffer_.erase(0, newline + 1);
+  while (buffer_.size() < length) {
+    if (!fill()) {
+      return false;
+    }
+  }
+  message->body = buffer_.substr(0, length);
+  buffer_.erase(0, length);
+  return true;
+}
+
+void Channel::shutdown() {
+  ::shutdown(fd_, SHUT_RDWR);
+}
+
+bool Channel::fill() {
+  char data[4096];
+  ssize_t n = ::recv(fd_, data, sizeof(data), 0);
+  if (n <= 0) {
+    return false;
+  }
+  buffer_.append(data, n);
+  return true;
+}
+
+int runAgent(Channel* channel, uint32_t workers) {
+  std::unique_ptr<wa::rtc_api> agent = wa::AgentFactory().create_agent();
+  if (agent->initiate(workers, {kLoopbackAddress},
+                      std::string("udp://") + kLoopbackAddress + ":0") != 0) {
+    return 1;
+  }
+
+  std::vector<std::string> publishers;
+  std::vector<std::string> subscribers;
+  Message message;
+  while (channel->receive(&message)) {
+    if (message.type == "publish" || message.type == "subscribe") {
+      wa::TOption option;
+      option.connectId_ = message.id;
+      option.stream_name_ = message.id;
+      option.tracks_ = loadTracks();
+      option.call_back_ = std::make_shared<ServerSink>(channel, message.id);
+      int result;
+      if (message.type == "publish") {
+        result = agent->publish(option, message.body);
+        publishers.push_back(message.id);
+      } else {
+        result = agent->subscribe(option, message.body);
+        subscribers.push_back(message.id);
+      }
+      if (result != 0) {
+        channel->send("failed", message.id, message.type);
+      }
+    } else if (message.type == "linkup") {
+      // |id| is the subscriber, the body its publisher
+      if (agent->linkup(message.body, message.id) != 0) {
+        channel->send("failed", message.id, "linkup");
+      }
+    } else if (message.type == "cpu") {
+      channel->send("cpu", "", std::to_string(cpuNs()));
+    } else if (message.type == "quit") {
+      break;
+    }
+  }
+
+  for (const std::string& id : subscribers) {
+    agent->unsubscribe(id);
+  }
+  for (const std::string& id : publishers) {
+    agent->unpublish(id);
+  }
+  std::this_thread::sleep_for(std::chrono::milliseconds(500));
+  return 0;
+}
+
+// CounterValues
+
+void CounterValues::add(const PeerCounters& counters) {
+  packets += counters.packets.load(std::memory_order_relaxed);
+  bytes += counters.bytes.load(std::memory_order_relaxed);
+  expected += counters.expected.load(std::memory_order_relaxed);
+  received += counters.received.load(std::memory_order_relaxed);
+  recovered += counters.recovered.load(std::memory_order_relaxed);
+  nacks += counters.nacks.load(std::memory_order_relaxed);
+  rtcp += counters.rtcp.load(std::memory_order_relaxed);
+  key_requests += counters.key_requests.load(std::memory_order_relaxed);
+}
+
+CounterValues CounterValues::operator-(const CounterValues& other) const {
+  CounterValues result;
+  result.packets = packets - other.packets;
+  result.bytes = bytes - other.bytes;
+  result.expected = expected - other.expected;
+  result.received = received - other.received;
+  result.recovered = recovered - other.recovered;
+  result.nacks = nacks - other.nacks;
+  result.rtcp = rtcp - other.rtcp;
+  result.key_requests = key_requests - other.key_requests;
+  return result;
+}
+
+// LoopbackPeer
+
+LoopbackPeer::LoopbackPeer(const std::string& id, bool publish, int tick_ms,
+                           std::shared_ptr<wa::Worker> worker,
+                           std::shared_ptr<wa::IOWorker> io_worker)
+    : id_(id), publish_(publish), tick_ms_(tick_ms),
+      worker_(std::move(worker)), io_worker_(std::move(io_worker)) {
+  std::random_device random;
+  local_ssrc_ = random();
+  audio_ssrc_ = random();
+  video_ssrc_ = random();
+}
+
+std::string LoopbackPeer::start() {
+  std::string offer;
+  runOn(worker_.get(), [this, &offer] {
+    erizo::IceConfig config;
+    config.ip_addresses = {kLoopbackAddress};
+    config.ice_components = 1;
+    config.ice_controlling = true;
+    transport_ = std::make_shared<erizo::DtlsTransport>(
+        erizo::VIDEO_TYPE, "video", id_, true, true, shared_from_this(),
+        config, "", "", false, worker_.get(), io_worker_.get());
+    transport_->start();
+    erizo::IceConnection* ice = transport_->getIceConnection();
+    offer = makeOffer(ice->getLocalUsername(), ice->getLocalPassword(),
+                      transport_->getMyFingerprint());
+  });
+  return offer;
+}
+
+void LoopbackPeer::onAnswer(const std::string& sdp) {
+  std::weak_ptr<LoopbackPeer> weak_this = shared_from_this();
+  worker_->task([weak_this, sdp] {
+    if (auto this_ptr = weak_this.lock()) {
+      this_ptr->onAnswerSync(sdp);
+    }
+  });
+}
+
+void LoopbackPeer::close() {
+  runOn(worker_.get(), [this] {
+    closed_ = true;
+    if (transport_) {
+      transport_->close();
+      transport_.reset();
+    }
+  });
+}
+
+void LoopbackPeer::onTransportData(std::shared_ptr<erizo::DataPacket> packet,
+                                   erizo::Transport*) {
+  if (closed_ || packet->length < 12) {
+    return;
+  }
+  const uint8_t* data = reinterpret_cast<const uint8_t*>(packet->data);
+  erizo::RtcpHeader* rtcp = reinterpret_cast<erizo::RtcpHeader*>(packet->data);
+  if (rtcp->isRtcp()) {
+    counters_.rtcp.fetch_add(1, std::memory_order_relaxed);
+    onRtcp(data, packet->length);
+  } else {
+    onRtp(data, packet->length, nowNs());
+  }
+}
+
+void LoopbackPeer::updateState(TransportState state, erizo::Transport*) {
+  if (state == TRANSPORT_READY && !ready_) {
+    ready_ = true;
+    std::weak_ptr<LoopbackPeer> weak_this = shared_from_this();
+    worker_->scheduleEvery([weak_this] {
+      auto this_ptr = weak_this.lock();
+      if (!this_ptr || this_ptr->closed_) {
+        return false;
+      }
+      this_ptr->onTick(nowNs());
+      return true;
+    }, std::chrono::milliseconds(tick_ms_));
+  } else if (state == TRANSPORT_FAILED) {
+    failed_ = true;
+  }
+}
+
+void LoopbackPeer::send(const uint8_t* data, int length) {
+  if (!transport_) {
+    return;
+  }
+  wa::LatencyTrace trace;
+  transport_->write(reinterpret_cast<char*>(const_cast<uint8_t*>(data)),
+                    length, trace);
+  counters_.packets.fetch_add(1, std::memory_order_relaxed);
+  counters_.bytes.fetch_add(length, std::memory_order_relaxed);
+}
+
+void LoopbackPeer::sendRtcp(const webrtc::rtcp::RtcpPacket& rtcp) {
+  rtc::Buffer packet = rtcp.Build();
+  if (transport_ && packet.size()) {
+    wa::LatencyTrace trace;
+    transport_->write(reinterpret_cast<char*>(packet.data()),
+                      static_cast<int>(packet.size()), trace);
+  }
+}
+
+std::string LoopbackPeer::makeOffer(const std::string& ufrag,
+                                    const std::string& pwd,
+                                    const std::string& fingerprint) const {
+  const char* direction = publish_ ? "sendonly" : "recvonly";
+  std::ostringstream sdp;
+  sdp << "v=0\r\n"
+      << "o=- " << local_ssrc_ << " 2 IN IP4 " << kLoopbackAddress << "\r\n"
+      << "s=-\r\n"
+      << "t=0 0\r\n"
+      << "a=group:BUNDLE 0 1\r\n"
+      << "a=msid-semantic: WMS " << id_ << "\r\n";
+
+  auto media = [&](const char* kind, int payload_type, const char* mid) {
+    sdp << "m=" << kind << " 9 UDP/TLS/RTP/SAVPF " << payload_type << "\r\n"
+        << "c=IN IP4 0.0.0.0\r\n"
+        << "a=rtcp:9 IN IP4 0.0.0.0\r\n"
+        << "a=ice-ufrag:" << ufrag << "\r\n"
+        << "a=ice-pwd:" << pwd << "\r\n"
+        << "a=fingerprint:sha-256 " << fingerprint << "\r\n"
+        << "a=setup:active\r\n"
+        << "a=mid:" << mid << "\r\n"
+        << "a=extmap:" << kTransportCcExtId << " " << kTransportCcUri << "\r\n"
+        << "a=extmap:" << kMidExtId << " " << kMidUri << "\r\n"
+        << "a=" << direction << "\r\n"
+        << "a=rtcp-mux\r\n";
+  };
+  auto source = [&](uint32_t ssrc, const char* track) {
+    if (!publish_) {
+      return;
+    }
+    sdp << "a=ssrc:" << ssrc << " cname:" << id_ << "\r\n"
+        << "a=ssrc:" << ssrc << " msid:" << id_ << " " << track << "\r\n";
+  };
+
+  media("audio", kAudioPayloadType, "0");
+  sdp << "a=rtpmap:" << +kAudioPayloadType << " opus/48000/2\r\n"
+      << "a=rtcp-fb:" << +kAudioPayloadType << " transport-cc\r\n"
+      << "a=fmtp:" << +kAudioPayloadType << " minptime=10;useinbandfec=1\r\n";
+  source(audio_ssrc_, "audio");
+
+  media("video", kVideoPayloadType, "1");
+  sdp << "a=rtcp-rsize\r\n"
+      << "a=rtpmap:" << +kVideoPayloadType << " H264/90000\r\n";
+  for (const char* feedback :
+       {"goog-remb", "transport-cc", "ccm fir", "nack", "nack pli"}) {
+    sdp << "a=rtcp-fb:" << +kVideoPayloadType << " " << feedback << "\r\n";
+  }
+  sdp << "a=fmtp:" << +kVideoPayloadType
+      << " level-asymmetry-allowed=1;packetization-mode=1;"
+         "profile-level-id=42e01f\r\n";
+  source(video_ssrc_, "video");
+  return sdp.str();
+}
+
+void LoopbackPeer::onAnswerSync(const std::string& sdp) {
+  if (closed_ || !transport_) {
+    return;
+  }
+  std::string ufrag;
+  std::string pwd;
+  std::vector<erizo::CandidateInfo> candidates;
+  std::istringstream lines(sdp);
+  std::string line;
+  while (std::getline(lines, line)) {
+    if (!line.empty() && line.back() == '\r') {
+      line.pop_back();
+    }
+    if (line.compare(0, 12, "a=ice-ufrag:") == 0) {
+      ufrag = line.substr(12);
+    } else if (line.compare(0, 10, "a=ice-pwd:") == 0) {
+      pwd = line.substr(10);
+    } else if (line.compare(0, 12, "a=candidate:") == 0) {
+      std::istringstream fields(line.substr(12));
+      erizo::CandidateInfo candidate;
+      std::string typ;
+      std::string type;
+      fields >> candidate.foundation >> candidate.componentId
+             >> candidate.netProtocol >> candidate.priority
+             >> candidate.hostAddress >> candidate.hostPort >> typ >> type;
+      if (!fields || type != "host") {
+        continue;
+      }
+      candidate.isBundle = true;
+      candidate.hostType = erizo::HOST;
+      candidate.mediaType = erizo::VIDEO_TYPE;
+      candidate.transProtocol = candidate.netProtocol;
+      candidate.rPort = 0;
+      candidates.push_back(std::move(candidate));
+    }
+  }
+  for (auto& candidate : candidates) {
+    candidate.username = ufrag;
+    candidate.password = pwd;
+  }
+  onAnswerSdp(sdp);
+  transport_->getIceConnection()->setRemoteCredentials(ufrag, pwd);
+  if (candidates.empty() || !transport_->setRemoteCandidates(candidates, true)) {
+    failed_ = true;
+  }
+}
+
+// LoopbackSubscriber
+
+LoopbackSubscriber::LoopbackSubscriber(const std::string& id,
+                                       const std::string& publisher,
+                                       std::shared_ptr<wa::Worker> worker,
+                                       std::shared_ptr<wa::IOWorker> io_worker)
+    : LoopbackPeer(id, false, kFeedbackTickMs, std::move(worker),
+                   std::move(io_worker)),
+      publisher_(publisher) {
+}
+
+void LoopbackSubscriber::takeLatencies(std::vector<int64_t>* video,
+                                       std::vector<int64_t>* audio) {
+  std::lock_guard<std::mutex> guard(latency_lock_);
+  video->insert(video->end(), video_latency_us_.begin(),
+                video_latency_us_.end());
+  audio->insert(audio->end(), audio_latency_us_.begin(),
+                audio_latency_us_.end());
+  video_latency_us_.clear();
+  audio_latency_us_.clear();
+}
+
+void LoopbackSubscriber::onAnswerSdp(const std::string& sdp) {
+  std::istringstream lines(sdp);
+  std::string line;
+  std::vector<uint8_t>* payload_types = nullptr;
+  while (std::getline(lines, line)) {
+    if (!line.empty() && line.back() == '\r') {
+      line.pop_back();
+    }
+    if (line.compare(0, 2, "m=") == 0) {
+      payload_types = line.compare(2, 5, "video") == 0 ? &video_payload_types_
+                                                       : &audio_payload_types_;
+      std::istringstream fields(line);
+      std::string skip;
+      fields >> skip >> skip >> skip;
+      int payload_type;
+      while (fields >> payload_type) {
+        payload_types->push_back(static_cast<uint8_t>(payload_type));
+      }
+    } else if (line.compare(0, 9, "a=extmap:") == 0 &&
+               line.find(kTransportCcUri) != std::string::npos) {
+      transport_cc_ext_id_ = atoi(line.c_str() + 9);
+    }
+  }
+}
+
+void LoopbackSubscriber::onRtp(const uint8_t* data, int length,
+                               int64_t now_ns) {
+  const erizo::RtpHeader* header =
+      reinterpret_cast<const erizo::RtpHeader*>(data);
+  int header_length = header->getHeaderLength();
+  if (header_length >= length) {
+    return;
+  }
+  counters_.packets.fetch_add(1, std::memory_order_relaxed);
+  counters_.bytes.fetch_add(length, std::memory_order_relaxed);
+
+  int ext_length = 0;
+  if (const uint8_t* ext = findExtension(data, length, transport_cc_ext_id_,
+                                         &ext_length)) {
+    if (ext_length == 2) {
+      uint16_t seq = (ext[0] << 8) | ext[1];
+      int64_t unwrapped = unwrap(&last_transport_seq_, seq);
+      arrivals_.emplace(unwrapped, now_ns / 1000);
+    }
+  }
+
+  uint8_t payload_type = header->getPayloadType();
+  bool video = std::find(video_payload_types_.begin(),
+                         video_payload_types_.end(),
+                         payload_type) != video_payload_types_.end();
+  if (!video && std::find(audio_payload_types_.begin(),
+                          audio_payload_types_.end(),
+                          payload_type) == audio_payload_types_.end()) {
+    return;
+  }
+  uint32_t ssrc = header->getSSRC();
+  if (video) {
+    remote_video_ssrc_ = ssrc;
+  }
+  if (!receive(streams_[ssrc], video, header->getSeqNumber(), now_ns)) {
+    return;
+  }
+
+  const uint8_t* payload = data + header_length;
+  int payload_length = length - header_length;
+  if (header->hasPadding()) {
+    payload_length -= data[length - 1];
+  }
+  if (payload_length <= 0) {
+    return;
+  }
+  if (video) {
+    // First packet of a slice: a single NAL unit or the start of an FU-A
+    uint8_t nal_type = payload[0] & 0x1f;
+    if (nal_type == 28 && payload_length > 2 && (payload[1] & 0x80)) {
+      nal_type = payload[1] & 0x1f;
+    } else if (nal_type == 28) {
+      return;
+    }
+    if (nal_type != 1 && nal_type != 5) {
+      return;
+    }
+  }
+  if (int64_t sent_ns = readStamp(payload, payload_length)) {
+    std::lock_guard<std::mutex> guard(latency_lock_);
+    (video ? video_latency_us_ : audio_latency_us_).push_back(
+        (now_ns - sent_ns) / 1000);
+  }
+}
+
+void LoopbackSubscriber::onTick(int64_t now_ns) {
+  sendNacks(now_ns);
+  if (now_ns - last_feedback_ns_ >= kTransportFeedbackMs * 1000000LL) {
+    last_feedback_ns_ = now_ns;
+    sendTransportFeedback();
+  }
+  if (now_ns - last_report_ns_ >= kReceiverReportMs * 1000000LL) {
+    last_report_ns_ = now_ns;
+    sendReceiverReport();
+  }
+}
+
+bool LoopbackSubscriber::receive(ReceiveStream& stream, bool video,
+                                 uint16_t seq, int64_t now_ns) {
+  if (!stream.started) {
+    stream.started = true;
+    int64_t unwrapped = seq;
+    stream.base_seq = stream.max_seq = unwrapped;
+    stream.received = 1;
+    counters_.expected.fetch_add(1, std::memory_order_relaxed);
+    counters_.received.fetch_add(1, std::memory_order_relaxed);
+    return true;
+  }
+  int64_t last = stream.max_seq;
+  int64_t unwrapped = unwrap(&last, seq);
+  if (unwrapped > stream.max_seq) {
+    if (video) {
+      for (int64_t missing = std::max(stream.max_seq + 1,
+                                      unwrapped - kMaxNackGap);
+           missing < unwrapped; ++missing) {
+        stream.missing.emplace(missing, NackState());
+      }
+    }
+    counters_.expected.fetch_add(unwrapped - stream.max_seq,
+                                 std::memory_order_relaxed);
+    stream.max_seq = unwrapped;
+  } else if (stream.missing.erase(unwrapped)) {
+    counters_.recovered.fetch_add(1, std::memory_order_relaxed);
+  } else {
+    // Duplicate, or late and not asked for
+    return false;
+  }
+  ++stream.received;
+  counters_.received.fetch_add(1, std::memory_order_relaxed);
+  return true;
+}
+
+void LoopbackSubscriber::sendNacks(int64_t now_ns) {
+  for (auto& item : streams_) {
+    ReceiveStream& stream = item.second;
+    std::vector<uint16_t> ids;
+    for (auto it = stream.missing.begin(); it != stream.missing.end();) {
+      NackState& state = it->second;
+      if (state.tries >= kMaxNackTries) {
+        if (now_ns - state.sent_ns > 10 * kNackIntervalNs) {
+          it = stream.missing.erase(it);
+          continue;
+        }
+      } else if (now_ns - state.sent_ns >= kNackIntervalNs) {
+        ids.push_back(static_cast<uint16_t>(it->first));
+        state.sent_ns = now_ns;
+        ++state.tries;
+      }
+      ++it;
+    }
+    if (ids.empty()) {
+      continue;
+    }
+    webrtc::rtcp::Nack nack;
+    nack.SetSenderSsrc(local_ssrc_);
+    nack.SetMediaSsrc(item.first);
+    counters_.nacks.fetch_add(ids.size(), std::memory_order_relaxed);
+    nack.SetPacketIds(std::move(ids));
+    sendRtcp(nack);
+  }
+}
+
+void LoopbackSubscriber::sendTransportFeedback() {
+  if (arrivals_.empty()) {
+    return;
+  }
+  webrtc::rtcp::TransportFeedback feedback;
+  feedback.SetSenderSsrc(local_ssrc_);
+  feedback.SetMediaSsrc(remote_video_ssrc_);
+  feedback.SetBase(static_cast<uint16_t>(arrivals_.begin()->first),
+                   arrivals_.begin()->second);
+  feedback.SetFeedbackSequenceNumber(feedback_seq_++);
+  for (const auto& arrival : arrivals_) {
+    if (!feedback.AddReceivedPacket(static_cast<uint16_t>(arrival.first),
+                                    arrival.second)) {
+      break;
+    }
+  }
+  arrivals_.clear();
+  sendRtcp(feedback);
+}
+
+void LoopbackSubscriber::sendReceiverReport() {
+  webrtc::rtcp::ReceiverReport report;
+  report.SetSenderSsrc(local_ssrc_);
+  for (auto& item : streams_) {
+    ReceiveStream& stream = item.second;
+    if (!stream.started) {
+      continue;
+    }
+    int64_t expected = stream.max_seq - stream.base_seq + 1;
+    int64_t expected_interval = expected - stream.prior_expected;
+    int64_t received_interval = stream.received - stream.prior_received;
+    int64_t lost_interval = expected_interval - received_interval;
+    stream.prior_expected = expected;
+    stream.prior_received = stream.received;
+
+    webrtc::rtcp::ReportBlock block;
+    block.SetMediaSsrc(item.first);
+    block.SetExtHighestSeqNum(static_cast<uint32_t>(stream.max_seq));
+    block.SetCumulativeLost(static_cast<int32_t>(
+        std::max<int64_t>(expected - stream.received, 0)));
+    block.SetFractionLost(expected_interval > 0 && lost_interval > 0 ?
+        static_cast<uint8_t>((lost_interval << 8) / expected_interval) : 0);
+    report.AddReportBlock(block);
+  }
+  sendRtcp(report);
+}
+
+}  // namespace loopback
@@ -0,0 +1,246 @@
+// Copyright (c) 2021- anjisuan783
+//
+// SPDX-License-Identifier: MIT
+
+// What a loopback bench needs around the WebrtcAgent: the agent in a child
+// process, driven over a socketpair, and client connections to it made of
+// the real erizo transports, a full ICE agent and the active DTLS end.
+//
+// Offers carry Opus on mid 0 and H.264 on mid 1, BUNDLE, rtcp-mux and the
+// transport-wide sequence number. Publishers write a send time stamp into
+// the first bytes of the frames, LoopbackSubscriber reads it back for the
+// latency of each frame.
+
+#ifndef __WA_TEST_LOOPBACK_HARNESS_H__
+#define __WA_TEST_LOOPBACK_HARNESS_H__
+
+#include <atomic>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "erizo/DtlsTransport.h"
+#include "myrtc/rtp_rtcp/rtcp_packet.h"
+#include "utils/IOWorker.h"
+#include "utils/Worker.h"
+
+namespace loopback {
+
+const char kLoopbackAddress[] = "127.0.0.1";
+
+const uint8_t kAudioPayloadType = 111;
+const uint8_t kVideoPayloadType = 102;
+const int kTransportCcExtId = 3;
+const int kMidExtId = 4;
+
+// Written at the start of every frame, followed by the send time in ns of the
+// steady clock as 16 hex digits, so the frame holds no start code.
+const size_t kStampSize = 4 + 16;
+
+int64_t nowNs();
+
+// CPU time of this process, all threads.
+int64_t cpuNs();
+
+// Runs |f| on |worker| and waits for it.
+void runOn(wa::Worker* worker, std::function<void()> f);
+
+void writeStamp(uint8_t* p, int64_t ns);
+
+// The send time of a stamp in the first bytes of |payload|, 0 if none.
+int64_t readStamp(const uint8_t* payload, int length);
+
+// RTP header with the transport-wide sequence number and the MID, returns its
+// length.
+int writeRtpHeader(uint8_t* p, uint8_t payload_type, bool marker, uint16_t seq,
+                   uint32_t timestamp, uint32_t ssrc, uint16_t transport_seq,
+                   char mid);
+
+// Messages between the two processes, "<type> <id> <length>\n<body>".
+struct Message {
+  std::string type;
+  std::string id;
+  std::string body;
+};
+
+class Channel {
+ public:
+  explicit Channel(int fd) : fd_(fd) {}
+
+  bool send(const std::string& type, const std::string& id,
+            const std::string& body);
+
+  // Only one reader.
+  bool receive(Message* message);
+
+  void shutdown();
+
+ private:
+  bool fill();
+
+  int fd_;
+  std::mutex send_lock_;
+  std::string buffer_;
+};
+
+// The agent process: publishes, subscribes and links up what |channel| asks
+// for, with |workers| workers, until "quit". Answers "cpu" with cpuNs().
+int runAgent(Channel* channel, uint32_t workers);
+
+// Counters of one peer, written on its worker, read by the driver.
+struct PeerCounters {
+  std::atomic<uint64_t> packets{0};
+  std::atomic<uint64_t> bytes{0};
+  // Subscribers, expected and received after retransmission.
+  std::atomic<uint64_t> expected{0};
+  std::atomic<uint64_t> received{0};
+  std::atomic<uint64_t> recovered{0};
+  std::atomic<uint64_t> nacks{0};
+  std::atomic<uint64_t> rtcp{0};
+  // Publishers, PLI and FIR from the agent.
+  std::atomic<uint64_t> key_requests{0};
+};
+
+struct CounterValues {
+  uint64_t packets{0};
+  uint64_t bytes{0};
+  uint64_t expected{0};
+  uint64_t received{0};
+  uint64_t recovered{0};
+  uint64_t nacks{0};
+  uint64_t rtcp{0};
+  uint64_t key_requests{0};
+
+  void add(const PeerCounters& counters);
+
+  CounterValues operator-(const CounterValues& other) const;
+};
+
+// A client connection to the agent, the active DTLS end of a full ICE agent.
+// Runs on one of the generator's workers, onTick() every |tick_ms| once the
+// transport is ready.
+class LoopbackPeer : public erizo::TransportListener,
+                     public std::enable_shared_from_this<LoopbackPeer> {
+ public:
+  LoopbackPeer(const std::string& id, bool publish, int tick_ms,
+               std::shared_ptr<wa::Worker> worker,
+               std::shared_ptr<wa::IOWorker> io_worker);
+  ~LoopbackPeer() override = default;
+
+  const std::string& id() const { return id_; }
+  bool publish() const { return publish_; }
+  PeerCounters& counters() { return counters_; }
+  bool ready() const { return ready_; }
+  bool failed() const { return failed_; }
+  void fail() { failed_ = true; }
+
+  // Creates the transport and returns the offer.
+  std::string start();
+
+  void onAnswer(const std::string& sdp);
+
+  void close();
+
+  // Implements erizo::TransportListener
+  void onTransportData(std::shared_ptr<erizo::DataPacket> packet,
+                       erizo::Transport*) override;
+  void updateState(TransportState state, erizo::Transport*) override;
+  // The agent learns ours from the connectivity checks.
+  void onCandidate(const erizo::CandidateInfo&, erizo::Transport*) override {}
+
+ protected:
+  virtual void onRtp(const uint8_t* data, int length, int64_t now_ns) = 0;
+  virtual void onRtcp(const uint8_t* data, int length) = 0;
+  virtual void onTick(int64_t now_ns) = 0;
+  virtual void onAnswerSdp(const std::string&) {}
+
+  void send(const uint8_t* data, int length);
+  void sendRtcp(const webrtc::rtcp::RtcpPacket& rtcp);
+
+  const std::string id_;
+  const bool publish_;
+  uint32_t local_ssrc_;
+  uint32_t audio_ssrc_;
+  uint32_t video_ssrc_;
+  PeerCounters counters_;
+
+ private:
+  std::string makeOffer(const std::string& ufrag, const std::string& pwd,
+                        const std::string& fingerprint) const;
+  void onAnswerSync(const std::string& sdp);
+
+  const int tick_ms_;
+  std::shared_ptr<wa::Worker> worker_;
+  std::shared_ptr<wa::IOWorker> io_worker_;
+  std::shared_ptr<erizo::DtlsTransport> transport_;
+  std::atomic<bool> ready_{false};
+  std::atomic<bool> failed_{false};
+  std::atomic<bool> closed_{false};
+};
+
+// Receives what the agent forwards from |publisher|, answers with receiver
+// reports, NACKs and transport-wide feedback when it is negotiated, and
+// measures the loss after retransmission and the latency of each frame.
+class LoopbackSubscriber : public LoopbackPeer {
+ public:
+  LoopbackSubscriber(const std::string& id, const std::string& publisher,
+                     std::shared_ptr<wa::Worker> worker,
+                     std::shared_ptr<wa::IOWorker> io_worker);
+
+  const std::string& publisher() const { return publisher_; }
+
+  // Frame latencies in us since the last call.
+  void takeLatencies(std::vector<int64_t>* video, std::vector<int64_t>* audio);
+
+ protected:
+  void onAnswerSdp(const std::string& sdp) override;
+  void onRtp(const uint8_t* data, int length, int64_t now_ns) override;
+  void onRtcp(const uint8_t*, int) override {}
+  void onTick(int64_t now_ns) override;
+
+ private:
+  struct NackState {
+    int64_t sent_ns{0};
+    int tries{0};
+  };
+
+  struct ReceiveStream {
+    bool started{false};
+    int64_t base_seq{0};
+    int64_t max_seq{0};
+    uint64_t received{0};
+    int64_t prior_expected{0};
+    uint64_t prior_received{0};
+    std::map<int64_t, NackState> missing;
+  };
+
+  // False for a duplicate.
+  bool receive(ReceiveStream& stream, bool video, uint16_t seq, int64_t now_ns);
+  void sendNacks(int64_t now_ns);
+  void sendTransportFeedback();
+  void sendReceiverReport();
+
+  const std::string publisher_;
+  std::vector<uint8_t> video_payload_types_;
+  std::vector<uint8_t> audio_payload_types_;
+  int transport_cc_ext_id_{0};
+
+  std::map<uint32_t, ReceiveStream> streams_;
+  uint32_t remote_video_ssrc_{0};
+  int64_t last_transport_seq_{-1};
+  std::map<int64_t, int64_t> arrivals_;
+  uint8_t feedback_seq_{0};
+  int64_t last_feedback_ns_{0};
+  int64_t last_report_ns_{0};
+
+  std::mutex latency_lock_;
+  std::vector<int64_t> video_latency_us_;
+  std::vector<int64_t> audio_latency_us_;
+};
+
+}  // namespace loopback
+
+#endif  // __WA_TEST_LOOPBACK_HARNESS_H__
@@ -0,0 +1,774 @@
+// Copyright (c) 2021- anjisuan783
+//
+// SPDX-License-Identifier: MIT
+
+// Loopback load generator and capacity benchmark of the WebrtcAgent.
+//
+// The agent runs in a child process on 127.0.0.1, the generator in this one,
+// the two exchange offers and answers over a socketpair, see
+// loopback_harness.h. Everything between them is the real thing: ICE
+// connectivity checks against the lite agent, DTLS, SRTP, and RTP and RTCP
+// over loopback UDP.
+//
+//   publishers   replay the H.264 and Opus of an rtpdump capture, as
+//                rtc_api::startCapture writes them, in a loop at its own
+//                pace. Each starts at a random point of the capture.
+//   subscribers  are linked up to a publisher, answer with receiver reports,
+//                NACKs and transport-wide feedback when it is negotiated, and
+//                measure the loss after retransmission and the latency of
+//                each frame.
+//
+// Replayed packets get the payload types, SSRCs, sequence numbers and header
+// extensions of the offer, the payload is the captured one with the send
+// time written over the first bytes of each slice and Opus frame; the agent
+// forwards it without decoding. Retransmissions of the capture are left out,
+// PLIs and FIRs from the agent are counted, there is no encoder to answer
+// them.
+//
+// The load grows by --step publishers, each with --subscribers subscribers,
+// every step is measured for --step-seconds. The CPU is the one of the agent
+// process only. It stops at the first step over one of the budgets and reports
+// the last one within all of them, per core of the agent.
+//
+//   bench_loopback_load --capture=<prefix>-in.rtpdump [--video-pt=N]
+//       [--audio-pt=111] [--workers=1] [--client-workers=2]
+//       [--subscribers=3] [--step=1] [--max-publishers=64]
+//       [--step-seconds=10] [--warmup-seconds=3] [--cpu-budget=0.8]
+//       [--latency-budget-ms=100] [--loss-budget=1]
+//
+// The video is the stream of the capture carrying the most RTP bytes, apart
+// from the audio one, with its most frequent payload type unless --video-pt
+// gives it; it has to be H.264 in packetization mode 1. The audio is the
+// stream carrying the most --audio-pt packets.
+// --cpu-budget is in cores of the agent process, 0.8 per worker by default.
+
+#include <sys/socket.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "erizo/global_init.h"
+#include "erizo/rtp/RtpCapture.h"
+#include "erizo/rtp/RtpHeaders.h"
+#include "test/loopback_harness.h"
+#include "wa/wa_rtp_define.h"
+
+namespace {
+
+using loopback::Channel;
+using loopback::CounterValues;
+using loopback::LoopbackPeer;
+using loopback::LoopbackSubscriber;
+using loopback::Message;
+
+const int kTickMs = 5;
+// Packets due longer ago than this after a stall are skipped.
+const int kMaxLateMs = 100;
+const int kAudioFrameMs = 20;
+const int kSetupTimeoutSeconds = 15;
+const int kMaxRtpSize = 1500;
+// What writeRtpHeader() writes
+const int kRtpHeaderSize = 20;
+
+struct Options {
+  std::string capture;
+  int video_pt{-1};
+  int audio_pt{111};
+  uint32_t workers{1};
+  uint32_t client_workers{2};
+  int subscribers{3};
+  int step{1};
+  int max_publishers{64};
+  int step_seconds{10};
+  int warmup_seconds{3};
+  double cpu_budget{0};
+  double latency_budget_ms{100};
+  double loss_budget{1};
+};
+
+bool parseOptions(int argc, char* argv[], Options* options) {
+  for (int i = 1; i < argc; ++i) {
+    std::string arg(argv[i]);
+    size_t equal = arg.find('=');
+    if (arg.compare(0, 2, "--") != 0 || equal == std::string::npos) {
+      return false;
+    }
+    std::string name = arg.substr(2, equal - 2);
+    double value = atof(arg.c_str() + equal + 1);
+    if (name == "capture") {
+      options->capture = arg.substr(equal + 1);
+    } else if (name == "video-pt") {
+      options->video_pt = static_cast<int>(value);
+    } else if (name == "audio-pt") {
+      options->audio_pt = static_cast<int>(value);
+    } else if (name == "workers") {
+      options->workers = static_cast<uint32_t>(value);
+    } else if (name == "client-workers") {
+      options->client_workers = static_cast<uint32_t>(value);
+    } else if (name == "subscribers") {
+      options->subscribers = static_cast<int>(value);
+    } else if (name == "step") {
+      options->step = static_cast<int>(value);
+    } else if (name == "max-publishers") {
+      options->max_publishers = static_cast<int>(value);
+    } else if (name == "step-seconds") {
+      options->step_seconds = static_cast<int>(value);
+    } else if (name == "warmup-seconds") {
+      options->warmup_seconds = static_cast<int>(value);
+    } else if (name == "cpu-budget") {
+      options->cpu_budget = value;
+    } else if (name == "latency-budget-ms") {
+      options->latency_budget_ms = value;
+    } else if (name == "loss-budget") {
+      options->loss_budget = value;
+    } else {
+      return false;
+    }
+  }
+  if (options->capture.empty() || options->workers == 0 ||
+      options->client_workers == 0 || options->step <= 0 ||
+      options->step_seconds <= 0) {
+    return false;
+  }
+  if (options->cpu_budget <= 0) {
+    options->cpu_budget = 0.8 * options->workers;
+  }
+  return true;
+}
+
+// ---------------------------------------------------------------------------
+// The capture
+
+struct CapturedPacket {
+  uint32_t offset_ms{0};
+  bool video{false};
+  bool marker{false};
+  // From the first packet of its stream
+  uint32_t timestamp{0};
+  std::vector<uint8_t> payload;
+};
+
+// Shared by all the publishers, read only once loaded.
+struct Capture {
+  std::vector<CapturedPacket> packets;
+  // The packets repeat after this, an audio frame past the last one.
+  uint32_t duration_ms{0};
+  uint32_t video_ssrc{0};
+  uint32_t audio_ssrc{0};
+  uint64_t video_bytes{0};
+};
+
+// Picks the audio and the video stream of |options->capture| and keeps their
+// payloads, each sequence number once. False without a video stream.
+bool loadCapture(Options* options, Capture* capture) {
+  auto reader = erizo::RtpDumpReader::open(options->capture);
+  if (!reader) {
+    return false;
+  }
+  std::vector<erizo::RtpDumpPacket> packets;
+  std::map<uint32_t, uint64_t> bytes;
+  std::map<uint32_t, uint64_t> audio_packets;
+  std::map<std::pair<uint32_t, int>, uint64_t> payload_types;
+  erizo::RtpDumpPacket packet;
+  while (reader->next(&packet)) {
+    if (packet.rtcp || packet.data.size() < erizo::RtpHeader::MIN_SIZE) {
+      continue;
+    }
+    auto head = reinterpret_cast<const erizo::RtpHeader*>(packet.data.data());
+    if (head->getPayloadType() == options->audio_pt) {
+      ++audio_packets[head->getSSRC()];
+    } else {
+      bytes[head->getSSRC()] += packet.data.size();
+      payload_types[{head->getSSRC(), head->getPayloadType()}] +=
+          packet.data.size();
+    }
+    packets.push_back(std::move(packet));
+  }
+
+  uint64_t most = 0;
+  for (auto& i : audio_packets) {
+    if (i.second > most) {
+      most = i.second;
+      capture->audio_ssrc = i.first;
+    }
+  }
+  most = 0;
+  for (auto& i : bytes) {
+    if (i.first != capture->audio_ssrc && i.second > most) {
+      most = i.second;
+      capture->video_ssrc = i.first;
+    }
+  }
+  if (options->video_pt < 0) {
+    most = 0;
+    for (auto& i : payload_types) {
+      if (i.first.first == capture->video_ssrc && i.second > most) {
+        most = i.second;
+        options->video_pt = i.first.second;
+      }
+    }
+  }
+  if (!capture->video_ssrc || options->video_pt < 0) {
+    return false;
+  }
+
+  std::map<uint32_t, uint32_t> first_timestamp;
+  std::map<uint32_t, int64_t> last_seq;
+  for (const erizo::RtpDumpPacket& item : packets) {
+    auto head = reinterpret_cast<const erizo::RtpHeader*>(item.data.data());
+    uint32_t ssrc = head->getSSRC();
+    bool video = ssrc == capture->video_ssrc &&
+                 head->getPayloadType() == options->video_pt;
+    bool audio = ssrc == capture->audio_ssrc &&
+                 head->getPayloadType() == options->audio_pt;
+    if (!video && !audio) {
+      continue;
+    }
+    int header_length = head->getHeaderLength();
+    int length = static_cast<int>(item.data.size());
+    if (head->hasPadding()) {
+      length -= static_cast<uint8_t>(item.data.back());
+    }
+    if (length <= header_length ||
+        length - header_length > kMaxRtpSize - kRtpHeaderSize) {
+      continue;
+    }
+    // Retransmitted or reordered, the replay keeps the first of each
+    auto seq = last_seq.emplace(ssrc, head->getSeqNumber() - 1).first;
+    int16_t delta = static_cast<int16_t>(
+        head->getSeqNumber() - static_cast<uint16_t>(seq->second));
+    if (delta <= 0) {
+      continue;
+    }
+    seq->second += delta;
+    uint32_t first = first_timestamp.emplace(ssrc, head->getTimestamp())
+                         .first->second;
+
+    capture->packets.emplace_back();
+    CapturedPacket& captured = capture->packets.back();
+    captured.offset_ms = item.offset_ms;
+    captured.video = video;
+    captured.marker = head->getMarker();
+    captured.timestamp = head->getTimestamp() - first;
+    captured.payload.assign(item.data.begin() + header_length,
+                            item.data.begin() + length);
+    if (video) {
+      capture->video_bytes += captured.payload.size();
+    }
+  }
+  if (capture->packets.empty()) {
+    return false;
+  }
+  // Offsets from the first packet kept
+  uint32_t start_ms = capture->packets.front().offset_ms;
+  for (CapturedPacket& captured : capture->packets) {
+    captured.offset_ms -= start_ms;
+  }
+  capture->duration_ms = capture->packets.back().offset_ms + kAudioFrameMs;
+  return true;
+}
+
+// ---------------------------------------------------------------------------
+// The generator process
+
+class CapturePublisher : public LoopbackPeer {
+ public:
+  CapturePublisher(const std::string& id,
+                   std::shared_ptr<const Capture> capture,
+                   std::shared_ptr<wa::Worker> worker,
+                   std::shared_ptr<wa::IOWorker> io_worker)
+      : LoopbackPeer(id, true, kTickMs, std::move(worker),
+                     std::move(io_worker)),
+        capture_(std::move(capture)) {
+    std::random_device random;
+    start_offset_ms_ = random() % capture_->duration_ms;
+    while (next_ < capture_->packets.size() &&
+           capture_->packets[next_].offset_ms < start_offset_ms_) {
+      ++next_;
+    }
+  }
+
+ protected:
+  void onRtp(const uint8_t*, int, int64_t) override {}
+
+  void onRtcp(const uint8_t* data, int length) override {
+    // Compound, look for PLI and FIR
+    int offset = 0;
+    while (offset + 4 <= length) {
+      uint8_t fmt = data[offset] & 0x1f;
+      uint8_t type = data[offset + 1];
+      int size = ((data[offset + 2] << 8) | data[offset + 3]) * 4 + 4;
+      if (type == RTCP_PS_Feedback_PT &&
+          (fmt == RTCP_PLI_FMT || fmt == RTCP_FIR_FMT)) {
+        counters_.key_requests.fetch_add(1, std::memory_order_relaxed);
+      }
+      offset += size;
+    }
+  }
+
+  void onTick(int64_t now_ns) override {
+    if (!start_ns_) {
+      start_ns_ = now_ns;
+    }
+    int64_t position_ms = (now_ns - start_ns_) / 1000000 + start_offset_ms_;
+    const std::vector<CapturedPacket>& packets = capture_->packets;
+    while (true) {
+      if (next_ == packets.size()) {
+        next_ = 0;
+        ++loops_;
+      }
+      const CapturedPacket& packet = packets[next_];
+      int64_t due_ms = loops_ * capture_->duration_ms + packet.offset_ms;
+      if (due_ms > position_ms) {
+        break;
+      }
+      if (position_ms - due_ms <= kMaxLateMs) {
+        sendPacket(packet, now_ns);
+      }
+      ++next_;
+    }
+  }
+
+ private:
+  void sendPacket(const CapturedPacket& captured, int64_t now_ns) {
+    uint8_t packet[kMaxRtpSize];
+    // Both clocks move on by the length of the capture each loop
+    uint32_t rate_khz = captured.video ? 90 : 48;
+    uint32_t timestamp = captured.timestamp +
+        static_cast<uint32_t>(loops_ * capture_->duration_ms * rate_khz);
+    int length = captured.video ?
+        loopback::writeRtpHeader(packet, loopback::kVideoPayloadType,
+                                 captured.marker, video_seq_++, timestamp,
+                                 video_ssrc_, transport_seq_++, '1') :
+        loopback::writeRtpHeader(packet, loopback::kAudioPayloadType,
+                                 captured.marker, audio_seq_++, timestamp,
+                                 audio_ssrc_, transport_seq_++, '0');
+    uint8_t* payload = packet + length;
+    int payload_length = static_cast<int>(captured.payload.size());
+    memcpy(payload, captured.payload.data(), payload_length);
+    int stamp = stampOffset(captured.video, payload, payload_length);
+    if (stamp >= 0) {
+      loopback::writeStamp(payload + stamp, now_ns);
+    }
+    send(packet, length + payload_length);
+  }
+
+  // Where the send time goes in |payload|, -1 for none: past the TOC byte of
+  // an Opus frame, past the NAL unit header and the two bytes after it in the
+  // first packet of a slice, single NAL unit or FU-A start, which keeps
+  // first_mb_in_slice and the slice type of most streams.
+  static int stampOffset(bool video, const uint8_t* payload, int length) {
+    int offset = 1;
+    if (video) {
+      uint8_t nal_type = payload[0] & 0x1f;
+      offset = 3;
+      if (nal_type == 28 && length > 2 && (payload[1] & 0x80)) {
+        nal_type = payload[1] & 0x1f;
+        offset = 4;
+      }
+      if (nal_type != 1 && nal_type != 5) {
+        return -1;
+      }
+    }
+    return offset + static_cast<int>(loopback::kStampSize) <= length ?
+        offset : -1;
+  }
+
+  const std::shared_ptr<const Capture> capture_;
+  uint32_t start_offset_ms_{0};
+  int64_t start_ns_{0};
+  size_t next_{0};
+  int64_t loops_{0};
+  uint16_t audio_seq_{0};
+  uint16_t video_seq_{0};
+  uint16_t transport_seq_{0};
+};
+
+struct StepResult {
+  int publishers{0};
+  int subscribers{0};
+  double seconds{0};
+  double agent_cores{0};
+  double generator_cores{0};
+  double in_mbps{0};
+  double out_mbps{0};
+  double loss_percent{0};
+  uint64_t nacks{0};
+  uint64_t recovered{0};
+  double video_p50_ms{0};
+  double video_p99_ms{0};
+  double audio_p50_ms{0};
+  double audio_p99_ms{0};
+};
+
+double percentileMs(std::vector<int64_t>& values, double q) {
+  if (values.empty()) {
+    return 0;
+  }
+  size_t rank = static_cast<size_t>(q * (values.size() - 1) + 0.5);
+  std::nth_element(values.begin(), values.begin() + rank, values.end());
+  return values[rank] / 1e3;
+}
+
+class LoadDriver {
+ public:
+  LoadDriver(const Options& options, std::shared_ptr<const Capture> capture,
+             Channel* channel)
+      : options_(options), capture_(std::move(capture)), channel_(channel),
+        workers_(options.client_workers),
+        io_workers_(options.client_workers) {
+  }
+
+  int run() {
+    workers_.start();
+    io_workers_.start();
+    reader_ = std::thread([this] { readLoop(); });
+
+    printf("agent workers:%u client workers:%u subscribers/publisher:%d "
+           "budgets cpu:%.2f cores p99:%.0fms loss:%.2f%%\n",
+           options_.workers, options_.client_workers, options_.subscribers,
+           options_.cpu_budget, options_.latency_budget_ms,
+           options_.loss_budget);
+    printf("%5s %5s %9s %9s %6s %6s %7s %6s %9s %9s %9s %9s\n",
+           "pubs", "subs", "in Mbps", "out Mbps", "cores", "gen", "loss%",
+           "nacks", "v p50ms", "v p99ms", "a p50ms", "a p99ms");
+
+    StepResult best;
+    bool any = false;
+    const char* stop = "max publishers reached";
+    while (publishers_ < options_.max_publishers) {
+      if (!addPublishers(options_.step)) {
+        stop = "connection setup failed";
+        break;
+      }
+      std::this_thread::sleep_for(
+          std::chrono::seconds(options_.warmup_seconds));
+      StepResult result = measure();
+      printRow(result);
+      const char* over = overBudget(result);
+      if (over) {
+        stop = over;
+        break;
+      }
+      best = result;
+      any = true;
+    }
+
+    printf("stopped: %s\n", stop);
+    if (any) {
+      double cores = std::max(best.agent_cores, 0.01);
+      printf("capacity within budgets, %.2f cores of the agent:\n", cores);
+      printf("  publishers  %5d  %8.1f per core\n", best.publishers,
+             best.publishers / cores);
+      printf("  subscribers %5d  %8.1f per core\n", best.subscribers,
+             best.subscribers / cores);
+      printf("  Mbps in     %7.1f  %6.1f per core\n", best.in_mbps,
+             best.in_mbps / cores);
+      printf("  Mbps out    %7.1f  %6.1f per core\n", best.out_mbps,
+             best.out_mbps / cores);
+    } else {
+      printf("no step within the budgets\n");
+    }
+
+    for (auto& peer : allPeers()) {
+      peer->close();
+    }
+    channel_->send("quit", "", "");
+    channel_->shutdown();
+    reader_.join();
+    workers_.close();
+    io_workers_.close();
+    return any ? 0 : 1;
+  }
+
+ private:
+  std::vector<std::shared_ptr<LoopbackPeer>> allPeers() {
+    std::lock_guard<std::mutex> guard(peers_lock_);
+    std::vector<std::shared_ptr<LoopbackPeer>> peers;
+    for (auto& item : peers_) {
+      peers.push_back(item.second);
+    }
+    return peers;
+  }
+
+  void readLoop() {
+    Message message;
+    while (channel_->receive(&message)) {
+      if (message.type == "cpu") {
+        std::lock_guard<std::mutex> guard(cpu_lock_);
+        agent_cpu_ns_ = atoll(message.body.c_str());
+        cpu_cv_.notify_all();
+        continue;
+      }
+      std::shared_ptr<LoopbackPeer> peer;
+      {
+        std::lock_guard<std::mutex> guard(peers_lock_);
+        auto found = peers_.find(message.id);
+        if (found == peers_.end()) {
+          continue;
+        }
+        peer = found->second;
+      }
+      if (message.type == "answer") {
+        peer->onAnswer(message.body);
+      } else if (message.type == "failed") {
+        printf("%s failed: %s\n", message.id.c_str(), message.body.c_str());
+        peer->fail();
+      }
+    }
+    // The agent is gone, nobody waits for a cpu reply forever.
+    std::lock_guard<std::mutex> guard(cpu_lock_);
+    agent_gone_ = true;
+    cpu_cv_.notify_all();
+  }
+
+  int64_t agentCpuNs() {
+    std::unique_lock<std::mutex> guard(cpu_lock_);
+    agent_cpu_ns_ = -1;
+    guard.unlock();
+    channel_->send("cpu", "", "");
+    guard.lock();
+    cpu_cv_.wait(guard, [this] { return agent_cpu_ns_ >= 0 || agent_gone_; });
+    return agent_cpu_ns_;
+  }
+
+  std::shared_ptr<LoopbackPeer> connect(std::shared_ptr<LoopbackPeer> peer,
+                                        const char* type) {
+    {
+      std::lock_guard<std::mutex> guard(peers_lock_);
+      peers_[peer->id()] = peer;
+    }
+    std::string offer = peer->start();
+    channel_->send(type, peer->id(), offer);
+    return peer;
+  }
+
+  bool waitReady(const std::vector<std::shared_ptr<LoopbackPeer>>& peers) {
+    auto deadline = std::chrono::steady_clock::now() +
+                    std::chrono::seconds(kSetupTimeoutSeconds);
+    while (std::chrono::steady_clock::now() < deadline) {
+      bool all = true;
+      for (auto& peer : peers) {
+        if (peer->failed()) {
+          return false;
+        }
+        all = all && peer->ready();
+      }
+      if (all) {
+        return true;
+      }
+      std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    return false;
+  }
+
+  bool addPublishers(int count) {
+    std::vector<std::shared_ptr<LoopbackPeer>> added;
+    std::vector<std::shared_ptr<LoopbackSubscriber>> subscribers;
+    for (int i = 0; i < count; ++i) {
+      std::string publisher = "pub" + std::to_string(publishers_++);
+      added.push_back(connect(std::make_shared<CapturePublisher>(
+          publisher, capture_, workers_.getLessUsedWorker(),
+          io_workers_.getLessUsedIOWorker()), "publish"));
+      for (int j = 0; j < options_.subscribers; ++j) {
+        auto subscriber = std::make_shared<LoopbackSubscriber>(
+            publisher + "-sub" + std::to_string(j), publisher,
+            workers_.getLessUsedWorker(), io_workers_.getLessUsedIOWorker());
+        connect(subscriber, "subscribe");
+        added.push_back(subscriber);
+        subscribers.push_back(subscriber);
+        ++subscribers_;
+      }
+    }
+    if (!waitReady(added)) {
+      return false;
+    }
+    for (auto& subscriber : subscribers) {
+      channel_->send("linkup", subscriber->id(), subscriber->publisher());
+    }
+    return true;
+  }
+
+  void snapshot(CounterValues* published, CounterValues* received) {
+    *published = CounterValues();
+    *received = CounterValues();
+    for (auto& peer : allPeers()) {
+      (peer->publish() ? published : received)->add(peer->counters());
+    }
+  }
+
+  void takeLatencies(std::vector<int64_t>* video, std::vector<int64_t>* audio) {
+    for (auto& peer : allPeers()) {
+      if (!peer->publish()) {
+        static_cast<LoopbackSubscriber*>(peer.get())->takeLatencies(video,
+                                                                    audio);
+      }
+    }
+  }
+
+  StepResult measure() {
+    std::vector<int64_t> video;
+    std::vector<int64_t> audio;
+    CounterValues published_before;
+    CounterValues received_before;
+    takeLatencies(&video, &audio);
+    video.clear();
+    audio.clear();
+    snapshot(&published_before, &received_before);
+    int64_t agent_cpu = agentCpuNs();
+    int64_t own_cpu = loopback::cpuNs();
+    int64_t start = loopback::nowNs();
+
+    std::this_thread::sleep_for(std::chrono::seconds(options_.step_seconds));
+
+    CounterValues published_after;
+    CounterValues received_after;
+    snapshot(&published_after, &received_after);
+    takeLatencies(&video, &audio);
+    StepResult result;
+    int64_t wall = loopback::nowNs() - start;
+    result.seconds = wall / 1e9;
+    result.agent_cores = static_cast<double>(agentCpuNs() - agent_cpu) / wall;
+    result.generator_cores =
+        static_cast<double>(loopback::cpuNs() - own_cpu) / wall;
+
+    CounterValues published = published_after - published_before;
+    CounterValues received = received_after - received_before;
+    result.publishers = publishers_;
+    result.subscribers = subscribers_;
+    result.in_mbps = published.bytes * 8 / 1e6 / result.seconds;
+    result.out_mbps = received.bytes * 8 / 1e6 / result.seconds;
+    if (received.expected > 0) {
+      result.loss_percent = received.expected > received.received ?
+          100.0 * (received.expected - received.received) / received.expected
+          : 0;
+    } else {
+      // Nothing arrived at all
+      result.loss_percent = 100;
+    }
+    result.nacks = received.nacks;
+    result.recovered = received.recovered;
+    result.video_p50_ms = percentileMs(video, 0.5);
+    result.video_p99_ms = percentileMs(video, 0.99);
+    result.audio_p50_ms = percentileMs(audio, 0.5);
+    result.audio_p99_ms = percentileMs(audio, 0.99);
+    return result;
+  }
+
+  const char* overBudget(const StepResult& result) const {
+    if (result.agent_cores > options_.cpu_budget) {
+      return "cpu budget exceeded";
+    }
+    if (std::max(result.video_p99_ms, result.audio_p99_ms) >
+        options_.latency_budget_ms) {
+      return "latency budget exceeded";
+    }
+    if (result.loss_percent > options_.loss_budget) {
+      return "loss budget exceeded";
+    }
+    return nullptr;
+  }
+
+  void printRow(const StepResult& result) const {
+    printf("%5d %5d %9.1f %9.1f %6.2f %6.2f %7.2f %6llu %9.1f %9.1f %9.1f "
+           "%9.1f%s\n",
+           result.publishers, result.subscribers, result.in_mbps,
+           result.out_mbps, result.agent_cores, result.generator_cores,
+           result.loss_percent, static_cast<unsigned long long>(result.nacks),
+           result.video_p50_ms, result.video_p99_ms, result.audio_p50_ms,
+           result.audio_p99_ms,
+           // The generator itself is the bottleneck, not the agent
+           result.generator_cores > 0.9 * options_.client_workers ?
+               "  generator saturated" : "");
+    fflush(stdout);
+  }
+
+  const Options options_;
+  const std::shared_ptr<const Capture> capture_;
+  Channel* channel_;
+  wa::ThreadPool workers_;
+  wa::IOThreadPool io_workers_;
+  std::thread reader_;
+
+  std::mutex peers_lock_;
+  std::map<std::string, std::shared_ptr<LoopbackPeer>> peers_;
+  int publishers_{0};
+  int subscribers_{0};
+
+  std::mutex cpu_lock_;
+  std::condition_variable cpu_cv_;
+  int64_t agent_cpu_ns_{-1};
+  bool agent_gone_{false};
+};
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  Options options;
+  if (!parseOptions(argc, argv, &options)) {
+    fprintf(stderr, "usage: %s --capture=<prefix>-in.rtpdump [--video-pt=n] "
+            "[--audio-pt=n] [--workers=n] [--client-workers=n] "
+            "[--subscribers=n] [--step=n] [--max-publishers=n] "
+            "[--step-seconds=s] [--warmup-seconds=s] [--cpu-budget=cores] "
+            "[--latency-budget-ms=ms] [--loss-budget=percent]\n", argv[0]);
+    return 2;
+  }
+  auto capture = std::make_shared<Capture>();
+  if (!loadCapture(&options, capture.get())) {
+    fprintf(stderr, "%s: no video stream to replay\n",
+            options.capture.c_str());
+    return 2;
+  }
+  printf("replaying %s video ssrc:%u pt:%d audio ssrc:%u pt:%d, "
+         "%u ms, %.0f kbps of video\n", options.capture.c_str(),
+         capture->video_ssrc, options.video_pt, capture->audio_ssrc,
+         options.audio_pt, capture->duration_ms,
+         capture->video_bytes * 8.0 / capture->duration_ms);
+
+  int fds[2];
+  if (socketpair(AF_UNIX, SOCK_STREAM, 0, fds) != 0) {
+    perror("socketpair");
+    return 1;
+  }
+  fflush(stdout);
+  pid_t pid = fork();
+  if (pid < 0) {
+    perror("fork");
+    return 1;
+  }
+  if (pid == 0) {
+    // The agent, CPU of this process is what the report is about
+    close(fds[0]);
+    Channel channel(fds[1]);
+    int result = loopback::runAgent(&channel, options.workers);
+    close(fds[1]);
+    return result;
+  }
+
+  close(fds[1]);
+  erizo::erizo_global_init();
+  int result;
+  {
+    Channel channel(fds[0]);
+    LoadDriver driver(options, std::move(capture), &channel);
+    result = driver.run();
+  }
+  close(fds[0]);
+  int status = 0;
+  waitpid(pid, &status, 0);
+  erizo::erizo_global_release();
+  return result;
+}
@@ -0,0 +1,636 @@
+// Copyright (c) 2021- anjisuan783
+//
+// SPDX-License-Identifier: MIT
+
+// Times the per packet stages of the media path and counts the heap
+// allocations each of them makes, on synthetic H.264 and Opus streams:
+//
+//   srtp-protect     DtlsTransport::write, SRTP and the ICE hand off
+//   srtp-unprotect   DtlsTransport::onIceData up to the transport listener
+//   rtp-ext          RtpExtensionProcessor::processRtpExtensions
+//   rtp-demux        RtpDemuxer::OnRtpPacket, by MID and SSRC
+//   nack             NackModule::OnReceivedPacket, one packet in 100 lost
+//   pipeline         a read and a write through an erizo Pipeline
+//   video-send       VideoSendAdapterImpl::onFrame, RTP packets out
+//   video-send-fec   the same with RED and ULPFEC generation
+//   audio-send       AudioSendAdapterImpl::onFrame, Opus frames
+//   audio-forward    AudioSendAdapterImpl::onFrame, forwarded RTP packets
+//
+// The DTLS handshake is skipped, both transports get their SRTP keys as if it
+// had completed, and ICE is a loopback that copies what is written into the
+// packet the receiving side reads next.
+// The adapters run on a worker like they do in a connection. The NACK list
+// under loss and the FEC XOR kernels have bench_nack and bench_fec_xor.
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <future>
+#include <memory>
+#include <new>
+#include <random>
+#include <vector>
+
+#include "erizo/DtlsTransport.h"
+#include "erizo/global_init.h"
+#include "erizo/pipeline/Handler.h"
+#include "erizo/pipeline/Pipeline.h"
+#include "erizo/rtp/RtpExtensionProcessor.h"
+#include "myrtc/call/rtp_demuxer.h"
+#include "myrtc/call/rtp_packet_sink_interface.h"
+#include "myrtc/rtc_base/clock.h"
+#include "myrtc/rtp_rtcp/rtp_header_extensions.h"
+#include "myrtc/rtp_rtcp/rtp_packet_received.h"
+#include "myrtc/video/nack_module.h"
+#include "owt/rtc_adapter/RtcAdapter.h"
+#include "utils/Worker.h"
+
+namespace {
+
+std::atomic<uint64_t> g_allocations{0};
+
+}  // namespace
+
+void* operator new(size_t size) {
+  g_allocations.fetch_add(1, std::memory_order_relaxed);
+  if (void* p = std::malloc(size ? size : 1)) {
+    return p;
+  }
+  throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept {
+  std::free(p);
+}
+
+void operator delete(void* p, size_t) noexcept {
+  std::free(p);
+}
+
+namespace {
+
+const int kRounds = 50;
+const int kPacketsPerRound = 2000;
+const int kRtpPayloadSize = 1100;
+const uint32_t kVideoSsrc = 0x12345678;
+const uint8_t kVideoPayloadType = 96;
+
+// Extension ids of the bench SDP, one-byte header form.
+const int kMidExtId = 1;
+const int kAbsSendTimeExtId = 2;
+const int kTransportCcExtId = 3;
+
+class Meter {
+ public:
+  explicit Meter(const char* name) : name_(name) {}
+
+  void start() {
+    allocations_ -= g_allocations.load(std::memory_order_relaxed);
+    begin_ = std::chrono::steady_clock::now();
+  }
+
+  void stop(int packets) {
+    elapsed_ += std::chrono::steady_clock::now() - begin_;
+    allocations_ += g_allocations.load(std::memory_order_relaxed);
+    packets_ += packets;
+  }
+
+  void report() const {
+    double ns = std::chrono::duration<double, std::nano>(elapsed_).count();
+    printf("%-15s %8llu packets %8.1fns/packet %6.2f allocs/packet\n", name_,
+           static_cast<unsigned long long>(packets_),
+           packets_ ? ns / packets_ : 0.0,
+           packets_ ? static_cast<double>(allocations_) / packets_ : 0.0);
+  }
+
+ private:
+  const char* name_;
+  std::chrono::steady_clock::duration elapsed_{};
+  std::chrono::steady_clock::time_point begin_;
+  uint64_t allocations_{0};
+  uint64_t packets_{0};
+};
+
+// RTP packet with the MID, abs-send-time and transport-cc extensions.
+int writeRtp(char* buf, uint16_t seq, uint32_t timestamp, std::mt19937& rng) {
+  uint8_t* p = reinterpret_cast<uint8_t*>(buf);
+  p[0] = 0x90;  // V=2, X=1
+  p[1] = kVideoPayloadType;
+  p[2] = seq >> 8;
+  p[3] = seq & 0xff;
+  p[4] = timestamp >> 24;
+  p[5] = (timestamp >> 16) & 0xff;
+  p[6] = (timestamp >> 8) & 0xff;
+  p[7] = timestamp & 0xff;
+  p[8] = kVideoSsrc >> 24;
+  p[9] = (kVideoSsrc >> 16) & 0xff;
+  p[10] = (kVideoSsrc >> 8) & 0xff;
+  p[11] = kVideoSsrc & 0xff;
+  const uint8_t extensions[] = {
+    0xbe, 0xde, 0x00, 0x03,
+    kMidExtId << 4, '0',
+    (kAbsSendTimeExtId << 4) | 2, 0x12, 0x34, 0x56,
+    (kTransportCcExtId << 4) | 1, static_cast<uint8_t>(seq >> 8),
+    static_cast<uint8_t>(seq), 0, 0, 0,
+  };
+  memcpy(p + 12, extensions, sizeof(extensions));
+  int length = 12 + sizeof(extensions);
+  for (int i = 0; i < kRtpPayloadSize; ++i) {
+    p[length++] = static_cast<uint8_t>(rng());
+  }
+  return length;
+}
+
+// Annex B frame of one IDR or non-IDR slice, no start code in the payload.
+std::vector<uint8_t> makeH264Frame(bool key, size_t size, std::mt19937& rng) {
+  std::vector<uint8_t> frame = {0, 0, 0, 1, static_cast<uint8_t>(key ? 0x65 : 0x41)};
+  while (frame.size() < size) {
+    frame.push_back(static_cast<uint8_t>(rng() | 0x80));
+  }
+  return frame;
+}
+
+class LoopbackIce : public erizo::IceConnection {
+ public:
+  explicit LoopbackIce(const erizo::IceConfig& config)
+      : erizo::IceConnection(config) {
+    ice_state_ = erizo::IceState::READY;
+  }
+
+  void start() override {}
+  bool setRemoteCandidates(const std::vector<erizo::CandidateInfo>&,
+                           bool) override {
+    return true;
+  }
+  void setRemoteCredentials(const std::string&, const std::string&) override {}
+  int sendData(unsigned int, const void* buf, int len) override {
+    memcpy(target->data, buf, len);
+    target->length = len;
+    return len;
+  }
+  void onData(unsigned int, char*, int) override {}
+  erizo::CandidatePair getSelectedPair() override {
+    return erizo::CandidatePair();
+  }
+  void setReceivedLastCandidate(bool) override {}
+  void close() override {}
+
+  erizo::DataPacket* target{nullptr};
+};
+
+class CountingListener : public erizo::TransportListener {
+ public:
+  void onTransportData(std::shared_ptr<erizo::DataPacket> packet,
+                       erizo::Transport*) override {
+    ++packets;
+    bytes += packet->length;
+  }
+  void updateState(TransportState state, erizo::Transport*) override {
+    this->state = state;
+  }
+  void onCandidate(const erizo::CandidateInfo&, erizo::Transport*) override {}
+
+  TransportState state{TRANSPORT_INITIAL};
+  uint64_t packets{0};
+  uint64_t bytes{0};
+};
+
+// A server transport over LoopbackIce, with SRTP keyed by |key| and |peer_key|
+// the way onHandshakeCompleted() would have.
+std::shared_ptr<erizo::DtlsTransport> makeTransport(
+    wa::Worker* worker, std::shared_ptr<CountingListener> listener,
+    const std::string& key, const std::string& peer_key, LoopbackIce** ice) {
+  erizo::IceConfig config;
+  config.ice_components = 1;
+  auto prewarmed = std::make_unique<erizo::PrewarmedTransport>();
+  prewarmed->dtls.reset(new dtls::DtlsSocketContext());
+  prewarmed->dtls->createServer();
+  dtls::DtlsSocketContext* dtls = prewarmed->dtls.get();
+  *ice = new LoopbackIce(config);
+  prewarmed->ice.reset(*ice);
+  auto transport = std::make_shared<erizo::DtlsTransport>(
+      erizo::VIDEO_TYPE, "video", "bench", true, true, listener, config,
+      "", "", true, worker, nullptr, std::move(prewarmed));
+  // A server swaps the keys, it sends with the second one.
+  transport->onHandshakeCompleted(dtls, key, peer_key, "SRTP_AES128_CM_SHA1_80");
+  return transport;
+}
+
+void benchSrtp(wa::Worker* worker) {
+  // 30 bytes of master key and salt, base64
+  const std::string key_a = "WVNfX19zZW1jdGwgKCkgewkyMjA7fQp9CnVubGVz";
+  const std::string key_b = "Ymxhc3QgdGhpcyBrZXkgaXMgb25seSBmb3IgYmVu";
+
+  auto sender_listener = std::make_shared<CountingListener>();
+  auto receiver_listener = std::make_shared<CountingListener>();
+  LoopbackIce* sender_ice = nullptr;
+  LoopbackIce* receiver_ice = nullptr;
+  auto sender = makeTransport(worker, sender_listener, key_b, key_a, &sender_ice);
+  auto receiver =
+      makeTransport(worker, receiver_listener, key_a, key_b, &receiver_ice);
+  if (sender_listener->state != TRANSPORT_READY ||
+      receiver_listener->state != TRANSPORT_READY) {
+    printf("srtp            transports not ready, skipped\n");
+    return;
+  }
+
+  std::mt19937 rng(47);
+  std::vector<std::vector<char>> plain(kPacketsPerRound,
+                                       std::vector<char>(1500));
+  std::vector<int> plain_length(kPacketsPerRound);
+  // What the socket reads would have made of the protected packets
+  std::vector<erizo::packetPtr> protected_packets;
+  for (int i = 0; i < kPacketsPerRound; ++i) {
+    protected_packets.push_back(std::make_shared<erizo::DataPacket>());
+    protected_packets.back()->comp = 1;
+  }
+  Meter protect("srtp-protect");
+  Meter unprotect("srtp-unprotect");
+  wa::LatencyTrace trace;
+  uint16_t seq = 0;
+  for (int round = 0; round < kRounds; ++round) {
+    for (int i = 0; i < kPacketsPerRound; ++i, ++seq) {
+      plain_length[i] = writeRtp(plain[i].data(), seq, seq * 3000, rng);
+    }
+
+    protect.start();
+    for (int i = 0; i < kPacketsPerRound; ++i) {
+      sender_ice->target = protected_packets[i].get();
+      sender->write(plain[i].data(), plain_length[i], trace);
+    }
+    protect.stop(kPacketsPerRound);
+
+    unprotect.start();
+    for (int i = 0; i < kPacketsPerRound; ++i) {
+      receiver->onIceData(protected_packets[i]);
+    }
+    unprotect.stop(kPacketsPerRound);
+  }
+  protect.report();
+  unprotect.report();
+  if (receiver_listener->packets != static_cast<uint64_t>(kRounds) * kPacketsPerRound) {
+    printf("srtp            only %llu packets unprotected\n",
+           static_cast<unsigned long long>(receiver_listener->packets));
+  }
+  sender->close();
+  receiver->close();
+}
+
+void benchRtpExtensions() {
+  std::vector<erizo::ExtMap> supported = {
+    erizo::ExtMap(kMidExtId, "urn:ietf:params:rtp-hdrext:sdes:mid"),
+    erizo::ExtMap(kAbsSendTimeExtId,
+                  "http://www.webrtc.org/experiments/rtp-hdrext/abs-send-time"),
+    erizo::ExtMap(kTransportCcExtId,
+                  "http://www.ietf.org/id/draft-holmer-rmcat-transport-wide-cc-extensions-01"),
+  };
+  auto sdp = std::make_shared<erizo::SdpInfo>(std::vector<erizo::RtpMap>());
+  for (erizo::ExtMap map : supported) {
+    map.mediaType = erizo::VIDEO_TYPE;
+    sdp->extMapVector.push_back(map);
+  }
+  erizo::RtpExtensionProcessor processor(supported);
+  processor.setSdpInfo(sdp);
+
+  std::mt19937 rng(47);
+  std::vector<erizo::packetPtr> packets;
+  char buf[1500];
+  for (int i = 0; i < kPacketsPerRound; ++i) {
+    int length = writeRtp(buf, i, i * 3000, rng);
+    packets.push_back(std::make_shared<erizo::DataPacket>(
+        1, buf, length, erizo::VIDEO_PACKET));
+  }
+
+  Meter meter("rtp-ext");
+  uint32_t checksum = 0;
+  for (int round = 0; round < kRounds; ++round) {
+    meter.start();
+    for (const auto& packet : packets) {
+      checksum += processor.processRtpExtensions(packet);
+    }
+    meter.stop(kPacketsPerRound);
+  }
+  meter.report();
+  if (processor.lastMid() != "0") {
+    printf("rtp-ext         mid not found, checksum %u\n", checksum);
+  }
+}
+
+class CountingSink : public webrtc::RtpPacketSinkInterface {
+ public:
+  void OnRtpPacket(const webrtc::RtpPacketReceived&) override { ++packets; }
+
+  uint64_t packets{0};
+};
+
+void benchRtpDemuxer() {
+  webrtc::RtpHeaderExtensionMap extensions;
+  extensions.Register<webrtc::RtpMid>(kMidExtId);
+  // The audio sink only makes the demuxer pick between two.
+  CountingSink audio;
+  CountingSink video;
+  webrtc::RtpDemuxer demuxer;
+  webrtc::RtpDemuxerCriteria audio_criteria;
+  audio_criteria.mid = "1";
+  audio_criteria.ssrcs.insert(kVideoSsrc + 1);
+  demuxer.AddSink(audio_criteria, &audio);
+  webrtc::RtpDemuxerCriteria video_criteria;
+  video_criteria.mid = "0";
+  video_criteria.ssrcs.insert(kVideoSsrc);
+  demuxer.AddSink(video_criteria, &video);
+
+  std::mt19937 rng(47);
+  std::vector<webrtc::RtpPacketReceived> packets;
+  char buf[1500];
+  for (int i = 0; i < kPacketsPerRound; ++i) {
+    int length = writeRtp(buf, i, i * 3000, rng);
+    packets.emplace_back(&extensions);
+    packets.back().Parse(reinterpret_cast<uint8_t*>(buf), length);
+  }
+
+  Meter meter("rtp-demux");
+  for (int round = 0; round < kRounds; ++round) {
+    meter.start();
+    for (const auto& packet : packets) {
+      demuxer.OnRtpPacket(packet);
+    }
+    meter.stop(kPacketsPerRound);
+  }
+  meter.report();
+  if (video.packets != static_cast<uint64_t>(kRounds) * kPacketsPerRound) {
+    printf("rtp-demux       only %llu packets demuxed\n",
+           static_cast<unsigned long long>(video.packets));
+  }
+}
+
+class CountingNackSender : public webrtc::NackSender {
+ public:
+  void SendNack(const std::vector<uint16_t>& sequence_numbers,
+                bool) override {
+    nacked += sequence_numbers.size();
+  }
+
+  uint64_t nacked{0};
+};
+
+class CountingKeyFrameRequestSender : public webrtc::KeyFrameRequestSender {
+ public:
+  void RequestKeyFrame() override { ++requests; }
+
+  uint64_t requests{0};
+};
+
+void benchNack() {
+  const int kLossInterval = 100;
+  const int kFramesPerKeyFrame = 3000;
+  webrtc::SimulatedClock clock(1000000);
+  CountingNackSender nack_sender;
+  CountingKeyFrameRequestSender keyframe_sender;
+  webrtc::NackModule nack(&clock, &nack_sender, &keyframe_sender);
+  nack.UpdateRtt(50);
+
+  Meter meter("nack");
+  uint16_t seq = 0;
+  for (int round = 0; round < kRounds; ++round) {
+    int received = 0;
+    meter.start();
+    for (int i = 0; i < kPacketsPerRound; ++i, ++seq) {
+      if (seq % kLossInterval == kLossInterval - 1) {
+        continue;
+      }
+      nack.OnReceivedPacket(seq, seq % kFramesPerKeyFrame == 0, false);
+      ++received;
+    }
+    meter.stop(received);
+    // A round is about two seconds of 720p, the lost packets are given up on.
+    clock.AdvanceTimeMilliseconds(2000);
+    nack.Process();
+  }
+  meter.report();
+  if (nack_sender.nacked == 0) {
+    printf("nack            no packet nacked\n");
+  }
+}
+
+// Pass through stage, like the stats and feedback handlers of a MediaStream.
+class RelayHandler : public erizo::Handler {
+ public:
+  void enable() override { enabled_ = true; }
+  void disable() override { enabled_ = false; }
+  std::string getName() override { return "relay"; }
+  void read(Context* ctx, std::shared_ptr<erizo::DataPacket> packet) override {
+    if (enabled_) {
+      bytes_ += packet->length;
+    }
+    ctx->fireRead(std::move(packet));
+  }
+  void write(Context* ctx, std::shared_ptr<erizo::DataPacket> packet) override {
+    if (enabled_) {
+      bytes_ += packet->length;
+    }
+    ctx->fireWrite(std::move(packet));
+  }
+  void notifyUpdate() override {}
+
+ private:
+  bool enabled_{true};
+  uint64_t bytes_{0};
+};
+
+class SinkReader : public erizo::InboundHandler {
+ public:
+  void enable() override {}
+  void disable() override {}
+  std::string getName() override { return "reader"; }
+  void read(Context*, std::shared_ptr<erizo::DataPacket>) override { ++packets; }
+  void notifyUpdate() override {}
+
+  uint64_t packets{0};
+};
+
+class SinkWriter : public erizo::OutboundHandler {
+ public:
+  void enable() override {}
+  void disable() override {}
+  std::string getName() override { return "writer"; }
+  void write(Context*, std::shared_ptr<erizo::DataPacket>) override { ++packets; }
+  void notifyUpdate() override {}
+
+  uint64_t packets{0};
+};
+
+void benchPipeline() {
+  const int kRelays = 4;
+  auto reader = std::make_shared<SinkReader>();
+  auto writer = std::make_shared<SinkWriter>();
+  erizo::Pipeline::Ptr pipeline = erizo::Pipeline::create();
+  pipeline->addFront(reader);
+  for (int i = 0; i < kRelays; ++i) {
+    pipeline->addFront(std::make_shared<RelayHandler>());
+  }
+  pipeline->addFront(writer);
+  pipeline->finalize();
+
+  std::mt19937 rng(47);
+  char buf[1500];
+  int length = writeRtp(buf, 0, 0, rng);
+  auto packet = std::make_shared<erizo::DataPacket>(
+      1, buf, length, erizo::VIDEO_PACKET);
+
+  Meter meter("pipeline");
+  for (int round = 0; round < kRounds; ++round) {
+    meter.start();
+    for (int i = 0; i < kPacketsPerRound; ++i) {
+      pipeline->read(packet);
+      pipeline->write(packet);
+    }
+    meter.stop(kPacketsPerRound);
+  }
+  meter.report();
+  if (reader->packets != writer->packets) {
+    printf("pipeline        read %llu, wrote %llu\n",
+           static_cast<unsigned long long>(reader->packets),
+           static_cast<unsigned long long>(writer->packets));
+  }
+  pipeline->close();
+}
+
+class CountingDataListener : public rtc_adapter::AdapterDataListener {
+ public:
+  void onAdapterData(char*, int len) override {
+    ++packets;
+    bytes += len;
+  }
+
+  uint64_t packets{0};
+  uint64_t bytes{0};
+};
+
+// Runs |f| on |worker| and waits for it.
+void runOn(wa::Worker* worker, std::function<void()> f) {
+  auto done = std::make_shared<std::promise<void>>();
+  std::future<void> future = done->get_future();
+  worker->task([f, done] {
+    f();
+    done->set_value();
+  });
+  future.wait();
+}
+
+void benchVideoSend(wa::Worker* worker, const char* name, bool fec) {
+  const int kFrames = 3000;
+  const int kFramesPerKeyFrame = 300;
+
+  std::mt19937 rng(47);
+  std::vector<uint8_t> key_frame = makeH264Frame(true, 60000, rng);
+  std::vector<uint8_t> delta_frame = makeH264Frame(false, 8000, rng);
+
+  runOn(worker, [&] {
+    rtc_adapter::RtcAdapterFactory factory(worker->getTaskQueue());
+    std::shared_ptr<rtc_adapter::RtcAdapter> adapter = factory.CreateRtcAdapter();
+    CountingDataListener listener;
+    rtc_adapter::RtcAdapter::Config config;
+    memset(config.mid, 0, sizeof(config.mid));
+    config.rtp_listener = &listener;
+    if (fec) {
+      config.red_payload = 116;
+      config.ulpfec_payload = 117;
+    }
+    rtc_adapter::VideoSendAdapter* sender = adapter->createVideoSender(config);
+
+    owt_base::Frame frame{};
+    frame.format = owt_base::FRAME_FORMAT_H264;
+    frame.additionalInfo.video.width = 1280;
+    frame.additionalInfo.video.height = 720;
+
+    Meter meter(name);
+    for (int i = 0; i < kFrames; ++i) {
+      std::vector<uint8_t>& payload =
+          i % kFramesPerKeyFrame == 0 ? key_frame : delta_frame;
+      frame.payload = payload.data();
+      frame.length = payload.size();
+      frame.timeStamp = i * 3000;
+      frame.additionalInfo.video.isKeyFrame = i % kFramesPerKeyFrame == 0;
+      uint64_t before = listener.packets;
+      meter.start();
+      sender->onFrame(frame);
+      meter.stop(static_cast<int>(listener.packets - before));
+    }
+    meter.report();
+    adapter->destoryVideoSender(sender);
+  });
+}
+
+void benchAudioSend(wa::Worker* worker, const char* name, bool forward) {
+  const int kFrames = 50000;
+  const int kOpusFrameSize = 120;
+
+  std::mt19937 rng(47);
+  char rtp[1500];
+  std::vector<uint8_t> payload(kOpusFrameSize);
+  for (uint8_t& byte : payload) {
+    byte = static_cast<uint8_t>(rng());
+  }
+
+  runOn(worker, [&] {
+    rtc_adapter::RtcAdapterFactory factory(worker->getTaskQueue());
+    std::shared_ptr<rtc_adapter::RtcAdapter> adapter = factory.CreateRtcAdapter();
+    CountingDataListener listener;
+    rtc_adapter::RtcAdapter::Config config;
+    memset(config.mid, 0, sizeof(config.mid));
+    config.rtp_listener = &listener;
+    rtc_adapter::AudioSendAdapter* sender = adapter->createAudioSender(config);
+
+    owt_base::Frame frame{};
+    frame.format = owt_base::FRAME_FORMAT_OPUS;
+    frame.additionalInfo.audio.isRtpPacket = forward;
+    frame.additionalInfo.audio.nbSamples = 960;
+    frame.additionalInfo.audio.sampleRate = 48000;
+    frame.additionalInfo.audio.channels = 2;
+
+    Meter meter(name);
+    for (int i = 0; i < kFrames; ++i) {
+      if (forward) {
+        // The RTP packet as received, rewritten in place by the adapter.
+        int length = writeRtp(rtp, i, i * 960, rng);
+        frame.payload = reinterpret_cast<uint8_t*>(rtp);
+        frame.length = length - kRtpPayloadSize + kOpusFrameSize;
+      } else {
+        frame.payload = payload.data();
+        frame.length = payload.size();
+      }
+      frame.timeStamp = i * 960;
+      uint64_t before = listener.packets;
+      meter.start();
+      sender->onFrame(frame);
+      meter.stop(static_cast<int>(listener.packets - before));
+    }
+    meter.report();
+    adapter->destoryAudioSender(sender);
+  });
+}
+
+}  // namespace
+
+int main() {
+  erizo::erizo_global_init();
+  wa::ThreadPool workers(1);
+  workers.start();
+  std::shared_ptr<wa::Worker> worker = workers.getLessUsedWorker();
+
+  benchSrtp(worker.get());
+  benchRtpExtensions();
+  benchRtpDemuxer();
+  benchNack();
+  benchPipeline();
+  benchVideoSend(worker.get(), "video-send", false);
+  benchVideoSend(worker.get(), "video-send-fec", true);
+  benchAudioSend(worker.get(), "audio-send", false);
+  benchAudioSend(worker.get(), "audio-forward", true);
+
+  workers.close();
+  erizo::erizo_global_release();
+  return 0;
+}
@@ -0,0 +1,171 @@
+// Copyright (c) 2021- anjisuan783
+//
+// SPDX-License-Identifier: MIT
+
+// Replays bursty loss traces through webrtc::NackModule on a simulated clock
+// and reports the time spent per received packet. Lost packets are repaired
+// by retransmissions arriving out of order a round trip after being nacked.
+// A first pass records the packet arrivals so the timed pass runs nothing but
+// the module.
+
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "rtc_base/clock.h"
+#include "video/nack_module.h"
+
+namespace {
+
+const int kPackets = 200000;
+const int kPacketsPerFrame = 8;
+const int kFramesPerKeyFrame = 300;
+const int64_t kPacketIntervalUs = 1000;
+const int64_t kRttMs = 60;
+
+// One step of the trace: the packet received after advancing the clock, if
+// any, followed by a Process() call when one is due.
+struct Event {
+  int64_t advance_us;
+  int seq_num;  // -1 when nothing arrives
+  bool is_keyframe;
+  bool is_recovered;
+};
+
+struct Trace {
+  const char* name;
+  double p_good_to_bad;  // chance of entering a loss burst
+  double p_bad_to_good;  // chance of leaving it
+  double p_repair;       // chance a nacked packet's retransmission arrives
+};
+
+class CountingNackSender : public webrtc::NackSender {
+ public:
+  void SendNack(const std::vector<uint16_t>& sequence_numbers,
+                bool buffering_allowed) override {
+    for (uint16_t seq_num : sequence_numbers) {
+      checksum = checksum * 31 + seq_num;
+      ++nacks;
+    }
+    last_batch = sequence_numbers;
+  }
+
+  std::vector<uint16_t> last_batch;
+  uint64_t checksum = 0;
+  int nacks = 0;
+};
+
+class CountingKeyFrameRequestSender : public webrtc::KeyFrameRequestSender {
+ public:
+  void RequestKeyFrame() override { ++requests; }
+
+  int requests = 0;
+};
+
+std::vector<Event> record(const Trace& trace) {
+  webrtc::SimulatedClock clock(1000000);
+  CountingNackSender nack_sender;
+  CountingKeyFrameRequestSender keyframe_sender;
+  webrtc::NackModule nack(&clock, &nack_sender, &keyframe_sender);
+  nack.UpdateRtt(kRttMs);
+
+  std::mt19937 rng(36);
+  std::uniform_real_distribution<double> uniform(0.0, 1.0);
+  // Retransmissions in flight, delivered once the clock passes |at_us|.
+  struct Repair {
+    int64_t at_us;
+    uint16_t seq_num;
+  };
+  std::vector<Repair> repairs;
+  std::vector<Event> events;
+  bool in_burst = false;
+
+  for (int i = 0; i < kPackets; ++i) {
+    const int64_t now_us = clock.TimeInMicroseconds() + kPacketIntervalUs;
+    const bool is_keyframe =
+        i % (kPacketsPerFrame * kFramesPerKeyFrame) == 0;
+    in_burst = in_burst ? uniform(rng) >= trace.p_bad_to_good
+                        : uniform(rng) < trace.p_good_to_bad;
+
+    std::vector<Event> step;
+    if (!in_burst || is_keyframe)
+      step.push_back({kPacketIntervalUs, i & 0xffff, is_keyframe, false});
+    size_t kept = 0;
+    for (const Repair& repair : repairs) {
+      if (repair.at_us <= now_us) {
+        step.push_back({0, repair.seq_num, false, true});
+      } else {
+        repairs[kept++] = repair;
+      }
+    }
+    repairs.resize(kept);
+    if (step.empty() || step[0].advance_us == 0)
+      step.insert(step.begin(), {kPacketIntervalUs, -1, false, false});
+
+    for (const Event& event : step) {
+      clock.AdvanceTimeMicroseconds(event.advance_us);
+      if (event.seq_num >= 0) {
+        nack.OnReceivedPacket(event.seq_num, event.is_keyframe,
+                              event.is_recovered);
+      }
+      events.push_back(event);
+    }
+    if (nack.TimeUntilNextProcess() <= 0) {
+      nack_sender.last_batch.clear();
+      nack.Process();
+      for (uint16_t nacked : nack_sender.last_batch) {
+        if (uniform(rng) < trace.p_repair)
+          repairs.push_back({now_us + kRttMs * 1000, nacked});
+      }
+    }
+  }
+  return events;
+}
+
+void run(const Trace& trace) {
+  const std::vector<Event> events = record(trace);
+
+  webrtc::SimulatedClock clock(1000000);
+  CountingNackSender nack_sender;
+  CountingKeyFrameRequestSender keyframe_sender;
+  webrtc::NackModule nack(&clock, &nack_sender, &keyframe_sender);
+  nack.UpdateRtt(kRttMs);
+
+  int received = 0;
+  auto begin = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < events.size(); ++i) {
+    const Event& event = events[i];
+    clock.AdvanceTimeMicroseconds(event.advance_us);
+    if (event.seq_num >= 0) {
+      nack.OnReceivedPacket(event.seq_num, event.is_keyframe,
+                            event.is_recovered);
+      ++received;
+    }
+    // Process after the last packet of each step, as record() did.
+    bool step_done = i + 1 == events.size() || events[i + 1].advance_us != 0;
+    if (step_done && nack.TimeUntilNextProcess() <= 0)
+      nack.Process();
+  }
+  auto elapsed = std::chrono::duration<double>(
+      std::chrono::steady_clock::now() - begin).count();
+
+  printf("%-8s received %6d nacked %6d keyframes %3d %6.1fns/packet "
+         "checksum %016llx\n",
+         trace.name, received, nack_sender.nacks, keyframe_sender.requests,
+         elapsed * 1e9 / received,
+         static_cast<unsigned long long>(nack_sender.checksum));
+}
+
+}  // namespace
+
+int main() {
+  const Trace kTraces[] = {
+      {"light", 0.002, 0.5, 0.9},
+      {"bursty", 0.01, 0.1, 0.8},
+      {"outage", 0.0005, 0.002, 0.7},
+  };
+  for (const Trace& trace : kTraces)
+    run(trace);
+  return 0;
+}
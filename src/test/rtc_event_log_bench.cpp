@@ -0,0 +1,219 @@
+// Copyright (c) 2021- anjisuan783
+//
+// SPDX-License-Identifier: MIT
+
+// Cost of the RtcEventLogImpl on the worker thread, and what reaches the
+// files:
+//
+//   bench_rtc_event_log [events] [rate] [file_prefix]
+//
+// Logs |events| outgoing RTCP packets and delay based BWE updates, the per
+// packet and per feedback events of a connection, three ways:
+//   off     call sites checking IsLogging(), as call.cc and rtp_sender.cc do
+//   off-raw Log() called anyway, the event built and dropped
+//   on      logging to <file_prefix>-<n>.rtclog
+// then reads the files back and counts their records per type. The logging
+// run is paced at |rate| events a second, the time spent sleeping is not
+// counted; past what the drain thread writes, events are dropped and the
+// dropped records of the files count them.
+
+#include <unistd.h>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "myrtc/api/network_state_predictor.h"
+#include "myrtc/logging/rtc_event_bwe_update_delay_based.h"
+#include "myrtc/logging/rtc_event_rtcp_packet_outgoing.h"
+#include "owt/rtc_adapter/RtcEventLogImpl.h"
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+// A receiver report with one block and a REMB, about what a subscriber sends.
+const size_t kRtcpBytes = 56;
+// Every this many packets a BWE update.
+const int kPacketsPerUpdate = 10;
+// Packets logged between two sleeps of a paced run.
+const int kPacketsPerSlice = 100;
+
+// Logs |events| packets, at |rate| a second if not 0, and returns the ns
+// spent in the calls per event logged.
+double logEvents(webrtc::RtcEventLog* log, int events, bool check, int rate) {
+  std::vector<uint8_t> rtcp(kRtcpBytes, 0x80);
+  Clock::duration spent{0};
+  Clock::time_point slice = Clock::now();
+  const Clock::time_point first = slice;
+  for (int i = 0; i < events; ++i) {
+    if (rate && i % kPacketsPerSlice == 0 && i) {
+      spent += Clock::now() - slice;
+      std::this_thread::sleep_until(
+          first + std::chrono::microseconds(1000000LL * i / rate));
+      slice = Clock::now();
+    }
+    if (!check || log->IsLogging()) {
+      log->Log(std::make_unique<webrtc::RtcEventRtcpPacketOutgoing>(rtcp));
+    }
+    if (i % kPacketsPerUpdate == 0 && (!check || log->IsLogging())) {
+      log->Log(std::make_unique<webrtc::RtcEventBweUpdateDelayBased>(
+          1000000 + i, webrtc::BandwidthUsage::kBwNormal));
+    }
+  }
+  spent += Clock::now() - slice;
+  const int logged = events + (events + kPacketsPerUpdate - 1) /
+                     kPacketsPerUpdate;
+  return std::chrono::duration<double, std::nano>(spent).count() / logged;
+}
+
+bool readVarint(FILE* file, uint64_t* value) {
+  *value = 0;
+  for (int shift = 0; shift < 64; shift += 7) {
+    int c = fgetc(file);
+    if (c == EOF) {
+      return false;
+    }
+    *value |= static_cast<uint64_t>(c & 0x7f) << shift;
+    if (!(c & 0x80)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+uint64_t varintOf(const std::vector<uint8_t>& payload) {
+  uint64_t value = 0;
+  for (size_t i = 0; i < payload.size() && i < 10; ++i) {
+    value |= static_cast<uint64_t>(payload[i] & 0x7f) << (7 * i);
+    if (!(payload[i] & 0x80)) {
+      break;
+    }
+  }
+  return value;
+}
+
+struct FileCounts {
+  std::map<int, uint64_t> records;
+  uint64_t dropped{0};
+  uint64_t bytes{0};
+  bool truncated{false};
+};
+
+// False if |path| is not an event log file.
+bool readFile(const std::string& path, FileCounts* counts) {
+  FILE* file = fopen(path.c_str(), "rb");
+  if (!file) {
+    return false;
+  }
+  char magic[sizeof(rtc_adapter::kRtcEventLogMagic) + 1];
+  if (fread(magic, sizeof(magic), 1, file) != 1 ||
+      memcmp(magic, rtc_adapter::kRtcEventLogMagic,
+             sizeof(rtc_adapter::kRtcEventLogMagic)) ||
+      magic[sizeof(magic) - 1] != rtc_adapter::kRtcEventLogVersion) {
+    fclose(file);
+    return false;
+  }
+  std::vector<uint8_t> payload;
+  while (true) {
+    int type = fgetc(file);
+    if (type == EOF) {
+      break;
+    }
+    uint64_t delta = 0;
+    uint64_t length = 0;
+    if (!readVarint(file, &delta) || !readVarint(file, &length)) {
+      counts->truncated = true;
+      break;
+    }
+    payload.resize(length);
+    if (length && fread(payload.data(), length, 1, file) != 1) {
+      counts->truncated = true;
+      break;
+    }
+    ++counts->records[type];
+    if (type == rtc_adapter::kRtcEventLogDroppedRecord) {
+      counts->dropped += varintOf(payload);
+    }
+  }
+  counts->bytes += ftell(file);
+  fclose(file);
+  return true;
+}
+
+const char* typeName(int type) {
+  switch (type) {
+    case rtc_adapter::kRtcEventLogSyncRecord:
+      return "sync";
+    case rtc_adapter::kRtcEventLogDroppedRecord:
+      return "dropped";
+    case static_cast<int>(webrtc::RtcEvent::Type::RtcpPacketOutgoing):
+      return "rtcp-out";
+    case static_cast<int>(webrtc::RtcEvent::Type::BweUpdateDelayBased):
+      return "bwe-delay";
+    default:
+      return "other";
+  }
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  const int events = argc > 1 ? atoi(argv[1]) : 200000;
+  // About a hundred busy connections of one worker
+  const int rate = argc > 2 ? atoi(argv[2]) : 100000;
+  const std::string prefix = argc > 3 ? argv[3] :
+      "/tmp/bench_rtc_event_log-" + std::to_string(getpid());
+  if (events <= 0 || rate < 0) {
+    fprintf(stderr, "usage: %s [events] [rate] [file_prefix]\n", argv[0]);
+    return 1;
+  }
+  const int logged = events + (events + kPacketsPerUpdate - 1) /
+                     kPacketsPerUpdate;
+
+  // All calls from this thread, which stands for the worker; the task queue
+  // only keys the shared buffer.
+  rtc_adapter::RtcEventLogImpl log(nullptr);
+
+  printf("off      %8.1f ns/event\n", logEvents(&log, events, true, 0));
+  printf("off-raw  %8.1f ns/event\n", logEvents(&log, events, false, 0));
+
+  if (!log.StartLogging(
+          std::make_unique<rtc_adapter::RotatingEventLogOutput>(prefix), 0)) {
+    fprintf(stderr, "can not open %s-0.rtclog\n", prefix.c_str());
+    return 1;
+  }
+  printf("on       %8.1f ns/event\n", logEvents(&log, events, true, rate));
+  log.StopLogging();
+
+  // The output is closed by the drain thread once it wrote the last batch.
+  std::this_thread::sleep_for(std::chrono::milliseconds(500));
+
+  FileCounts counts;
+  int files = 0;
+  for (int i = 0; readFile(prefix + "-" + std::to_string(i) + ".rtclog",
+                           &counts); ++i) {
+    ++files;
+  }
+  uint64_t written = 0;
+  for (const auto& record : counts.records) {
+    printf("  %-10s %10llu\n", typeName(record.first),
+           static_cast<unsigned long long>(record.second));
+    if (record.first < rtc_adapter::kRtcEventLogDroppedRecord) {
+      written += record.second;
+    }
+  }
+  printf("%d files, %llu bytes, %llu of %d events written, "
+         "%llu reported dropped%s\n", files,
+         static_cast<unsigned long long>(counts.bytes),
+         static_cast<unsigned long long>(written), logged,
+         static_cast<unsigned long long>(counts.dropped),
+         counts.truncated ? ", last record truncated" : "");
+  return 0;
+}
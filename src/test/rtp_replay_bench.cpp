@@ -0,0 +1,509 @@
+// Copyright (c) 2021- anjisuan783
+//
+// SPDX-License-Identifier: MIT
+
+// Replays the inbound side of a capture taken with rtc_api::startCapture into
+// a VideoFrameConstructor, on a simulated clock:
+//
+//   bench_rtp_replay <prefix>-in.rtpdump [--ssrc=N] [--rtx-ssrc=N] [--pt=N]
+//                    [--red=N] [--ulpfec=N] [--transport-cc=ID]
+//
+// Packets are delivered at their capture offsets and the timers of the
+// receive side, NACK, key frame requests, RTCP reports and the 1s bitrate
+// tick, fire at their simulated due times. Nothing waits on the wall clock,
+// so a capture of minutes replays in seconds and every run of the same file
+// prints the same numbers.
+// The feedback the receive side would have sent back is counted per second
+// of the capture: NACKed packets, PLIs and FIRs, REMB and transport-cc, along
+// with the frames it assembled. The replay is open loop, retransmissions are
+// the ones the capture holds and not answers to the replayed NACKs.
+// Without --ssrc the stream carrying the most RTP bytes is replayed, with its
+// most frequent payload type. The SDP is not part of the capture, --red,
+// --ulpfec and --transport-cc give the ids the connection negotiated.
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <future>
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "erizo/MediaDefinitions.h"
+#include "erizo/rtp/RtpCapture.h"
+#include "erizo/rtp/RtpHeaders.h"
+#include "erizo/rtp/RtpUtils.h"
+#include "myrtc/api/task_queue_base.h"
+#include "myrtc/api/task_queue_factory.h"
+#include "myrtc/rtc_base/time_utils.h"
+#include "owt/owt_base/VideoFrameConstructor.h"
+#include "owt/rtc_adapter/RtcAdapter.h"
+#include "utils/Clock.h"
+#include "utils/Worker.h"
+
+namespace {
+
+// Simulated time starts here rather than at 0, like a host that is up.
+const int64_t kStartUs = 1000 * 1000 * 1000;
+const int64_t kReportPeriodUs = 1000 * 1000;
+// Left to the timers after the last packet.
+const int64_t kDrainUs = 3 * 1000 * 1000;
+
+const uint8_t kNackFmt = 1;
+const uint8_t kTransportCcFmt = 15;
+
+// Time of the wa::Worker and, through rtc::SetClockForTesting, of everything
+// below the RtcAdapter.
+class SimulatedClock : public wa::Clock, public rtc::ClockInterface {
+ public:
+  wa::time_point now() override {
+    return wa::time_point(std::chrono::microseconds(now_us_));
+  }
+
+  int64_t TimeNanos() const override {
+    return now_us_ * 1000;
+  }
+
+  int64_t nowUs() const {
+    return now_us_;
+  }
+
+  void advanceTo(int64_t time_us) {
+    now_us_ = std::max(now_us_, time_us);
+  }
+
+ private:
+  int64_t now_us_{kStartUs};
+};
+
+// Runs its tasks only from runUntil(), on the calling thread, in due time
+// order and FIFO among tasks due at the same time.
+class SimulatedTaskQueue : public webrtc::TaskQueueBase {
+ public:
+  explicit SimulatedTaskQueue(SimulatedClock* clock) : clock_{clock} {}
+
+  void Delete() override {
+    delete this;
+  }
+
+  void PostTask(std::unique_ptr<webrtc::QueuedTask> task) override {
+    ready_.push_back(std::move(task));
+  }
+
+  void PostDelayedTask(std::unique_ptr<webrtc::QueuedTask> task,
+                       uint32_t milliseconds) override {
+    delayed_.emplace(
+        std::make_pair(clock_->nowUs() + milliseconds * int64_t{1000},
+                       sequence_++),
+        std::move(task));
+  }
+
+  // Moves the clock to |time_us|, stopping at every delayed task due before.
+  void runUntil(int64_t time_us) {
+    CurrentTaskQueueSetter setter(this);
+    runReady();
+    while (!delayed_.empty() && delayed_.begin()->first.first <= time_us) {
+      auto first = delayed_.begin();
+      clock_->advanceTo(first->first.first);
+      std::unique_ptr<webrtc::QueuedTask> task = std::move(first->second);
+      delayed_.erase(first);
+      run(std::move(task));
+      runReady();
+    }
+    clock_->advanceTo(time_us);
+  }
+
+ private:
+  ~SimulatedTaskQueue() override = default;
+
+  void runReady() {
+    while (!ready_.empty()) {
+      std::unique_ptr<webrtc::QueuedTask> task = std::move(ready_.front());
+      ready_.pop_front();
+      run(std::move(task));
+    }
+  }
+
+  static void run(std::unique_ptr<webrtc::QueuedTask> task) {
+    // A task returning false took its own ownership.
+    if (!task->Run()) {
+      task.release();
+    }
+  }
+
+  SimulatedClock* clock_;
+  std::deque<std::unique_ptr<webrtc::QueuedTask>> ready_;
+  std::map<std::pair<int64_t, uint64_t>, std::unique_ptr<webrtc::QueuedTask>>
+      delayed_;
+  uint64_t sequence_{0};
+};
+
+class SimulatedTaskQueueFactory : public webrtc::TaskQueueFactory {
+ public:
+  explicit SimulatedTaskQueueFactory(SimulatedClock* clock) : clock_{clock} {}
+
+  std::unique_ptr<webrtc::TaskQueueBase, webrtc::TaskQueueDeleter>
+  CreateTaskQueue(std::string_view, Priority) const override {
+    queue_ = new SimulatedTaskQueue(clock_);
+    return std::unique_ptr<webrtc::TaskQueueBase, webrtc::TaskQueueDeleter>(
+        queue_);
+  }
+
+  // The last queue created, owned by its worker.
+  SimulatedTaskQueue* queue() const {
+    return queue_;
+  }
+
+ private:
+  SimulatedClock* clock_;
+  mutable SimulatedTaskQueue* queue_{nullptr};
+};
+
+struct Counters {
+  uint64_t rtp{0};
+  uint64_t rtcp{0};
+  uint64_t frames{0};
+  uint64_t key_frames{0};
+  uint64_t frame_bytes{0};
+  uint64_t nack_packets{0};
+  uint64_t nacked{0};
+  uint64_t pli{0};
+  uint64_t fir{0};
+  uint64_t remb{0};
+  uint64_t remb_min_bps{0};
+  uint64_t remb_max_bps{0};
+  uint64_t transport_cc{0};
+  uint64_t receiver_reports{0};
+
+  void add(const Counters& other) {
+    rtp += other.rtp;
+    rtcp += other.rtcp;
+    frames += other.frames;
+    key_frames += other.key_frames;
+    frame_bytes += other.frame_bytes;
+    nack_packets += other.nack_packets;
+    nacked += other.nacked;
+    pli += other.pli;
+    fir += other.fir;
+    transport_cc += other.transport_cc;
+    receiver_reports += other.receiver_reports;
+    if (other.remb) {
+      remb_min_bps = remb ? std::min(remb_min_bps, other.remb_min_bps)
+                          : other.remb_min_bps;
+      remb_max_bps = std::max(remb_max_bps, other.remb_max_bps);
+      remb += other.remb;
+    }
+  }
+
+  void addRemb(uint64_t bps) {
+    remb_min_bps = remb ? std::min(remb_min_bps, bps) : bps;
+    remb_max_bps = std::max(remb_max_bps, bps);
+    ++remb;
+  }
+
+  void print(const char* label) const {
+    printf("%-8s rtp:%-6llu rtcp:%-4llu frames:%-4llu key:%-3llu "
+           "kbit:%-6llu nack:%llu/%-5llu pli:%-3llu fir:%-3llu rr:%-3llu "
+           "twcc:%-4llu remb:%llu",
+           label,
+           static_cast<unsigned long long>(rtp),
+           static_cast<unsigned long long>(rtcp),
+           static_cast<unsigned long long>(frames),
+           static_cast<unsigned long long>(key_frames),
+           static_cast<unsigned long long>(frame_bytes * 8 / 1000),
+           static_cast<unsigned long long>(nack_packets),
+           static_cast<unsigned long long>(nacked),
+           static_cast<unsigned long long>(pli),
+           static_cast<unsigned long long>(fir),
+           static_cast<unsigned long long>(receiver_reports),
+           static_cast<unsigned long long>(transport_cc),
+           static_cast<unsigned long long>(remb));
+    if (remb) {
+      printf(" %llu-%llukbps",
+             static_cast<unsigned long long>(remb_min_bps / 1000),
+             static_cast<unsigned long long>(remb_max_bps / 1000));
+    }
+    printf("\n");
+  }
+};
+
+// Stands in for the MediaStream, counting the feedback it would have sent.
+class ReplaySource : public erizo::MediaSource, public erizo::FeedbackSink {
+ public:
+  explicit ReplaySource(Counters* counters) : counters_{counters} {}
+
+  int sendPLI() override {
+    return 0;
+  }
+
+  void close() override {}
+
+  erizo::MediaSink* videoSink() {
+    return video_sink_;
+  }
+
+ private:
+  int deliverFeedback_(std::shared_ptr<erizo::DataPacket> packet) override {
+    erizo::RtpUtils::forEachRtcpBlock(packet->data, packet->length,
+        [this](erizo::RtcpHeader* chead, int, int) {
+          uint8_t type = chead->getPacketType();
+          uint8_t fmt = chead->getBlockCount();
+          if (type == RTCP_Receiver_PT) {
+            ++counters_->receiver_reports;
+          } else if (type == RTCP_RTP_Feedback_PT && fmt == kNackFmt) {
+            ++counters_->nack_packets;
+            erizo::RtpUtils::forEachNack(chead,
+                [this](uint16_t, uint16_t blp, erizo::RtcpHeader*) {
+                  counters_->nacked += 1 + __builtin_popcount(blp);
+                });
+          } else if (type == RTCP_RTP_Feedback_PT && fmt == kTransportCcFmt) {
+            ++counters_->transport_cc;
+          } else if (type == RTCP_PS_Feedback_PT && fmt == RTCP_PLI_FMT) {
+            ++counters_->pli;
+          } else if (type == RTCP_PS_Feedback_PT && fmt == RTCP_FIR_FMT) {
+            ++counters_->fir;
+          } else if (chead->isREMB()) {
+            counters_->addRemb(chead->getREMBBitRate());
+          }
+        });
+    return packet->length;
+  }
+
+  Counters* counters_;
+};
+
+class FrameCounter : public owt_base::FrameDestination {
+ public:
+  explicit FrameCounter(Counters* counters) : counters_{counters} {}
+
+  void onFrame(const owt_base::Frame& frame) override {
+    ++counters_->frames;
+    counters_->frame_bytes += frame.length;
+    if (frame.additionalInfo.video.isKeyFrame) {
+      ++counters_->key_frames;
+    }
+  }
+
+ private:
+  Counters* counters_;
+};
+
+struct Options {
+  std::string path;
+  uint32_t ssrc{0};
+  uint32_t rtx_ssrc{0};
+  int payload_type{-1};
+  int red{-1};
+  int ulpfec{-1};
+  int transport_cc{-1};
+};
+
+bool parseOptions(int argc, char** argv, Options* options) {
+  for (int i = 1; i < argc; ++i) {
+    const char* arg = argv[i];
+    const char* value = strchr(arg, '=');
+    if (arg[0] != '-') {
+      options->path = arg;
+      continue;
+    }
+    if (!value) {
+      return false;
+    }
+    std::string name(arg, value - arg);
+    unsigned long number = strtoul(value + 1, nullptr, 0);
+    if (name == "--ssrc") {
+      options->ssrc = number;
+    } else if (name == "--rtx-ssrc") {
+      options->rtx_ssrc = number;
+    } else if (name == "--pt") {
+      options->payload_type = number;
+    } else if (name == "--red") {
+      options->red = number;
+    } else if (name == "--ulpfec") {
+      options->ulpfec = number;
+    } else if (name == "--transport-cc") {
+      options->transport_cc = number;
+    } else {
+      return false;
+    }
+  }
+  return !options->path.empty();
+}
+
+// Picks the stream with the most RTP bytes, and its most frequent payload
+// type, for the options not given.
+bool detectStream(Options* options) {
+  auto reader = erizo::RtpDumpReader::open(options->path);
+  if (!reader) {
+    return false;
+  }
+  std::map<uint32_t, uint64_t> bytes;
+  std::map<std::pair<uint32_t, int>, uint64_t> payload_types;
+  erizo::RtpDumpPacket packet;
+  while (reader->next(&packet)) {
+    if (packet.rtcp || packet.data.size() < sizeof(erizo::RtpHeader)) {
+      continue;
+    }
+    auto head = reinterpret_cast<erizo::RtpHeader*>(packet.data.data());
+    bytes[head->getSSRC()] += packet.data.size();
+    ++payload_types[{head->getSSRC(), head->getPayloadType()}];
+  }
+  if (!options->ssrc) {
+    uint64_t most = 0;
+    for (auto& i : bytes) {
+      if (i.second > most) {
+        most = i.second;
+        options->ssrc = i.first;
+      }
+    }
+  }
+  if (options->payload_type < 0) {
+    uint64_t most = 0;
+    for (auto& i : payload_types) {
+      if (i.first.first == options->ssrc && i.second > most) {
+        most = i.second;
+        options->payload_type = i.first.second;
+      }
+    }
+  }
+  return options->ssrc != 0 && options->payload_type >= 0;
+}
+
+// The receive stream takes sender reports and the like, feedback blocks are
+// for the send side.
+bool isReceiveSideRtcp(erizo::RtcpHeader* chead, uint32_t ssrc) {
+  switch (chead->getPacketType()) {
+    case RTCP_Sender_PT:
+      return chead->getSSRC() == ssrc;
+    case RTCP_SDES_PT:
+    case RTCP_XR_PT:
+      return true;
+    default:
+      return false;
+  }
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  Options options;
+  if (!parseOptions(argc, argv, &options)) {
+    fprintf(stderr,
+            "usage: %s <capture>-in.rtpdump [--ssrc=N] [--rtx-ssrc=N] "
+            "[--pt=N] [--red=N] [--ulpfec=N] [--transport-cc=ID]\n",
+            argv[0]);
+    return 1;
+  }
+  if (!detectStream(&options)) {
+    fprintf(stderr, "%s: no RTP stream to replay\n", options.path.c_str());
+    return 1;
+  }
+  printf("replaying %s ssrc:%u rtx:%u pt:%d red:%d ulpfec:%d "
+         "transport-cc:%d\n",
+         options.path.c_str(), options.ssrc, options.rtx_ssrc,
+         options.payload_type, options.red, options.ulpfec,
+         options.transport_cc);
+
+  auto clock = std::make_shared<SimulatedClock>();
+  rtc::SetClockForTesting(clock.get());
+  SimulatedTaskQueueFactory factory(clock.get());
+  auto worker = std::make_shared<wa::Worker>(&factory, clock);
+  worker->start(std::make_shared<std::promise<void>>());
+  SimulatedTaskQueue* queue = factory.queue();
+  queue->runUntil(clock->nowUs());
+
+  Counters period;
+  Counters total;
+  rtc_adapter::RtcAdapterFactory adapter_factory(worker->getTaskQueue());
+  auto source = std::make_unique<ReplaySource>(&period);
+  auto frames = std::make_shared<FrameCounter>(&period);
+  std::shared_ptr<owt_base::VideoFrameConstructor> constructor;
+  worker->task([&] {
+    owt_base::VideoFrameConstructor::config config;
+    config.ssrc = options.ssrc;
+    config.rtx_ssrc = options.rtx_ssrc;
+    config.rtp_payload_type = options.payload_type;
+    config.ulpfec_payload = options.ulpfec;
+    config.transportcc = options.transport_cc;
+    config.red_payload = options.red;
+    config.worker = worker.get();
+    config.factory = &adapter_factory;
+    constructor =
+        std::make_shared<owt_base::VideoFrameConstructor>(nullptr, config);
+    constructor->bindTransport(source.get(), source.get());
+    constructor->addVideoDestination(frames);
+  });
+  queue->runUntil(clock->nowUs());
+
+  auto report = [&](int64_t until_us) {
+    char label[32];
+    snprintf(label, sizeof(label), "%llds",
+             static_cast<long long>((until_us - kStartUs) / kReportPeriodUs));
+    period.print(label);
+    total.add(period);
+    period = Counters();
+  };
+
+  auto reader = erizo::RtpDumpReader::open(options.path);
+  erizo::RtpDumpPacket packet;
+  int64_t next_report_us = kStartUs + kReportPeriodUs;
+  int64_t last_us = kStartUs;
+  while (reader->next(&packet)) {
+    int64_t time_us = kStartUs + packet.offset_ms * int64_t{1000};
+    while (time_us >= next_report_us) {
+      queue->runUntil(next_report_us);
+      report(next_report_us);
+      next_report_us += kReportPeriodUs;
+    }
+    queue->runUntil(time_us);
+    last_us = time_us;
+
+    auto data = std::make_shared<erizo::DataPacket>(
+        0, packet.data.data(), static_cast<int>(packet.data.size()),
+        erizo::VIDEO_PACKET, time_us / 1000);
+    if (packet.rtcp) {
+      worker->task([&, data] {
+        erizo::RtpUtils::forEachRtcpBlock(data->data, data->length,
+            [&](erizo::RtcpHeader* chead, int offset, int length) {
+              if (isReceiveSideRtcp(chead, options.ssrc)) {
+                ++period.rtcp;
+                source->videoSink()->deliverVideoRtcp(
+                    erizo::DataPacketView(data.get(), offset, length));
+              }
+            });
+      });
+      continue;
+    }
+    auto head = reinterpret_cast<erizo::RtpHeader*>(data->data);
+    if (head->getSSRC() != options.ssrc &&
+        (!options.rtx_ssrc || head->getSSRC() != options.rtx_ssrc)) {
+      continue;
+    }
+    data->metadata().header.Parse(reinterpret_cast<const uint8_t*>(data->data),
+                                  data->length);
+    ++period.rtp;
+    worker->task([&, data] {
+      source->videoSink()->deliverVideoData(data);
+    });
+  }
+
+  int64_t end_us = last_us + kDrainUs;
+  while (next_report_us <= end_us) {
+    queue->runUntil(next_report_us);
+    report(next_report_us);
+    next_report_us += kReportPeriodUs;
+  }
+  total.print("total");
+
+  worker->task([&] {
+    constructor->unbindTransport();
+    constructor.reset();
+  });
+  queue->runUntil(clock->nowUs());
+  worker->close();
+  rtc::SetClockForTesting(nullptr);
+  return 0;
+}
@@ -0,0 +1,94 @@
+// Copyright (c) 2021- anjisuan783
+//
+// SPDX-License-Identifier: MIT
+
+// Times the offer/answer SDP path of WaSdpInfo: parsing an offer and writing
+// it back out, once through the direct parser and writer and once through
+// libsdptransform. Each file holds one SDP per line, with "\r\n" written as
+// an escape, like the files of the unit tests.
+
+#include <chrono>
+#include <cstdio>
+#include <exception>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "h/rtc_return_value.h"
+#include "wa/helper.h"
+#include "wa/sdp_processor.h"
+
+namespace {
+
+const int kIterations = 2000;
+
+std::vector<std::string> load(const char* path) {
+  std::vector<std::string> sdps;
+  std::ifstream fin(path);
+  std::string line;
+  while (std::getline(fin, line)) {
+    if (!line.empty())
+      sdps.push_back(wa::wa_string_replace(line, "\\r\\n", "\r\n"));
+  }
+  return sdps;
+}
+
+template <typename Parse, typename Write>
+void run(const char* name, const std::string& sdp, Parse parse, Write write) {
+  size_t bytes = 0;
+  double parse_s = 0;
+  double write_s = 0;
+  try {
+    for (int i = 0; i < kIterations; ++i) {
+      wa::WaSdpInfo info;
+      auto begin = std::chrono::steady_clock::now();
+      if (parse(info, sdp) != wa::wa_ok) {
+        printf("%-10s parse failed\n", name);
+        return;
+      }
+      auto parsed = std::chrono::steady_clock::now();
+      bytes += write(info).size();
+      auto written = std::chrono::steady_clock::now();
+      parse_s += std::chrono::duration<double>(parsed - begin).count();
+      write_s += std::chrono::duration<double>(written - parsed).count();
+    }
+  } catch (std::exception& ex) {
+    printf("%-10s exception %s\n", name, ex.what());
+    return;
+  }
+
+  printf("%-10s %5zu bytes parse %8.1fus write %8.1fus\n", name,
+         bytes / kIterations, parse_s * 1e6 / kIterations,
+         write_s * 1e6 / kIterations);
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  std::vector<const char*> paths(argv + 1, argv + argc);
+  if (paths.empty()) {
+    paths = {"../../../src/test/data/chrome_91.sdp",
+             "../../../src/test/data/chrome_88.sdp",
+             "../../../src/test/data/Firefox.sdp"};
+  }
+
+  for (const char* path : paths) {
+    std::vector<std::string> sdps = load(path);
+    if (sdps.empty()) {
+      printf("%s: no sdp\n", path);
+      continue;
+    }
+    printf("%s\n", path);
+    run("direct", sdps[0],
+        [](wa::WaSdpInfo& info, const std::string& sdp) {
+          return info.parseSdp(sdp);
+        },
+        [](wa::WaSdpInfo& info) { return info.writeSdp(); });
+    run("transform", sdps[0],
+        [](wa::WaSdpInfo& info, const std::string& sdp) {
+          return info.parseSdpTransform(sdp);
+        },
+        [](wa::WaSdpInfo& info) { return info.writeSdpTransform(); });
+  }
+  return 0;
+}
@@ -12,6 +12,8 @@
 #include "h/rtc_return_value.h"
 #include "wa/sdp_processor.h"
 #include "wa/helper.h"
+#include "wa/media_config.h"
+#include "erizo/SdpInfo.h"
 
 static std::string chrome_sdp{"../../../src/test/data/chrome_91.sdp"};
 static std::string chrome_sdp88{"../../../src/test/data/chrome_88.sdp"};
@@ -783,6 +785,138 @@ TEST(WaSdpInfo, chrome_tostring) {
   sdp_info_comp(out_sdp_info);
 }
 
+// The direct parser and writer must read and write what the
+// libsdptransform based pair does.
+TEST(WaSdpInfo, direct_matches_sdptransform) {
+  for(auto& file : {chrome_sdp, chrome_sdp88, firefox_sdp}) {
+    std::ifstream fin(file);
+    ASSERT_EQ(true, fin.is_open());
+
+    std::string sdp;
+    ASSERT_TRUE(std::getline(fin, sdp));
+    sdp = wa::wa_string_replace(sdp, "\\r\\n", "\r\n");
+
+    wa::WaSdpInfo direct;
+    wa::WaSdpInfo transform;
+    ASSERT_EQ(direct.parseSdp(sdp), wa::wa_ok);
+    ASSERT_EQ(transform.parseSdpTransform(sdp), wa::wa_ok);
+
+    std::string expected = transform.writeSdpTransform();
+    EXPECT_EQ(direct.writeSdp(), expected);
+    EXPECT_EQ(transform.writeSdp(), expected);
+    for(auto& media : transform.media_descs_) {
+      EXPECT_EQ(direct.writeSdp(media.mid_), 
+                transform.writeSdpTransform(media.mid_));
+    }
+  }
+}
+
+// singleMediaSdpInfo fills erizo::SdpInfo as parsing singleMediaSdp does.
+TEST(WaSdpInfo, erizo_sdp_info) {
+  wa::WaSdpInfo sdpinfo;
+  int result = read_sdp_from_string(sdpinfo, chrome_sdp);
+  ASSERT_EQ(result, wa::wa_ok);
+
+  std::vector<erizo::RtpMap> mappings{wa::rtpH264, wa::rtpRed, wa::rtpOpus};
+  erizo::SdpInfo text(mappings);
+  erizo::SdpInfo parsed(mappings);
+  for(auto& media : sdpinfo.media_descs_) {
+    text.initWithSdp(sdpinfo.singleMediaSdp(media.mid_), "");
+    parsed.initWithParsedSdp([&](erizo::SdpInfo& info) {
+      sdpinfo.singleMediaSdpInfo(media.mid_, info);
+    });
+
+    EXPECT_EQ(parsed.isBundle, text.isBundle);
+    EXPECT_EQ(parsed.hasAudio, text.hasAudio);
+    EXPECT_EQ(parsed.hasVideo, text.hasVideo);
+    EXPECT_EQ(parsed.isRtcpMux, text.isRtcpMux);
+    EXPECT_EQ(parsed.dtlsRole, text.dtlsRole);
+    EXPECT_EQ(parsed.isFingerprint, text.isFingerprint);
+    EXPECT_EQ(parsed.audioSdpMLine, text.audioSdpMLine);
+    EXPECT_EQ(parsed.videoSdpMLine, text.videoSdpMLine);
+    EXPECT_EQ(parsed.getUsername(erizo::AUDIO_TYPE), 
+              text.getUsername(erizo::AUDIO_TYPE));
+    EXPECT_EQ(parsed.getPassword(erizo::VIDEO_TYPE), 
+              text.getPassword(erizo::VIDEO_TYPE));
+    EXPECT_EQ(parsed.inOutPTMap, text.inOutPTMap);
+    EXPECT_EQ(parsed.parsed_order_map, text.parsed_order_map);
+
+    ASSERT_EQ(parsed.payloadVector.size(), text.payloadVector.size());
+    for(size_t i = 0; i < text.payloadVector.size(); ++i) {
+      EXPECT_EQ(parsed.payloadVector[i].payload_type, 
+                text.payloadVector[i].payload_type);
+      EXPECT_EQ(parsed.payloadVector[i].feedback_types, 
+                text.payloadVector[i].feedback_types);
+      EXPECT_EQ(parsed.payloadVector[i].format_parameters, 
+                text.payloadVector[i].format_parameters);
+    }
+
+    ASSERT_EQ(parsed.extMapVector.size(), text.extMapVector.size());
+    for(size_t i = 0; i < text.extMapVector.size(); ++i) {
+      EXPECT_EQ(parsed.extMapVector[i].value, text.extMapVector[i].value);
+      EXPECT_EQ(parsed.extMapVector[i].uri, text.extMapVector[i].uri);
+      EXPECT_EQ(parsed.extMapVector[i].mediaType, text.extMapVector[i].mediaType);
+    }
+
+    ASSERT_EQ(parsed.bundleTags.size(), text.bundleTags.size());
+    for(size_t i = 0; i < text.bundleTags.size(); ++i) {
+      EXPECT_EQ(parsed.bundleTags[i].id, text.bundleTags[i].id);
+      EXPECT_EQ(parsed.bundleTags[i].mediaType, text.bundleTags[i].mediaType);
+    }
+
+    ASSERT_EQ(parsed.candidateVector_.size(), text.candidateVector_.size());
+    for(size_t i = 0; i < text.candidateVector_.size(); ++i) {
+      EXPECT_EQ(parsed.candidateVector_[i].hostAddress, 
+                text.candidateVector_[i].hostAddress);
+      EXPECT_EQ(parsed.candidateVector_[i].hostPort, 
+                text.candidateVector_[i].hostPort);
+      EXPECT_EQ(parsed.candidateVector_[i].priority, 
+                text.candidateVector_[i].priority);
+      EXPECT_EQ(parsed.candidateVector_[i].username, 
+                text.candidateVector_[i].username);
+    }
+  }
+}
+
+// Unlike the text parse, candidates keep their type and related address, and
+// every mid of the group becomes a bundle tag.
+TEST(WaSdpInfo, erizo_sdp_info_candidates) {
+  std::ifstream fin(chrome_sdp);
+  ASSERT_EQ(true, fin.is_open());
+
+  std::string sdp;
+  ASSERT_TRUE(std::getline(fin, sdp));
+  sdp = wa::wa_string_replace(sdp, "\\r\\n", "\r\n");
+  sdp = wa::wa_string_replace(sdp, "a=group:BUNDLE 0 1\r\n", 
+                              "a=group:BUNDLE 0 1 2 3 4 5 6 7 8 9\r\n");
+  sdp = wa::wa_string_replace(sdp, "a=setup:actpass\r\na=mid:0\r\n", 
+      "a=setup:actpass\r\n"
+      "a=candidate:1 1 udp 2122260223 192.168.1.2 50000 typ host\r\n"
+      "a=candidate:2 1 udp 1686052607 203.0.113.7 50001 typ srflx "
+      "raddr 192.168.1.2 rport 50000\r\n"
+      "a=mid:0\r\n");
+
+  wa::WaSdpInfo direct;
+  wa::WaSdpInfo transform;
+  ASSERT_EQ(direct.parseSdp(sdp), wa::wa_ok);
+  ASSERT_EQ(transform.parseSdpTransform(sdp), wa::wa_ok);
+  EXPECT_EQ(direct.writeSdp(), transform.writeSdpTransform());
+
+  std::vector<erizo::RtpMap> mappings{wa::rtpH264, wa::rtpRed, wa::rtpOpus};
+  erizo::SdpInfo parsed(mappings);
+  parsed.initWithParsedSdp([&](erizo::SdpInfo& info) {
+    direct.singleMediaSdpInfo("0", info);
+  });
+
+  ASSERT_EQ(parsed.candidateVector_.size(), 2u);
+  EXPECT_EQ(parsed.candidateVector_[0].hostType, erizo::HOST);
+  EXPECT_EQ(parsed.candidateVector_[1].hostType, erizo::SRFLX);
+  EXPECT_EQ(parsed.candidateVector_[1].rAddress, "192.168.1.2");
+  EXPECT_EQ(parsed.candidateVector_[1].rPort, 50000u);
+  EXPECT_TRUE(parsed.isBundle);
+  EXPECT_EQ(parsed.bundleTags.size(), 10u);
+}
+
 TEST(WaSdpInfo, chrome_filterVideoPayload) {
   wa::WaSdpInfo sdpinfo;
   int result = read_sdp_from_string(sdpinfo, chrome_sdp88);
@@ -0,0 +1,124 @@
+// Copyright (c) 2021- anjisuan783
+//
+// SPDX-License-Identifier: MIT
+
+// Times the start code scanners over synthetic 1080p H.264 key frames.
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+#include "rtc_base/cpu_info.h"
+#include "video/h264_common.h"
+#include "video/start_code_scanner.h"
+
+namespace {
+
+const int kFrames = 16;
+const int kRounds = 200;
+// A 1080p key frame at ~4 Mbps: AUD, parameter sets and SEI, then the picture
+// split in 8 IDR slices.
+const int kSlices = 8;
+const size_t kSliceBytes = 24 * 1024;
+
+void appendNalu(std::vector<uint8_t>& frame, uint8_t header, size_t size,
+                std::mt19937& rng) {
+  static const uint8_t kStartCode[] = {0, 0, 0, 1};
+  frame.insert(frame.end(), kStartCode, kStartCode + sizeof(kStartCode));
+  frame.push_back(header);
+  // Payload with emulation prevention applied, like an encoder's output.
+  int zeros = 0;
+  for (size_t i = 0; i < size; ++i) {
+    uint8_t b = (rng() & 7) ? static_cast<uint8_t>(rng()) : 0;
+    if (zeros >= 2 && b <= 3) {
+      frame.push_back(3);
+      zeros = 0;
+    }
+    frame.push_back(b);
+    zeros = b ? 0 : zeros + 1;
+  }
+}
+
+std::vector<uint8_t> makeKeyFrame(std::mt19937& rng) {
+  std::vector<uint8_t> frame;
+  appendNalu(frame, 0x09, 1, rng);    // AUD
+  appendNalu(frame, 0x67, 24, rng);   // SPS
+  appendNalu(frame, 0x68, 4, rng);    // PPS
+  appendNalu(frame, 0x06, 32, rng);   // SEI
+  for (int i = 0; i < kSlices; ++i) {
+    appendNalu(frame, 0x65, kSliceBytes + rng() % 4096, rng);
+  }
+  return frame;
+}
+
+typedef size_t (*Scanner)(const uint8_t*, size_t);
+
+size_t countStartCodes(Scanner scan, const std::vector<uint8_t>& frame) {
+  size_t count = 0;
+  const size_t end = frame.size() - 1;
+  for (size_t i = scan(frame.data(), end); i < end;
+       i += 3, i += scan(frame.data() + i, end - i)) {
+    ++count;
+  }
+  return count;
+}
+
+void run(const char* name, Scanner scan,
+         const std::vector<std::vector<uint8_t>>& frames, size_t expected) {
+  size_t bytes = 0;
+  size_t found = 0;
+  auto begin = std::chrono::steady_clock::now();
+  for (int r = 0; r < kRounds; ++r) {
+    for (auto& frame : frames) {
+      found += countStartCodes(scan, frame);
+      bytes += frame.size();
+    }
+  }
+  auto elapsed = std::chrono::duration<double>(
+      std::chrono::steady_clock::now() - begin).count();
+  if (found != expected * kRounds) {
+    printf("%-6s mismatch: %zu start codes, expected %zu\n",
+           name, found / kRounds, expected);
+    exit(1);
+  }
+  printf("%-6s %8.2f us/frame %8.0f MB/s\n", name,
+         elapsed * 1e6 / (kRounds * frames.size()), bytes / elapsed / 1e6);
+}
+
+}  // namespace
+
+int main() {
+  std::mt19937 rng(1080);
+  std::vector<std::vector<uint8_t>> frames;
+  size_t expected = 0;
+  for (int i = 0; i < kFrames; ++i) {
+    frames.push_back(makeKeyFrame(rng));
+    expected += countStartCodes(webrtc::FindStartCode_C, frames.back());
+  }
+
+  run("C", webrtc::FindStartCode_C, frames, expected);
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+  run("SSE2", webrtc::FindStartCode_SSE2, frames, expected);
+  if (webrtc::CpuInfo::Supports(webrtc::CpuInfo::kAVX2)) {
+    run("AVX2", webrtc::FindStartCode_AVX2, frames, expected);
+  }
+#endif
+  run("auto", webrtc::FindStartCode, frames, expected);
+
+  auto begin = std::chrono::steady_clock::now();
+  size_t nalus = 0;
+  for (int r = 0; r < kRounds; ++r) {
+    for (auto& frame : frames) {
+      nalus += webrtc::H264::FindNaluIndices(frame.data(), frame.size())
+                   .size();
+    }
+  }
+  auto elapsed = std::chrono::duration<double>(
+      std::chrono::steady_clock::now() - begin).count();
+  printf("FindNaluIndices %8.2f us/frame, %zu NALUs/frame\n",
+         elapsed * 1e6 / (kRounds * frames.size()),
+         nalus / (kRounds * frames.size()));
+  return 0;
+}
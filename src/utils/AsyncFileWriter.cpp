@@ -0,0 +1,168 @@
+//
+// Copyright (c) 2021- anjisuan783
+//
+// SPDX-License-Identifier: MIT
+//
+
+#include "./AsyncFileWriter.h"
+
+#include <sys/prctl.h>
+
+#include <algorithm>
+#include <chrono>  // NOLINT
+#include <condition_variable>  // NOLINT
+#include <thread>  // NOLINT
+#include <vector>
+
+namespace wa {
+
+static const char* const thread_name = "File Writer";
+
+// Drains every open AsyncFileWriter of the process.
+class FileWriterThread {
+ public:
+  static FileWriterThread& instance() {
+    static FileWriterThread writer_thread;
+    return writer_thread;
+  }
+
+  void add(std::weak_ptr<AsyncFileWriter> writer) {
+    std::lock_guard<std::mutex> guard(lock_);
+    writers_.push_back(std::move(writer));
+    if (!thread_) {
+      thread_ = std::make_unique<std::thread>([this] { run(); });
+    }
+  }
+
+  void wakeup() {
+    cond_.notify_one();
+  }
+
+ private:
+  // Closed writers are noticed on the next round at the latest.
+  static constexpr auto kDrainPeriod = std::chrono::milliseconds(100);
+
+  FileWriterThread() = default;
+
+  ~FileWriterThread() {
+    {
+      std::lock_guard<std::mutex> guard(lock_);
+      stopped_ = true;
+    }
+    cond_.notify_one();
+    if (thread_) {
+      thread_->join();
+    }
+  }
+
+  void run() {
+    prctl(PR_SET_NAME, reinterpret_cast<unsigned long>(thread_name));
+    std::vector<std::weak_ptr<AsyncFileWriter>> writers;
+    bool stopped = false;
+    while (!stopped) {
+      {
+        std::unique_lock<std::mutex> guard(lock_);
+        cond_.wait_for(guard, kDrainPeriod);
+        stopped = stopped_;
+        writers = writers_;
+      }
+      std::vector<AsyncFileWriter*> finished;
+      for (auto& weak_writer : writers) {
+        auto writer = weak_writer.lock();
+        if (writer && !writer->drain()) {
+          finished.push_back(writer.get());
+        }
+      }
+
+      std::lock_guard<std::mutex> guard(lock_);
+      writers_.erase(
+          std::remove_if(writers_.begin(), writers_.end(),
+              [&finished](const std::weak_ptr<AsyncFileWriter>& weak_writer) {
+                auto writer = weak_writer.lock();
+                return !writer ||
+                       std::find(finished.begin(), finished.end(),
+                                 writer.get()) != finished.end();
+              }),
+          writers_.end());
+    }
+  }
+
+  std::mutex lock_;
+  std::condition_variable cond_;
+  std::vector<std::weak_ptr<AsyncFileWriter>> writers_;
+  bool stopped_{false};
+  std::unique_ptr<std::thread> thread_;
+};
+
+std::shared_ptr<AsyncFileWriter> AsyncFileWriter::open(
+    const std::string& path, size_t max_buffered) {
+  FILE* file = fopen(path.c_str(), "wb");
+  if (!file) {
+    return nullptr;
+  }
+  std::shared_ptr<AsyncFileWriter> writer(
+      new AsyncFileWriter(path, file, max_buffered));
+  FileWriterThread::instance().add(writer);
+  return writer;
+}
+
+AsyncFileWriter::AsyncFileWriter(const std::string& path,
+                                 FILE* file,
+                                 size_t max_buffered)
+    : path_{path},
+      max_buffered_{max_buffered},
+      file_{file} {
+}
+
+AsyncFileWriter::~AsyncFileWriter() {
+  close();
+  drain();
+}
+
+bool AsyncFileWriter::write(const void* data, size_t len) {
+  bool was_empty;
+  {
+    std::lock_guard<std::mutex> guard(lock_);
+    if (closed_ || pending_.size() + len > max_buffered_) {
+      dropped_.fetch_add(len, std::memory_order_relaxed);
+      return false;
+    }
+    was_empty = pending_.empty();
+    pending_.append(static_cast<const char*>(data), len);
+  }
+  // Only the first write into an empty buffer wakes the writer thread up.
+  if (was_empty) {
+    FileWriterThread::instance().wakeup();
+  }
+  return true;
+}
+
+void AsyncFileWriter::close() {
+  std::lock_guard<std::mutex> guard(lock_);
+  closed_ = true;
+}
+
+bool AsyncFileWriter::drain() {
+  bool closed;
+  {
+    std::lock_guard<std::mutex> guard(lock_);
+    draining_.swap(pending_);
+    closed = closed_;
+  }
+  if (file_ && !draining_.empty()) {
+    size_t done = fwrite(draining_.data(), 1, draining_.size(), file_);
+    written_.fetch_add(done, std::memory_order_relaxed);
+    dropped_.fetch_add(draining_.size() - done, std::memory_order_relaxed);
+  }
+  draining_.clear();
+  if (!closed) {
+    return true;
+  }
+  if (file_) {
+    fclose(file_);
+    file_ = nullptr;
+  }
+  return false;
+}
+
+}  // namespace wa
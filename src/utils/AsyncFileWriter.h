@@ -0,0 +1,72 @@
+//
+// Copyright (c) 2021- anjisuan783
+//
+// SPDX-License-Identifier: MIT
+//
+
+#ifndef __WA_SRC_ASYNC_FILE_WRITER_H__
+#define __WA_SRC_ASYNC_FILE_WRITER_H__
+
+#include <atomic>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace wa {
+
+// Appends to a file without touching the disk on the calling thread. Writes
+// are copied into a bounded buffer that one background thread, shared by all
+// the writers of the process, drains to the file. When the buffer is full the
+// write is dropped and counted instead of blocking the caller.
+class AsyncFileWriter : public std::enable_shared_from_this<AsyncFileWriter> {
+ public:
+  static constexpr size_t kDefaultMaxBuffered = 4 * 1024 * 1024;
+
+  // nullptr if |path| can not be opened.
+  static std::shared_ptr<AsyncFileWriter> open(
+      const std::string& path, size_t max_buffered = kDefaultMaxBuffered);
+
+  // Flushes what is still buffered.
+  ~AsyncFileWriter();
+
+  AsyncFileWriter(const AsyncFileWriter&) = delete;
+  AsyncFileWriter& operator=(const AsyncFileWriter&) = delete;
+
+  // Any thread. False if the writer is closed or the buffer is full.
+  bool write(const void* data, size_t len);
+
+  // Any thread. What was written so far still reaches the file, later writes
+  // are refused.
+  void close();
+
+  const std::string& path() const { return path_; }
+  uint64_t written() const { return written_.load(std::memory_order_relaxed); }
+  uint64_t dropped() const { return dropped_.load(std::memory_order_relaxed); }
+
+ private:
+  friend class FileWriterThread;
+
+  AsyncFileWriter(const std::string& path, FILE* file, size_t max_buffered);
+
+  // On the writer thread, or the destructor once nobody writes any more.
+  // Returns false once the writer is closed and drained.
+  bool drain();
+
+  const std::string path_;
+  const size_t max_buffered_;
+  FILE* file_;
+
+  std::mutex lock_;
+  std::string pending_;
+  bool closed_{false};
+  // Only touched by drain()
+  std::string draining_;
+
+  std::atomic<uint64_t> written_{0};
+  std::atomic<uint64_t> dropped_{0};
+};
+
+}  // namespace wa
+
+#endif  // __WA_SRC_ASYNC_FILE_WRITER_H__
@@ -7,6 +7,9 @@ namespace wa {
 
 static const char* const thraed_name = "IO Woker";
 
+// The IOWorker of the calling thread, for the poll function.
+static thread_local IOWorker* current_io_worker = nullptr;
+
 IOWorker::IOWorker() = default;
 
 IOWorker::~IOWorker() {
@@ -26,8 +29,15 @@ void IOWorker::start(std::shared_ptr<std::promise<void>> start_promise) {
   if (!context_ && !loop_) {
     context_ = g_main_context_new();
     loop_ = g_main_loop_new(context_, FALSE);
+    g_main_context_set_poll_func(context_, &IOWorker::measuredPoll);
+    GSource* roll_source = g_timeout_source_new(
+        ClockUtils::durationToMs(kQueueStatsPeriod));
+    g_source_set_callback(roll_source, &IOWorker::rollMetrics, this, nullptr);
+    g_source_attach(roll_source, context_);
+    g_source_unref(roll_source);
     thread_ = std::unique_ptr<std::thread>(new std::thread([this, start_promise] {
       prctl(PR_SET_NAME, reinterpret_cast<unsigned long>(thraed_name));
+      current_io_worker = this;
       start_promise->set_value();
       if (!this->closed_ && this->loop_) {
         g_main_loop_run(this->loop_);
@@ -52,6 +62,43 @@ void IOWorker::close() {
   }
 }
 
+void IOWorker::task(Task f) {
+  if (closed_ || !context_) {
+    f();
+    return;
+  }
+  g_main_context_invoke_full(context_, G_PRIORITY_DEFAULT,
+      [](gpointer data) -> gboolean {
+        (*static_cast<Task*>(data))();
+        return G_SOURCE_REMOVE;
+      },
+      new Task(std::move(f)),
+      [](gpointer data) {
+        delete static_cast<Task*>(data);
+      });
+}
+
+// Time out of poll is busy time, and what poll returns the sources about to be
+// dispatched.
+gint IOWorker::measuredPoll(GPollFD* fds, guint nfds, gint timeout) {
+  IOWorker* me = current_io_worker;
+  int64_t enter_ns = LatencyTracer::nowNs();
+  if (me && me->poll_return_ns_) {
+    me->metrics_.onWakeup(me->poll_events_, enter_ns - me->poll_return_ns_);
+  }
+  gint ready = g_poll(fds, nfds, timeout);
+  if (me) {
+    me->poll_return_ns_ = LatencyTracer::nowNs();
+    me->poll_events_ = ready > 0 ? ready : 0;
+  }
+  return ready;
+}
+
+gboolean IOWorker::rollMetrics(gpointer data) {
+  static_cast<IOWorker*>(data)->metrics_.roll();
+  return G_SOURCE_CONTINUE;
+}
+
 IOThreadPool::IOThreadPool(unsigned int num_io_workers)
     : io_workers_{} {
   for (unsigned int index = 0; index < num_io_workers; index++) {
@@ -63,6 +110,14 @@ IOThreadPool::~IOThreadPool() {
   close();
 }
 
+std::vector<QueueStats> IOThreadPool::queueStats() {
+  std::vector<QueueStats> stats;
+  for (auto io_worker : io_workers_) {
+    stats.push_back(io_worker->queueStats());
+  }
+  return stats;
+}
+
 std::shared_ptr<IOWorker> IOThreadPool::getLessUsedIOWorker() {
   std::shared_ptr<IOWorker> chosen_io_worker = io_workers_.front();
   for (auto io_worker : io_workers_) {
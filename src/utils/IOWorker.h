@@ -9,16 +9,21 @@
 #define __WA_SRC_ERIZO_THREAD_IOWORKER_H__
 
 #include <atomic>
+#include <functional>
 #include <memory>
 #include <future>  // NOLINT
 #include <thread>  // NOLINT
 #include <vector>
 #include <glib.h>
 
+#include "utils/QueueMetrics.h"
+
 namespace wa {
 
 class IOWorker : public std::enable_shared_from_this<IOWorker> {
  public:
+  typedef std::function<void()> Task;
+
   IOWorker();
   ~IOWorker();
 
@@ -26,10 +31,26 @@ class IOWorker : public std::enable_shared_from_this<IOWorker> {
   virtual void start(std::shared_ptr<std::promise<void>> start_promise);
   virtual void close();
 
+  // Runs |f| on the thread of the main loop, right away when called there.
+  // Once closed |f| runs on the calling thread.
+  void task(Task f);
+
   GMainContext* getMainContext() { return context_; }
   GMainLoop* getMainLoop() { return loop_; }
 
+  // Load of the main loop over the last kQueueStatsPeriod, where each source
+  // dispatched after a poll counts as a task.
+  QueueStats queueStats() { return metrics_.last(); }
+
  private:
+  static gint measuredPoll(GPollFD* fds, guint nfds, gint timeout);
+  static gboolean rollMetrics(gpointer data);
+
+  QueueMetrics metrics_;
+  // When the last poll returned, 0 before the first one.
+  int64_t poll_return_ns_{0};
+  uint32_t poll_events_{0};
+
   std::atomic<bool> started_{false};
   std::atomic<bool> closed_{false};
   std::unique_ptr<std::thread> thread_;
@@ -47,6 +68,8 @@ class IOThreadPool {
   void start();
   void close();
 
+  std::vector<QueueStats> queueStats();
+
  private:
   std::vector<std::shared_ptr<IOWorker>> io_workers_;
 };
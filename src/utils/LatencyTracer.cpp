@@ -0,0 +1,155 @@
+//
+// Copyright (c) 2021- anjisuan783
+//
+// SPDX-License-Identifier: MIT
+//
+
+#include "./LatencyTracer.h"
+
+#include <algorithm>
+#include <cstdio>
+
+namespace wa {
+
+namespace {
+
+thread_local LatencyTracer* current_tracer = nullptr;
+
+const char* const kStageNames[] = {
+  "dequeue", "srtp", "frame", "packetize", "protect", "send", "total"
+};
+
+static_assert(sizeof(kStageNames) / sizeof(kStageNames[0]) ==
+              static_cast<size_t>(LatencyStage::kCount),
+              "a name per stage");
+
+}  // namespace
+
+const char* latencyStageName(LatencyStage stage) {
+  return kStageNames[static_cast<size_t>(stage)];
+}
+
+int LatencyHistogram::bucketOf(int64_t ns) {
+  uint64_t value = std::min<uint64_t>(std::max<int64_t>(ns, 0),
+                                      (uint64_t{1} << kMaxBits) - 1);
+  if (value < kSubBuckets) {
+    return static_cast<int>(value);
+  }
+  int msb = 63 - __builtin_clzll(value);
+  int shift = msb - kSubBucketBits;
+  return (msb - kSubBucketBits + 1) * kSubBuckets +
+         static_cast<int>((value >> shift) & (kSubBuckets - 1));
+}
+
+int64_t LatencyHistogram::valueOf(int bucket) {
+  if (bucket < kSubBuckets) {
+    return bucket;
+  }
+  int shift = bucket / kSubBuckets - 1;
+  int64_t lower = static_cast<int64_t>(kSubBuckets + bucket % kSubBuckets) << shift;
+  // Middle of the bucket
+  return lower + ((int64_t{1} << shift) >> 1);
+}
+
+void LatencyHistogram::record(int64_t ns) {
+  // Single writer, plain increments are enough for the readers.
+  std::atomic<uint64_t>& count = counts_[bucketOf(ns)];
+  count.store(count.load(std::memory_order_relaxed) + 1,
+              std::memory_order_relaxed);
+  if (ns > max_ns_.load(std::memory_order_relaxed)) {
+    max_ns_.store(ns, std::memory_order_relaxed);
+  }
+}
+
+LatencyHistogram::Snapshot LatencyHistogram::snapshot() const {
+  std::array<uint64_t, kBuckets> counts;
+  Snapshot result;
+  for (int i = 0; i < kBuckets; ++i) {
+    counts[i] = counts_[i].load(std::memory_order_relaxed);
+    result.count += counts[i];
+  }
+  result.max_ns = max_ns_.load(std::memory_order_relaxed);
+  if (result.count == 0) {
+    return result;
+  }
+
+  struct Quantile {
+    double q;
+    int64_t* out;
+  };
+  const Quantile quantiles[] = {
+    {0.5, &result.p50_ns},
+    {0.9, &result.p90_ns},
+    {0.99, &result.p99_ns},
+    {0.999, &result.p999_ns},
+  };
+  uint64_t seen = 0;
+  int bucket = 0;
+  for (const Quantile& quantile : quantiles) {
+    uint64_t rank = std::max<uint64_t>(
+        1, static_cast<uint64_t>(quantile.q * result.count + 0.5));
+    while (bucket < kBuckets && seen + counts[bucket] < rank) {
+      seen += counts[bucket++];
+    }
+    *quantile.out = std::min(valueOf(bucket), result.max_ns);
+  }
+  return result;
+}
+
+void LatencyHistogram::reset() {
+  for (auto& count : counts_) {
+    count.store(0, std::memory_order_relaxed);
+  }
+  max_ns_.store(0, std::memory_order_relaxed);
+}
+
+std::atomic<uint32_t> LatencyTracer::sample_interval_{64};
+
+void LatencyTracer::bind() {
+  current_tracer = this;
+}
+
+void LatencyTracer::stageSlow(LatencyStage stage, LatencyTrace& trace) {
+  int64_t now = nowNs();
+  if (LatencyTracer* tracer = current_tracer) {
+    tracer->stages_[static_cast<size_t>(stage)].record(now - trace.last_ns);
+    if (stage == LatencyStage::kSend) {
+      tracer->stages_[static_cast<size_t>(LatencyStage::kTotal)].record(
+          now - trace.start_ns);
+    }
+  }
+  trace.last_ns = now;
+}
+
+LatencyTracer::Snapshot LatencyTracer::snapshot() const {
+  Snapshot result;
+  for (size_t i = 0; i < stages_.size(); ++i) {
+    result.stages[i] = stages_[i].snapshot();
+  }
+  return result;
+}
+
+void LatencyTracer::reset() {
+  for (auto& stage : stages_) {
+    stage.reset();
+  }
+}
+
+std::string LatencyTracer::Snapshot::toString() const {
+  std::string result;
+  char line[160];
+  for (size_t i = 0; i < stages.size(); ++i) {
+    const LatencyHistogram::Snapshot& s = stages[i];
+    snprintf(line, sizeof(line),
+             "%-9s n:%llu p50:%.1fus p90:%.1fus p99:%.1fus p999:%.1fus "
+             "max:%.1fus\n",
+             latencyStageName(static_cast<LatencyStage>(i)),
+             static_cast<unsigned long long>(s.count),
+             s.p50_ns / 1e3, s.p90_ns / 1e3, s.p99_ns / 1e3,
+             s.p999_ns / 1e3, s.max_ns / 1e3);
+    result += line;
+  }
+  return result;
+}
+
+}  // namespace wa
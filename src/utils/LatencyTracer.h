@@ -0,0 +1,137 @@
+//
+// Copyright (c) 2021- anjisuan783
+//
+// SPDX-License-Identifier: MIT
+//
+
+#ifndef __WA_SRC_LATENCY_TRACER_H__
+#define __WA_SRC_LATENCY_TRACER_H__
+
+#include <array>
+#include <atomic>
+#include <chrono>  // NOLINT
+#include <string>
+
+namespace wa {
+
+// Stages a sampled media packet goes through on its way from the socket of
+// the publisher to the socket of a subscriber. Each one is timed from the end
+// of the previous one, kTotal from the socket read.
+enum class LatencyStage {
+  kDequeue,    // socket read to worker dequeue
+  kSrtp,       // unprotected
+  kFrame,      // frame complete, jitter buffer included
+  kPacketize,  // first RTP packet of the frame out of the send stream
+  kProtect,    // protected for the subscriber
+  kSend,       // handed to the socket
+  kTotal,
+  kCount
+};
+
+const char* latencyStageName(LatencyStage stage);
+
+// Timestamps, in ns of the steady clock, of a packet picked for tracing.
+// Travels with the packet, and with the frame built from it.
+struct LatencyTrace {
+  int64_t start_ns{0};  // socket read, 0 when the packet is not traced
+  int64_t last_ns{0};   // end of the last stage recorded
+
+  bool active() const { return start_ns != 0; }
+};
+
+// Log-linear histogram of ns values, 16 sub-buckets per power of two, so
+// percentiles are within about 6% up to about a minute. Written by one thread,
+// read by any.
+class LatencyHistogram {
+ public:
+  struct Snapshot {
+    uint64_t count{0};
+    int64_t p50_ns{0};
+    int64_t p90_ns{0};
+    int64_t p99_ns{0};
+    int64_t p999_ns{0};
+    int64_t max_ns{0};
+  };
+
+  void record(int64_t ns);
+  Snapshot snapshot() const;
+  void reset();
+
+ private:
+  static constexpr int kSubBucketBits = 4;
+  static constexpr int kSubBuckets = 1 << kSubBucketBits;
+  static constexpr int kMaxBits = 36;
+  static constexpr int kBuckets = (kMaxBits - kSubBucketBits + 1) * kSubBuckets;
+
+  static int bucketOf(int64_t ns);
+  static int64_t valueOf(int bucket);
+
+  std::array<std::atomic<uint64_t>, kBuckets> counts_{};
+  std::atomic<int64_t> max_ns_{0};
+};
+
+// Per worker latency histograms of the traced packets. A worker binds its
+// tracer to its thread, stages are then recorded into the tracer of whichever
+// worker completes them.
+//
+// Tracing is compiled in with WA_LATENCY_TRACE, otherwise sample() never
+// starts a trace and the rest does nothing.
+class LatencyTracer {
+ public:
+  struct Snapshot {
+    std::array<LatencyHistogram::Snapshot,
+               static_cast<size_t>(LatencyStage::kCount)> stages;
+
+    std::string toString() const;
+  };
+
+  static int64_t nowNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+  }
+
+  // Called at socket read, starts a trace for one packet in every interval.
+  static LatencyTrace sample() {
+#if defined(WA_LATENCY_TRACE)
+    thread_local uint32_t counter = 0;
+    uint32_t interval = sample_interval_.load(std::memory_order_relaxed);
+    if (interval && ++counter >= interval) {
+      counter = 0;
+      int64_t now = nowNs();
+      return LatencyTrace{now, now};
+    }
+#endif
+    return LatencyTrace{};
+  }
+
+  // Ends |stage| of |trace| now, on the tracer of the calling thread.
+  static void stage(LatencyStage stage, LatencyTrace& trace) {
+#if defined(WA_LATENCY_TRACE)
+    if (trace.active()) {
+      stageSlow(stage, trace);
+    }
+#endif
+  }
+
+  // 0 stops tracing.
+  static void setSampleInterval(uint32_t interval) {
+    sample_interval_.store(interval, std::memory_order_relaxed);
+  }
+
+  // Makes this tracer the one of the calling thread.
+  void bind();
+
+  Snapshot snapshot() const;
+  void reset();
+
+ private:
+  static void stageSlow(LatencyStage stage, LatencyTrace& trace);
+
+  static std::atomic<uint32_t> sample_interval_;
+
+  std::array<LatencyHistogram, static_cast<size_t>(LatencyStage::kCount)> stages_;
+};
+
+}  // namespace wa
+
+#endif  // __WA_SRC_LATENCY_TRACER_H__
@@ -0,0 +1,114 @@
+//
+// Copyright (c) 2021- anjisuan783
+//
+// SPDX-License-Identifier: MIT
+//
+
+#include "./QueueMetrics.h"
+
+#include <algorithm>
+#include <cstdio>
+
+namespace wa {
+
+std::string QueueStats::toString() const {
+  char text[320];
+  snprintf(text, sizeof(text),
+           "busy:%.1f%% tasks:%llu slow:%llu wakeups:%llu "
+           "tasks/wakeup:%.1f max:%u depth:%u max:%u "
+           "delay p50:%.1fus p99:%.1fus max:%.1fus "
+           "run p50:%.1fus p99:%.1fus max:%.1fus",
+           busy_ratio * 100,
+           static_cast<unsigned long long>(tasks),
+           static_cast<unsigned long long>(slow_tasks),
+           static_cast<unsigned long long>(wakeups),
+           tasks_per_wakeup, max_tasks_per_wakeup, depth, max_depth,
+           delay.p50_ns / 1e3, delay.p99_ns / 1e3, delay.max_ns / 1e3,
+           run.p50_ns / 1e3, run.p99_ns / 1e3, run.max_ns / 1e3);
+  return text;
+}
+
+QueueMetrics::QueueMetrics()
+    : period_start_ns_{LatencyTracer::nowNs()} {
+}
+
+void QueueMetrics::OnTaskPosted(size_t depth) {
+  uint32_t value = static_cast<uint32_t>(depth);
+  depth_.store(value, std::memory_order_relaxed);
+  uint32_t max_depth = max_depth_.load(std::memory_order_relaxed);
+  while (value > max_depth &&
+         !max_depth_.compare_exchange_weak(max_depth, value,
+                                           std::memory_order_relaxed)) {
+  }
+}
+
+void QueueMetrics::OnTaskRun(int64_t delay_ns, int64_t run_ns, size_t depth) {
+  depth_.store(static_cast<uint32_t>(depth), std::memory_order_relaxed);
+  delay_.record(delay_ns);
+  run_.record(run_ns);
+  busy_ns_ += run_ns;
+  ++tasks_;
+  if (run_ns > kSlowTaskNs) {
+    ++slow_tasks_;
+  }
+  ++tasks_in_wakeup_;
+  if (depth == 0) {
+    ++wakeups_;
+    max_tasks_per_wakeup_ = std::max(max_tasks_per_wakeup_, tasks_in_wakeup_);
+    tasks_in_wakeup_ = 0;
+  }
+}
+
+void QueueMetrics::onWakeup(uint32_t events, int64_t run_ns) {
+  busy_ns_ += run_ns;
+  if (!events) {
+    return;
+  }
+  run_.record(run_ns);
+  tasks_ += events;
+  if (run_ns > kSlowTaskNs) {
+    ++slow_tasks_;
+  }
+  ++wakeups_;
+  max_tasks_per_wakeup_ = std::max(max_tasks_per_wakeup_, events);
+}
+
+void QueueMetrics::roll() {
+  int64_t now = LatencyTracer::nowNs();
+  QueueStats stats;
+  stats.period_ns = now - period_start_ns_;
+  stats.busy_ns = busy_ns_;
+  if (stats.period_ns > 0) {
+    stats.busy_ratio = static_cast<double>(busy_ns_) / stats.period_ns;
+  }
+  stats.tasks = tasks_;
+  stats.slow_tasks = slow_tasks_;
+  stats.wakeups = wakeups_;
+  if (wakeups_) {
+    stats.tasks_per_wakeup = static_cast<double>(tasks_) / wakeups_;
+  }
+  stats.max_tasks_per_wakeup = max_tasks_per_wakeup_;
+  stats.depth = depth_.load(std::memory_order_relaxed);
+  stats.max_depth = max_depth_.exchange(stats.depth, std::memory_order_relaxed);
+  stats.delay = delay_.snapshot();
+  stats.run = run_.snapshot();
+
+  period_start_ns_ = now;
+  busy_ns_ = 0;
+  tasks_ = 0;
+  slow_tasks_ = 0;
+  wakeups_ = 0;
+  max_tasks_per_wakeup_ = 0;
+  delay_.reset();
+  run_.reset();
+
+  std::lock_guard<std::mutex> guard(last_lock_);
+  last_ = stats;
+}
+
+QueueStats QueueMetrics::last() {
+  std::lock_guard<std::mutex> guard(last_lock_);
+  return last_;
+}
+
+}  // namespace wa
@@ -0,0 +1,94 @@
+//
+// Copyright (c) 2021- anjisuan783
+//
+// SPDX-License-Identifier: MIT
+//
+
+#ifndef __WA_SRC_QUEUE_METRICS_H__
+#define __WA_SRC_QUEUE_METRICS_H__
+
+#include <atomic>
+#include <mutex>
+#include <string>
+
+#include "myrtc/api/task_queue_base.h"
+#include "utils/Clock.h"
+#include "utils/LatencyTracer.h"
+
+namespace wa {
+
+// How often the workers and IO threads roll their QueueStats over.
+constexpr duration kQueueStatsPeriod = std::chrono::seconds(5);
+
+// Load of a worker or IO thread over one period.
+struct QueueStats {
+  int64_t period_ns{0};
+  // Time spent running tasks, the rest of the period the thread was idle.
+  int64_t busy_ns{0};
+  double busy_ratio{0};
+
+  uint64_t tasks{0};
+  // Tasks longer than kSlowTaskNs.
+  uint64_t slow_tasks{0};
+  // A wakeup is a run of tasks from the queue leaving idle to it being
+  // drained, or one return from poll for an IO thread.
+  uint64_t wakeups{0};
+  double tasks_per_wakeup{0};
+  uint32_t max_tasks_per_wakeup{0};
+
+  // Tasks waiting when the period ended, and the most seen during it.
+  uint32_t depth{0};
+  uint32_t max_depth{0};
+
+  // Post, or due time of a delayed task, to run. Not measured on IO threads.
+  LatencyHistogram::Snapshot delay;
+  // Per task, or per wakeup on IO threads.
+  LatencyHistogram::Snapshot run;
+
+  std::string toString() const;
+};
+
+// Collects the QueueStats of one thread. The counters and histograms are only
+// written by the measured thread, which also rolls the periods over; the depth
+// is kept up to date from the posting threads.
+class QueueMetrics : public webrtc::TaskQueueObserver {
+ public:
+  static constexpr int64_t kSlowTaskNs = 10 * 1000 * 1000;
+
+  QueueMetrics();
+
+  // Implements webrtc::TaskQueueObserver
+  void OnTaskPosted(size_t depth) override;
+  void OnTaskRun(int64_t delay_ns, int64_t run_ns, size_t depth) override;
+
+  // For event loops, where |events| sources were dispatched in |run_ns|.
+  // Polls that found nothing only add to the busy time.
+  void onWakeup(uint32_t events, int64_t run_ns);
+
+  // Ends the current period, on the measured thread.
+  void roll();
+
+  // The last period ended, from any thread.
+  QueueStats last();
+
+ private:
+  std::atomic<uint32_t> depth_{0};
+  std::atomic<uint32_t> max_depth_{0};
+
+  int64_t period_start_ns_;
+  int64_t busy_ns_{0};
+  uint64_t tasks_{0};
+  uint64_t slow_tasks_{0};
+  uint64_t wakeups_{0};
+  uint32_t tasks_in_wakeup_{0};
+  uint32_t max_tasks_per_wakeup_{0};
+  LatencyHistogram delay_;
+  LatencyHistogram run_;
+
+  std::mutex last_lock_;
+  QueueStats last_;
+};
+
+}  // namespace wa
+
+#endif  // __WA_SRC_QUEUE_METRICS_H__
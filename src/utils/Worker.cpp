@@ -33,12 +33,19 @@ void Worker::start() {
 
 void Worker::start(std::shared_ptr<std::promise<void>> start_promise) {
   auto pQueue = factory_->CreateTaskQueue("wa worker", webrtc::TaskQueueFactory::Priority::NORMAL);
+  pQueue->SetObserver(&metrics_);
   task_queue_base_ = pQueue.get();
   task_queue_ = std::move(std::make_unique<rtc::TaskQueue>(std::move(pQueue))); 
 
-  task_queue_->PostTask([start_promise] {
+  task_queue_->PostTask([this, start_promise] {
+    latency_.bind();
     start_promise->set_value();
   });
+
+  scheduleEvery([this]() {
+    metrics_.roll();
+    return !closed_;
+  }, kQueueStatsPeriod);
 }
 
 void Worker::close() {
@@ -122,6 +129,22 @@ void ThreadPool::close() {
   }
 }
 
+std::vector<QueueStats> ThreadPool::queueStats() {
+  std::vector<QueueStats> stats;
+  for (auto worker : workers_) {
+    stats.push_back(worker->queueStats());
+  }
+  return stats;
+}
+
+std::vector<LatencyTracer::Snapshot> ThreadPool::latencySnapshots() {
+  std::vector<LatencyTracer::Snapshot> snapshots;
+  for (auto worker : workers_) {
+    snapshots.push_back(worker->latency().snapshot());
+  }
+  return snapshots;
+}
+
 
 } //namespace wa
 
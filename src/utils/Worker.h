@@ -15,6 +15,8 @@
 #include "myrtc/rtc_base/task_queue.h"
 #include "myrtc/api/task_queue_factory.h"
 #include "utils/Clock.h"
+#include "utils/LatencyTracer.h"
+#include "utils/QueueMetrics.h"
 
 namespace wa {
 
@@ -50,6 +52,16 @@ class Worker final : public std::enable_shared_from_this<Worker> {
     return task_queue_base_;
   }
 
+  // Latency of the traced packets whose stages ran on this worker.
+  LatencyTracer& latency() {
+    return latency_;
+  }
+
+  // Load of the task queue over the last kQueueStatsPeriod.
+  QueueStats queueStats() {
+    return metrics_.last();
+  }
+
  private:
   void scheduleEvery(ScheduledTask f, duration period, duration next_delay);
 
@@ -60,6 +72,9 @@ class Worker final : public std::enable_shared_from_this<Worker> {
   webrtc::TaskQueueFactory* factory_;
   std::shared_ptr<Clock> clock_;
   std::atomic<bool> closed_{false};
+  // Used by the tasks, so they outlive the queue.
+  LatencyTracer latency_;
+  QueueMetrics metrics_;
   std::unique_ptr<rtc::TaskQueue> task_queue_;
   webrtc::TaskQueueBase* task_queue_base_;
 };
@@ -73,6 +88,9 @@ class ThreadPool {
   void start();
   void close();
 
+  std::vector<LatencyTracer::Snapshot> latencySnapshots();
+  std::vector<QueueStats> queueStats();
+
  private:
   std::vector<std::shared_ptr<Worker>> workers_;
 };
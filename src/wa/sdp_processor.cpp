@@ -23,6 +23,7 @@
 #include "h/rtc_return_value.h"
 #include "helper.h"
 #include "media_config.h"
+#include "erizo/StringUtil.h"
 
 //#define __DEBUG_SDP__
 
@@ -102,6 +103,66 @@ int32_t filer_h264(const std::vector<MediaDesc::rtpmap>& rtpMaps,
   return result;
 }
 
+inline bool is_sdp_space(char c) {
+  return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\v' || c == '\f';
+}
+
+// Reads the int at the front of |str| as operator>> does: leading blanks
+// skipped, 0 if there is no number, clamped to the range of int.
+int32_t stream_int(std::string_view str) {
+  size_t i = 0;
+  while (i < str.size() && is_sdp_space(str[i])) {
+    ++i;
+  }
+  bool negative = false;
+  if (i < str.size() && (str[i] == '-' || str[i] == '+')) {
+    negative = str[i++] == '-';
+  }
+  int64_t value = 0;
+  bool digits = false;
+  for (; i < str.size() && str[i] >= '0' && str[i] <= '9'; ++i) {
+    digits = true;
+    if (value <= INT32_MAX) {
+      value = value * 10 + (str[i] - '0');
+    }
+  }
+  if (!digits) {
+    return 0;
+  }
+  if (negative) {
+    return -value < INT32_MIN ? INT32_MIN : static_cast<int32_t>(-value);
+  }
+  return value > INT32_MAX ? INT32_MAX : static_cast<int32_t>(value);
+}
+
+// Appends the unsigned numbers at the front of |str| to |out|, stopping
+// where operator>> into an unsigned int would fail.
+void stream_uints(std::string_view str, std::vector<uint32_t>& out) {
+  size_t i = 0;
+  while (true) {
+    while (i < str.size() && is_sdp_space(str[i])) {
+      ++i;
+    }
+    bool negative = false;
+    if (i < str.size() && (str[i] == '-' || str[i] == '+')) {
+      negative = str[i++] == '-';
+    }
+    uint64_t value = 0;
+    bool digits = false;
+    for (; i < str.size() && str[i] >= '0' && str[i] <= '9'; ++i) {
+      digits = true;
+      if (value <= UINT32_MAX) {
+        value = value * 10 + (str[i] - '0');
+      }
+    }
+    if (!digits || value > UINT32_MAX) {
+      return;
+    }
+    out.push_back(negative ? 0u - static_cast<uint32_t>(value) 
+                           : static_cast<uint32_t>(value));
+  }
+}
+
 }
 
 // SessionInfo
@@ -170,6 +231,10 @@ void MediaDesc::Candidate::encode(JSON_TYPE& session) {
   session["ip"] = ip_;
   session["port"] = port_;
   session["type"] = type_;
+  if (!raddr_.empty()) {
+    session["raddr"] = raddr_;
+    session["rport"] = rport_;
+  }
 }
 
 void MediaDesc::Candidate::decode(const JSON_TYPE& session) { 
@@ -180,6 +245,13 @@ void MediaDesc::Candidate::decode(const JSON_TYPE& session) {
   ip_ = session.at("ip");
   port_ = session.at("port");
   type_ = session.at("type");
+  auto raddr_found = session.find("raddr");
+  auto rport_found = session.find("rport");
+  if (raddr_found != session.end() && rport_found != session.end() &&
+      rport_found->is_number_integer()) {
+    raddr_ = *raddr_found;
+    rport_ = *rport_found;
+  }
 }
 
 // rtpmap
@@ -277,13 +349,15 @@ void MediaDesc::SSRCGroup::encode(JSON_TYPE& session) {
 }
 
 void MediaDesc::SSRCGroup::decode(const JSON_TYPE& session) {
-  semantic_ = session.at("semantics");
-  std::string ssrcs = session.at("ssrcs");
-  std::istringstream iss(ssrcs);
-  unsigned int word;
-  while(iss >> word){
-    ssrcs_.push_back(word);
-  }
+  std::string semantic = session.at("semantics").get<std::string>();
+  std::string ssrcs = session.at("ssrcs").get<std::string>();
+  decode(semantic, ssrcs);
+}
+
+void MediaDesc::SSRCGroup::decode(std::string_view semantic, 
+                                  std::string_view ssrcs) {
+  semantic_ = semantic;
+  stream_uints(ssrcs, ssrcs_);
 }
 
 // MediaDesc
@@ -335,9 +409,7 @@ void MediaDesc::parse_rtcp_fb(const JSON_TYPE& media) {
 
   for(size_t i = 0; i < (*fb).size(); ++i){
     std::string str_payload = (*fb)[i].at("payload");
-    std::istringstream iss(str_payload);
-    int p_type = 0;
-    iss >> p_type;
+    int p_type = stream_int(str_payload);
    
     rtpmap* found = find_rtpmap_with_payload_type(p_type);
     if(!found){
@@ -369,25 +441,26 @@ void MediaDesc::parse_fmtp(const JSON_TYPE& media) {
       continue;
     }
     
-    found->fmtp_ = (*fmtp)[i].at("config");
-    size_t pos = found->fmtp_.find("apt=");
-    if(std::string::npos == pos){
-      continue;
-    }
-    
-    std::string strAtp = found->fmtp_.substr(pos+4);
-    std::istringstream iss(strAtp);
-    int32_t atp = 0;
-    iss >> atp;
+    set_fmtp(found, (*fmtp)[i].at("config").get<std::string>());
+  }
+}
 
-    rtpmap* relate_map = find_rtpmap_with_payload_type(atp);
+void MediaDesc::set_fmtp(rtpmap* found, std::string config) {
+  found->fmtp_ = std::move(config);
+  size_t pos = found->fmtp_.find("apt=");
+  if(std::string::npos == pos){
+    return;
+  }
+  
+  int32_t atp = stream_int(std::string_view(found->fmtp_).substr(pos+4));
 
-    if(!relate_map){
-      continue;
-    }
-    
-    relate_map->related_.push_back(*found);
+  rtpmap* relate_map = find_rtpmap_with_payload_type(atp);
+
+  if(!relate_map){
+    return;
   }
+  
+  relate_map->related_.push_back(*found);
 }
 
 void MediaDesc::parse_ssrc_info(const JSON_TYPE& media) {
@@ -401,8 +474,6 @@ void MediaDesc::parse_ssrc_info(const JSON_TYPE& media) {
 
   for(size_t i = 0; i < ssrcs.size(); ++i){
     uint32_t _ssrc = ssrcs[i].at("id");
-    SSRCInfo& ssrc_info = fetch_or_create_ssrc_info(_ssrc);
-  
     std::string ssrc_attr = ssrcs[i].at("attribute");
 
 #ifdef __DEBUG_SDP__    
@@ -425,24 +496,31 @@ void MediaDesc::parse_ssrc_info(const JSON_TYPE& media) {
                      ", v:" << ssrc_value <<
                      std::endl;
 #endif
+    add_ssrc_attribute(_ssrc, ssrc_attr, ssrc_value);
+  }
+}
 
-    if (ssrc_attr == "cname") {
-      ssrc_info.cname_ = ssrc_value;
-      ssrc_info.ssrc_ = _ssrc;
-    } else if (!ssrc_value.empty()) { 
-      if (ssrc_attr == "msid") {
-        std::vector<std::string> vec = wa_split_str(ssrc_value, " ");
-        if (!vec.empty()) {
-          ssrc_info.msid_ = vec[0];
-          if (vec.size() > 1) {
-              ssrc_info.msid_tracker_ = vec[1];
-          }
+void MediaDesc::add_ssrc_attribute(uint32_t _ssrc, 
+                                   std::string_view ssrc_attr, 
+                                   std::string_view ssrc_value) {
+  SSRCInfo& ssrc_info = fetch_or_create_ssrc_info(_ssrc);
+
+  if (ssrc_attr == "cname") {
+    ssrc_info.cname_ = ssrc_value;
+    ssrc_info.ssrc_ = _ssrc;
+  } else if (!ssrc_value.empty()) { 
+    if (ssrc_attr == "msid") {
+      std::vector<std::string> vec = wa_split_str(std::string(ssrc_value), " ");
+      if (!vec.empty()) {
+        ssrc_info.msid_ = vec[0];
+        if (vec.size() > 1) {
+            ssrc_info.msid_tracker_ = vec[1];
         }
-      } else if (ssrc_attr == "mslabel") {
-          ssrc_info.mslabel_ = ssrc_value;
-      } else if (ssrc_attr == "label") {
-          ssrc_info.label_ = ssrc_value;
       }
+    } else if (ssrc_attr == "mslabel") {
+        ssrc_info.mslabel_ = ssrc_value;
+    } else if (ssrc_attr == "label") {
+        ssrc_info.label_ = ssrc_value;
     }
   }
 }
@@ -557,6 +635,11 @@ void MediaDesc::parse(const JSON_TYPE& media) {
 
   parse_ssrc_group(media);
 
+  relate_red_ulpfec(red_map, ulpfec_map);
+}
+
+void MediaDesc::relate_red_ulpfec(const rtpmap& red_map, 
+                                  const rtpmap& ulpfec_map) {
   //make relations with red ulpfec for video
   if (red_map.encoding_name_.empty() && ulpfec_map.encoding_name_.empty()) {
     return;
@@ -917,6 +1000,801 @@ void MediaDesc::filterExtmap() {
   }
 }
 
+void MediaDesc::write(std::string& sdp) {
+  sdp.append("m=").append(type_).append(" ").append(std::to_string(port_));
+  if(numPorts_ != 0){
+    sdp.append("/").append(std::to_string(numPorts_));
+  }
+  sdp.append(" ").append(protocols_).append(" ").append(payloads_).append("\r\n");
+
+  sdp.append("c=IN IP4 0.0.0.0\r\n");
+
+  // a= lines in the order of libsdptransform's grammar
+  for(auto& map : rtp_maps_){
+    sdp.append("a=rtpmap:").append(std::to_string(map.payload_type_))
+       .append(" ").append(map.encoding_name_)
+       .append("/").append(std::to_string(map.clock_rate_));
+    if(!map.encoding_param_.empty()){
+      sdp.append("/").append(map.encoding_param_);
+    }
+    sdp.append("\r\n");
+  }
+
+  for(auto& map : rtp_maps_){
+    if(!map.fmtp_.empty()){
+      sdp.append("a=fmtp:").append(std::to_string(map.payload_type_))
+         .append(" ").append(map.fmtp_).append("\r\n");
+    }
+  }
+
+  for(auto& map : rtp_maps_){
+    for(auto& fb : map.rtcp_fb_){
+      sdp.append("a=rtcp-fb:").append(std::to_string(map.payload_type_))
+         .append(" ").append(fb).append("\r\n");
+    }
+  }
+
+  for(auto& i : extmaps_){
+    sdp.append("a=extmap:").append(std::to_string(i.second.id));
+    if(!i.second.direction.empty()){
+      sdp.append("/").append(i.second.direction);
+    }
+    sdp.append(" ").append(i.second.param).append("\r\n");
+  }
+
+  if(!session_info_.setup_.empty()){
+    sdp.append("a=setup:").append(session_info_.setup_).append("\r\n");
+  }
+
+  sdp.append("a=mid:").append(mid_).append("\r\n");
+
+  if(!msid_.empty()){
+    sdp.append("a=msid:").append(msid_).append("\r\n");
+  }
+
+  sdp.append("a=").append(direction_).append("\r\n");
+
+  if(!session_info_.ice_ufrag_.empty()){
+    sdp.append("a=ice-ufrag:").append(session_info_.ice_ufrag_).append("\r\n");
+  }
+
+  if(!session_info_.ice_pwd_.empty()){
+    sdp.append("a=ice-pwd:").append(session_info_.ice_pwd_).append("\r\n");
+  }
+
+  if(!session_info_.fingerprint_algo_.empty()){
+    sdp.append("a=fingerprint:").append(session_info_.fingerprint_algo_)
+       .append(" ").append(session_info_.fingerprint_).append("\r\n");
+  }
+
+  for(auto& c : candidates_){
+    sdp.append("a=candidate:").append(c.foundation_)
+       .append(" ").append(std::to_string(c.component_))
+       .append(" ").append(c.transport_type_)
+       .append(" ").append(std::to_string(c.priority_))
+       .append(" ").append(c.ip_)
+       .append(" ").append(std::to_string(c.port_))
+       .append(" typ ").append(c.type_);
+    if (!c.raddr_.empty()) {
+      sdp.append(" raddr ").append(c.raddr_)
+         .append(" rport ").append(std::to_string(c.rport_));
+    }
+    sdp.append("\r\n");
+  }
+
+  if(!session_info_.ice_options_.empty()){
+    sdp.append("a=ice-options:").append(session_info_.ice_options_).append("\r\n");
+  }
+
+  for(auto& info : ssrc_infos_){
+    std::string ssrc = std::to_string(info.ssrc_);
+    std::string msid_value = info.msid_;
+    if(!info.msid_tracker_.empty()){
+      msid_value += " " + info.msid_tracker_;
+    }
+    const std::pair<const char*, const std::string*> attributes[] = {
+      {" cname", &info.cname_},
+      {" msid", &msid_value},
+      {" mslabel", &info.mslabel_},
+      {" label", &info.label_},
+    };
+    for(auto& attribute : attributes){
+      sdp.append("a=ssrc:").append(ssrc).append(attribute.first);
+      if(!attribute.second->empty()){
+        sdp.append(":").append(*attribute.second);
+      }
+      sdp.append("\r\n");
+    }
+  }
+
+  for(auto& group : ssrc_groups_){
+    sdp.append("a=ssrc-group:").append(group.semantic_).append(" ");
+    for(size_t i = 0; i < group.ssrcs_.size(); ++i){
+      if(i != 0){
+        sdp.append(" ");
+      }
+      sdp.append(std::to_string(group.ssrcs_[i]));
+    }
+    sdp.append("\r\n");
+  }
+
+  if(!rtcp_mux_.empty()){
+    sdp.append("a=").append(rtcp_mux_).append("\r\n");
+  }
+
+  if(!rtcp_rsize_.empty()){
+    sdp.append("a=").append(rtcp_rsize_).append("\r\n");
+  }
+}
+
+namespace {
+
+inline bool is_sdp_digit(char c) {
+  return c >= '0' && c <= '9';
+}
+
+// \w of the grammar regexes
+inline bool is_sdp_word(char c) {
+  return is_sdp_digit(c) || (c >= 'a' && c <= 'z') || 
+         (c >= 'A' && c <= 'Z') || c == '_';
+}
+
+// Walks the content of one SDP line the way the regexes of libsdptransform's
+// grammar match it. A step only advances when it matches.
+class SdpCursor {
+ public:
+  explicit SdpCursor(std::string_view line) : rest_(line) { }
+
+  bool consume(std::string_view prefix) {
+    if (rest_.substr(0, prefix.size()) != prefix) {
+      return false;
+    }
+    rest_.remove_prefix(prefix.size());
+    return true;
+  }
+
+  bool at(char c) const { return !rest_.empty() && rest_[0] == c; }
+
+  template <typename Pred>
+  std::string_view take(Pred pred) {
+    size_t n = 0;
+    while (n < rest_.size() && pred(rest_[n])) {
+      ++n;
+    }
+    std::string_view run = rest_.substr(0, n);
+    rest_.remove_prefix(n);
+    return run;
+  }
+
+  // (\d*)
+  std::string_view digits() { return take(is_sdp_digit); }
+  // (\w*)
+  std::string_view word() { return take(is_sdp_word); }
+  // (\S*)
+  std::string_view token() { 
+    return take([](char c) { return !is_sdp_space(c); }); 
+  }
+  // (.*)
+  std::string_view tail() { 
+    return take([](char c) { return c != '\r' && c != '\n'; }); 
+  }
+  // \s*
+  void skip_spaces() { take(is_sdp_space); }
+
+  std::string_view rest() const { return rest_; }
+
+ private:
+  std::string_view rest_;
+};
+
+// toType() of libsdptransform for a run of digits, 0 when it overflows.
+int64_t sdp_int(std::string_view digits) {
+  int64_t value = 0;
+  for (char c : digits) {
+    if (value > (INT64_MAX - (c - '0')) / 10) {
+      return 0;
+    }
+    value = value * 10 + (c - '0');
+  }
+  return value;
+}
+
+uint64_t sdp_uint(std::string_view digits) {
+  uint64_t value = 0;
+  for (char c : digits) {
+    if (value > (UINT64_MAX - (c - '0')) / 10) {
+      return 0;
+    }
+    value = value * 10 + (c - '0');
+  }
+  return value;
+}
+
+// What "is >> word" splits |str| into.
+void split_words(std::string_view str, std::vector<std::string>& out) {
+  size_t i = 0;
+  while (true) {
+    while (i < str.size() && is_sdp_space(str[i])) {
+      ++i;
+    }
+    if (i == str.size()) {
+      return;
+    }
+    size_t begin = i;
+    while (i < str.size() && !is_sdp_space(str[i])) {
+      ++i;
+    }
+    out.emplace_back(str.substr(begin, i - begin));
+  }
+}
+
+// The ice and dtls attributes SessionInfo::decode reads off one level of
+// the SDP. An empty view stands for a field the grammar leaves unset.
+struct SdpTransportLines {
+  bool fingerprint{false};
+  std::string_view fingerprint_type;
+  std::string_view fingerprint_hash;
+  bool has_ice_options{false};
+  std::string_view ice_options;
+  bool has_ice_ufrag{false};
+  std::string_view ice_ufrag;
+  bool has_ice_pwd{false};
+  std::string_view ice_pwd;
+  bool has_setup{false};
+  std::string_view setup;
+
+  // Takes the a= line if it is one of these.
+  bool parse(std::string_view content) {
+    SdpCursor c(content);
+    if (c.consume("setup:")) {
+      has_setup = true;
+      setup = c.word();
+    } else if (c.consume("ice-ufrag:")) {
+      has_ice_ufrag = true;
+      ice_ufrag = c.token();
+    } else if (c.consume("ice-pwd:")) {
+      has_ice_pwd = true;
+      ice_pwd = c.token();
+    } else if (c.consume("fingerprint:")) {
+      std::string_view type = c.token();
+      if (c.consume(" ")) {
+        std::string_view hash = c.token();
+        fingerprint = true;
+        if (!type.empty()) {
+          fingerprint_type = type;
+        }
+        if (!hash.empty()) {
+          fingerprint_hash = hash;
+        }
+      }
+    } else if (c.consume("ice-options:")) {
+      has_ice_options = true;
+      ice_options = c.token();
+    } else {
+      return false;
+    }
+    return true;
+  }
+
+  // False where SessionInfo::decode would throw.
+  bool apply(SessionInfo& info) const {
+    if (fingerprint) {
+      if (fingerprint_type.empty() || fingerprint_hash.empty()) {
+        return false;
+      }
+      info.fingerprint_algo_ = fingerprint_type;
+      info.fingerprint_ = fingerprint_hash;
+    }
+    if (has_ice_options) {
+      info.ice_options_ = ice_options;
+    }
+    if (has_ice_ufrag) {
+      if (!has_ice_pwd) {
+        return false;
+      }
+      info.ice_ufrag_ = ice_ufrag;
+      info.ice_pwd_ = ice_pwd;
+    }
+    if (has_setup) {
+      info.setup_ = setup;
+    }
+    return true;
+  }
+};
+
+// Fills a WaSdpInfo in one pass over the SDP text, reading each line with
+// the rule libsdptransform's grammar would pick for it and leaving out the
+// ones WaSdpInfo::init never looks at. parse() fails wherever init() throws
+// on a missing field.
+class SdpParser {
+ public:
+  explicit SdpParser(WaSdpInfo& info) : info_(info) { }
+
+  bool parse(std::string_view sdp) {
+    bool in_media = false;
+    size_t pos = 0;
+    while (pos < sdp.size()) {
+      size_t end = sdp.find('\n', pos);
+      if (end == std::string_view::npos) {
+        end = sdp.size();
+      }
+      std::string_view line = sdp.substr(pos, end - pos);
+      pos = end + 1;
+
+      if (!line.empty() && line.back() == '\r') {
+        line.remove_suffix(1);
+      }
+      if (line.size() < 2 || line[0] < 'a' || line[0] > 'z' || line[1] != '=') {
+        continue;
+      }
+
+      char type = line[0];
+      std::string_view content = line.substr(2);
+      if (type == 'm') {
+        if (!(in_media ? finishMedia() : finishSession())) {
+          return false;
+        }
+        in_media = true;
+        startMedia(content);
+      } else if (!in_media) {
+        sessionLine(type, content);
+      } else if (type == 'a' && !mediaAttribute(content)) {
+        return false;
+      }
+    }
+    return in_media ? finishMedia() : finishSession();
+  }
+
+ private:
+  struct RtcpFbLine {
+    int payload;
+    std::string_view type;
+    std::string_view subtype;
+  };
+
+  struct FmtpLine {
+    int payload;
+    std::string_view config;
+  };
+
+  struct SsrcLine {
+    uint32_t ssrc;
+    std::string_view attribute;
+    std::string_view value;
+  };
+
+  struct SsrcGroupLine {
+    std::string_view semantic;
+    std::string_view ssrcs;
+  };
+
+  void sessionLine(char type, std::string_view content) {
+    SdpCursor c(content);
+    if (type == 'o') {
+      // ^(\S*) (\d*) (\d*) (\S*) IP(\d) (\S*)
+      std::string_view fields[6];
+      fields[0] = c.token();
+      if (!c.consume(" ")) return;
+      fields[1] = c.digits();
+      if (!c.consume(" ")) return;
+      fields[2] = c.digits();
+      if (!c.consume(" ")) return;
+      fields[3] = c.token();
+      if (!c.consume(" IP") || !is_sdp_digit(c.rest().empty() ? 0 : c.rest()[0])) {
+        return;
+      }
+      fields[4] = c.rest().substr(0, 1);
+      c.consume(fields[4]);
+      if (!c.consume(" ")) return;
+      fields[5] = c.token();
+      for (int i = 0; i < 6; ++i) {
+        if (!fields[i].empty()) {
+          origin_[i] = fields[i];
+        }
+      }
+    } else if (type == 's') {
+      has_name_ = true;
+      info_.session_name_ = c.tail();
+    } else if (type == 't') {
+      // ^(\d*) (\d*)
+      std::string_view start = c.digits();
+      if (!c.consume(" ")) return;
+      std::string_view stop = c.digits();
+      if (!start.empty()) {
+        timing_[0] = start;
+      }
+      if (!stop.empty()) {
+        timing_[1] = stop;
+      }
+    } else if (type == 'a') {
+      if (transport_.parse(content)) {
+        return;
+      }
+      if (c.consume("extmap-allow-mixed")) {
+        has_extmap_allow_mixed_ = true;
+      } else if (c.consume("ice-lite")) {
+        info_.ice_lite_ = true;
+      } else if (c.consume("msid-semantic:")) {
+        // ^msid-semantic:\s?(\w*)\s?(.*)
+        if (!c.rest().empty() && is_sdp_space(c.rest()[0])) {
+          c.consume(c.rest().substr(0, 1));
+        }
+        std::string_view semantic = c.word();
+        if (!c.rest().empty() && is_sdp_space(c.rest()[0])) {
+          c.consume(c.rest().substr(0, 1));
+        }
+        std::string_view token = c.tail();
+        has_msid_semantic_ = true;
+        if (!semantic.empty()) {
+          msid_semantic_ = semantic;
+        }
+        if (!token.empty()) {
+          msid_token_ = token;
+        }
+      } else if (c.consume("group:")) {
+        // ^group:(\w*) (.*)
+        std::string_view type = c.word();
+        if (!c.consume(" ")) return;
+        if (++num_groups_ == 1) {
+          group_type_ = type;
+          group_mids_ = c.tail();
+        }
+      }
+    }
+  }
+
+  bool finishSession() {
+    for (auto& field : origin_) {
+      if (field.empty()) {
+        return false;
+      }
+    }
+    if (!has_name_ || timing_[0].empty() || timing_[1].empty()) {
+      return false;
+    }
+    info_.username_ = origin_[0];
+    info_.session_id_ = sdp_uint(origin_[1]);
+    info_.session_version_ = static_cast<uint32_t>(sdp_uint(origin_[2]));
+    info_.nettype_ = origin_[3];
+    info_.addrtype_ = static_cast<int32_t>(sdp_int(origin_[4]));
+    info_.unicast_address_ = origin_[5];
+    info_.start_time_ = sdp_int(timing_[0]);
+    info_.end_time_ = sdp_int(timing_[1]);
+
+    if (!transport_.apply(info_.session_info_)) {
+      return false;
+    }
+
+    if (num_groups_ == 0) {
+      return false;
+    }
+    assert(num_groups_ == 1);
+    if (group_type_.empty() || group_mids_.empty()) {
+      return false;
+    }
+    info_.group_policy_ = group_type_;
+    split_words(group_mids_, info_.groups_);
+
+    if (info_.enable_extmapAllowMixed_ && has_extmap_allow_mixed_) {
+      info_.extmapAllowMixed_ = "extmap-allow-mixed";
+    }
+
+    if (has_msid_semantic_) {
+      if (msid_semantic_.empty()) {
+        return false;
+      }
+      info_.msid_semantic_ = msid_semantic_;
+      split_words(msid_token_, info_.msids_);
+    }
+    return true;
+  }
+
+  void startMedia(std::string_view content) {
+    info_.media_descs_.emplace_back(info_.session_info_);
+    media_transport_ = SdpTransportLines();
+    has_type_ = has_port_ = has_protocol_ = has_payloads_ = false;
+    has_mid_ = has_direction_ = has_ext_ = false;
+    rtcp_fbs_.clear();
+    fmtps_.clear();
+    ssrcs_.clear();
+    ssrc_groups_.clear();
+
+    // ^(\w*) (\d*)(?:/(\d*))? ([\w\/]*)(?: (.*))?
+    MediaDesc& desc = info_.media_descs_.back();
+    SdpCursor c(content);
+    std::string_view type = c.word();
+    if (!c.consume(" ")) return;
+    std::string_view port = c.digits();
+    std::string_view num_ports;
+    if (c.at('/')) {
+      SdpCursor ports = c;
+      ports.consume("/");
+      num_ports = ports.digits();
+      if (!ports.at(' ')) {
+        return;
+      }
+      c = ports;
+    }
+    if (!c.consume(" ")) return;
+    std::string_view protocol = c.take([](char ch) {
+      return is_sdp_word(ch) || ch == '/';
+    });
+    std::string_view payloads;
+    if (c.consume(" ")) {
+      payloads = c.tail();
+    }
+
+    if ((has_type_ = !type.empty())) {
+      desc.type_ = type;
+    }
+    if ((has_port_ = !port.empty())) {
+      desc.port_ = static_cast<int32_t>(sdp_int(port));
+    }
+    if (!num_ports.empty()) {
+      desc.numPorts_ = static_cast<int32_t>(sdp_int(num_ports));
+    }
+    if ((has_protocol_ = !protocol.empty())) {
+      desc.protocols_ = protocol;
+    }
+    if ((has_payloads_ = !payloads.empty())) {
+      desc.payloads_ = payloads;
+    }
+  }
+
+  bool mediaAttribute(std::string_view content) {
+    MediaDesc& desc = info_.media_descs_.back();
+    SdpCursor c(content);
+    if (c.consume("rtpmap:")) {
+      // ^rtpmap:(\d*) ([\w\-\.]*)(?:\s*\/(\d*)(?:\s*\/(\S*))?)?
+      std::string_view payload = c.digits();
+      if (!c.consume(" ")) return true;
+      std::string_view codec = c.take([](char ch) {
+        return is_sdp_word(ch) || ch == '-' || ch == '.';
+      });
+      std::string_view rate;
+      std::string_view encoding;
+      c.skip_spaces();
+      if (c.consume("/")) {
+        rate = c.digits();
+        c.skip_spaces();
+        if (c.consume("/")) {
+          encoding = c.token();
+        }
+      }
+      if (payload.empty() || codec.empty() || rate.empty()) {
+        return false;
+      }
+      desc.rtp_maps_.emplace_back();
+      MediaDesc::rtpmap& map = desc.rtp_maps_.back();
+      map.payload_type_ = static_cast<int32_t>(sdp_int(payload));
+      map.encoding_name_ = codec;
+      map.clock_rate_ = static_cast<int32_t>(sdp_int(rate));
+      map.encoding_param_ = encoding;
+    } else if (c.consume("fmtp:")) {
+      // ^fmtp:(\d*) (.*)
+      std::string_view payload = c.digits();
+      if (!c.consume(" ")) return true;
+      if (payload.empty()) {
+        return false;
+      }
+      fmtps_.push_back({static_cast<int>(sdp_int(payload)), c.tail()});
+    } else if (c.consume("rtcp-fb:")) {
+      // ^rtcp-fb:(\*|\d*) ([\w\-_]*)(?: ([\w\-_]*))?, unless it is trr-int
+      std::string_view payload = c.consume("*") ? "*" : c.digits();
+      if (c.rest().substr(0, 9) == " trr-int " || !c.consume(" ")) {
+        return true;
+      }
+      auto fb_char = [](char ch) { return is_sdp_word(ch) || ch == '-'; };
+      std::string_view type = c.take(fb_char);
+      std::string_view subtype;
+      if (c.consume(" ")) {
+        subtype = c.take(fb_char);
+      }
+      if (payload.empty()) {
+        return false;
+      }
+      rtcp_fbs_.push_back({stream_int(payload), type, subtype});
+    } else if (c.consume("extmap:")) {
+      // ^extmap:(\d+)(?:\/(\w+))?(?: (urn:ietf:params:rtp-hdrext:encrypt))? (\S*)(?: (\S*))?
+      std::string_view value = c.digits();
+      if (value.empty()) return true;
+      std::string_view direction;
+      if (c.consume("/")) {
+        direction = c.word();
+        if (direction.empty()) return true;
+      }
+      if (!c.consume(" ")) return true;
+      c.consume("urn:ietf:params:rtp-hdrext:encrypt ");
+      std::string_view uri = c.token();
+      has_ext_ = true;
+      if (uri.empty()) {
+        return false;
+      }
+      MediaDesc::extmap_item item{static_cast<int>(sdp_int(value)), 
+                                  std::string(direction), 
+                                  std::string(uri)};
+      desc.extmaps_.emplace(item.id, item);
+    } else if (media_transport_.parse(content)) {
+      // applied to the session by finishMedia()
+    } else if (c.consume("mid:")) {
+      has_mid_ = true;
+      desc.mid_ = c.token();
+    } else if (c.consume("msid:")) {
+      desc.msid_ = c.tail();
+    } else if (c.consume("sendrecv") || c.consume("recvonly") || 
+               c.consume("sendonly") || c.consume("inactive")) {
+      has_direction_ = true;
+      desc.direction_ = content.substr(0, 8);
+    } else if (c.consume("candidate:")) {
+      // ^candidate:(\S*) (\d*) (\S*) (\d*) (\S*) (\d*) typ (\S*)
+      //   (?: raddr (\S*) rport (\d*))?
+      std::string_view fields[7];
+      fields[0] = c.token();
+      if (!c.consume(" ")) return true;
+      fields[1] = c.digits();
+      if (!c.consume(" ")) return true;
+      fields[2] = c.token();
+      if (!c.consume(" ")) return true;
+      fields[3] = c.digits();
+      if (!c.consume(" ")) return true;
+      fields[4] = c.token();
+      if (!c.consume(" ")) return true;
+      fields[5] = c.digits();
+      if (!c.consume(" typ ")) return true;
+      fields[6] = c.token();
+      for (auto& field : fields) {
+        if (field.empty()) {
+          return false;
+        }
+      }
+      desc.candidates_.emplace_back();
+      MediaDesc::Candidate& candidate = desc.candidates_.back();
+      candidate.foundation_ = fields[0];
+      candidate.component_ = static_cast<int32_t>(sdp_int(fields[1]));
+      candidate.transport_type_ = fields[2];
+      candidate.priority_ = static_cast<int32_t>(sdp_int(fields[3]));
+      candidate.ip_ = fields[4];
+      candidate.port_ = static_cast<int32_t>(sdp_int(fields[5]));
+      candidate.type_ = fields[6];
+      if (c.consume(" raddr ")) {
+        std::string_view raddr = c.token();
+        if (c.consume(" rport ")) {
+          std::string_view rport = c.digits();
+          if (!raddr.empty() && !rport.empty()) {
+            candidate.raddr_ = raddr;
+            candidate.rport_ = static_cast<int32_t>(sdp_int(rport));
+          }
+        }
+      }
+    } else if (c.consume("ssrc:")) {
+      // ^ssrc:(\d*) ([\w_-]*)(?::(.*))?
+      std::string_view id = c.digits();
+      if (!c.consume(" ")) return true;
+      std::string_view attribute = c.take([](char ch) {
+        return is_sdp_word(ch) || ch == '-';
+      });
+      std::string_view value;
+      if (c.consume(":")) {
+        value = c.tail();
+      }
+      if (id.empty() || attribute.empty()) {
+        return false;
+      }
+      ssrcs_.push_back({static_cast<uint32_t>(sdp_int(id)), attribute, value});
+    } else if (c.consume("ssrc-group:")) {
+      // ^ssrc-group:([\x21\x23\x24\x25\x26\x27\x2A\x2B\x2D\x2E\w]*) (.*)
+      std::string_view semantic = c.take([](char ch) {
+        return is_sdp_word(ch) || strchr("!#$%&'*+-.", ch) != nullptr;
+      });
+      if (!c.consume(" ")) return true;
+      std::string_view ssrcs = c.tail();
+      if (semantic.empty() || ssrcs.empty()) {
+        return false;
+      }
+      ssrc_groups_.push_back({semantic, ssrcs});
+    } else if (c.consume("rtcp-mux")) {
+      desc.rtcp_mux_ = "rtcp-mux";
+    } else if (c.consume("rtcp-rsize")) {
+      desc.rtcp_rsize_ = "rtcp-rsize";
+    }
+    return true;
+  }
+
+  // The part of MediaDesc::parse() that needs the whole m-section.
+  bool finishMedia() {
+    MediaDesc& desc = info_.media_descs_.back();
+    if (!has_type_ || !has_port_ || !has_protocol_ || !has_payloads_) {
+      return false;
+    }
+    if (!media_transport_.apply(info_.session_info_)) {
+      return false;
+    }
+    if (!has_mid_ || !has_ext_ || !has_direction_) {
+      return false;
+    }
+
+    MediaDesc::rtpmap red_map;
+    MediaDesc::rtpmap ulpfec_map;
+    for (auto& map : desc.rtp_maps_) {
+      if ("red" == map.encoding_name_) {
+        red_map = map;
+      } else if ("ulpfec" == map.encoding_name_) {
+        ulpfec_map = map;
+      }
+    }
+
+    for (auto& fb : rtcp_fbs_) {
+      MediaDesc::rtpmap* found = desc.find_rtpmap_with_payload_type(fb.payload);
+      if (!found) {
+        continue;
+      }
+      if (fb.type.empty()) {
+        return false;
+      }
+      std::string fb_str(fb.type);
+      if (!fb.subtype.empty()) {
+        fb_str.append(" ").append(fb.subtype);
+      }
+      found->rtcp_fb_.push_back(std::move(fb_str));
+    }
+
+    for (auto& fmtp : fmtps_) {
+      MediaDesc::rtpmap* found = desc.find_rtpmap_with_payload_type(fmtp.payload);
+      if (!found) {
+        continue;
+      }
+      if (fmtp.config.empty()) {
+        return false;
+      }
+      desc.set_fmtp(found, std::string(fmtp.config));
+    }
+
+    for (auto& ssrc : ssrcs_) {
+      desc.add_ssrc_attribute(ssrc.ssrc, ssrc.attribute, ssrc.value);
+    }
+
+    desc.ssrc_groups_.resize(ssrc_groups_.size());
+    for (size_t i = 0; i < ssrc_groups_.size(); ++i) {
+      desc.ssrc_groups_[i].decode(ssrc_groups_[i].semantic, 
+                                  ssrc_groups_[i].ssrcs);
+    }
+
+    desc.relate_red_ulpfec(red_map, ulpfec_map);
+    return true;
+  }
+
+  WaSdpInfo& info_;
+
+  // Session level
+  std::string_view origin_[6];
+  bool has_name_{false};
+  std::string_view timing_[2];
+  SdpTransportLines transport_;
+  int num_groups_{0};
+  std::string_view group_type_;
+  std::string_view group_mids_;
+  bool has_extmap_allow_mixed_{false};
+  bool has_msid_semantic_{false};
+  std::string_view msid_semantic_;
+  std::string_view msid_token_;
+
+  // Current m-section
+  SdpTransportLines media_transport_;
+  bool has_type_{false};
+  bool has_port_{false};
+  bool has_protocol_{false};
+  bool has_payloads_{false};
+  bool has_mid_{false};
+  bool has_direction_{false};
+  bool has_ext_{false};
+  std::vector<RtcpFbLine> rtcp_fbs_;
+  std::vector<FmtpLine> fmtps_;
+  std::vector<SsrcLine> ssrcs_;
+  std::vector<SsrcGroupLine> ssrc_groups_;
+};
+
+} // namespace
+
 // WaSdpInfo
 WaSdpInfo::WaSdpInfo() = default;
 
@@ -933,6 +1811,100 @@ int WaSdpInfo::init(const std::string& strSdp) {
     return wa_e_invalid_param;
   }
 
+#ifdef WA_SDP_TRANSFORM
+  return parseSdpTransform(strSdp);
+#else
+  int ret = parseSdp(strSdp);
+  if(ret != wa_e_parse_offer_failed) {
+    return ret;
+  }
+
+  // let libsdptransform report the malformed sdp as it always did
+  ELOG_WARN("direct sdp parse failed, retry with sdptransform");
+  clear();
+  return parseSdpTransform(strSdp);
+#endif
+}
+
+int WaSdpInfo::parseSdp(std::string_view sdp) {
+  SdpParser parser(*this);
+  if(!parser.parse(sdp)) {
+    return wa_e_parse_offer_failed;
+  }
+  return wa_ok;
+}
+
+std::string WaSdpInfo::writeSdp(const std::string& strMid) {
+  if(media_descs_.empty()){
+    return "";
+  }
+
+  if(!strMid.empty()){
+    bool found = false;
+    for(size_t i = 0; i < media_descs_.size(); ++i){
+      if(media_descs_[i].mid_ == strMid){
+        found = true;
+      }
+    }
+
+    if(!found){
+      return "";
+    }
+  }
+
+  std::string sdp;
+  sdp.reserve(4096);
+
+  sdp.append("v=").append(std::to_string(version_)).append("\r\n");
+
+  sdp.append("o=").append(username_)
+     .append(" ").append(std::to_string(session_id_))
+     .append(" ").append(std::to_string(session_version_))
+     .append(" ").append(nettype_)
+     .append(" IP").append(std::to_string(addrtype_))
+     .append(" ").append(unicast_address_).append("\r\n");
+
+  sdp.append("s=").append(session_name_).append("\r\n");
+
+  sdp.append("t=").append(std::to_string(start_time_))
+     .append(" ").append(std::to_string(end_time_)).append("\r\n");
+
+  if(!extmapAllowMixed_.empty()){
+    sdp.append("a=").append(extmapAllowMixed_).append("\r\n");
+  }
+
+  if(ice_lite_){
+    sdp.append("a=ice-lite\r\n");
+  }
+
+  if(!msid_semantic_.empty()){
+    sdp.append("a=msid-semantic: ").append(msid_semantic_);
+    for(auto& msid : msids_){
+      sdp.append(" ").append(msid);
+    }
+    sdp.append("\r\n");
+  }
+
+  assert(!groups_.empty());
+  sdp.append("a=group:").append(group_policy_).append(" ");
+  for(auto itor=groups_.begin(); itor!=groups_.end();){
+    sdp.append(*itor++);
+    if(itor != groups_.end()){
+      sdp.append(" ");
+    }
+  }
+  sdp.append("\r\n");
+
+  for(auto& desc : media_descs_){
+    if(strMid.empty() || strMid == desc.mid_){
+      desc.write(sdp);
+    }
+  }
+
+  return sdp;
+}
+
+int WaSdpInfo::parseSdpTransform(const std::string& strSdp) {
   auto session = sdptransform::parse(strSdp);
   
   if(session.find("media") == session.end()) {
@@ -1013,7 +1985,15 @@ int WaSdpInfo::init(const std::string& strSdp) {
   return wa_ok;
 }
 
-std::string WaSdpInfo::toString(const std::string& strMid) {   
+std::string WaSdpInfo::toString(const std::string& strMid) {
+#ifdef WA_SDP_TRANSFORM
+  return writeSdpTransform(strMid);
+#else
+  return writeSdp(strMid);
+#endif
+}
+
+std::string WaSdpInfo::writeSdpTransform(const std::string& strMid) {
   if(media_descs_.empty()){
     return "";
   }
@@ -1254,6 +2234,239 @@ std::string WaSdpInfo::singleMediaSdp(const std::string& mid) {
   return toString(mid);
 }
 
+namespace {
+
+// What erizo::SdpInfo::processSdp() reads off the lines MediaDesc::write()
+// gives, each ended by a '\r' its getline keeps, except that candidates keep
+// their type and related address. |mline| and |mtype| carry over from the
+// m-sections before.
+void erizo_media_info(MediaDesc& desc, 
+                      int& mline, 
+                      erizo::MediaType& mtype, 
+                      erizo::SdpInfo& info) {
+  // m=, matched as "m=video" or "m=audio" anywhere in the line
+  bool is_video = desc.type_.compare(0, 5, "video") == 0;
+  bool is_audio = desc.type_.compare(0, 5, "audio") == 0;
+  if (is_video) {
+    info.videoSdpMLine = ++mline;
+    mtype = erizo::VIDEO_TYPE;
+    info.hasVideo = true;
+  } else if (is_audio) {
+    info.audioSdpMLine = ++mline;
+    mtype = erizo::AUDIO_TYPE;
+    info.hasAudio = true;
+  }
+  if (is_video || is_audio) {
+    for (auto& payload : erizo::stringutil::splitOneOf(desc.payloads_, " ")) {
+      unsigned int pt = strtoul(payload.c_str(), nullptr, 10);
+      if (info.parsed_order_map.find(pt) == info.parsed_order_map.end()) {
+        int order = info.parsed_order_map.size();
+        info.parsed_order_map[pt] = order;
+      }
+    }
+    if (desc.payloads_.empty() || desc.payloads_.back() == ' ') {
+      // the field holding nothing but '\r'
+      if (info.parsed_order_map.find(0) == info.parsed_order_map.end()) {
+        int order = info.parsed_order_map.size();
+        info.parsed_order_map[0] = order;
+      }
+    }
+  }
+  if (desc.protocols_.find("SAVPF") != std::string::npos) {
+    info.profile = erizo::SAVPF;
+  }
+
+  // a=rtpmap
+  for (auto& map : desc.rtp_maps_) {
+    unsigned int pt = static_cast<unsigned int>(map.payload_type_);
+    auto map_element = info.payload_parsed_map_.find(pt);
+    if (map_element != info.payload_parsed_map_.end()) {
+      map_element->second.payload_type = pt;
+      map_element->second.encoding_name = map.encoding_name_;
+      map_element->second.clock_rate = static_cast<unsigned int>(map.clock_rate_);
+      map_element->second.media_type = mtype;
+    } else {
+      erizo::RtpMap new_mapping;
+      new_mapping.payload_type = pt;
+      new_mapping.encoding_name = map.encoding_name_;
+      new_mapping.clock_rate = static_cast<unsigned int>(map.clock_rate_);
+      new_mapping.media_type = mtype;
+      info.payload_parsed_map_[pt] = new_mapping;
+    }
+  }
+
+  // a=fmtp, split on " :;" into at most 40 fields past the payload type
+  for (auto& map : desc.rtp_maps_) {
+    if (map.fmtp_.empty()) {
+      continue;
+    }
+    unsigned int pt = static_cast<unsigned int>(map.payload_type_);
+    std::vector<std::string> parts = 
+        erizo::stringutil::splitOneOf(map.fmtp_ + "\r", " :;", 38);
+    for (size_t i = 0; i < parts.size(); ++i) {
+      std::string fmtp_line = parts[i];
+      if (i == parts.size() - 1) {
+        fmtp_line.pop_back();
+      }
+      std::vector<std::string> key_value = 
+          erizo::stringutil::splitOneOf(fmtp_line, "=", 40);
+      std::string option = "none";
+      std::string value = "none";
+      if (key_value.size() == 1) {
+        value = key_value[0];
+      } else if (key_value.size() == 2) {
+        option = key_value[0];
+        value = key_value[1];
+      } else {
+        continue;
+      }
+      info.payload_parsed_map_[pt].payload_type = pt;
+      info.payload_parsed_map_[pt].format_parameters[option] = value;
+    }
+  }
+
+  // a=rtcp-fb
+  for (auto& map : desc.rtp_maps_) {
+    unsigned int pt = static_cast<unsigned int>(map.payload_type_);
+    for (auto& fb : map.rtcp_fb_) {
+      info.payload_parsed_map_[pt].payload_type = pt;
+      info.payload_parsed_map_[pt].feedback_types.push_back(fb);
+    }
+  }
+
+  // a=extmap
+  for (auto& i : desc.extmaps_) {
+    erizo::ExtMap ext(static_cast<unsigned int>(i.second.id), i.second.param);
+    ext.mediaType = mtype;
+    info.extMapVector.push_back(ext);
+  }
+
+  // a=setup
+  const std::string& setup = desc.session_info_.setup_;
+  if (!setup.empty()) {
+    if (setup.find("passive") != std::string::npos) {
+      info.dtlsRole = erizo::PASSIVE;
+    } else if (setup.find("active") != std::string::npos) {
+      info.dtlsRole = erizo::ACTIVE;
+    } else {
+      info.dtlsRole = erizo::ACTPASS;
+    }
+  }
+
+  // a=mid, it only types the bundle tags
+  if (info.isBundle) {
+    std::string this_id = desc.mid_.substr(0, desc.mid_.find(':'));
+    for (auto& tag : info.bundleTags) {
+      if (tag.id == this_id) {
+        tag.mediaType = mtype;
+      }
+    }
+  }
+
+  // a=sendrecv, a=recvonly, a=sendonly
+  erizo::StreamDirection& direction = 
+      mtype == erizo::AUDIO_TYPE ? info.audioDirection : info.videoDirection;
+  if (desc.direction_ == "recvonly") {
+    direction = erizo::RECVONLY;
+  } else if (desc.direction_ == "sendonly") {
+    direction = erizo::SENDONLY;
+  } else if (desc.direction_ == "sendrecv") {
+    direction = erizo::SENDRECV;
+  }
+
+  // a=ice-ufrag, a=ice-pwd
+  const SessionInfo& session = desc.session_info_;
+  if (!session.ice_ufrag_.empty()) {
+    if (mtype == erizo::AUDIO_TYPE) {
+      info.iceAudioUsername_ = session.ice_ufrag_;
+    } else {
+      info.iceVideoUsername_ = session.ice_ufrag_;
+    }
+  }
+  if (!session.ice_pwd_.empty()) {
+    if (mtype == erizo::AUDIO_TYPE) {
+      info.iceAudioPassword_ = session.ice_pwd_;
+    } else {
+      info.iceVideoPassword_ = session.ice_pwd_;
+    }
+  }
+
+  // a=fingerprint
+  if (!session.fingerprint_algo_.empty()) {
+    info.fingerprint = session.fingerprint_;
+    info.isFingerprint = true;
+  }
+
+  // a=candidate, udp only
+  for (auto& c : desc.candidates_) {
+    if (c.transport_type_ != "UDP" && c.transport_type_ != "udp") {
+      continue;
+    }
+    erizo::CandidateInfo cand;
+    cand.mediaType = mtype;
+    cand.foundation = c.foundation_.substr(0, c.foundation_.find(':'));
+    cand.componentId = static_cast<unsigned int>(c.component_);
+    cand.netProtocol = c.transport_type_;
+    cand.priority = static_cast<unsigned int>(c.priority_);
+    cand.hostAddress = c.ip_;
+    cand.hostPort = static_cast<unsigned int>(c.port_);
+    if (c.type_ == "srflx") {
+      cand.hostType = erizo::SRFLX;
+    } else if (c.type_ == "prflx") {
+      cand.hostType = erizo::PRFLX;
+    } else if (c.type_ == "relay") {
+      cand.hostType = erizo::RELAY;
+    } else {
+      cand.hostType = erizo::HOST;
+    }
+    cand.sdp = "a=candidate:" + c.foundation_ + 
+               " " + std::to_string(c.component_) + 
+               " " + c.transport_type_ + 
+               " " + std::to_string(c.priority_) + 
+               " " + c.ip_ + 
+               " " + std::to_string(c.port_) + 
+               " typ " + c.type_;
+    if (!c.raddr_.empty()) {
+      cand.rAddress = c.raddr_;
+      cand.rPort = static_cast<unsigned int>(c.rport_);
+      cand.sdp += " raddr " + c.raddr_ + " rport " + std::to_string(c.rport_);
+    }
+    info.candidateVector_.push_back(cand);
+  }
+
+  // a=rtcp-mux
+  if (!desc.rtcp_mux_.empty()) {
+    info.isRtcpMux = true;
+  }
+}
+
+} //namespace
+
+void WaSdpInfo::singleMediaSdpInfo(const std::string& mid, erizo::SdpInfo& info) {
+  auto selected = [&mid](const MediaDesc& item) {
+    return mid.empty() || item.mid_ == mid;
+  };
+  if (std::none_of(media_descs_.begin(), media_descs_.end(), selected)) {
+    return;
+  }
+
+  // a=group, every mid of it
+  if (group_policy_ == "BUNDLE") {
+    info.isBundle = true;
+  }
+  for (auto& i : groups_) {
+    info.bundleTags.emplace_back(i, erizo::OTHER);
+  }
+
+  int mline = -1;
+  erizo::MediaType mtype = erizo::OTHER;
+  for (auto& desc : media_descs_) {
+    if (selected(desc)) {
+      erizo_media_info(desc, mline, mtype, info);
+    }
+  }
+}
+
 void WaSdpInfo::SetMsid(const std::string& stream_id) {
   msids_.clear();
   msids_.push_back(stream_id);
@@ -1299,5 +2512,26 @@ media_setting WaSdpInfo::get_media_settings(const std::string& mid) {
   return media_setting();
 }
 
+void WaSdpInfo::clear() {
+  version_ = 0;
+  username_.clear();
+  session_id_ = 0;
+  session_version_ = 0;
+  nettype_.clear();
+  addrtype_ = 0;
+  unicast_address_.clear();
+  session_name_.clear();
+  start_time_ = 0;
+  end_time_ = 0;
+  session_info_.clear();
+  groups_.clear();
+  group_policy_.clear();
+  msid_semantic_.clear();
+  msids_.clear();
+  media_descs_.clear();
+  ice_lite_ = false;
+  extmapAllowMixed_.clear();
+}
+
 } //namespace wa
 
@@ -8,6 +8,7 @@
 #define __WA_SDP_PROCESSOR_H__
 
 #include <string>
+#include <string_view>
 #include <vector>
 #include <map>
 #include <iostream>
@@ -18,6 +19,10 @@
 
 using JSON_TYPE = nlohmann::json;
 
+namespace erizo {
+class SdpInfo;
+}
+
 namespace wa {
 
 struct FormatPreference;
@@ -62,6 +67,9 @@ class MediaDesc {
     std::string ip_;
     int32_t port_{0};
     std::string type_;
+    // Related address of srflx and relay candidates, empty if none given
+    std::string raddr_;
+    int32_t rport_{0};
   };
 
   struct rtpmap {
@@ -88,6 +96,7 @@ class MediaDesc {
   struct SSRCGroup {
     void encode(JSON_TYPE& session);
     void decode(const JSON_TYPE& session);
+    void decode(std::string_view semantic, std::string_view ssrcs);
     // e.g FIX, FEC, SIM.
     std::string semantic_;
     // SSRCs of this type. 
@@ -132,6 +141,21 @@ class MediaDesc {
   bool filterByPayload(int32_t payload, bool, bool, bool);
   
   void filterExtmap();
+
+  // Steps of parse() shared with the parser of WaSdpInfo::parseSdp.
+  rtpmap* find_rtpmap_with_payload_type(int payload_type);
+
+  void set_fmtp(rtpmap* map, std::string config);
+
+  void add_ssrc_attribute(uint32_t ssrc, 
+                          std::string_view attribute, 
+                          std::string_view value);
+
+  // |red| and |ulpfec| as they stood before rtcp-fb and fmtp were applied.
+  void relate_red_ulpfec(const rtpmap& red, const rtpmap& ulpfec);
+
+  // Appends the lines of the m-section to |sdp|.
+  void write(std::string& sdp);
  private:
   void parse_candidates(const JSON_TYPE& media);
 
@@ -142,8 +166,6 @@ class MediaDesc {
   void parse_ssrc_info(const JSON_TYPE& media);
 
   SSRCInfo& fetch_or_create_ssrc_info(uint32_t ssrc);
-  
-  rtpmap* find_rtpmap_with_payload_type(int payload_type);
 
   void parse_ssrc_group(const JSON_TYPE& media);
 
@@ -207,6 +229,15 @@ class WaSdpInfo {
 
   int init(const std::string& sdp);
 
+  // Single pass parser and writer behind init() and toString(). parseSdp()
+  // fails on text the libsdptransform based pair would throw on, leaving
+  // init() to fall back to that one.
+  int parseSdp(std::string_view sdp);
+  std::string writeSdp(const std::string& strMid = "");
+
+  int parseSdpTransform(const std::string& sdp);
+  std::string writeSdpTransform(const std::string& strMid = "");
+
   bool empty() { return media_descs_.empty(); }
 
   void media() {}
@@ -234,6 +265,12 @@ class WaSdpInfo {
   
   std::string singleMediaSdp(const std::string& mid);
 
+  // Sets in |info| what info.initWithSdp(singleMediaSdp(mid)) would read,
+  // without writing and parsing the text. For SdpInfo::initWithParsedSdp.
+  // Unlike the text parse, candidates keep their type and related address,
+  // and every mid of the group becomes a bundle tag.
+  void singleMediaSdpInfo(const std::string& mid, erizo::SdpInfo& info);
+
   void setCredentials(const WaSdpInfo&);
   
   void SetMsid(const std::string&);
@@ -253,6 +290,8 @@ class WaSdpInfo {
   WaSdpInfo* answer();
   
   std::string toString(const std::string& strMid = "");
+ private:
+  void clear();
  public:
   // version "v="
   int version_{0};
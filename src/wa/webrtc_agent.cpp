@@ -10,6 +10,7 @@
 #include "webrtc_agent_pc.h"
 
 #include "erizo/global_init.h"
+#include "erizo/TransportPool.h"
 #include "event.h"
 
 using namespace erizo;
@@ -63,6 +64,12 @@ int WebrtcAgent::initiate(uint32_t num_workers,
   return wa_ok;
 }
 
+int WebrtcAgent::setTransportPoolSize(uint32_t size) {
+  std::lock_guard<std::mutex> guard(poolLock_);
+  transportPoolSize_ = size;
+  return wa_ok;
+}
+
 int WebrtcAgent::publish(TOption& options, const std::string& offer) {
   for(auto& i : options.tracks_) {
     i.direction_ = "sendonly";
@@ -79,7 +86,8 @@ int WebrtcAgent::publish(TOption& options, const std::string& offer) {
   
   std::shared_ptr<Worker> worker = workers_->getLessUsedWorker();
   std::shared_ptr<IOWorker> ioworker = io_workers_->getLessUsedIOWorker();
-  pc->init(worker, ioworker, network_addresses_, stun_address_);
+  pc->init(worker, ioworker, transportPool(ioworker, worker), 
+           network_addresses_, stun_address_);
   pc->signalling("offer", offer);
   return wa_ok;
 }
@@ -119,7 +127,8 @@ int WebrtcAgent::subscribe(TOption& options, const std::string& offer) {
   
   std::shared_ptr<Worker> worker = workers_->getLessUsedWorker();
   std::shared_ptr<IOWorker> ioworker = io_workers_->getLessUsedIOWorker();
-  pc->init(worker, ioworker, network_addresses_, stun_address_);
+  pc->init(worker, ioworker, transportPool(ioworker, worker), 
+           network_addresses_, stun_address_);
   pc->signalling("offer", offer);
   return wa_ok;
 }
@@ -194,6 +203,89 @@ int WebrtcAgent::cutoff(const std::string& from, const std::string& to) {
   return wa_ok;
 }
 
+int WebrtcAgent::getStats(const std::string& connectId,
+    std::function<void(const RtcConnectionStats&)> callback) {
+  std::shared_ptr<WrtcAgentPc> pc = findPc(connectId);
+  if (!pc) {
+    return wa_e_not_found;
+  }
+  pc->getStats(std::move(callback));
+  return wa_ok;
+}
+
+int WebrtcAgent::startCapture(const std::string& connectId, 
+                              const std::string& file_prefix,
+                              std::function<void(bool)> callback) {
+  std::shared_ptr<WrtcAgentPc> pc = findPc(connectId);
+  if (!pc) {
+    return wa_e_not_found;
+  }
+  pc->startCapture(file_prefix, std::move(callback));
+  return wa_ok;
+}
+
+int WebrtcAgent::stopCapture(const std::string& connectId) {
+  std::shared_ptr<WrtcAgentPc> pc = findPc(connectId);
+  if (!pc) {
+    return wa_e_not_found;
+  }
+  pc->stopCapture();
+  return wa_ok;
+}
+
+int WebrtcAgent::startEventLog(const std::string& connectId,
+                               const std::string& file_prefix,
+                               std::function<void(bool)> callback) {
+  std::shared_ptr<WrtcAgentPc> pc = findPc(connectId);
+  if (!pc) {
+    return wa_e_not_found;
+  }
+  pc->startEventLog(file_prefix, std::move(callback));
+  return wa_ok;
+}
+
+int WebrtcAgent::stopEventLog(const std::string& connectId) {
+  std::shared_ptr<WrtcAgentPc> pc = findPc(connectId);
+  if (!pc) {
+    return wa_e_not_found;
+  }
+  pc->stopEventLog();
+  return wa_ok;
+}
+
+std::shared_ptr<WrtcAgentPc> WebrtcAgent::findPc(const std::string& connectId) {
+  std::lock_guard<std::mutex> guard(pcLock_);
+  auto found = peerConnections_.find(connectId);
+  if(found == peerConnections_.end()){
+    return nullptr;
+  }
+  return found->second;
+}
+
+std::shared_ptr<erizo::TransportPool> WebrtcAgent::transportPool(
+    const std::shared_ptr<IOWorker>& ioworker, 
+    const std::shared_ptr<Worker>& worker) {
+  std::lock_guard<std::mutex> guard(poolLock_);
+  if (transportPoolSize_ == 0) {
+    return nullptr;
+  }
+
+  auto& pool = transportPools_[ioworker.get()];
+  if (!pool) {
+    pool = std::make_shared<erizo::TransportPool>(
+        WrtcAgentPc::iceConfig(network_addresses_, stun_address_), 
+        ioworker.get(), 
+        transportPoolSize_);
+    std::weak_ptr<erizo::TransportPool> weak_pool = pool;
+    worker->task([weak_pool]() {
+      if (auto pool = weak_pool.lock()) {
+        pool->refill();
+      }
+    });
+  }
+  return pool;
+}
+
 std::unique_ptr<rtc_api> AgentFactory::create_agent() {
   return std::make_unique<WebrtcAgent>();
 }
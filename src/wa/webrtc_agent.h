@@ -20,6 +20,10 @@
 
 #include "./wa_log.h"
 
+namespace erizo {
+class TransportPool;
+}
+
 namespace wa {
 
 class WrtcAgentPc;
@@ -34,6 +38,8 @@ public:
   int initiate(uint32_t num_workers, 
       const std::vector<std::string>& ip_addresses, const std::string& service_addr);
 
+  int setTransportPoolSize(uint32_t size) override;
+
   int publish(TOption&, const std::string& offer) override;
 
   int unpublish(const std::string& connectId) override;
@@ -48,6 +54,21 @@ public:
 
   void mediaOnOff() { }
 
+  int getStats(const std::string& connectId,
+      std::function<void(const RtcConnectionStats&)> callback) override;
+
+  int startCapture(const std::string& connectId, 
+                   const std::string& file_prefix,
+                   std::function<void(bool)> callback) override;
+
+  int stopCapture(const std::string& connectId) override;
+
+  int startEventLog(const std::string& connectId,
+                    const std::string& file_prefix,
+                    std::function<void(bool)> callback) override;
+
+  int stopEventLog(const std::string& connectId) override;
+
   const std::vector<std::string>& getAddresses(){
     return network_addresses_;
   }
@@ -56,6 +77,15 @@ private:
   using connection_id = std::string;
   using track_id = std::string;
 
+  // Pool of prewarmed transports of |ioworker|, made on first use and filled
+  // on |worker|.
+  std::shared_ptr<erizo::TransportPool> transportPool(
+      const std::shared_ptr<IOWorker>& ioworker, 
+      const std::shared_ptr<Worker>& worker);
+
+  // The connection of |connectId|, null if there is none.
+  std::shared_ptr<WrtcAgentPc> findPc(const std::string& connectId);
+
   std::mutex pcLock_;
   std::unordered_map<connection_id, std::shared_ptr<WrtcAgentPc>> peerConnections_;
   //std::map<track_id, TTrackInfo> mediaTracks_;
@@ -66,6 +96,10 @@ private:
 
   std::vector<std::string> network_addresses_;
   std::string stun_address_;
+
+  std::mutex poolLock_;
+  uint32_t transportPoolSize_{0};
+  std::unordered_map<IOWorker*, std::shared_ptr<erizo::TransportPool>> transportPools_;
 };
 
 } //!wa
@@ -6,6 +6,7 @@
 
 #include "webrtc_agent_pc.h"
 
+#include <algorithm>
 #include <atomic>
 
 #include "./wa_log.h"
@@ -210,6 +211,52 @@ void WrtcAgentPc::WebrtcTrack::requestKeyFrame() {
   }
 }
 
+void WrtcAgentPc::WebrtcTrack::getStats(RtcTrackStats& stats, time_point now) {
+  rtc_adapter::AdapterRtpStats rtp;
+  stats.mid_ = mid_;
+  stats.type_ = isAudio() ? media_audio : media_video;
+  if (audioFrameConstructor_) {
+    stats.publish_ = true;
+    audioFrameConstructor_->getStats(rtp);
+  } else if (videoFrameConstructor_) {
+    stats.publish_ = true;
+    videoFrameConstructor_->getStats(rtp);
+  } else if (audioFramePacketizer_) {
+    audioFramePacketizer_->getStats(rtp);
+  } else if (videoFramePacketizer_) {
+    videoFramePacketizer_->getStats(rtp);
+  }
+
+  stats.ssrc_ = rtp.ssrc;
+  stats.packets_ = rtp.packets;
+  stats.bytes_ = rtp.bytes;
+  stats.packets_lost_ = rtp.packets_lost;
+  stats.jitter_ms_ = rtp.jitter_ms;
+  stats.nack_count_ = rtp.nack_count;
+  stats.pli_count_ = rtp.pli_count;
+  stats.fir_count_ = rtp.fir_count;
+  stats.key_frames_ = rtp.key_frames;
+  stats.bwe_bps_ = rtp.bwe_bps;
+  stats.rtt_ms_ = rtp.rtt_ms;
+
+  int64_t elapsed_ms = ClockUtils::durationToMs(now - lastStatsTime_);
+  if (lastStatsTime_ != time_point{} && elapsed_ms > 0 &&
+      rtp.packets >= lastPackets_) {
+    uint64_t packets = rtp.packets - lastPackets_;
+    stats.bitrate_bps_ =
+        static_cast<uint32_t>((rtp.bytes - lastBytes_) * 8000 / elapsed_ms);
+    stats.packet_rate_ = static_cast<uint32_t>(packets * 1000 / elapsed_ms);
+    int64_t lost = std::max(0, rtp.packets_lost - lastPacketsLost_);
+    if (packets + lost > 0) {
+      stats.fraction_lost_ = static_cast<float>(lost) / (packets + lost);
+    }
+  }
+  lastStatsTime_ = now;
+  lastPackets_ = rtp.packets;
+  lastBytes_ = rtp.bytes;
+  lastPacketsLost_ = rtp.packets_lost;
+}
+
 /////////////////////////////
 //WrtcAgentPc
 WrtcAgentPc::WrtcAgentPc(const TOption& config, WebrtcAgent& mgr)
@@ -232,22 +279,28 @@ WrtcAgentPc::~WrtcAgentPc() {
 
 int WrtcAgentPc::init(std::shared_ptr<Worker>& worker, 
                       std::shared_ptr<IOWorker>& ioworker, 
+                      std::shared_ptr<erizo::TransportPool> pool,
                       const std::vector<std::string>& ipAddresses,
                       const std::string& stun_addr) {
   worker_ = worker;
   ioworker_ = ioworker;
 
+#ifdef WA_SHARED_CALL
+  const bool share_call = true;
+#else
+  const bool share_call = false;
+#endif
   adapter_factory_ = std::move(std::make_unique<rtc_adapter::RtcAdapterFactory>(
-      worker->getTaskQueue()));
+      worker->getTaskQueue(), share_call));
 
-  asyncTask([ipAddresses, stun_addr](std::shared_ptr<WrtcAgentPc> pc){
-    pc->init_i(ipAddresses, stun_addr);
+  asyncTask([pool, ipAddresses, stun_addr](std::shared_ptr<WrtcAgentPc> pc){
+    pc->init_i(pool, ipAddresses, stun_addr);
   });
   return wa_ok;
 }
 
-void WrtcAgentPc::init_i(const std::vector<std::string>& ipAddresses, 
-                         const std::string& stun_addr) {
+erizo::IceConfig WrtcAgentPc::iceConfig(const std::vector<std::string>& ipAddresses, 
+                                        const std::string& stun_addr) {
   erizo::IceConfig ice_config;
   ice_config.ip_addresses = ipAddresses;
 
@@ -260,6 +313,13 @@ void WrtcAgentPc::init_i(const std::vector<std::string>& ipAddresses,
 
   std::istringstream iss(stun_addr.substr(pos2+1));
   iss >> ice_config.stun_port;
+  return ice_config;
+}
+
+void WrtcAgentPc::init_i(std::shared_ptr<erizo::TransportPool> pool,
+                         const std::vector<std::string>& ipAddresses, 
+                         const std::string& stun_addr) {
+  erizo::IceConfig ice_config = iceConfig(ipAddresses, stun_addr);
   
   std::vector<erizo::RtpMap> rtp_mappings{rtpH264, rtpRed, rtpOpus};
   
@@ -278,6 +338,7 @@ void WrtcAgentPc::init_i(const std::vector<std::string>& ipAddresses,
                                                 rtp_mappings, 
                                                 ext_mappings, 
                                                 this);
+  connection_->setTransportPool(std::move(pool));
   connection_->init();
 }
 
@@ -330,6 +391,9 @@ srs_error_t WrtcAgentPc::addTrackOperation(const std::string& mid,
 
 void WrtcAgentPc::signalling(const std::string& signal, 
                              const std::string& content) {
+  if (signal == "offer") {
+    offer_time_ = clock::now();
+  }
   asyncTask([this, signal, content](std::shared_ptr<WrtcAgentPc> this_ptr) {
     srs_error_t result = srs_success;  
     if (signal == "offer") {
@@ -410,6 +474,9 @@ void WrtcAgentPc::processSendAnswer(const std::string& streamId,
   }
   std::string answerSdp = local_sdp_->toString();
 
+  OLOG_INFO_THIS(id_ << ", offer to answer " 
+      << ClockUtils::durationToMs(clock::now() - offer_time_) << "ms, prewarmed:"
+      << connection_->getSetupTimes().prewarmed);
   callBack(E_ANSWER, answerSdp);
 }
 
@@ -585,8 +652,9 @@ srs_error_t WrtcAgentPc::setupTransport(MediaDesc& media) {
             std::move(std::dynamic_pointer_cast<owt_base::FrameDestination>(
                 shared_from_this())));
       }
-      connection_->setRemoteSdp(
-          remote_sdp_->singleMediaSdp(media.mid_), media.mid_);
+      connection_->setRemoteSdp([this, &media](erizo::SdpInfo& info) {
+            remote_sdp_->singleMediaSdpInfo(media.mid_, info);
+          }, media.mid_);
     } else {
       result = srs_error_new(wa_e_found, "Conflict trackId %s with %s", 
                              media.mid_.c_str(), id_.c_str());
@@ -794,6 +862,81 @@ void WrtcAgentPc::callBack(E_SINKID, const owt_base::Frame& message) {
   });
 }
 
+void WrtcAgentPc::getStats(
+    std::function<void(const RtcConnectionStats&)> callback) {
+  asyncTask([callback](std::shared_ptr<WrtcAgentPc> this_ptr) {
+    RtcConnectionStats stats;
+    stats.connectId_ = this_ptr->id_;
+    time_point now = clock::now();
+    for (auto& i : this_ptr->track_map_) {
+      stats.tracks_.emplace_back();
+      RtcTrackStats& track = stats.tracks_.back();
+      i.second->getStats(track, now);
+      stats.rtt_ms_ = std::max(stats.rtt_ms_, track.rtt_ms_);
+    }
+
+    QueueStats queue = this_ptr->worker_->queueStats();
+    stats.worker_busy_ratio_ = queue.busy_ratio;
+    stats.worker_queue_delay_p50_us_ = queue.delay.p50_ns / 1000;
+    stats.worker_queue_delay_p99_us_ = queue.delay.p99_ns / 1000;
+
+    if (callback) {
+      callback(stats);
+      return;
+    }
+    auto sink = std::atomic_load<WebrtcAgentSink>(&this_ptr->sink_);
+    if (sink) {
+      sink->callBack([stats](std::shared_ptr<WebrtcAgentSink> pc_sink) {
+        pc_sink->onStat(stats);
+      });
+    }
+  });
+}
+
+void WrtcAgentPc::startCapture(const std::string& file_prefix,
+                               std::function<void(bool)> callback) {
+  asyncTask([file_prefix, callback](std::shared_ptr<WrtcAgentPc> this_ptr) {
+    bool started = this_ptr->connection_ &&
+                   this_ptr->connection_->startCapture(file_prefix);
+    if (!started) {
+      WLOG_ERROR("%s, capture %s not started",
+                 this_ptr->id_.c_str(), file_prefix.c_str());
+    }
+    if (callback) {
+      callback(started);
+    }
+  });
+}
+
+void WrtcAgentPc::stopCapture() {
+  asyncTask([](std::shared_ptr<WrtcAgentPc> this_ptr) {
+    if (this_ptr->connection_) {
+      this_ptr->connection_->stopCapture();
+    }
+  });
+}
+
+void WrtcAgentPc::startEventLog(const std::string& file_prefix,
+                                std::function<void(bool)> callback) {
+  asyncTask([file_prefix, callback](std::shared_ptr<WrtcAgentPc> this_ptr) {
+    bool started = this_ptr->adapter_factory_->CreateRtcAdapter()->
+        startEventLog(file_prefix);
+    if (!started) {
+      WLOG_ERROR("%s, event log %s not started",
+                 this_ptr->id_.c_str(), file_prefix.c_str());
+    }
+    if (callback) {
+      callback(started);
+    }
+  });
+}
+
+void WrtcAgentPc::stopEventLog() {
+  asyncTask([](std::shared_ptr<WrtcAgentPc> this_ptr) {
+    this_ptr->adapter_factory_->CreateRtcAdapter()->stopEventLog();
+  });
+}
+
 void WrtcAgentPc::asyncTask(
     std::function<void(std::shared_ptr<WrtcAgentPc>)> f) {
   std::weak_ptr<WrtcAgentPc> weak_this = weak_from_this();
@@ -81,6 +81,8 @@ class WrtcAgentPc final : public erizo::WebRtcConnectionEventListener,
     int32_t format(bool isAudio) { return isAudio?audioFormat_:videoFormat_; }
     srs_error_t trackControl(ETrackCtrl, bool isIn, bool isOn);
     void requestKeyFrame();
+    // Fills |stats| and moves the rate window on to |now|.
+    void getStats(RtcTrackStats& stats, time_point now);
     inline bool isAudio() {
       return name_ == "audio";
     }
@@ -101,6 +103,12 @@ class WrtcAgentPc final : public erizo::WebRtcConnectionEventListener,
     int32_t audioFormat_{0};
     int32_t videoFormat_{0};
     std::string name_;
+
+    // Counters of the previous getStats
+    time_point lastStatsTime_;
+    uint64_t lastPackets_{0};
+    uint64_t lastBytes_{0};
+    int32_t lastPacketsLost_{0};
   };
 
 public:
@@ -108,11 +116,16 @@ public:
   WrtcAgentPc(const TOption&, WebrtcAgent&);
   ~WrtcAgentPc();
 
+  // |pool| may be null, the transport is then built after the offer.
   int init(std::shared_ptr<Worker>& worker, 
            std::shared_ptr<IOWorker>& ioworker, 
+           std::shared_ptr<erizo::TransportPool> pool,
            const std::vector<std::string>& ipAddresses,
            const std::string& stun_addr);
 
+  static erizo::IceConfig iceConfig(const std::vector<std::string>& ipAddresses,
+                                    const std::string& stun_addr);
+
   void close();
 
   void signalling(const std::string& signal, 
@@ -125,6 +138,19 @@ public:
   void Subscribe(std::shared_ptr<WrtcAgentPc> subscriber);
   void unSubscribe(std::shared_ptr<WrtcAgentPc> subscriber);
 
+  // Snapshot of the connection taken on its worker, see rtc_api::getStats.
+  void getStats(std::function<void(const RtcConnectionStats&)> callback);
+
+  // Clear RTP/RTCP capture of the connection, see rtc_api::startCapture.
+  void startCapture(const std::string& file_prefix,
+                    std::function<void(bool)> callback);
+  void stopCapture();
+
+  // Event log of the connection's adapter, see rtc_api::startEventLog.
+  void startEventLog(const std::string& file_prefix,
+                     std::function<void(bool)> callback);
+  void stopEventLog();
+
   void setAudioSsrc(const std::string& mid, uint32_t ssrc);
   
   void setVideoSsrcList(const std::string& mid, 
@@ -138,7 +164,8 @@ public:
   }
   
  private:
-  void init_i(const std::vector<std::string>& ipAddresses, 
+  void init_i(std::shared_ptr<erizo::TransportPool> pool,
+              const std::vector<std::string>& ipAddresses, 
               const std::string& stun_addr);
   void close_i();
   void subscribe_i(std::shared_ptr<WrtcAgentPc> subscriber, bool isSub);
@@ -235,6 +262,9 @@ private:
   erizo::WebRTCEvent connection_state_;
 
   bool ready_{false};
+
+  // when signalling got the offer, for the offer to answer time
+  wa::time_point offer_time_;
   
   std::unique_ptr<rtc_adapter::RtcAdapterFactory> adapter_factory_;
 };